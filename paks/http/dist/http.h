@@ -75,6 +75,9 @@ struct HttpWebSocket;
 #ifndef ME_HTTP_WEB_SOCKETS
     #define ME_HTTP_WEB_SOCKETS     1
 #endif
+#ifndef ME_HTTP_HTTP2
+    #define ME_HTTP_HTTP2           1
+#endif
 #ifndef ME_HTTP_DEFAULT_METHODS
     #define ME_HTTP_DEFAULT_METHODS "GET,POST"          /**< Default methods for routes */
 #endif
@@ -105,6 +108,9 @@ struct HttpWebSocket;
 #ifndef ME_MAX_IOVEC
     #define ME_MAX_IOVEC           16                   /**< Number of fragments in a single socket write */
 #endif
+#ifndef ME_MIN_REF_WRITE
+    #define ME_MIN_REF_WRITE       1024                 /**< Smaller reference writes are copied into the queue */
+#endif
 #ifndef ME_MAX_CLIENTS_HASH
     #define ME_MAX_CLIENTS_HASH    131                  /**< Hash table for client IP addresses */
 #endif
@@ -917,6 +923,7 @@ typedef struct Http {
     struct HttpStage *ejsHandler;           /**< Ejscript Web Framework handler */
     struct HttpStage *espHandler;           /**< ESP Web Framework handler */
     struct HttpStage *fileHandler;          /**< Static file handler */
+    struct HttpStage *http2Connector;       /**< HTTP/2 stream connector */
     struct HttpStage *netConnector;         /**< Default network connector */
     struct HttpStage *passHandler;          /**< Pass through handler */
     struct HttpStage *phpHandler;           /**< PHP through handler */
@@ -1729,6 +1736,7 @@ typedef struct HttpRange {
 #define HTTP_PACKET_DATA      0x4               /**< Packet contains actual content data */
 #define HTTP_PACKET_END       0x8               /**< End of stream packet */
 #define HTTP_PACKET_SOLO      0x10              /**< Don't join this packet */
+#define HTTP_PACKET_REF       0x20              /**< Packet content references immutable external data */
 
 /**
     Callback procedure to fill a packet with data
@@ -2433,6 +2441,26 @@ PUBLIC ssize httpWrite(HttpQueue *q, cchar *fmt, ...) PRINTF_ATTRIBUTE(2,3);
  */
 PUBLIC ssize httpWriteBlock(HttpQueue *q, cchar *buf, ssize size, int flags);
 
+/**
+    Write a block of immutable data to the queue without copying
+    @description This queues a reference to the caller's data in a new packet rather than copying the data into the
+        queue buffers. The network connector then writes the referenced data directly via a vectored socket write.
+        The data must not be modified while it is referenced. The owner memory block is retained by the packet until
+        the data has been written. Writes smaller than ME_MIN_REF_WRITE are copied via #httpWriteBlock as copying
+        small fragments is cheaper than creating a packet for each fragment.
+        \n\n
+        The data is always accepted in full. Otherwise, this call behaves like #httpWriteBlock.
+    @param q Queue reference
+    @param buf Buffer containing the write data
+    @param size of the data in buf
+    @param owner Allocated memory block containing buf. For example, the string object holding the data.
+    @param flags Set to HTTP_BLOCK, HTTP_NON_BLOCK or HTTP_BUFFER. See #httpWriteBlock for details.
+    @return The size value if successful or a negative MPR error code.
+    @ingroup HttpQueue
+    @stability Prototype
+ */
+PUBLIC ssize httpWriteBlockRef(HttpQueue *q, cchar *buf, ssize size, cvoid *owner, int flags);
+
 /**
     Write a string of data to the queue
     @description Write a string of data into packets onto the end of the queue. Data packets will be created
@@ -2801,6 +2829,7 @@ PUBLIC int httpOpenChunkFilter();
 PUBLIC int httpOpenCacheHandler();
 PUBLIC int httpOpenDirHandler();
 PUBLIC int httpOpenFileHandler();
+PUBLIC int httpOpenHttp2Connector();
 PUBLIC int httpOpenPassHandler();
 PUBLIC int httpOpenRangeFilter();
 PUBLIC int httpOpenNetConnector();
@@ -2950,6 +2979,8 @@ typedef struct HttpConn {
     struct HttpHost *host;                  /**< Host object (if relevant) */
 
     HttpPacket      *input;                 /**< Header packet */
+    struct Http2    *h2;                    /**< HTTP/2 connection state (network connection only) */
+    struct Http2Stream *stream;             /**< HTTP/2 stream (stream connections only) */
     ssize           lastRead;               /**< Length of new data last read into the input packet */
     HttpQueue       *connectorq;            /**< Connector write queue */
     MprTicks        started;                /**< When the request started (ticks) */
@@ -7284,6 +7315,7 @@ PUBLIC ssize httpWriteUploadData(HttpConn *conn, MprList *formData, MprList *fil
     Endpoint flags
  */
 #define HTTP_NEW_DISPATCHER     0x1         /**< New dispatcher for each connection */
+#define HTTP_REUSE_PORT         0x2         /**< Share the listening port with other processes (SO_REUSEPORT) */
 
 /**
     Listening endpoints. Endpoints may have multiple virtual named hosts.
@@ -8001,6 +8033,89 @@ PUBLIC int httpUpgradeWebSocket(HttpConn *conn);
  */
 PUBLIC bool httpWebSocketOrderlyClosed(HttpConn *conn);
 
+/************************************ HTTP/2 ***************************************/
+/**
+    HTTP/2 support for server-side connections (RFC 7540, RFC 7541).
+    @description HTTP/2 multiplexes many concurrent requests over a single network connection. The http library detects
+    HTTP/2 by the client connection preface which is sent either after the "h2" protocol is negotiated via TLS ALPN, or
+    directly over cleartext connections with prior knowledge (h2c). Each HTTP/2 stream is serviced by a lightweight
+    stream connection (HttpConn) with its own request pipeline so that handlers are unaware of the framing. Request
+    headers are decoded via HPACK and presented to the stream connection as a HTTP/1.1 request. Responses are framed by
+    the http2Connector which enforces per-stream and per-connection flow control. When the connection is congested,
+    streams waiting to write are resumed in order of their priority weight.
+    @defgroup Http2 Http2
+    @see httpDetectHttp2 httpIOHttp2
+    @stability Prototype
+ */
+typedef struct Http2 {
+    HttpConn        *conn;                  /**< Network connection owning the HTTP/2 session */
+    MprList         *streams;               /**< Active streams (Http2Stream) */
+    MprList         *blocked;               /**< Streams waiting for flow control window or output space */
+    MprList         *table;                 /**< HPACK dynamic decoder table (MprKeyValue, newest first) */
+    MprBuf          *headers;               /**< Header block being assembled from HEADERS and CONTINUATION frames */
+    MprBuf          *output;                /**< Encoded frames waiting to be written to the network */
+    MprMutex        *mutex;                 /**< Multithread sync for streams on worker threads */
+    ssize           tableSize;              /**< Current size of the dynamic table */
+    ssize           tableMax;               /**< Maximum size of the dynamic table */
+    ssize           window;                 /**< Connection level send window */
+    ssize           initialWindow;          /**< Initial stream send window (SETTINGS_INITIAL_WINDOW_SIZE) */
+    ssize           frameSize;              /**< Maximum frame size accepted by the peer */
+    int             headerStream;           /**< Stream receiving the current header block */
+    int             headerFlags;            /**< Flags of the HEADERS frame starting the current header block */
+    int             headerWeight;           /**< Priority weight of the current header block */
+    int             lastStreamId;           /**< Highest stream ID opened by the peer */
+    int             maxStreams;             /**< Maximum concurrent streams */
+    bool            goaway: 1;              /**< GOAWAY sent or received. No new streams accepted */
+    bool            flushing: 1;            /**< Flush event scheduled on the connection dispatcher */
+} Http2;
+
+/**
+    HTTP/2 stream
+    @ingroup Http2
+    @stability Prototype
+ */
+typedef struct Http2Stream {
+    Http2           *h2;                    /**< Owning HTTP/2 session */
+    HttpConn        *conn;                  /**< Stream connection servicing the request */
+    HttpPacket      *input;                 /**< Received data waiting to be passed to the stream connection */
+    ssize           window;                 /**< Stream send window */
+    ssize           consumed;               /**< Received data to acknowledge via WINDOW_UPDATE */
+    int             id;                     /**< Stream identifier */
+    int             weight;                 /**< Priority weight (1-256) */
+    bool            chunked: 1;             /**< Request body is presented to the pipeline using chunked encoding */
+    bool            chunks: 1;              /**< At least one body chunk has been presented */
+    bool            endRx: 1;               /**< Peer has ended the stream */
+    bool            endTx: 1;               /**< END_STREAM has been sent */
+    bool            reset: 1;               /**< Stream has been reset */
+    bool            scheduled: 1;           /**< Stream event has been scheduled */
+} Http2Stream;
+
+/**
+    Test if a connection is starting a HTTP/2 session
+    @description Called for new server connections to detect the HTTP/2 client connection preface.
+    @param conn HttpConn connection object
+    @return 1 if the connection preface has been received, zero if the connection is using HTTP/1 and -1 if more
+        data is required to decide.
+    @ingroup Http2
+    @stability Prototype
+ */
+PUBLIC int httpDetectHttp2(HttpConn *conn);
+
+/**
+    Service I/O on a HTTP/2 network connection
+    @param conn HttpConn connection object
+    @param eventMask I/O event mask
+    @ingroup Http2
+    @stability Prototype
+ */
+PUBLIC void httpIOHttp2(HttpConn *conn, int eventMask);
+
+/* Internal APIs */
+PUBLIC void httpDestroyHttp2(HttpConn *conn);
+PUBLIC void httpDestroyHttp2Stream(HttpConn *conn);
+PUBLIC void httpEnableHttp2StreamEvents(HttpConn *conn);
+PUBLIC int httpGetHttp2EventMask(HttpConn *conn);
+
 /************************************ Dir  *****************************************/
 /**
     Directory object for the DirHandler
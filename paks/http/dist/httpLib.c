@@ -140,6 +140,9 @@ PUBLIC Http *httpCreate(int flags)
     httpOpenChunkFilter();
 #if ME_HTTP_WEB_SOCKETS
     httpOpenWebSockFilter();
+#endif
+#if ME_HTTP_HTTP2
+    httpOpenHttp2Connector();
 #endif
     mprSetIdleCallback(isIdle);
     mprAddTerminator(terminateHttp);
@@ -2843,7 +2846,8 @@ static int matchChunk(HttpConn *conn, HttpRoute *route, int dir)
 
     tx = conn->tx;
 
-    if (conn->upgraded || (httpClientConn(conn) && tx->parsedUri && tx->parsedUri->webSockets)) {
+    if (conn->upgraded || conn->stream || (httpClientConn(conn) && tx->parsedUri && tx->parsedUri->webSockets)) {
+        /* HTTP/2 frames the response data */
         return HTTP_ROUTE_OMIT_FILTER;
     }
     if (dir & HTTP_STAGE_TX) {
@@ -5787,7 +5791,9 @@ PUBLIC void httpDestroyConn(HttpConn *conn)
     if (!conn->destroyed && !conn->borrowed) {
         HTTP_NOTIFY(conn, HTTP_EVENT_DESTROY, 0);
         if (httpServerConn(conn)) {
-            httpMonitorEvent(conn, HTTP_COUNTER_ACTIVE_CONNECTIONS, -1);
+            if (!conn->stream) {
+                httpMonitorEvent(conn, HTTP_COUNTER_ACTIVE_CONNECTIONS, -1);
+            }
             if (conn->activeRequest) {
                 httpMonitorEvent(conn, HTTP_COUNTER_ACTIVE_REQUESTS, -1);
                 conn->activeRequest = 0;
@@ -5795,13 +5801,20 @@ PUBLIC void httpDestroyConn(HttpConn *conn)
         }
         httpRemoveConn(conn);
         conn->input = 0;
+#if ME_HTTP_HTTP2
+        if (conn->stream) {
+            httpDestroyHttp2Stream(conn);
+        } else if (conn->h2) {
+            httpDestroyHttp2(conn);
+        }
+#endif
         if (conn->tx) {
             httpClosePipeline(conn);
         }
-        if (conn->sock) {
+        if (conn->sock && !conn->stream) {
             mprCloseSocket(conn->sock, 0);
         }
-        if (conn->dispatcher && conn->dispatcher->flags & MPR_DISPATCHER_AUTO) {
+        if (conn->dispatcher && conn->dispatcher->flags & MPR_DISPATCHER_AUTO && !conn->stream) {
             mprDestroyDispatcher(conn->dispatcher);
         }
         conn->destroyed = 1;
@@ -5830,6 +5843,8 @@ static void manageConn(HttpConn *conn, int flags)
         mprMark(conn->endpoint);
         mprMark(conn->host);
         mprMark(conn->input);
+        mprMark(conn->h2);
+        mprMark(conn->stream);
         mprMark(conn->connectorq);
         mprMark(conn->timeoutEvent);
         mprMark(conn->workerEvent);
@@ -5862,7 +5877,7 @@ PUBLIC void httpDisconnect(HttpConn *conn)
     HttpTx      *tx;
 
     tx = conn->tx;
-    if (conn->sock) {
+    if (conn->sock && !conn->stream) {
         mprDisconnectSocket(conn->sock);
     }
     conn->connError++;
@@ -6164,6 +6179,9 @@ static void readPeerData(HttpConn *conn)
 PUBLIC void httpIO(HttpConn *conn, int eventMask)
 {
     MprSocket   *sp;
+#if ME_HTTP_HTTP2
+    int         rc;
+#endif
 
     sp = conn->sock;
     if (conn->destroyed) {
@@ -6207,6 +6225,22 @@ PUBLIC void httpIO(HttpConn *conn, int eventMask)
             mprLog("info http ssl", 5, "SSL State: %s", mprGetSocketState(sp));
         }
     }
+#if ME_HTTP_HTTP2
+    /*
+        HTTP/2 connections are detected by the connection preface. Thereafter, frames are processed by the http2 layer.
+     */
+    rc = 0;
+    if (conn->h2 || (rc = httpDetectHttp2(conn)) > 0) {
+        conn->io = 0;
+        httpIOHttp2(conn, eventMask);
+        return;
+    } else if (rc < 0) {
+        /* Partial connection preface */
+        conn->io = 0;
+        httpEnableConnEvents(conn);
+        return;
+    }
+#endif
     /*
         Process one or more complete requests in the packet
      */
@@ -6215,6 +6249,11 @@ PUBLIC void httpIO(HttpConn *conn, int eventMask)
         httpProtocol(conn);
     } while (conn->endpoint && conn->state == HTTP_STATE_COMPLETE && prepForNext(conn));
 
+    /*
+        Clear before enabling events. Once enabled, the next I/O event may run immediately on a worker dispatcher.
+     */
+    conn->io = 0;
+
     /*
         When a request completes, prepForNext will reset the state to HTTP_STATE_BEGIN
         Errors will set keepAliveCount to zero.
@@ -6228,7 +6267,6 @@ PUBLIC void httpIO(HttpConn *conn, int eventMask)
     } else if (!mprIsSocketEof(conn->sock) && conn->async && !conn->delay) {
         httpEnableConnEvents(conn);
     }
-    conn->io = 0;
 }
 
 
@@ -6250,6 +6288,11 @@ PUBLIC int httpGetConnEventMask(HttpConn *conn)
     MprSocket   *sp;
     int         eventMask;
 
+#if ME_HTTP_HTTP2
+    if (conn->h2) {
+        return httpGetHttp2EventMask(conn);
+    }
+#endif
     sp = conn->sock;
     rx = conn->rx;
     tx = conn->tx;
@@ -6291,6 +6334,13 @@ PUBLIC void httpEnableConnEvents(HttpConn *conn)
         mprQueueEvent(conn->dispatcher, event);
         return;
     }
+#if ME_HTTP_HTTP2
+    if (conn->stream) {
+        /* HTTP/2 streams share the network connection and are scheduled via events */
+        httpEnableHttp2StreamEvents(conn);
+        return;
+    }
+#endif
     httpSetupWaitHandler(conn, httpGetConnEventMask(conn));
 }
 
@@ -7932,7 +7982,7 @@ PUBLIC int httpStartEndpoint(HttpEndpoint *endpoint)
 {
     HttpHost    *host;
     cchar       *proto, *ip;
-    int         next;
+    int         flags, next;
 
     if (!validateEndpoint(endpoint)) {
         return MPR_ERR_BAD_ARGS;
@@ -7943,8 +7993,11 @@ PUBLIC int httpStartEndpoint(HttpEndpoint *endpoint)
     if ((endpoint->sock = mprCreateSocket()) == 0) {
         return MPR_ERR_MEMORY;
     }
-    if (mprListenOnSocket(endpoint->sock, endpoint->ip, endpoint->port,
-                MPR_SOCKET_NODELAY | MPR_SOCKET_THREAD) == SOCKET_ERROR) {
+    flags = MPR_SOCKET_NODELAY | MPR_SOCKET_THREAD;
+    if (endpoint->flags & HTTP_REUSE_PORT) {
+        flags |= MPR_SOCKET_REUSE_PORT;
+    }
+    if (mprListenOnSocket(endpoint->sock, endpoint->ip, endpoint->port, flags) == SOCKET_ERROR) {
         if (mprGetError() == EADDRINUSE) {
             mprLog("error http", 0, "Cannot open a socket on %s:%d, socket already bound.",
                 *endpoint->ip ? endpoint->ip : "*", endpoint->port);
@@ -8118,6 +8171,11 @@ PUBLIC int httpSecureEndpoint(HttpEndpoint *endpoint, struct MprSsl *ssl)
 #if ME_COM_SSL
     endpoint->ssl = ssl;
     mprSetSslMatch(ssl, httpMatchSsl);
+#if ME_HTTP_HTTP2
+    if (ssl && !ssl->alpn) {
+        mprSetSslAlpn(ssl, "h2,http/1.1");
+    }
+#endif
     return 0;
 #else
     mprLog("error http", 0, "Configuration lacks SSL support");
@@ -9329,115 +9387,1900 @@ PUBLIC int httpAddRoute(HttpHost *host, HttpRoute *route)
             }
         }
     }
-    httpSetRouteHost(route, host);
-    return 0;
+    httpSetRouteHost(route, host);
+    return 0;
+}
+
+
+PUBLIC HttpRoute *httpLookupRoute(HttpHost *host, cchar *pattern)
+{
+    HttpRoute   *route;
+    int         next;
+
+    if (smatch(pattern, "default")) {
+        pattern = "";
+    }
+    if (smatch(pattern, "/") || smatch(pattern, "^/") || smatch(pattern, "^/$")) {
+        pattern = "";
+    }
+    if (!host && (host = httpGetDefaultHost()) == 0) {
+        return 0;
+    }
+    for (next = 0; (route = mprGetNextItem(host->routes, &next)) != 0; ) {
+        assert(route->pattern);
+        if (smatch(route->pattern, pattern)) {
+            return route;
+        }
+    }
+    return 0;
+}
+
+
+PUBLIC void httpResetRoutes(HttpHost *host)
+{
+    host->routes = mprCreateList(-1, MPR_LIST_STABLE);
+}
+
+
+PUBLIC void httpSetHostDefaultRoute(HttpHost *host, HttpRoute *route)
+{
+    host->defaultRoute = route;
+}
+
+
+PUBLIC void httpSetDefaultHost(HttpHost *host)
+{
+    defaultHost = host;
+}
+
+
+PUBLIC void httpSetHostSecureEndpoint(HttpHost *host, HttpEndpoint *endpoint)
+{
+    host->secureEndpoint = endpoint;
+}
+
+
+PUBLIC void httpSetHostDefaultEndpoint(HttpHost *host, HttpEndpoint *endpoint)
+{
+    host->defaultEndpoint = endpoint;
+}
+
+
+PUBLIC HttpHost *httpGetDefaultHost()
+{
+    return defaultHost;
+}
+
+
+PUBLIC HttpRoute *httpGetDefaultRoute(HttpHost *host)
+{
+    if (host) {
+        return host->defaultRoute;
+    } else if (defaultHost) {
+        return defaultHost->defaultRoute;
+    }
+    return 0;
+}
+
+
+PUBLIC bool httpGetStreaming(HttpHost *host, cchar *mime, cchar *uri)
+{
+    MprKey      *kp;
+
+    assert(host);
+    assert(host->streams);
+
+    if (schr(mime, ';')) {
+        mime = ssplit(sclone(mime), ";", 0);
+    }
+    if ((kp = mprLookupKeyEntry(host->streams, mime)) != 0) {
+        if (kp->data == NULL || sstarts(uri, kp->data)) {
+            /* Type is set to the enable value */
+            return kp->type;
+        }
+    }
+    return 1;
+}
+
+
+PUBLIC void httpSetStreaming(HttpHost *host, cchar *mime, cchar *uri, bool enable)
+{
+    MprKey  *kp;
+
+    assert(host);
+    if ((kp = mprAddKey(host->streams, mime, uri)) != 0) {
+        /*
+            We store the enable value in the key type to save an allocation
+         */
+        kp->type = enable;
+    }
+}
+
+/*
+    @copy   default
+
+    Copyright (c) Embedthis Software. All Rights Reserved.
+
+    This software is distributed under commercial and open source licenses.
+    You may use the Embedthis Open Source license or you may acquire a
+    commercial license from Embedthis Software. You agree to be fully bound
+    by the terms of either license. Consult the LICENSE.md distributed with
+    this software for full details and other copyrights.
+
+    Local variables:
+    tab-width: 4
+    c-basic-offset: 4
+    End:
+    vim: sw=4 ts=4 expandtab
+
+    @end
+ */
+
+
+
+/********* Start of file src/http2.c ************/
+
+
+/*
+    http2.c -- HTTP/2 framing layer (RFC 7540) with HPACK header compression (RFC 7541)
+
+    A HTTP/2 session is detected on a new server connection by the client connection preface. The preface is sent
+    after the "h2" protocol is selected via TLS ALPN, or immediately by cleartext clients with prior knowledge (h2c).
+    Thereafter, the network connection carries only frames. Each request stream is serviced by a stream connection
+    (HttpConn) that runs the normal request pipeline. Decoded request headers are presented to the stream connection
+    as a HTTP/1.1 request and request bodies of unknown length are presented using chunked transfer encoding.
+    Responses are framed by the http2Connector which honors per-stream and per-connection flow control.
+
+    Stream connections may run on worker threads, so session state is guarded by the Http2 mutex. Frames are
+    assembled in the Http2 output buffer which is only written to the network on the network connection dispatcher.
+
+    Copyright (c) All Rights Reserved. See details at the end of the file.
+ */
+
+/********************************* Includes ***********************************/
+
+
+
+#if ME_HTTP_HTTP2
+/*********************************** Locals ***********************************/
+
+#define H2_PREFACE              "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n"
+#define H2_PREFACE_LEN          24
+#define H2_FRAME_HEADER         9
+
+/*
+    Frame types
+ */
+#define H2_DATA                 0x0
+#define H2_HEADERS              0x1
+#define H2_PRIORITY             0x2
+#define H2_RST_STREAM           0x3
+#define H2_SETTINGS             0x4
+#define H2_PUSH_PROMISE         0x5
+#define H2_PING                 0x6
+#define H2_GOAWAY               0x7
+#define H2_WINDOW_UPDATE        0x8
+#define H2_CONTINUATION         0x9
+
+/*
+    Frame flags
+ */
+#define H2_ACK                  0x1
+#define H2_END_STREAM           0x1
+#define H2_END_HEADERS          0x4
+#define H2_PADDED               0x8
+#define H2_PRIORITY_FLAG        0x20
+
+/*
+    Settings
+ */
+#define H2_HEADER_TABLE_SIZE    0x1
+#define H2_ENABLE_PUSH          0x2
+#define H2_MAX_STREAMS          0x3
+#define H2_INITIAL_WINDOW_SIZE  0x4
+#define H2_MAX_FRAME_SIZE       0x5
+#define H2_MAX_HEADER_LIST_SIZE 0x6
+
+/*
+    Error codes
+ */
+#define H2_NO_ERROR             0x0
+#define H2_PROTOCOL_ERROR       0x1
+#define H2_INTERNAL_ERROR       0x2
+#define H2_FLOW_CONTROL_ERROR   0x3
+#define H2_STREAM_CLOSED        0x5
+#define H2_FRAME_SIZE_ERROR     0x6
+#define H2_REFUSED_STREAM       0x7
+#define H2_CANCEL               0x8
+#define H2_COMPRESSION_ERROR    0x9
+#define H2_ENHANCE_YOUR_CALM    0xb
+
+#define H2_DEFAULT_FRAME        16384           /* Default and maximum accepted frame size */
+#define H2_DEFAULT_WINDOW       65535           /* Default flow control window */
+#define H2_MAX_WINDOW           0x7FFFFFFF
+#define H2_TABLE_SIZE           4096            /* HPACK dynamic table size */
+#define H2_STREAMS_MAX          100             /* Default maximum concurrent streams */
+#define H2_OUTPUT_MAX           (64 * 1024)     /* Buffered output before streams must wait */
+#define H2_DEFAULT_WEIGHT       16
+#define H2_STATIC_ENTRIES       62              /* HPACK static table entries (plus one for the unused zero index) */
+
+/*
+    HPACK static table (RFC 7541 Appendix A)
+ */
+static cchar *staticTable[H2_STATIC_ENTRIES][2] = {
+    { 0, 0 },
+    { ":authority", "" },
+    { ":method", "GET" },
+    { ":method", "POST" },
+    { ":path", "/" },
+    { ":path", "/index.html" },
+    { ":scheme", "http" },
+    { ":scheme", "https" },
+    { ":status", "200" },
+    { ":status", "204" },
+    { ":status", "206" },
+    { ":status", "304" },
+    { ":status", "400" },
+    { ":status", "404" },
+    { ":status", "500" },
+    { "accept-charset", "" },
+    { "accept-encoding", "gzip, deflate" },
+    { "accept-language", "" },
+    { "accept-ranges", "" },
+    { "accept", "" },
+    { "access-control-allow-origin", "" },
+    { "age", "" },
+    { "allow", "" },
+    { "authorization", "" },
+    { "cache-control", "" },
+    { "content-disposition", "" },
+    { "content-encoding", "" },
+    { "content-language", "" },
+    { "content-length", "" },
+    { "content-location", "" },
+    { "content-range", "" },
+    { "content-type", "" },
+    { "cookie", "" },
+    { "date", "" },
+    { "etag", "" },
+    { "expect", "" },
+    { "expires", "" },
+    { "from", "" },
+    { "host", "" },
+    { "if-match", "" },
+    { "if-modified-since", "" },
+    { "if-none-match", "" },
+    { "if-range", "" },
+    { "if-unmodified-since", "" },
+    { "last-modified", "" },
+    { "link", "" },
+    { "location", "" },
+    { "max-forwards", "" },
+    { "proxy-authenticate", "" },
+    { "proxy-authorization", "" },
+    { "range", "" },
+    { "referer", "" },
+    { "refresh", "" },
+    { "retry-after", "" },
+    { "server", "" },
+    { "set-cookie", "" },
+    { "strict-transport-security", "" },
+    { "transfer-encoding", "" },
+    { "user-agent", "" },
+    { "vary", "" },
+    { "via", "" },
+    { "www-authenticate", "" },
+};
+
+/*
+    HPACK Huffman code (RFC 7541 Appendix B). Codes are right aligned. Symbol 256 is EOS.
+ */
+static const uint huffCodes[257] = {
+    0x1ff8, 0x7fffd8, 0xfffffe2, 0xfffffe3, 0xfffffe4, 0xfffffe5,
+    0xfffffe6, 0xfffffe7, 0xfffffe8, 0xffffea, 0x3ffffffc, 0xfffffe9,
+    0xfffffea, 0x3ffffffd, 0xfffffeb, 0xfffffec, 0xfffffed, 0xfffffee,
+    0xfffffef, 0xffffff0, 0xffffff1, 0xffffff2, 0x3ffffffe, 0xffffff3,
+    0xffffff4, 0xffffff5, 0xffffff6, 0xffffff7, 0xffffff8, 0xffffff9,
+    0xffffffa, 0xffffffb, 0x14, 0x3f8, 0x3f9, 0xffa,
+    0x1ff9, 0x15, 0xf8, 0x7fa, 0x3fa, 0x3fb,
+    0xf9, 0x7fb, 0xfa, 0x16, 0x17, 0x18,
+    0x0, 0x1, 0x2, 0x19, 0x1a, 0x1b,
+    0x1c, 0x1d, 0x1e, 0x1f, 0x5c, 0xfb,
+    0x7ffc, 0x20, 0xffb, 0x3fc, 0x1ffa, 0x21,
+    0x5d, 0x5e, 0x5f, 0x60, 0x61, 0x62,
+    0x63, 0x64, 0x65, 0x66, 0x67, 0x68,
+    0x69, 0x6a, 0x6b, 0x6c, 0x6d, 0x6e,
+    0x6f, 0x70, 0x71, 0x72, 0xfc, 0x73,
+    0xfd, 0x1ffb, 0x7fff0, 0x1ffc, 0x3ffc, 0x22,
+    0x7ffd, 0x3, 0x23, 0x4, 0x24, 0x5,
+    0x25, 0x26, 0x27, 0x6, 0x74, 0x75,
+    0x28, 0x29, 0x2a, 0x7, 0x2b, 0x76,
+    0x2c, 0x8, 0x9, 0x2d, 0x77, 0x78,
+    0x79, 0x7a, 0x7b, 0x7ffe, 0x7fc, 0x3ffd,
+    0x1ffd, 0xffffffc, 0xfffe6, 0x3fffd2, 0xfffe7, 0xfffe8,
+    0x3fffd3, 0x3fffd4, 0x3fffd5, 0x7fffd9, 0x3fffd6, 0x7fffda,
+    0x7fffdb, 0x7fffdc, 0x7fffdd, 0x7fffde, 0xffffeb, 0x7fffdf,
+    0xffffec, 0xffffed, 0x3fffd7, 0x7fffe0, 0xffffee, 0x7fffe1,
+    0x7fffe2, 0x7fffe3, 0x7fffe4, 0x1fffdc, 0x3fffd8, 0x7fffe5,
+    0x3fffd9, 0x7fffe6, 0x7fffe7, 0xffffef, 0x3fffda, 0x1fffdd,
+    0xfffe9, 0x3fffdb, 0x3fffdc, 0x7fffe8, 0x7fffe9, 0x1fffde,
+    0x7fffea, 0x3fffdd, 0x3fffde, 0xfffff0, 0x1fffdf, 0x3fffdf,
+    0x7fffeb, 0x7fffec, 0x1fffe0, 0x1fffe1, 0x3fffe0, 0x1fffe2,
+    0x7fffed, 0x3fffe1, 0x7fffee, 0x7fffef, 0xfffea, 0x3fffe2,
+    0x3fffe3, 0x3fffe4, 0x7ffff0, 0x3fffe5, 0x3fffe6, 0x7ffff1,
+    0x3ffffe0, 0x3ffffe1, 0xfffeb, 0x7fff1, 0x3fffe7, 0x7ffff2,
+    0x3fffe8, 0x1ffffec, 0x3ffffe2, 0x3ffffe3, 0x3ffffe4, 0x7ffffde,
+    0x7ffffdf, 0x3ffffe5, 0xfffff1, 0x1ffffed, 0x7fff2, 0x1fffe3,
+    0x3ffffe6, 0x7ffffe0, 0x7ffffe1, 0x3ffffe7, 0x7ffffe2, 0xfffff2,
+    0x1fffe4, 0x1fffe5, 0x3ffffe8, 0x3ffffe9, 0xffffffd, 0x7ffffe3,
+    0x7ffffe4, 0x7ffffe5, 0xfffec, 0xfffff3, 0xfffed, 0x1fffe6,
+    0x3fffe9, 0x1fffe7, 0x1fffe8, 0x7ffff3, 0x3fffea, 0x3fffeb,
+    0x1ffffee, 0x1ffffef, 0xfffff4, 0xfffff5, 0x3ffffea, 0x7ffff4,
+    0x3ffffeb, 0x7ffffe6, 0x3ffffec, 0x3ffffed, 0x7ffffe7, 0x7ffffe8,
+    0x7ffffe9, 0x7ffffea, 0x7ffffeb, 0xffffffe, 0x7ffffec, 0x7ffffed,
+    0x7ffffee, 0x7ffffef, 0x7fffff0, 0x3ffffee, 0x3fffffff,
+};
+
+static const uchar huffBits[257] = {
+    13, 23, 28, 28, 28, 28, 28, 28, 28, 24, 30, 28, 28, 30, 28, 28,
+    28, 28, 28, 28, 28, 28, 30, 28, 28, 28, 28, 28, 28, 28, 28, 28,
+    6, 10, 10, 12, 13, 6, 8, 11, 10, 10, 8, 11, 8, 6, 6, 6,
+    5, 5, 5, 6, 6, 6, 6, 6, 6, 6, 7, 8, 15, 6, 12, 10,
+    13, 6, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+    7, 7, 7, 7, 7, 7, 7, 7, 8, 7, 8, 13, 19, 13, 14, 6,
+    15, 5, 6, 5, 6, 5, 6, 6, 6, 5, 7, 7, 6, 6, 6, 5,
+    6, 7, 6, 5, 5, 6, 7, 7, 7, 7, 7, 15, 11, 14, 13, 28,
+    20, 22, 20, 20, 22, 22, 22, 23, 22, 23, 23, 23, 23, 23, 24, 23,
+    24, 24, 22, 23, 24, 23, 23, 23, 23, 21, 22, 23, 22, 23, 23, 24,
+    22, 21, 20, 22, 22, 23, 23, 21, 23, 22, 22, 24, 21, 22, 23, 23,
+    21, 21, 22, 21, 23, 22, 23, 23, 20, 22, 22, 22, 23, 22, 22, 23,
+    26, 26, 20, 19, 22, 23, 22, 25, 26, 26, 26, 27, 27, 26, 24, 25,
+    19, 21, 26, 27, 27, 26, 27, 24, 21, 21, 26, 26, 28, 27, 27, 27,
+    20, 24, 20, 21, 22, 21, 21, 23, 22, 22, 25, 25, 24, 24, 26, 23,
+    26, 27, 26, 26, 27, 27, 27, 27, 27, 28, 27, 27, 27, 27, 27, 26,
+    30,
+};
+
+/*
+    Canonical decoding tables indexed by code length. Built when the connector is opened.
+ */
+static uint huffFirst[32];
+static int huffCount[32];
+static int huffOffset[32];
+static short huffSymbols[257];
+
+/*
+    Hop-by-hop headers that must not be used with HTTP/2
+ */
+static cchar *connectionHeaders[] = {
+    "connection", "keep-alive", "proxy-connection", "transfer-encoding", "upgrade", 0
+};
+
+/********************************** Forwards **********************************/
+
+static void addInput(Http2Stream *stream, cuchar *data, ssize len, bool end);
+static void closeStream(HttpConn *conn);
+static void connectionError(Http2 *h2, int code, cchar *msg);
+static Http2 *createHttp2(HttpConn *conn);
+static HttpPacket *createRequest(MprList *fields, bool end, bool *chunked);
+static Http2Stream *createStream(Http2 *h2, int id);
+static MprList *decodeHeaders(Http2 *h2, cuchar *p, cuchar *end);
+static void encodeHeaders(HttpConn *conn, MprBuf *buf);
+static void endHeaders(Http2 *h2);
+static Http2Stream *findStream(Http2 *h2, int id);
+static uint getUint32(cuchar *p);
+static void flushEvent(Http2 *h2, MprEvent *event);
+static void flushOutput(Http2 *h2);
+static void http2Close(HttpQueue *q);
+static void http2OutgoingService(HttpQueue *q);
+static void initHuffman(void);
+static bool isConnectionHeader(cchar *name);
+static void manageHttp2(Http2 *h2, int flags);
+static void manageStream(Http2Stream *stream, int flags);
+static ssize parseFrame(Http2 *h2, MprBuf *buf);
+static void putFrame(Http2 *h2, int type, int flags, int id, cvoid *data, ssize len);
+static void putUint32(uchar *p, uint value);
+static void requestFlush(Http2 *h2);
+static void resetStream(Http2Stream *stream, int code);
+static void resumeStreams(Http2 *h2);
+static void scheduleStream(Http2Stream *stream);
+static ssize sendEntity(HttpQueue *q, HttpPacket *packet, ssize len);
+static void sendHeaders(HttpQueue *q, HttpPacket *packet);
+static void sendReset(Http2 *h2, int id, int code);
+static void sendWindowUpdate(Http2 *h2, int id, ssize increment);
+static void serviceHttp2(Http2 *h2);
+static void streamEvent(HttpConn *conn, MprEvent *event);
+
+/*********************************** Code *************************************/
+
+PUBLIC int httpOpenHttp2Connector()
+{
+    HttpStage     *stage;
+
+    if ((stage = httpCreateConnector("http2Connector", NULL)) == 0) {
+        return MPR_ERR_CANT_CREATE;
+    }
+    stage->close = http2Close;
+    stage->outgoingService = http2OutgoingService;
+    HTTP->http2Connector = stage;
+    initHuffman();
+    return 0;
+}
+
+
+/*
+    Test for the client connection preface on a new server connection. Return 1 if HTTP/2, zero if not and -1 if more
+    data is required.
+ */
+PUBLIC int httpDetectHttp2(HttpConn *conn)
+{
+    HttpPacket  *packet;
+    ssize       len;
+
+    if (!httpServerConn(conn) || conn->state != HTTP_STATE_CONNECTED) {
+        return 0;
+    }
+    if ((packet = conn->input) == 0 || (len = mprGetBufLength(packet->content)) == 0) {
+        return mprIsSocketEof(conn->sock) ? 0 : -1;
+    }
+    len = min(len, H2_PREFACE_LEN);
+    if (memcmp(mprGetBufStart(packet->content), H2_PREFACE, len) != 0) {
+        return 0;
+    }
+    if (len < H2_PREFACE_LEN) {
+        return mprIsSocketEof(conn->sock) ? 0 : -1;
+    }
+    mprAdjustBufStart(packet->content, H2_PREFACE_LEN);
+    if (createHttp2(conn) == 0) {
+        return 0;
+    }
+    return 1;
+}
+
+
+static Http2 *createHttp2(HttpConn *conn)
+{
+    Http2       *h2;
+    HttpLimits  *limits;
+    uchar       settings[12];
+    int         maxStreams;
+
+    if ((h2 = mprAllocObj(Http2, manageHttp2)) == 0) {
+        return 0;
+    }
+    limits = conn->limits;
+    h2->conn = conn;
+    h2->streams = mprCreateList(0, 0);
+    h2->blocked = mprCreateList(0, 0);
+    h2->table = mprCreateList(0, 0);
+    h2->headers = mprCreateBuf(ME_MAX_BUFFER, -1);
+    h2->output = mprCreateBuf(ME_MAX_BUFFER, -1);
+    h2->mutex = mprCreateLock();
+    h2->tableMax = H2_TABLE_SIZE;
+    h2->window = H2_DEFAULT_WINDOW;
+    h2->initialWindow = H2_DEFAULT_WINDOW;
+    h2->frameSize = H2_DEFAULT_FRAME;
+    maxStreams = limits->requestsPerClientMax;
+    h2->maxStreams = (maxStreams > 0 && maxStreams < H2_STREAMS_MAX) ? maxStreams : H2_STREAMS_MAX;
+    conn->h2 = h2;
+
+    settings[0] = 0;
+    settings[1] = H2_MAX_STREAMS;
+    putUint32(&settings[2], h2->maxStreams);
+    settings[6] = 0;
+    settings[7] = H2_MAX_HEADER_LIST_SIZE;
+    putUint32(&settings[8], (uint) limits->headerSize);
+    putFrame(h2, H2_SETTINGS, 0, 0, settings, sizeof(settings));
+
+    httpTrace(conn, "connection.http2", "context", "msg:'HTTP/2 session started',protocol:'%s'",
+        conn->sock->protocol ? conn->sock->protocol : "h2c");
+    return h2;
+}
+
+
+static void manageHttp2(Http2 *h2, int flags)
+{
+    if (flags & MPR_MANAGE_MARK) {
+        mprMark(h2->conn);
+        mprMark(h2->streams);
+        mprMark(h2->blocked);
+        mprMark(h2->table);
+        mprMark(h2->headers);
+        mprMark(h2->output);
+        mprMark(h2->mutex);
+    }
+}
+
+
+/*
+    Called when the network connection is destroyed. Streams are reset and torn down on their own dispatchers.
+ */
+PUBLIC void httpDestroyHttp2(HttpConn *conn)
+{
+    Http2           *h2;
+    Http2Stream     *stream;
+    int             next;
+
+    h2 = conn->h2;
+    lock(h2);
+    for (ITERATE_ITEMS(h2->streams, stream, next)) {
+        stream->reset = 1;
+        scheduleStream(stream);
+    }
+    mprFlushBuf(h2->output);
+    unlock(h2);
+}
+
+
+PUBLIC int httpGetHttp2EventMask(HttpConn *conn)
+{
+    Http2       *h2;
+    int         eventMask;
+
+    h2 = conn->h2;
+    eventMask = 0;
+    if (!mprIsSocketEof(conn->sock)) {
+        eventMask |= MPR_READABLE;
+    }
+    lock(h2);
+    if (mprGetBufLength(h2->output) > 0 || mprSocketHasBufferedWrite(conn->sock)) {
+        eventMask |= MPR_WRITABLE;
+    }
+    unlock(h2);
+    return eventMask;
+}
+
+
+/*
+    Service I/O events on the network connection. The socket data has already been read into conn->input.
+ */
+PUBLIC void httpIOHttp2(HttpConn *conn, int eventMask)
+{
+    Http2       *h2;
+    MprBuf      *buf;
+    ssize       len;
+
+    h2 = conn->h2;
+    if (conn->input) {
+        buf = conn->input->content;
+        while (!conn->connError && (len = parseFrame(h2, buf)) > 0) {
+            mprAdjustBufStart(buf, len);
+        }
+        conn->lastActivity = conn->http->now;
+    }
+    serviceHttp2(h2);
+}
+
+
+/*
+    Write pending output and close the network connection once complete or on errors.
+    This must only be called on the network connection dispatcher.
+ */
+static void serviceHttp2(Http2 *h2)
+{
+    HttpConn    *conn;
+    bool        idle;
+
+    conn = h2->conn;
+    if (conn->destroyed) {
+        return;
+    }
+    flushOutput(h2);
+
+    lock(h2);
+    idle = h2->goaway && mprGetListLength(h2->streams) == 0 && mprGetBufLength(h2->output) == 0;
+    unlock(h2);
+
+    if (conn->connError || mprIsSocketEof(conn->sock) || idle) {
+        if (!conn->errorMsg) {
+            conn->errorMsg = conn->sock->errorMsg ? conn->sock->errorMsg : sclone("Server close");
+        }
+        httpTrace(conn, "connection.close", "context", "msg:'%s'", conn->errorMsg);
+        httpDestroyConn(conn);
+    } else if (conn->async && !conn->delay) {
+        httpEnableConnEvents(conn);
+    }
+}
+
+
+static void flushOutput(Http2 *h2)
+{
+    HttpConn    *conn;
+    MprBuf      *buf;
+    ssize       len, written;
+    int         errCode;
+
+    conn = h2->conn;
+    buf = h2->output;
+
+    lock(h2);
+    while ((len = mprGetBufLength(buf)) > 0) {
+        written = mprWriteSocket(conn->sock, mprGetBufStart(buf), len);
+        if (written < 0) {
+            errCode = mprGetError();
+            if (errCode == EAGAIN || errCode == EWOULDBLOCK) {
+                /*  Socket full, wait for an I/O event */
+                break;
+            }
+            httpTrace(conn, "connection.io.error", "error", "msg:'HTTP/2 write error', errno: %d", errCode);
+            conn->connError = 1;
+            mprFlushBuf(buf);
+            break;
+        } else if (written == 0) {
+            break;
+        }
+        mprAdjustBufStart(buf, written);
+        conn->lastActivity = conn->http->now;
+    }
+    mprResetBufIfEmpty(buf);
+    resumeStreams(h2);
+    unlock(h2);
+}
+
+
+/*
+    Request the network connection to write pending output. Requests are coalesced into a single event.
+ */
+static void requestFlush(Http2 *h2)
+{
+    HttpConn    *conn;
+
+    conn = h2->conn;
+    lock(h2);
+    if (!h2->flushing && !conn->destroyed) {
+        h2->flushing = 1;
+        mprCreateEvent(conn->dispatcher, "http2Flush", 0, flushEvent, h2, 0);
+    }
+    unlock(h2);
+}
+
+
+static void flushEvent(Http2 *h2, MprEvent *event)
+{
+    lock(h2);
+    h2->flushing = 0;
+    unlock(h2);
+    serviceHttp2(h2);
+}
+
+
+/*
+    Resume streams waiting to write. Streams are resumed in order of priority weight so the most important streams
+    can claim the available connection window and output space first.
+ */
+static int compareWeight(Http2Stream **s1, Http2Stream **s2)
+{
+    return (*s2)->weight - (*s1)->weight;
+}
+
+
+static void resumeStreams(Http2 *h2)
+{
+    Http2Stream     *stream;
+    int             next;
+
+    lock(h2);
+    if (h2->window > 0 && mprGetBufLength(h2->output) < H2_OUTPUT_MAX && mprGetListLength(h2->blocked) > 0) {
+        mprSortList(h2->blocked, (MprSortProc) compareWeight, 0);
+        for (next = 0; (stream = mprGetNextItem(h2->blocked, &next)) != 0; ) {
+            if (stream->window > 0) {
+                mprRemoveItemAtPos(h2->blocked, --next);
+                scheduleStream(stream);
+            }
+        }
+    }
+    unlock(h2);
+}
+
+
+/*
+    Append a frame to the output buffer
+ */
+static void putFrame(Http2 *h2, int type, int flags, int id, cvoid *data, ssize len)
+{
+    uchar   header[H2_FRAME_HEADER];
+
+    header[0] = (uchar) ((len >> 16) & 0xFF);
+    header[1] = (uchar) ((len >> 8) & 0xFF);
+    header[2] = (uchar) (len & 0xFF);
+    header[3] = (uchar) type;
+    header[4] = (uchar) flags;
+    putUint32(&header[5], id & H2_MAX_WINDOW);
+
+    lock(h2);
+    mprPutBlockToBuf(h2->output, (cchar*) header, sizeof(header));
+    if (len > 0) {
+        mprPutBlockToBuf(h2->output, data, len);
+    }
+    unlock(h2);
+}
+
+
+static void sendReset(Http2 *h2, int id, int code)
+{
+    uchar   data[4];
+
+    putUint32(data, code);
+    putFrame(h2, H2_RST_STREAM, 0, id, data, sizeof(data));
+}
+
+
+static void sendWindowUpdate(Http2 *h2, int id, ssize increment)
+{
+    uchar   data[4];
+
+    putUint32(data, (uint) increment);
+    putFrame(h2, H2_WINDOW_UPDATE, 0, id, data, sizeof(data));
+}
+
+
+/*
+    Fatal connection error. Send GOAWAY and close the connection once the output is written.
+ */
+static void connectionError(Http2 *h2, int code, cchar *msg)
+{
+    HttpConn    *conn;
+    uchar       data[8];
+
+    conn = h2->conn;
+    if (!conn->connError) {
+        putUint32(data, h2->lastStreamId);
+        putUint32(&data[4], code);
+        putFrame(h2, H2_GOAWAY, 0, 0, data, sizeof(data));
+        h2->goaway = 1;
+        conn->errorMsg = sclone(msg);
+        conn->connError = 1;
+        httpTrace(conn, "connection.http2.error", "error", "msg:'%s',code:%d", msg, code);
+    }
+}
+
+/*
+    Parse and process one frame from the input buffer. Return the number of bytes consumed or zero if a complete frame
+    is not yet available.
+ */
+static ssize parseFrame(Http2 *h2, MprBuf *buf)
+{
+    Http2Stream *stream;
+    HttpConn    *conn;
+    cuchar      *data, *end;
+    ssize       len, size, increment;
+    int         type, flags, id, pad, field, next;
+    uint        value;
+
+    conn = h2->conn;
+    if ((size = mprGetBufLength(buf)) < H2_FRAME_HEADER) {
+        return 0;
+    }
+    data = (cuchar*) mprGetBufStart(buf);
+    len = (data[0] << 16) | (data[1] << 8) | data[2];
+    type = data[3];
+    flags = data[4];
+    id = getUint32(&data[5]) & H2_MAX_WINDOW;
+    if (len > H2_DEFAULT_FRAME) {
+        connectionError(h2, H2_FRAME_SIZE_ERROR, "Frame too large");
+        return 0;
+    }
+    if (size < (len + H2_FRAME_HEADER)) {
+        return 0;
+    }
+    data += H2_FRAME_HEADER;
+    end = data + len;
+
+    if (h2->headerStream && (type != H2_CONTINUATION || id != h2->headerStream)) {
+        connectionError(h2, H2_PROTOCOL_ERROR, "Expected CONTINUATION frame");
+        return 0;
+    }
+    switch (type) {
+    case H2_DATA:
+        if (id == 0) {
+            connectionError(h2, H2_PROTOCOL_ERROR, "DATA frame without a stream");
+            break;
+        }
+        if (flags & H2_PADDED) {
+            if (len < 1 || data[0] >= len) {
+                connectionError(h2, H2_PROTOCOL_ERROR, "Bad DATA frame padding");
+                break;
+            }
+            end -= data[0];
+            data++;
+        }
+        if (len > 0) {
+            /* The connection window is replenished immediately. Streams are replenished as data is consumed. */
+            sendWindowUpdate(h2, 0, len);
+        }
+        lock(h2);
+        if ((stream = findStream(h2, id)) != 0 && !stream->endRx && !stream->reset) {
+            addInput(stream, data, end - data, flags & H2_END_STREAM);
+            if (flags & H2_END_STREAM) {
+                stream->endRx = 1;
+            } else {
+                stream->consumed += len;
+            }
+            scheduleStream(stream);
+        } else if (id > h2->lastStreamId) {
+            connectionError(h2, H2_PROTOCOL_ERROR, "DATA frame for idle stream");
+        } else if (!stream) {
+            sendReset(h2, id, H2_STREAM_CLOSED);
+        }
+        unlock(h2);
+        break;
+
+    case H2_HEADERS:
+        if (id == 0 || (id & 0x1) == 0) {
+            connectionError(h2, H2_PROTOCOL_ERROR, "Bad HEADERS stream identifier");
+            break;
+        }
+        pad = 0;
+        h2->headerWeight = H2_DEFAULT_WEIGHT;
+        if (flags & H2_PADDED) {
+            if (len < 1) {
+                connectionError(h2, H2_PROTOCOL_ERROR, "Bad HEADERS frame padding");
+                break;
+            }
+            pad = *data++;
+        }
+        if (flags & H2_PRIORITY_FLAG) {
+            if ((end - data) < 5) {
+                connectionError(h2, H2_FRAME_SIZE_ERROR, "Bad HEADERS frame priority");
+                break;
+            }
+            h2->headerWeight = data[4] + 1;
+            data += 5;
+        }
+        if (pad > (end - data)) {
+            connectionError(h2, H2_PROTOCOL_ERROR, "Bad HEADERS frame padding");
+            break;
+        }
+        end -= pad;
+        h2->headerStream = id;
+        h2->headerFlags = flags;
+        mprFlushBuf(h2->headers);
+        /* Fall through */
+
+    case H2_CONTINUATION:
+        if (!h2->headerStream) {
+            connectionError(h2, H2_PROTOCOL_ERROR, "Unexpected CONTINUATION frame");
+            break;
+        }
+        if ((mprGetBufLength(h2->headers) + (end - data)) > conn->limits->headerSize) {
+            connectionError(h2, H2_ENHANCE_YOUR_CALM, "Header block is too big");
+            break;
+        }
+        mprPutBlockToBuf(h2->headers, (cchar*) data, end - data);
+        if (flags & H2_END_HEADERS) {
+            endHeaders(h2);
+        }
+        break;
+
+    case H2_PRIORITY:
+        if (len != 5) {
+            connectionError(h2, H2_FRAME_SIZE_ERROR, "Bad PRIORITY frame");
+            break;
+        }
+        lock(h2);
+        if ((stream = findStream(h2, id)) != 0) {
+            stream->weight = data[4] + 1;
+        }
+        unlock(h2);
+        break;
+
+    case H2_RST_STREAM:
+        if (len != 4 || id == 0) {
+            connectionError(h2, H2_PROTOCOL_ERROR, "Bad RST_STREAM frame");
+            break;
+        }
+        lock(h2);
+        if ((stream = findStream(h2, id)) != 0) {
+            stream->reset = 1;
+            scheduleStream(stream);
+        }
+        unlock(h2);
+        break;
+
+    case H2_SETTINGS:
+        if (id != 0 || (len % 6) != 0) {
+            connectionError(h2, H2_PROTOCOL_ERROR, "Bad SETTINGS frame");
+            break;
+        }
+        if (flags & H2_ACK) {
+            break;
+        }
+        lock(h2);
+        for (; data < end; data += 6) {
+            field = (data[0] << 8) | data[1];
+            value = getUint32(&data[2]);
+            if (field == H2_INITIAL_WINDOW_SIZE) {
+                if (value > H2_MAX_WINDOW) {
+                    connectionError(h2, H2_FLOW_CONTROL_ERROR, "Bad initial window size");
+                    break;
+                }
+                for (ITERATE_ITEMS(h2->streams, stream, next)) {
+                    stream->window += (ssize) value - h2->initialWindow;
+                }
+                h2->initialWindow = value;
+
+            } else if (field == H2_MAX_FRAME_SIZE) {
+                if (value < H2_DEFAULT_FRAME || value > 0xFFFFFF) {
+                    connectionError(h2, H2_PROTOCOL_ERROR, "Bad maximum frame size");
+                    break;
+                }
+                h2->frameSize = value;
+
+            } else if (field == H2_ENABLE_PUSH && value > 1) {
+                connectionError(h2, H2_PROTOCOL_ERROR, "Bad enable push setting");
+                break;
+            }
+            /* The peer header table size applies to the encoder which does not use the dynamic table */
+        }
+        if (!conn->connError) {
+            putFrame(h2, H2_SETTINGS, H2_ACK, 0, 0, 0);
+            resumeStreams(h2);
+        }
+        unlock(h2);
+        break;
+
+    case H2_PUSH_PROMISE:
+        connectionError(h2, H2_PROTOCOL_ERROR, "Clients cannot push streams");
+        break;
+
+    case H2_PING:
+        if (len != 8 || id != 0) {
+            connectionError(h2, H2_PROTOCOL_ERROR, "Bad PING frame");
+            break;
+        }
+        if (!(flags & H2_ACK)) {
+            putFrame(h2, H2_PING, H2_ACK, 0, data, len);
+        }
+        break;
+
+    case H2_GOAWAY:
+        h2->goaway = 1;
+        break;
+
+    case H2_WINDOW_UPDATE:
+        if (len != 4) {
+            connectionError(h2, H2_FRAME_SIZE_ERROR, "Bad WINDOW_UPDATE frame");
+            break;
+        }
+        increment = getUint32(data) & H2_MAX_WINDOW;
+        lock(h2);
+        if (id == 0) {
+            if (increment == 0 || (h2->window + increment) > H2_MAX_WINDOW) {
+                connectionError(h2, H2_FLOW_CONTROL_ERROR, "Bad connection window update");
+            } else {
+                h2->window += increment;
+            }
+        } else if ((stream = findStream(h2, id)) != 0) {
+            if (increment == 0 || (stream->window + increment) > H2_MAX_WINDOW) {
+                resetStream(stream, H2_FLOW_CONTROL_ERROR);
+            } else {
+                stream->window += increment;
+            }
+        }
+        resumeStreams(h2);
+        unlock(h2);
+        break;
+
+    default:
+        /* Unknown frame types are ignored */
+        break;
+    }
+    return conn->connError ? 0 : len + H2_FRAME_HEADER;
+}
+
+
+/*
+    A complete header block has been received. Decode and open a new stream or process trailers.
+ */
+static void endHeaders(Http2 *h2)
+{
+    Http2Stream *stream;
+    HttpPacket  *packet;
+    MprList     *fields;
+    cuchar      *start;
+    bool        chunked, end;
+    int         id;
+
+    id = h2->headerStream;
+    end = (h2->headerFlags & H2_END_STREAM) ? 1 : 0;
+    h2->headerStream = 0;
+
+    /*
+        Always decode to keep the HPACK table in sync, even if the stream is refused
+     */
+    start = (cuchar*) mprGetBufStart(h2->headers);
+    if ((fields = decodeHeaders(h2, start, start + mprGetBufLength(h2->headers))) == 0) {
+        connectionError(h2, H2_COMPRESSION_ERROR, "Cannot decode header block");
+        return;
+    }
+    mprFlushBuf(h2->headers);
+
+    lock(h2);
+    if ((stream = findStream(h2, id)) != 0) {
+        /* Trailers must end the stream and are otherwise ignored */
+        if (!end || stream->endRx) {
+            resetStream(stream, H2_PROTOCOL_ERROR);
+        } else {
+            addInput(stream, 0, 0, 1);
+            stream->endRx = 1;
+            scheduleStream(stream);
+        }
+        unlock(h2);
+        return;
+    }
+    unlock(h2);
+
+    if (id <= h2->lastStreamId) {
+        sendReset(h2, id, H2_STREAM_CLOSED);
+        return;
+    }
+    h2->lastStreamId = id;
+    if (h2->goaway || mprGetListLength(h2->streams) >= h2->maxStreams || mprShouldDenyNewRequests()) {
+        sendReset(h2, id, H2_REFUSED_STREAM);
+        return;
+    }
+    if ((packet = createRequest(fields, end, &chunked)) == 0) {
+        httpTrace(h2->conn, "connection.http2.error", "error", "msg:'Malformed request headers',stream:%d", id);
+        sendReset(h2, id, H2_PROTOCOL_ERROR);
+        return;
+    }
+    if ((stream = createStream(h2, id)) == 0) {
+        sendReset(h2, id, H2_REFUSED_STREAM);
+        return;
+    }
+    lock(h2);
+    stream->weight = h2->headerWeight;
+    stream->chunked = chunked;
+    stream->endRx = end;
+    stream->input = packet;
+    scheduleStream(stream);
+    unlock(h2);
+}
+
+
+/*
+    Present the request as HTTP/1.1 to the stream connection so the standard request parser can be used
+ */
+static HttpPacket *createRequest(MprList *fields, bool end, bool *chunked)
+{
+    MprKeyValue *kv;
+    HttpPacket  *packet;
+    MprBuf      *buf;
+    cchar       *method, *path, *authority, *cookies, *name;
+    bool        hasLength;
+    int         next;
+
+    method = path = authority = cookies = 0;
+    hasLength = 0;
+    *chunked = 0;
+
+    if ((packet = httpCreateDataPacket(ME_MAX_BUFFER)) == 0) {
+        return 0;
+    }
+    buf = mprCreateBuf(ME_MAX_BUFFER, -1);
+    for (ITERATE_ITEMS(fields, kv, next)) {
+        name = kv->key;
+        if (*name == '\0' || strpbrk(kv->value, "\r\n") || strpbrk(&name[1], "\r\n: ")) {
+            return 0;
+        }
+        if (*name == ':') {
+            if (smatch(name, ":method")) {
+                method = kv->value;
+            } else if (smatch(name, ":path")) {
+                path = kv->value;
+            } else if (smatch(name, ":authority")) {
+                authority = kv->value;
+            } else if (!smatch(name, ":scheme")) {
+                return 0;
+            }
+        } else if (smatch(name, "cookie")) {
+            /* Cookies may be split into separate fields */
+            cookies = cookies ? sjoin(cookies, "; ", kv->value, NULL) : kv->value;
+
+        } else if (smatch(name, "host")) {
+            if (!authority) {
+                authority = kv->value;
+            }
+        } else if (!isConnectionHeader(name) && !smatch(name, "te") && !smatch(name, "expect")) {
+            if (smatch(name, "content-length")) {
+                hasLength = 1;
+            }
+            mprPutToBuf(buf, "%s: %s\r\n", name, (cchar*) kv->value);
+        }
+    }
+    if (!method || !path || *path == '\0') {
+        return 0;
+    }
+    mprPutToBuf(packet->content, "%s %s HTTP/1.1\r\n", method, path);
+    if (authority) {
+        mprPutToBuf(packet->content, "Host: %s\r\n", authority);
+    }
+    if (cookies) {
+        mprPutToBuf(packet->content, "Cookie: %s\r\n", cookies);
+    }
+    mprPutBlockToBuf(packet->content, mprGetBufStart(buf), mprGetBufLength(buf));
+    if (!end && !hasLength) {
+        mprPutStringToBuf(packet->content, "Transfer-Encoding: chunked\r\n");
+        *chunked = 1;
+    }
+    mprPutStringToBuf(packet->content, "\r\n");
+    return packet;
+}
+
+
+/*
+    Append received data for the stream. Must be called locked.
+    Bodies of unknown length are re-encoded as chunks. The first chunk delimiter omits the leading "\r\n" as the
+    request parser retains the "\r\n" after the headers for chunked requests.
+ */
+static void addInput(Http2Stream *stream, cuchar *data, ssize len, bool end)
+{
+    MprBuf      *buf;
+
+    if (stream->input == 0) {
+        stream->input = httpCreateDataPacket(len + 32);
+    }
+    buf = stream->input->content;
+    if (stream->chunked) {
+        if (len > 0) {
+            mprPutToBuf(buf, stream->chunks ? "\r\n%zx\r\n" : "%zx\r\n", len);
+            mprPutBlockToBuf(buf, (cchar*) data, len);
+            stream->chunks = 1;
+        }
+        if (end) {
+            mprPutStringToBuf(buf, stream->chunks ? "\r\n0\r\n\r\n" : "0\r\n\r\n");
+        }
+    } else if (len > 0) {
+        mprPutBlockToBuf(buf, (cchar*) data, len);
+    }
+}
+
+
+static bool isConnectionHeader(cchar *name)
+{
+    cchar   **cp;
+
+    for (cp = connectionHeaders; *cp; cp++) {
+        if (smatch(name, *cp)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+
+static uint getUint32(cuchar *p)
+{
+    return ((uint) p[0] << 24) | ((uint) p[1] << 16) | ((uint) p[2] << 8) | (uint) p[3];
+}
+
+
+static void putUint32(uchar *p, uint value)
+{
+    p[0] = (uchar) ((value >> 24) & 0xFF);
+    p[1] = (uchar) ((value >> 16) & 0xFF);
+    p[2] = (uchar) ((value >> 8) & 0xFF);
+    p[3] = (uchar) (value & 0xFF);
+}
+
+/************************************ HPACK ***********************************/
+
+static void initHuffman(void)
+{
+    uint    code;
+    int     bits, sym, offset;
+
+    code = 0;
+    offset = 0;
+    for (bits = 1; bits <= 30; bits++) {
+        huffFirst[bits] = code;
+        huffOffset[bits] = offset;
+        for (sym = 0; sym < 257; sym++) {
+            if (huffBits[sym] == bits) {
+                huffSymbols[offset++] = (short) sym;
+                code++;
+            }
+        }
+        huffCount[bits] = offset - huffOffset[bits];
+        code <<= 1;
+    }
+}
+
+
+/*
+    Decode a Huffman encoded string. The code is canonical so codes of each length are consecutive.
+ */
+static char *decodeHuffman(cuchar *data, ssize len)
+{
+    MprBuf  *buf;
+    uint    code;
+    ssize   i;
+    int     bit, bits, sym;
+
+    buf = mprCreateBuf(len * 2 + 1, -1);
+    code = 0;
+    bits = 0;
+    for (i = 0; i < len; i++) {
+        for (bit = 7; bit >= 0; bit--) {
+            code = (code << 1) | ((data[i] >> bit) & 0x1);
+            bits++;
+            if ((code - huffFirst[bits]) < (uint) huffCount[bits]) {
+                sym = huffSymbols[huffOffset[bits] + code - huffFirst[bits]];
+                if (sym == 256) {
+                    /* EOS must not appear in the string */
+                    return 0;
+                }
+                mprPutCharToBuf(buf, sym);
+                code = 0;
+                bits = 0;
+            } else if (bits >= 30) {
+                return 0;
+            }
+        }
+    }
+    /* Padding must be the most significant bits of EOS (all ones) and shorter than 8 bits */
+    if (bits > 7 || code != ((1U << bits) - 1)) {
+        return 0;
+    }
+    return snclone(mprGetBufStart(buf), mprGetBufLength(buf));
+}
+
+
+static bool decodeInt(cuchar **pp, cuchar *end, int prefix, ssize *value)
+{
+    cuchar  *p;
+    ssize   v;
+    int     max, shift;
+
+    p = *pp;
+    if (p >= end) {
+        return 0;
+    }
+    max = (1 << prefix) - 1;
+    v = *p++ & max;
+    if (v == max) {
+        for (shift = 0; ; shift += 7) {
+            if (p >= end || shift > 28) {
+                return 0;
+            }
+            v += (ssize) (*p & 0x7f) << shift;
+            if ((*p++ & 0x80) == 0) {
+                break;
+            }
+        }
+    }
+    *pp = p;
+    *value = v;
+    return 1;
+}
+
+
+static char *decodeString(cuchar **pp, cuchar *end)
+{
+    cuchar  *p;
+    ssize   len;
+    bool    huffman;
+
+    p = *pp;
+    if (p >= end) {
+        return 0;
+    }
+    huffman = (*p & 0x80) ? 1 : 0;
+    if (!decodeInt(&p, end, 7, &len) || len > (end - p)) {
+        return 0;
+    }
+    *pp = p + len;
+    if (huffman) {
+        return decodeHuffman(p, len);
+    }
+    return snclone((cchar*) p, len);
+}
+
+
+static bool getField(Http2 *h2, ssize index, cchar **name, cchar **value)
+{
+    MprKeyValue     *kv;
+
+    if (index <= 0) {
+        return 0;
+    }
+    if (index < H2_STATIC_ENTRIES) {
+        *name = staticTable[index][0];
+        *value = staticTable[index][1];
+        return 1;
+    }
+    if ((kv = mprGetItem(h2->table, (int) (index - H2_STATIC_ENTRIES))) == 0) {
+        return 0;
+    }
+    *name = kv->key;
+    *value = kv->value;
+    return 1;
+}
+
+
+/*
+    Evict the oldest dynamic table entries until the table fits the given size
+ */
+static void evictFields(Http2 *h2, ssize size)
+{
+    MprKeyValue     *kv;
+
+    while (h2->tableSize > size && (kv = mprPopItem(h2->table)) != 0) {
+        h2->tableSize -= slen(kv->key) + slen(kv->value) + 32;
+    }
+}
+
+
+static void addField(Http2 *h2, cchar *name, cchar *value)
+{
+    ssize   size;
+
+    size = slen(name) + slen(value) + 32;
+    evictFields(h2, h2->tableMax - size);
+    if (size <= h2->tableMax) {
+        mprInsertItemAtPos(h2->table, 0, mprCreateKeyPair(name, value, 0));
+        h2->tableSize += size;
+    }
+}
+
+
+/*
+    Decode a header block into a list of MprKeyValue fields. Return null on compression errors.
+ */
+static MprList *decodeHeaders(Http2 *h2, cuchar *p, cuchar *end)
+{
+    MprList     *fields;
+    cchar       *name, *value;
+    ssize       index;
+    int         prefix;
+
+    fields = mprCreateList(0, 0);
+    while (p < end) {
+        if (*p & 0x80) {
+            /* Indexed field */
+            if (!decodeInt(&p, end, 7, &index) || !getField(h2, index, &name, &value)) {
+                return 0;
+            }
+        } else if ((*p & 0xE0) == 0x20) {
+            /* Dynamic table size update */
+            if (!decodeInt(&p, end, 5, &index) || index > H2_TABLE_SIZE) {
+                return 0;
+            }
+            h2->tableMax = index;
+            evictFields(h2, index);
+            continue;
+
+        } else {
+            /* Literal with incremental indexing (01), without indexing (0000) or never indexed (0001) */
+            prefix = (*p & 0x40) ? 6 : 4;
+            if (!decodeInt(&p, end, prefix, &index)) {
+                return 0;
+            }
+            if (index == 0) {
+                if ((name = decodeString(&p, end)) == 0) {
+                    return 0;
+                }
+            } else if (!getField(h2, index, &name, &value)) {
+                return 0;
+            }
+            if ((value = decodeString(&p, end)) == 0) {
+                return 0;
+            }
+            if (prefix == 6) {
+                addField(h2, name, value);
+            }
+        }
+        mprAddItem(fields, mprCreateKeyPair(name, value, 0));
+    }
+    return fields;
+}
+
+
+static void encodeInt(MprBuf *buf, int flags, int prefix, ssize value)
+{
+    int     max;
+
+    max = (1 << prefix) - 1;
+    if (value < max) {
+        mprPutCharToBuf(buf, flags | (int) value);
+        return;
+    }
+    mprPutCharToBuf(buf, flags | max);
+    for (value -= max; value >= 128; value >>= 7) {
+        mprPutCharToBuf(buf, (int) (value & 0x7f) | 0x80);
+    }
+    mprPutCharToBuf(buf, (int) value);
+}
+
+
+/*
+    Encode a string using the Huffman code if that is shorter
+ */
+static void encodeString(MprBuf *buf, cchar *str)
+{
+    cuchar  *cp;
+    uint64  bits;
+    ssize   len, size;
+    int     count;
+
+    len = slen(str);
+    for (size = 0, cp = (cuchar*) str; *cp; cp++) {
+        size += huffBits[*cp];
+    }
+    size = (size + 7) / 8;
+    if (size >= len) {
+        encodeInt(buf, 0, 7, len);
+        mprPutBlockToBuf(buf, str, len);
+        return;
+    }
+    encodeInt(buf, 0x80, 7, size);
+    for (bits = 0, count = 0, cp = (cuchar*) str; *cp; cp++) {
+        bits = (bits << huffBits[*cp]) | huffCodes[*cp];
+        for (count += huffBits[*cp]; count >= 8; ) {
+            count -= 8;
+            mprPutCharToBuf(buf, (int) ((bits >> count) & 0xFF));
+        }
+    }
+    if (count > 0) {
+        /* Pad with the most significant bits of EOS */
+        mprPutCharToBuf(buf, (int) (((bits << (8 - count)) | (0xFF >> count)) & 0xFF));
+    }
+}
+
+
+/*
+    Encode a literal field without indexing. The name is referenced from the static table if possible.
+ */
+static void encodeField(MprBuf *buf, cchar *name, cchar *value)
+{
+    int     index;
+
+    for (index = 1; index < H2_STATIC_ENTRIES; index++) {
+        if (smatch(staticTable[index][0], name)) {
+            break;
+        }
+    }
+    if (index < H2_STATIC_ENTRIES) {
+        encodeInt(buf, 0, 4, index);
+    } else {
+        mprPutCharToBuf(buf, 0);
+        encodeString(buf, name);
+    }
+    encodeString(buf, value);
+}
+
+
+static void encodeHeaders(HttpConn *conn, MprBuf *buf)
+{
+    HttpTx      *tx;
+    MprKey      *kp;
+    cchar       *status, *name;
+    int         index;
+
+    tx = conn->tx;
+    status = itos(tx->status);
+    for (index = 8; index <= 14; index++) {
+        if (smatch(staticTable[index][1], status)) {
+            break;
+        }
+    }
+    if (index <= 14) {
+        encodeInt(buf, 0x80, 7, index);
+    } else {
+        encodeField(buf, ":status", status);
+    }
+    for (ITERATE_KEYS(tx->headers, kp)) {
+        name = slower(kp->key);
+        if (!isConnectionHeader(name)) {
+            encodeField(buf, name, kp->data ? kp->data : "");
+        }
+    }
+}
+
+/*********************************** Streams **********************************/
+
+static Http2Stream *createStream(Http2 *h2, int id)
+{
+    Http2Stream     *stream;
+    HttpConn        *parent, *conn;
+
+    parent = h2->conn;
+    if ((stream = mprAllocObj(Http2Stream, manageStream)) == 0) {
+        return 0;
+    }
+    if ((conn = httpCreateConn(parent->endpoint, parent->dispatcher)) == 0) {
+        return 0;
+    }
+    stream->h2 = h2;
+    stream->conn = conn;
+    stream->id = id;
+    stream->weight = H2_DEFAULT_WEIGHT;
+    stream->window = h2->initialWindow;
+
+    conn->stream = stream;
+    conn->sock = parent->sock;
+    conn->ip = parent->ip;
+    conn->port = parent->port;
+    conn->address = parent->address;
+    conn->notifier = parent->notifier;
+    conn->async = parent->async;
+    conn->secure = parent->secure;
+    conn->ioCallback = streamEvent;
+    httpSetState(conn, HTTP_STATE_CONNECTED);
+
+    lock(h2);
+    mprAddItem(h2->streams, stream);
+    unlock(h2);
+    parent->started = parent->http->now;
+    return stream;
+}
+
+
+static void manageStream(Http2Stream *stream, int flags)
+{
+    if (flags & MPR_MANAGE_MARK) {
+        mprMark(stream->h2);
+        mprMark(stream->conn);
+        mprMark(stream->input);
+    }
 }
 
 
-PUBLIC HttpRoute *httpLookupRoute(HttpHost *host, cchar *pattern)
+/*
+    Called when a stream connection is destroyed
+ */
+PUBLIC void httpDestroyHttp2Stream(HttpConn *conn)
 {
-    HttpRoute   *route;
-    int         next;
+    Http2Stream     *stream;
+    Http2           *h2;
 
-    if (smatch(pattern, "default")) {
-        pattern = "";
-    }
-    if (smatch(pattern, "/") || smatch(pattern, "^/") || smatch(pattern, "^/$")) {
-        pattern = "";
-    }
-    if (!host && (host = httpGetDefaultHost()) == 0) {
-        return 0;
+    stream = conn->stream;
+    h2 = stream->h2;
+    lock(h2);
+    mprRemoveItem(h2->streams, stream);
+    mprRemoveItem(h2->blocked, stream);
+    stream->input = 0;
+    unlock(h2);
+    requestFlush(h2);
+}
+
+
+PUBLIC void httpEnableHttp2StreamEvents(HttpConn *conn)
+{
+    if (!conn->destroyed) {
+        scheduleStream(conn->stream);
     }
-    for (next = 0; (route = mprGetNextItem(host->routes, &next)) != 0; ) {
-        assert(route->pattern);
-        if (smatch(route->pattern, pattern)) {
-            return route;
+}
+
+
+static Http2Stream *findStream(Http2 *h2, int id)
+{
+    Http2Stream     *stream;
+    int             next;
+
+    for (ITERATE_ITEMS(h2->streams, stream, next)) {
+        if (stream->id == id) {
+            return stream;
         }
     }
     return 0;
 }
 
 
-PUBLIC void httpResetRoutes(HttpHost *host)
+/*
+    Schedule the stream to run on its connection dispatcher. This may be a worker thread.
+ */
+static void scheduleStream(Http2Stream *stream)
 {
-    host->routes = mprCreateList(-1, MPR_LIST_STABLE);
+    Http2       *h2;
+    HttpConn    *conn;
+
+    h2 = stream->h2;
+    conn = stream->conn;
+    lock(h2);
+    if (!stream->scheduled && !conn->destroyed) {
+        stream->scheduled = 1;
+        mprCreateEvent(conn->dispatcher, "http2Stream", 0, streamEvent, conn, 0);
+    }
+    unlock(h2);
 }
 
 
-PUBLIC void httpSetHostDefaultRoute(HttpHost *host, HttpRoute *route)
+/*
+    Reset a stream due to a stream error. Must be called locked.
+ */
+static void resetStream(Http2Stream *stream, int code)
 {
-    host->defaultRoute = route;
+    if (!stream->reset) {
+        sendReset(stream->h2, stream->id, code);
+        stream->reset = 1;
+        scheduleStream(stream);
+    }
 }
 
 
-PUBLIC void httpSetDefaultHost(HttpHost *host)
+/*
+    Run the request pipeline for a stream. This is the I/O callback for stream connections.
+ */
+static void streamEvent(HttpConn *conn, MprEvent *event)
 {
-    defaultHost = host;
+    Http2Stream     *stream;
+    Http2           *h2;
+    HttpPacket      *packet;
+    ssize           consumed;
+    bool            reset;
+
+    if (conn->destroyed) {
+        return;
+    }
+    stream = conn->stream;
+    h2 = stream->h2;
+    if (event && event->dispatcher != conn->dispatcher) {
+        /* The stream has since moved to a worker dispatcher */
+        lock(h2);
+        stream->scheduled = 0;
+        scheduleStream(stream);
+        unlock(h2);
+        return;
+    }
+    lock(h2);
+    stream->scheduled = 0;
+    packet = stream->input;
+    stream->input = 0;
+    consumed = stream->consumed;
+    stream->consumed = 0;
+    reset = stream->reset;
+    unlock(h2);
+
+    if (reset && !conn->connError) {
+        httpDisconnect(conn);
+    }
+    if (packet) {
+        if (conn->input) {
+            httpJoinPacket(conn->input, packet);
+        } else {
+            conn->input = packet;
+        }
+        conn->lastRead = httpGetPacketLength(conn->input);
+        conn->lastActivity = conn->http->now;
+        if (consumed > 0 && !reset) {
+            sendWindowUpdate(h2, stream->id, consumed);
+        }
+    }
+    if (conn->connectorq && conn->connectorq->first) {
+        httpResumeQueue(conn->connectorq);
+    }
+    httpProtocol(conn);
+
+    if (conn->state == HTTP_STATE_COMPLETE || (conn->connError && conn->state < HTTP_STATE_PARSED)) {
+        closeStream(conn);
+    } else if (conn->workerEvent) {
+        httpEnableConnEvents(conn);
+    }
+    requestFlush(h2);
 }
 
 
-PUBLIC void httpSetHostSecureEndpoint(HttpHost *host, HttpEndpoint *endpoint)
+static void closeStream(HttpConn *conn)
 {
-    host->secureEndpoint = endpoint;
+    Http2Stream     *stream;
+    Http2           *h2;
+
+    stream = conn->stream;
+    h2 = stream->h2;
+    lock(h2);
+    if (!stream->reset && (!stream->endTx || !stream->endRx)) {
+        /* Response abandoned or the request body was not fully received */
+        sendReset(h2, stream->id, stream->endTx ? H2_NO_ERROR : H2_CANCEL);
+        stream->reset = 1;
+    }
+    unlock(h2);
+    httpDestroyConn(conn);
 }
 
+/********************************** Connector *********************************/
 
-PUBLIC void httpSetHostDefaultEndpoint(HttpHost *host, HttpEndpoint *endpoint)
+static void http2OutgoingService(HttpQueue *q)
 {
-    host->defaultEndpoint = endpoint;
+    HttpConn        *conn;
+    HttpTx          *tx;
+    HttpPacket      *packet;
+    Http2Stream     *stream;
+    Http2           *h2;
+    ssize           len;
+
+    conn = q->conn;
+    tx = conn->tx;
+    stream = conn->stream;
+    h2 = stream->h2;
+    conn->lastActivity = conn->http->now;
+
+    if (tx->finalizedConnector) {
+        return;
+    }
+    if (tx->flags & HTTP_TX_NO_BODY) {
+        httpDiscardQueueData(q, 1);
+    }
+    if ((tx->bytesWritten + q->count) > conn->limits->txBodySize && conn->limits->txBodySize != HTTP_UNLIMITED) {
+        httpLimitError(conn, HTTP_CODE_REQUEST_TOO_LARGE | ((tx->bytesWritten) ? HTTP_ABORT : 0),
+            "Http transmission aborted. Exceeded transmission max body of %lld bytes", conn->limits->txBodySize);
+        if (tx->bytesWritten) {
+            httpFinalizeConnector(conn);
+            return;
+        }
+    }
+    tx->writeBlocked = 0;
+    if (stream->reset || h2->conn->destroyed) {
+        httpDiscardQueueData(q, 1);
+        httpFinalizeConnector(conn);
+        return;
+    }
+    if (q->first && q->first->flags & HTTP_PACKET_HEADER) {
+        sendHeaders(q, q->first);
+    }
+    lock(h2);
+    while ((packet = q->first) != 0) {
+        if (packet->flags & HTTP_PACKET_END) {
+            if (!stream->endTx) {
+                putFrame(h2, H2_DATA, H2_END_STREAM, stream->id, 0, 0);
+                stream->endTx = 1;
+            }
+            httpGetPacket(q);
+            httpFinalizeConnector(conn);
+            break;
+        }
+        if ((len = httpGetPacketLength(packet)) == 0 && packet->esize <= 0) {
+            httpGetPacket(q);
+            continue;
+        }
+        if (packet->esize > 0) {
+            /* Entity packet from Request.writeFile (sendfile). The file data is read here. */
+            len = (ssize) min(packet->esize, H2_DEFAULT_FRAME);
+        }
+        len = min(len, h2->frameSize);
+        len = min(len, stream->window);
+        len = min(len, h2->window);
+        if (len <= 0 || mprGetBufLength(h2->output) >= H2_OUTPUT_MAX) {
+            /* Wait for a WINDOW_UPDATE or for the output to drain */
+            if (mprLookupItem(h2->blocked, stream) < 0) {
+                mprAddItem(h2->blocked, stream);
+            }
+            tx->writeBlocked = 1;
+            break;
+        }
+        if (packet->esize > 0) {
+            if (sendEntity(q, packet, len) < 0) {
+                break;
+            }
+            continue;
+        }
+        if (httpTracing(conn)) {
+            httpTraceBody(conn, 1, packet, len);
+        }
+        putFrame(h2, H2_DATA, 0, stream->id, mprGetBufStart(packet->content), len);
+        mprAdjustBufStart(packet->content, len);
+        q->count -= len;
+        stream->window -= len;
+        h2->window -= len;
+        tx->bytesWritten += len;
+        if (httpGetPacketLength(packet) == 0) {
+            httpGetPacket(q);
+        }
+    }
+    unlock(h2);
+    requestFlush(h2);
 }
 
 
-PUBLIC HttpHost *httpGetDefaultHost()
+/*
+    Send entity data from the response file. Must be called locked.
+ */
+static ssize sendEntity(HttpQueue *q, HttpPacket *packet, ssize len)
 {
-    return defaultHost;
+    HttpConn        *conn;
+    HttpTx          *tx;
+    Http2Stream     *stream;
+    char            *data;
+
+    conn = q->conn;
+    tx = conn->tx;
+    stream = conn->stream;
+
+    if (!tx->file && (tx->file = mprOpenFile(tx->filename, O_RDONLY | O_BINARY, 0)) == 0) {
+        httpError(conn, HTTP_ABORT | HTTP_CODE_NOT_FOUND, "Cannot open document: %s", tx->filename);
+        return MPR_ERR_CANT_OPEN;
+    }
+    data = mprAlloc(len);
+    mprSeekFile(tx->file, SEEK_SET, packet->epos);
+    if (mprReadFile(tx->file, data, len) != len) {
+        httpError(conn, HTTP_ABORT | HTTP_CODE_SERVICE_UNAVAILABLE, "Cannot read file %s", tx->filename);
+        return MPR_ERR_CANT_READ;
+    }
+    putFrame(stream->h2, H2_DATA, 0, stream->id, data, len);
+    packet->epos += len;
+    packet->esize -= len;
+    stream->window -= len;
+    stream->h2->window -= len;
+    tx->bytesWritten += len;
+    if (packet->esize <= 0) {
+        httpGetPacket(q);
+    }
+    return len;
 }
 
 
-PUBLIC HttpRoute *httpGetDefaultRoute(HttpHost *host)
+static void http2Close(HttpQueue *q)
 {
-    if (host) {
-        return host->defaultRoute;
-    } else if (defaultHost) {
-        return defaultHost->defaultRoute;
+    HttpTx      *tx;
+
+    tx = q->conn->tx;
+    if (tx->file) {
+        mprCloseFile(tx->file);
+        tx->file = 0;
     }
-    return 0;
 }
 
 
-PUBLIC bool httpGetStreaming(HttpHost *host, cchar *mime, cchar *uri)
+/*
+    Encode the response headers into HEADERS and CONTINUATION frames
+ */
+static void sendHeaders(HttpQueue *q, HttpPacket *packet)
 {
-    MprKey      *kp;
-
-    assert(host);
-    assert(host->streams);
+    HttpConn        *conn;
+    HttpTx          *tx;
+    HttpPacket      *next;
+    Http2Stream     *stream;
+    Http2           *h2;
+    MprBuf          *buf;
+    ssize           len;
+    int             flags, type;
 
-    if (schr(mime, ';')) {
-        mime = ssplit(sclone(mime), ";", 0);
-    }
-    if ((kp = mprLookupKeyEntry(host->streams, mime)) != 0) {
-        if (kp->data == NULL || sstarts(uri, kp->data)) {
-            /* Type is set to the enable value */
-            return kp->type;
+    conn = q->conn;
+    tx = conn->tx;
+    stream = conn->stream;
+    h2 = stream->h2;
+
+    if (tx->length < 0 && !tx->altBody) {
+        /* The content length is known if the response has been finalized */
+        for (next = packet->next; next; next = next->next) {
+            if (next->flags & HTTP_PACKET_END) {
+                tx->length = q->count;
+                break;
+            }
+        }
+        if (next == 0) {
+            tx->flags |= HTTP_TX_NO_LENGTH;
         }
     }
-    return 1;
-}
+    httpWriteHeaders(q, packet);
+    /* The HTTP/1 header text is not used */
+    httpGetPacket(q);
 
+    buf = mprCreateBuf(ME_MAX_BUFFER, -1);
+    encodeHeaders(conn, buf);
+    flags = (q->first && q->first->flags & HTTP_PACKET_END) ? H2_END_STREAM : 0;
 
-PUBLIC void httpSetStreaming(HttpHost *host, cchar *mime, cchar *uri, bool enable)
-{
-    MprKey  *kp;
+    lock(h2);
+    type = H2_HEADERS;
+    do {
+        len = min(mprGetBufLength(buf), h2->frameSize);
+        if (len == mprGetBufLength(buf)) {
+            flags |= H2_END_HEADERS;
+        }
+        putFrame(h2, type, flags, stream->id, mprGetBufStart(buf), len);
+        mprAdjustBufStart(buf, len);
+        type = H2_CONTINUATION;
+        flags = 0;
+    } while (mprGetBufLength(buf) > 0);
 
-    assert(host);
-    if ((kp = mprAddKey(host->streams, mime, uri)) != 0) {
-        /*
-            We store the enable value in the key type to save an allocation
-         */
-        kp->type = enable;
+    if (q->first && q->first->flags & HTTP_PACKET_END) {
+        stream->endTx = 1;
     }
+    unlock(h2);
 }
 
+#endif /* ME_HTTP_HTTP2 */
+
 /*
     @copy   default
 
@@ -10519,6 +12362,7 @@ static void adjustNetVec(HttpQueue *q, ssize written)
 
 /********************************** Forwards **********************************/
 
+static int detachPacketRef(HttpPacket *packet);
 static void managePacket(HttpPacket *packet, int flags);
 
 /************************************ Code ************************************/
@@ -10553,6 +12397,27 @@ static void managePacket(HttpPacket *packet, int flags)
 }
 
 
+/*
+    Replace referenced packet content with a private copy so the packet content can be modified
+ */
+static int detachPacketRef(HttpPacket *packet)
+{
+    MprBuf      *content;
+    ssize       len;
+
+    len = httpGetPacketLength(packet);
+    if ((content = mprCreateBuf(max(len, ME_MAX_BUFFER), -1)) == 0) {
+        return MPR_ERR_MEMORY;
+    }
+    if (len > 0 && mprPutBlockToBuf(content, mprGetBufStart(packet->content), len) != len) {
+        return MPR_ERR_MEMORY;
+    }
+    packet->content = content;
+    packet->flags &= ~HTTP_PACKET_REF;
+    return 0;
+}
+
+
 PUBLIC HttpPacket *httpCreateDataPacket(ssize size)
 {
     HttpPacket    *packet;
@@ -10696,6 +12561,9 @@ PUBLIC char *httpGetPacketString(HttpPacket *packet)
     if (!packet && !packet->content) {
         return 0;
     }
+    if (packet->flags & HTTP_PACKET_REF) {
+        detachPacketRef(packet);
+    }
     mprAddNullToBuf(packet->content);
     return mprGetBufStart(packet->content);
 }
@@ -10752,6 +12620,9 @@ PUBLIC int httpJoinPacket(HttpPacket *packet, HttpPacket *p)
     assert(!(packet->flags & HTTP_PACKET_SOLO));
     assert(!(p->flags & HTTP_PACKET_SOLO));
 
+    if (packet->flags & HTTP_PACKET_REF && detachPacketRef(packet) < 0) {
+        return MPR_ERR_MEMORY;
+    }
     len = httpGetPacketLength(p);
     if (mprPutBlockToBuf(packet->content, mprGetBufStart(p->content), len) != len) {
         assert(0);
@@ -11383,6 +13254,11 @@ PUBLIC void httpCreateTxPipeline(HttpConn *conn, HttpRoute *route)
             }
         }
     }
+#if ME_HTTP_HTTP2
+    if (conn->stream) {
+        tx->connector = http->http2Connector;
+    } else
+#endif
     if (tx->connector == 0) {
 #if !ME_ROM
         if (tx->handler == http->fileHandler && (rx->flags & HTTP_GET) && !(tx->flags & HTTP_TX_HAS_FILTERS) &&
@@ -11580,7 +13456,8 @@ PUBLIC void httpSetFileHandler(HttpConn *conn, cchar *path)
     if (path && path != tx->filename) {
         httpSetFilename(conn, path, 0);
     }
-    if ((conn->rx->flags & HTTP_GET) && !(tx->flags & HTTP_TX_HAS_FILTERS) && !conn->secure && !httpTracing(conn)) {
+    if ((conn->rx->flags & HTTP_GET) && !(tx->flags & HTTP_TX_HAS_FILTERS) && !conn->secure && !conn->stream &&
+            !httpTracing(conn)) {
         tx->flags |= HTTP_TX_SENDFILE;
         tx->connector = HTTP->sendConnector;
     }
@@ -12001,7 +13878,8 @@ PUBLIC bool httpFlushQueue(HttpQueue *q, int flags)
             to the O/S socket.
          */
         while (tx->writeBlocked || conn->connectorq->count > 0 || conn->connectorq->ioCount) {
-            if (conn->connError) {
+            if (conn->connError || conn->stream) {
+                /* HTTP/2 streams are resumed by the network connection and cannot wait on the socket */
                 break;
             }
             assert(!tx->finalizedConnector);
@@ -16360,7 +18238,7 @@ static bool parseIncoming(HttpConn *conn)
 static void delayAwake(HttpConn *conn, MprEvent *event)
 {
     conn->delay = 0;
-    mprCreateEvent(conn->dispatcher, "resumeConn", 0, httpIOEvent, conn, 0);
+    mprCreateEvent(conn->dispatcher, "resumeConn", 0, conn->ioCallback, conn, 0);
 }
 
 
@@ -20661,6 +22539,18 @@ PUBLIC bool httpFileExists(HttpConn *conn)
 }
 
 
+/*
+    Get the write mode. Default to buffered writes. Streaming connections cannot block.
+ */
+static int getWriteFlags(HttpConn *conn, int flags)
+{
+    if (flags == 0 || (conn->stream && (flags & HTTP_BLOCK))) {
+        flags = HTTP_BUFFER;
+    }
+    return flags;
+}
+
+
 /*
     Write a block of data. This is the lowest level write routine for data. This will buffer the data and flush if
     the queue buffer is full. Flushing is done by calling httpFlushQueue which will service queues as required. This
@@ -20680,16 +22570,15 @@ PUBLIC ssize httpWriteBlock(HttpQueue *q, cchar *buf, ssize len, int flags)
     if (tx == 0 || tx->finalizedOutput) {
         return MPR_ERR_CANT_WRITE;
     }
-    if (flags == 0) {
-        flags = HTTP_BUFFER;
-    }
+    flags = getWriteFlags(conn, flags);
     tx->responded = 1;
 
     for (totalWritten = 0; len > 0; ) {
         if (conn->state >= HTTP_STATE_FINALIZED || conn->connError) {
             return MPR_ERR_CANT_WRITE;
         }
-        if (q->last && q->last != q->first && q->last->flags & HTTP_PACKET_DATA && mprGetBufSpace(q->last->content) > 0) {
+        if (q->last && q->last != q->first && q->last->flags & HTTP_PACKET_DATA && !(q->last->flags & HTTP_PACKET_REF) &&
+                mprGetBufSpace(q->last->content) > 0) {
             packet = q->last;
         } else {
             packetSize = (tx->chunkSize > 0) ? tx->chunkSize : q->packetSize;
@@ -20729,6 +22618,51 @@ PUBLIC ssize httpWriteBlock(HttpQueue *q, cchar *buf, ssize len, int flags)
 }
 
 
+/*
+    Write a block of immutable data by reference. The packet content references the data and retains the owner.
+ */
+PUBLIC ssize httpWriteBlockRef(HttpQueue *q, cchar *buf, ssize len, cvoid *owner, int flags)
+{
+    HttpPacket  *packet;
+    HttpConn    *conn;
+    HttpTx      *tx;
+
+    assert(q == q->conn->writeq);
+    conn = q->conn;
+    tx = conn->tx;
+
+    if (len < ME_MIN_REF_WRITE || owner == 0) {
+        return httpWriteBlock(q, buf, len, flags);
+    }
+    if (tx == 0 || tx->finalizedOutput) {
+        return MPR_ERR_CANT_WRITE;
+    }
+    flags = getWriteFlags(conn, flags);
+    tx->responded = 1;
+    if (conn->state >= HTTP_STATE_FINALIZED || conn->connError) {
+        return MPR_ERR_CANT_WRITE;
+    }
+    if ((packet = httpCreateDataPacket(0)) == 0) {
+        return MPR_ERR_MEMORY;
+    }
+    if ((packet->content = mprCreateRefBuf(buf, len, owner)) == 0) {
+        return MPR_ERR_MEMORY;
+    }
+    packet->flags |= HTTP_PACKET_REF;
+    httpPutForService(q, packet, HTTP_DELAY_SERVICE);
+    if (q->count >= q->max) {
+        httpFlushQueue(q, flags);
+    }
+    if (conn->error) {
+        return MPR_ERR_CANT_WRITE;
+    }
+    if (httpClientConn(conn)) {
+        httpEnableConnEvents(conn);
+    }
+    return len;
+}
+
+
 PUBLIC ssize httpWriteString(HttpQueue *q, cchar *s)
 {
     return httpWriteBlock(q, s, strlen(s), HTTP_BUFFER);
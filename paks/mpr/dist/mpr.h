@@ -2697,6 +2697,20 @@ PUBLIC char *mprBufToString(MprBuf *buf);
  */
 PUBLIC MprBuf *mprCreateBuf(ssize initialSize, ssize maxSize);
 
+/**
+    Create a buffer that references external data
+    @description Create a read-only buffer over existing data without copying. The buffer cannot grow and must not
+    be written to. The owner memory block is marked by the buffer so the referenced data is retained while the buffer
+    is in use. The owner is stored as the buffer refill argument, so a refill procedure must not be defined.
+    @param data Data to reference. This may point inside the owner memory block.
+    @param len Length of the data in bytes
+    @param owner Allocated memory block containing the data
+    @return a new buffer
+    @ingroup MprBuf
+    @stability Prototype.
+ */
+PUBLIC MprBuf *mprCreateRefBuf(cvoid *data, ssize len, cvoid *owner);
+
 /**
     Clone a buffer
     @description Copy the buffer and contents into a newly allocated buffer
@@ -7552,6 +7566,7 @@ PUBLIC int mprSetMaxSocketAccept(int max);
 #define MPR_SOCKET_DISCONNECTED     0x4000  /**< The mprDisconnectSocket has been called */
 #define MPR_SOCKET_HANDSHAKING      0x8000  /**< Doing an SSL handshake */
 #define MPR_SOCKET_CERT_ERROR       0x10000 /**< Error when validating peer certificate */
+#define MPR_SOCKET_REUSE_PORT       0x20000 /**< Set SO_REUSEPORT so multiple processes can listen on the endpoint */
 
 /**
     Socket Service
@@ -7593,6 +7608,7 @@ typedef struct MprSocket {
     cchar           *peerName;          /**< Peer common SSL name */
     cchar           *peerCert;          /**< Peer SSL certificate */
     cchar           *peerCertIssuer;    /**< Issuer of peer certificate */
+    cchar           *protocol;          /**< Application protocol selected via ALPN */
     bool            secured;            /**< SSL Peer verified */
     MprMutex        *mutex;             /**< Multi-thread sync */
     void            *data;              /**< Custom user data (unmanaged) */
@@ -8107,6 +8123,7 @@ typedef struct MprSsl *(*MprMatchSsl)(MprSocket *sp, cchar *hostname);
     @stability Internal
  */
 typedef struct MprSsl {
+    cchar           *alpn;              /**< Application protocols to offer via ALPN (comma separated) */
     cchar           *keyFile;           /**< Alternatively, locate the key in a file */
     cchar           *certFile;          /**< Certificate filename */
     cchar           *revoke;            /**< Certificate revocation list */
@@ -8217,6 +8234,17 @@ PUBLIC void mprSetSslCaFile(struct MprSsl *ssl, cchar *caFile);
  */
 PUBLIC void mprSetSslCaPath(struct MprSsl *ssl, cchar *caPath);
 
+/**
+    Set the application protocols to negotiate via ALPN
+    @description The first protocol in the list that is also offered by the peer is selected. The selected
+        protocol is stored in MprSocket.protocol once the handshake completes.
+    @param ssl SSL instance returned from #mprCreateSsl
+    @param protocols Comma separated list of protocol names in order of preference. For example: "h2,http/1.1".
+    @ingroup MprSsl
+    @stability Prototype
+ */
+PUBLIC void mprSetSslAlpn(MprSsl *ssl, cchar *protocols);
+
 /**
     Set the ciphers to use
     @param ssl SSL instance returned from #mprCreateSsl
@@ -182,6 +182,7 @@ clean:
 	rm -f "$(BUILD)/obj/ejsSystem.o"
 	rm -f "$(BUILD)/obj/ejsTimer.o"
 	rm -f "$(BUILD)/obj/ejsType.o"
+	rm -f "$(BUILD)/obj/ejsTypedArray.o"
 	rm -f "$(BUILD)/obj/ejsUri.o"
 	rm -f "$(BUILD)/obj/ejsVoid.o"
 	rm -f "$(BUILD)/obj/ejsWeb.o"
@@ -1109,128 +1110,138 @@ $(BUILD)/obj/ejsType.o: \
 	$(CC) -c -o $(BUILD)/obj/ejsType.o -arch $(CC_ARCH) $(CFLAGS) $(DFLAGS) -D_FILE_OFFSET_BITS=64 -DMBEDTLS_USER_CONFIG_FILE=\"embedtls.h\" $(IFLAGS) src/core/src/ejsType.c
 
 #
-#   ejsUri.o
+#   ejsTypedArray.o
 #
 DEPS_89 += src/ejs.h
 
+$(BUILD)/obj/ejsTypedArray.o: \
+    src/core/src/ejsTypedArray.c $(DEPS_89)
+	@echo '   [Compile] $(BUILD)/obj/ejsTypedArray.o'
+	$(CC) -c -o $(BUILD)/obj/ejsTypedArray.o -arch $(CC_ARCH) $(CFLAGS) $(DFLAGS) -D_FILE_OFFSET_BITS=64 -DMBEDTLS_USER_CONFIG_FILE=\"embedtls.h\" $(IFLAGS) src/core/src/ejsTypedArray.c
+
+#
+#   ejsUri.o
+#
+DEPS_90 += src/ejs.h
+
 $(BUILD)/obj/ejsUri.o: \
-    src/core/src/ejsUri.c $(DEPS_89)
+    src/core/src/ejsUri.c $(DEPS_90)
 	@echo '   [Compile] $(BUILD)/obj/ejsUri.o'
 	$(CC) -c -o $(BUILD)/obj/ejsUri.o -arch $(CC_ARCH) $(CFLAGS) $(DFLAGS) -D_FILE_OFFSET_BITS=64 -DMBEDTLS_USER_CONFIG_FILE=\"embedtls.h\" $(IFLAGS) src/core/src/ejsUri.c
 
 #
 #   ejsVoid.o
 #
-DEPS_90 += src/ejs.h
+DEPS_91 += src/ejs.h
 
 $(BUILD)/obj/ejsVoid.o: \
-    src/core/src/ejsVoid.c $(DEPS_90)
+    src/core/src/ejsVoid.c $(DEPS_91)
 	@echo '   [Compile] $(BUILD)/obj/ejsVoid.o'
 	$(CC) -c -o $(BUILD)/obj/ejsVoid.o -arch $(CC_ARCH) $(CFLAGS) $(DFLAGS) -D_FILE_OFFSET_BITS=64 -DMBEDTLS_USER_CONFIG_FILE=\"embedtls.h\" $(IFLAGS) src/core/src/ejsVoid.c
 
 #
 #   ejsWeb.o
 #
-DEPS_91 += $(BUILD)/inc/me.h
-DEPS_91 += $(BUILD)/inc/ejs.h
-DEPS_91 += $(BUILD)/inc/ejsCompiler.h
-DEPS_91 += src/ejs.web/ejsWeb.h
-DEPS_91 += $(BUILD)/inc/ejs.web.slots.h
+DEPS_92 += $(BUILD)/inc/me.h
+DEPS_92 += $(BUILD)/inc/ejs.h
+DEPS_92 += $(BUILD)/inc/ejsCompiler.h
+DEPS_92 += src/ejs.web/ejsWeb.h
+DEPS_92 += $(BUILD)/inc/ejs.web.slots.h
 
 $(BUILD)/obj/ejsWeb.o: \
-    src/ejs.web/ejsWeb.c $(DEPS_91)
+    src/ejs.web/ejsWeb.c $(DEPS_92)
 	@echo '   [Compile] $(BUILD)/obj/ejsWeb.o'
 	$(CC) -c -o $(BUILD)/obj/ejsWeb.o -arch $(CC_ARCH) $(CFLAGS) $(DFLAGS) -D_FILE_OFFSET_BITS=64 -DMBEDTLS_USER_CONFIG_FILE=\"embedtls.h\" $(IFLAGS) src/ejs.web/ejsWeb.c
 
 #
 #   ejsWebSocket.o
 #
-DEPS_92 += src/ejs.h
+DEPS_93 += src/ejs.h
 
 $(BUILD)/obj/ejsWebSocket.o: \
-    src/core/src/ejsWebSocket.c $(DEPS_92)
+    src/core/src/ejsWebSocket.c $(DEPS_93)
 	@echo '   [Compile] $(BUILD)/obj/ejsWebSocket.o'
 	$(CC) -c -o $(BUILD)/obj/ejsWebSocket.o -arch $(CC_ARCH) $(CFLAGS) $(DFLAGS) -D_FILE_OFFSET_BITS=64 -DMBEDTLS_USER_CONFIG_FILE=\"embedtls.h\" $(IFLAGS) src/core/src/ejsWebSocket.c
 
 #
 #   ejsWorker.o
 #
-DEPS_93 += src/ejs.h
+DEPS_94 += src/ejs.h
 
 $(BUILD)/obj/ejsWorker.o: \
-    src/core/src/ejsWorker.c $(DEPS_93)
+    src/core/src/ejsWorker.c $(DEPS_94)
 	@echo '   [Compile] $(BUILD)/obj/ejsWorker.o'
 	$(CC) -c -o $(BUILD)/obj/ejsWorker.o -arch $(CC_ARCH) $(CFLAGS) $(DFLAGS) -D_FILE_OFFSET_BITS=64 -DMBEDTLS_USER_CONFIG_FILE=\"embedtls.h\" $(IFLAGS) src/core/src/ejsWorker.c
 
 #
 #   ejsXML.o
 #
-DEPS_94 += src/ejs.h
+DEPS_95 += src/ejs.h
 
 $(BUILD)/obj/ejsXML.o: \
-    src/core/src/ejsXML.c $(DEPS_94)
+    src/core/src/ejsXML.c $(DEPS_95)
 	@echo '   [Compile] $(BUILD)/obj/ejsXML.o'
 	$(CC) -c -o $(BUILD)/obj/ejsXML.o -arch $(CC_ARCH) $(CFLAGS) $(DFLAGS) -D_FILE_OFFSET_BITS=64 -DMBEDTLS_USER_CONFIG_FILE=\"embedtls.h\" $(IFLAGS) src/core/src/ejsXML.c
 
 #
 #   ejsXMLList.o
 #
-DEPS_95 += src/ejs.h
+DEPS_96 += src/ejs.h
 
 $(BUILD)/obj/ejsXMLList.o: \
-    src/core/src/ejsXMLList.c $(DEPS_95)
+    src/core/src/ejsXMLList.c $(DEPS_96)
 	@echo '   [Compile] $(BUILD)/obj/ejsXMLList.o'
 	$(CC) -c -o $(BUILD)/obj/ejsXMLList.o -arch $(CC_ARCH) $(CFLAGS) $(DFLAGS) -D_FILE_OFFSET_BITS=64 -DMBEDTLS_USER_CONFIG_FILE=\"embedtls.h\" $(IFLAGS) src/core/src/ejsXMLList.c
 
 #
 #   ejsXMLLoader.o
 #
-DEPS_96 += src/ejs.h
+DEPS_97 += src/ejs.h
 
 $(BUILD)/obj/ejsXMLLoader.o: \
-    src/core/src/ejsXMLLoader.c $(DEPS_96)
+    src/core/src/ejsXMLLoader.c $(DEPS_97)
 	@echo '   [Compile] $(BUILD)/obj/ejsXMLLoader.o'
 	$(CC) -c -o $(BUILD)/obj/ejsXMLLoader.o -arch $(CC_ARCH) $(CFLAGS) $(DFLAGS) -D_FILE_OFFSET_BITS=64 -DMBEDTLS_USER_CONFIG_FILE=\"embedtls.h\" $(IFLAGS) src/core/src/ejsXMLLoader.c
 
 #
 #   ejsZlib.o
 #
-DEPS_97 += $(BUILD)/inc/ejs.h
-DEPS_97 += $(BUILD)/inc/zlib.h
-DEPS_97 += $(BUILD)/inc/ejs.zlib.slots.h
+DEPS_98 += $(BUILD)/inc/ejs.h
+DEPS_98 += $(BUILD)/inc/zlib.h
+DEPS_98 += $(BUILD)/inc/ejs.zlib.slots.h
 
 $(BUILD)/obj/ejsZlib.o: \
-    src/ejs.zlib/ejsZlib.c $(DEPS_97)
+    src/ejs.zlib/ejsZlib.c $(DEPS_98)
 	@echo '   [Compile] $(BUILD)/obj/ejsZlib.o'
 	$(CC) -c -o $(BUILD)/obj/ejsZlib.o -arch $(CC_ARCH) $(CFLAGS) $(DFLAGS) -D_FILE_OFFSET_BITS=64 -DMBEDTLS_USER_CONFIG_FILE=\"embedtls.h\" $(IFLAGS) src/ejs.zlib/ejsZlib.c
 
 #
 #   ejsc.o
 #
-DEPS_98 += $(BUILD)/inc/ejsCompiler.h
+DEPS_99 += $(BUILD)/inc/ejsCompiler.h
 
 $(BUILD)/obj/ejsc.o: \
-    src/cmd/ejsc.c $(DEPS_98)
+    src/cmd/ejsc.c $(DEPS_99)
 	@echo '   [Compile] $(BUILD)/obj/ejsc.o'
 	$(CC) -c -o $(BUILD)/obj/ejsc.o -arch $(CC_ARCH) $(CFLAGS) $(DFLAGS) -D_FILE_OFFSET_BITS=64 -DMBEDTLS_USER_CONFIG_FILE=\"embedtls.h\" $(IFLAGS) src/cmd/ejsc.c
 
 #
 #   ejsmod.o
 #
-DEPS_99 += src/cmd/ejsmod.h
+DEPS_100 += src/cmd/ejsmod.h
 
 $(BUILD)/obj/ejsmod.o: \
-    src/cmd/ejsmod.c $(DEPS_99)
+    src/cmd/ejsmod.c $(DEPS_100)
 	@echo '   [Compile] $(BUILD)/obj/ejsmod.o'
 	$(CC) -c -o $(BUILD)/obj/ejsmod.o -arch $(CC_ARCH) $(CFLAGS) $(DFLAGS) -D_FILE_OFFSET_BITS=64 -DMBEDTLS_USER_CONFIG_FILE=\"embedtls.h\" $(IFLAGS) src/cmd/ejsmod.c
 
 #
 #   ejsrun.o
 #
-DEPS_100 += $(BUILD)/inc/ejsCompiler.h
+DEPS_101 += $(BUILD)/inc/ejsCompiler.h
 
 $(BUILD)/obj/ejsrun.o: \
-    src/cmd/ejsrun.c $(DEPS_100)
+    src/cmd/ejsrun.c $(DEPS_101)
 	@echo '   [Compile] $(BUILD)/obj/ejsrun.o'
 	$(CC) -c -o $(BUILD)/obj/ejsrun.o -arch $(CC_ARCH) $(CFLAGS) $(DFLAGS) -D_FILE_OFFSET_BITS=64 -DMBEDTLS_USER_CONFIG_FILE=\"embedtls.h\" $(IFLAGS) src/cmd/ejsrun.c
 
@@ -1238,37 +1249,37 @@ $(BUILD)/obj/ejsrun.o: \
 #   http.h
 #
 
-src/http/http.h: $(DEPS_101)
+src/http/http.h: $(DEPS_102)
 
 #
 #   http.o
 #
-DEPS_102 += src/http/http.h
+DEPS_103 += src/http/http.h
 
 $(BUILD)/obj/http.o: \
-    src/http/http.c $(DEPS_102)
+    src/http/http.c $(DEPS_103)
 	@echo '   [Compile] $(BUILD)/obj/http.o'
 	$(CC) -c -o $(BUILD)/obj/http.o -arch $(CC_ARCH) $(CFLAGS) $(DFLAGS) $(IFLAGS) src/http/http.c
 
 #
 #   httpLib.o
 #
-DEPS_103 += src/http/http.h
-DEPS_103 += $(BUILD)/inc/pcre.h
+DEPS_104 += src/http/http.h
+DEPS_104 += $(BUILD)/inc/pcre.h
 
 $(BUILD)/obj/httpLib.o: \
-    src/http/httpLib.c $(DEPS_103)
+    src/http/httpLib.c $(DEPS_104)
 	@echo '   [Compile] $(BUILD)/obj/httpLib.o'
 	$(CC) -c -o $(BUILD)/obj/httpLib.o -arch $(CC_ARCH) $(CFLAGS) $(DFLAGS) -D_FILE_OFFSET_BITS=64 -DMBEDTLS_USER_CONFIG_FILE=\"embedtls.h\" $(IFLAGS) src/http/httpLib.c
 
 #
 #   listing.o
 #
-DEPS_104 += src/cmd/ejsmod.h
-DEPS_104 += $(BUILD)/inc/ejsByteCodeTable.h
+DEPS_105 += src/cmd/ejsmod.h
+DEPS_105 += $(BUILD)/inc/ejsByteCodeTable.h
 
 $(BUILD)/obj/listing.o: \
-    src/cmd/listing.c $(DEPS_104)
+    src/cmd/listing.c $(DEPS_105)
 	@echo '   [Compile] $(BUILD)/obj/listing.o'
 	$(CC) -c -o $(BUILD)/obj/listing.o -arch $(CC_ARCH) $(CFLAGS) $(DFLAGS) -D_FILE_OFFSET_BITS=64 -DMBEDTLS_USER_CONFIG_FILE=\"embedtls.h\" $(IFLAGS) src/cmd/listing.c
 
@@ -1276,35 +1287,35 @@ $(BUILD)/obj/listing.o: \
 #   mbedtls.h
 #
 
-src/mbedtls/mbedtls.h: $(DEPS_105)
+src/mbedtls/mbedtls.h: $(DEPS_106)
 
 #
 #   mbedtls.o
 #
-DEPS_106 += src/mbedtls/mbedtls.h
+DEPS_107 += src/mbedtls/mbedtls.h
 
 $(BUILD)/obj/mbedtls.o: \
-    src/mbedtls/mbedtls.c $(DEPS_106)
+    src/mbedtls/mbedtls.c $(DEPS_107)
 	@echo '   [Compile] $(BUILD)/obj/mbedtls.o'
 	$(CC) -c -o $(BUILD)/obj/mbedtls.o -arch $(CC_ARCH) $(CFLAGS) $(DFLAGS) -DMBEDTLS_USER_CONFIG_FILE=\"embedtls.h\" $(IFLAGS) src/mbedtls/mbedtls.c
 
 #
 #   mpr-mbedtls.o
 #
-DEPS_107 += $(BUILD)/inc/mpr.h
+DEPS_108 += $(BUILD)/inc/mpr.h
 
 $(BUILD)/obj/mpr-mbedtls.o: \
-    src/mpr-mbedtls/mpr-mbedtls.c $(DEPS_107)
+    src/mpr-mbedtls/mpr-mbedtls.c $(DEPS_108)
 	@echo '   [Compile] $(BUILD)/obj/mpr-mbedtls.o'
 	$(CC) -c -o $(BUILD)/obj/mpr-mbedtls.o -arch $(CC_ARCH) $(CFLAGS) $(DFLAGS) -D_FILE_OFFSET_BITS=64 -DMBEDTLS_USER_CONFIG_FILE=\"embedtls.h\" $(IFLAGS) src/mpr-mbedtls/mpr-mbedtls.c
 
 #
 #   mpr-openssl.o
 #
-DEPS_108 += $(BUILD)/inc/mpr.h
+DEPS_109 += $(BUILD)/inc/mpr.h
 
 $(BUILD)/obj/mpr-openssl.o: \
-    src/mpr-openssl/mpr-openssl.c $(DEPS_108)
+    src/mpr-openssl/mpr-openssl.c $(DEPS_109)
 	@echo '   [Compile] $(BUILD)/obj/mpr-openssl.o'
 	$(CC) -c -o $(BUILD)/obj/mpr-openssl.o -arch $(CC_ARCH) $(CFLAGS) $(DFLAGS) $(IFLAGS) src/mpr-openssl/mpr-openssl.c
 
@@ -1312,15 +1323,15 @@ $(BUILD)/obj/mpr-openssl.o: \
 #   mpr.h
 #
 
-src/mpr/mpr.h: $(DEPS_109)
+src/mpr/mpr.h: $(DEPS_110)
 
 #
 #   mprLib.o
 #
-DEPS_110 += src/mpr/mpr.h
+DEPS_111 += src/mpr/mpr.h
 
 $(BUILD)/obj/mprLib.o: \
-    src/mpr/mprLib.c $(DEPS_110)
+    src/mpr/mprLib.c $(DEPS_111)
 	@echo '   [Compile] $(BUILD)/obj/mprLib.o'
 	$(CC) -c -o $(BUILD)/obj/mprLib.o -arch $(CC_ARCH) $(CFLAGS) $(DFLAGS) -D_FILE_OFFSET_BITS=64 -DMBEDTLS_USER_CONFIG_FILE=\"embedtls.h\" $(IFLAGS) src/mpr/mprLib.c
 
@@ -1328,26 +1339,26 @@ $(BUILD)/obj/mprLib.o: \
 #   pcre.h
 #
 
-src/pcre/pcre.h: $(DEPS_111)
+src/pcre/pcre.h: $(DEPS_112)
 
 #
 #   pcre.o
 #
-DEPS_112 += $(BUILD)/inc/me.h
-DEPS_112 += src/pcre/pcre.h
+DEPS_113 += $(BUILD)/inc/me.h
+DEPS_113 += src/pcre/pcre.h
 
 $(BUILD)/obj/pcre.o: \
-    src/pcre/pcre.c $(DEPS_112)
+    src/pcre/pcre.c $(DEPS_113)
 	@echo '   [Compile] $(BUILD)/obj/pcre.o'
 	$(CC) -c -o $(BUILD)/obj/pcre.o -arch $(CC_ARCH) $(CFLAGS) $(DFLAGS) $(IFLAGS) src/pcre/pcre.c
 
 #
 #   slotGen.o
 #
-DEPS_113 += src/cmd/ejsmod.h
+DEPS_114 += src/cmd/ejsmod.h
 
 $(BUILD)/obj/slotGen.o: \
-    src/cmd/slotGen.c $(DEPS_113)
+    src/cmd/slotGen.c $(DEPS_114)
 	@echo '   [Compile] $(BUILD)/obj/slotGen.o'
 	$(CC) -c -o $(BUILD)/obj/slotGen.o -arch $(CC_ARCH) $(CFLAGS) $(DFLAGS) -D_FILE_OFFSET_BITS=64 -DMBEDTLS_USER_CONFIG_FILE=\"embedtls.h\" $(IFLAGS) src/cmd/slotGen.c
 
@@ -1355,37 +1366,37 @@ $(BUILD)/obj/slotGen.o: \
 #   sqlite3.h
 #
 
-src/sqlite/sqlite3.h: $(DEPS_114)
+src/sqlite/sqlite3.h: $(DEPS_115)
 
 #
 #   sqlite.o
 #
-DEPS_115 += $(BUILD)/inc/me.h
-DEPS_115 += src/sqlite/sqlite3.h
+DEPS_116 += $(BUILD)/inc/me.h
+DEPS_116 += src/sqlite/sqlite3.h
 
 $(BUILD)/obj/sqlite.o: \
-    src/sqlite/sqlite.c $(DEPS_115)
+    src/sqlite/sqlite.c $(DEPS_116)
 	@echo '   [Compile] $(BUILD)/obj/sqlite.o'
 	$(CC) -c -o $(BUILD)/obj/sqlite.o -arch $(CC_ARCH) $(CFLAGS) $(DFLAGS) $(IFLAGS) src/sqlite/sqlite.c
 
 #
 #   sqlite3.o
 #
-DEPS_116 += $(BUILD)/inc/me.h
-DEPS_116 += src/sqlite/sqlite3.h
+DEPS_117 += $(BUILD)/inc/me.h
+DEPS_117 += src/sqlite/sqlite3.h
 
 $(BUILD)/obj/sqlite3.o: \
-    src/sqlite/sqlite3.c $(DEPS_116)
+    src/sqlite/sqlite3.c $(DEPS_117)
 	@echo '   [Compile] $(BUILD)/obj/sqlite3.o'
 	$(CC) -c -o $(BUILD)/obj/sqlite3.o -arch $(CC_ARCH) $(CFLAGS) $(DFLAGS) $(IFLAGS) src/sqlite/sqlite3.c
 
 #
 #   watchdog.o
 #
-DEPS_117 += $(BUILD)/inc/mpr.h
+DEPS_118 += $(BUILD)/inc/mpr.h
 
 $(BUILD)/obj/watchdog.o: \
-    src/watchdog/watchdog.c $(DEPS_117)
+    src/watchdog/watchdog.c $(DEPS_118)
 	@echo '   [Compile] $(BUILD)/obj/watchdog.o'
 	$(CC) -c -o $(BUILD)/obj/watchdog.o -arch $(CC_ARCH) $(CFLAGS) $(DFLAGS) -D_FILE_OFFSET_BITS=64 -DMBEDTLS_USER_CONFIG_FILE=\"embedtls.h\" $(IFLAGS) src/watchdog/watchdog.c
 
@@ -1393,16 +1404,16 @@ $(BUILD)/obj/watchdog.o: \
 #   zlib.h
 #
 
-src/zlib/zlib.h: $(DEPS_118)
+src/zlib/zlib.h: $(DEPS_119)
 
 #
 #   zlib.o
 #
-DEPS_119 += $(BUILD)/inc/me.h
-DEPS_119 += src/zlib/zlib.h
+DEPS_120 += $(BUILD)/inc/me.h
+DEPS_120 += src/zlib/zlib.h
 
 $(BUILD)/obj/zlib.o: \
-    src/zlib/zlib.c $(DEPS_119)
+    src/zlib/zlib.c $(DEPS_120)
 	@echo '   [Compile] $(BUILD)/obj/zlib.o'
 	$(CC) -c -o $(BUILD)/obj/zlib.o -arch $(CC_ARCH) $(CFLAGS) $(DFLAGS) $(IFLAGS) src/zlib/zlib.c
 
@@ -1410,19 +1421,19 @@ $(BUILD)/obj/zlib.o: \
 #   slots
 #
 
-slots: $(DEPS_120)
+slots: $(DEPS_121)
 
 ifeq ($(ME_COM_MBEDTLS),1)
 #
 #   libmbedtls
 #
-DEPS_121 += $(BUILD)/inc/osdep.h
-DEPS_121 += $(BUILD)/inc/embedtls.h
-DEPS_121 += $(BUILD)/inc/mbedtls-config.h
-DEPS_121 += $(BUILD)/inc/mbedtls.h
-DEPS_121 += $(BUILD)/obj/mbedtls.o
+DEPS_122 += $(BUILD)/inc/osdep.h
+DEPS_122 += $(BUILD)/inc/embedtls.h
+DEPS_122 += $(BUILD)/inc/mbedtls-config.h
+DEPS_122 += $(BUILD)/inc/mbedtls.h
+DEPS_122 += $(BUILD)/obj/mbedtls.o
 
-$(BUILD)/bin/libmbedtls.a: $(DEPS_121)
+$(BUILD)/bin/libmbedtls.a: $(DEPS_122)
 	@echo '      [Link] $(BUILD)/bin/libmbedtls.a'
 	ar -cr $(BUILD)/bin/libmbedtls.a "$(BUILD)/obj/mbedtls.o"
 endif
@@ -1431,10 +1442,10 @@ ifeq ($(ME_COM_MBEDTLS),1)
 #
 #   libmpr-mbedtls
 #
-DEPS_122 += $(BUILD)/bin/libmbedtls.a
-DEPS_122 += $(BUILD)/obj/mpr-mbedtls.o
+DEPS_123 += $(BUILD)/bin/libmbedtls.a
+DEPS_123 += $(BUILD)/obj/mpr-mbedtls.o
 
-$(BUILD)/bin/libmpr-mbedtls.a: $(DEPS_122)
+$(BUILD)/bin/libmpr-mbedtls.a: $(DEPS_123)
 	@echo '      [Link] $(BUILD)/bin/libmpr-mbedtls.a'
 	ar -cr $(BUILD)/bin/libmpr-mbedtls.a "$(BUILD)/obj/mpr-mbedtls.o"
 endif
@@ -1443,9 +1454,9 @@ ifeq ($(ME_COM_OPENSSL),1)
 #
 #   libmpr-openssl
 #
-DEPS_123 += $(BUILD)/obj/mpr-openssl.o
+DEPS_124 += $(BUILD)/obj/mpr-openssl.o
 
-$(BUILD)/bin/libmpr-openssl.a: $(DEPS_123)
+$(BUILD)/bin/libmpr-openssl.a: $(DEPS_124)
 	@echo '      [Link] $(BUILD)/bin/libmpr-openssl.a'
 	ar -cr $(BUILD)/bin/libmpr-openssl.a "$(BUILD)/obj/mpr-openssl.o"
 endif
@@ -1453,20 +1464,20 @@ endif
 #
 #   libmpr
 #
-DEPS_124 += $(BUILD)/inc/osdep.h
+DEPS_125 += $(BUILD)/inc/osdep.h
 ifeq ($(ME_COM_MBEDTLS),1)
-    DEPS_124 += $(BUILD)/bin/libmpr-mbedtls.a
+    DEPS_125 += $(BUILD)/bin/libmpr-mbedtls.a
 endif
 ifeq ($(ME_COM_MBEDTLS),1)
-    DEPS_124 += $(BUILD)/bin/libmbedtls.a
+    DEPS_125 += $(BUILD)/bin/libmbedtls.a
 endif
 ifeq ($(ME_COM_OPENSSL),1)
-    DEPS_124 += $(BUILD)/bin/libmpr-openssl.a
+    DEPS_125 += $(BUILD)/bin/libmpr-openssl.a
 endif
-DEPS_124 += $(BUILD)/inc/mpr.h
-DEPS_124 += $(BUILD)/obj/mprLib.o
+DEPS_125 += $(BUILD)/inc/mpr.h
+DEPS_125 += $(BUILD)/obj/mprLib.o
 
-$(BUILD)/bin/libmpr.a: $(DEPS_124)
+$(BUILD)/bin/libmpr.a: $(DEPS_125)
 	@echo '      [Link] $(BUILD)/bin/libmpr.a'
 	ar -cr $(BUILD)/bin/libmpr.a "$(BUILD)/obj/mprLib.o"
 
@@ -1474,10 +1485,10 @@ ifeq ($(ME_COM_PCRE),1)
 #
 #   libpcre
 #
-DEPS_125 += $(BUILD)/inc/pcre.h
-DEPS_125 += $(BUILD)/obj/pcre.o
+DEPS_126 += $(BUILD)/inc/pcre.h
+DEPS_126 += $(BUILD)/obj/pcre.o
 
-$(BUILD)/bin/libpcre.a: $(DEPS_125)
+$(BUILD)/bin/libpcre.a: $(DEPS_126)
 	@echo '      [Link] $(BUILD)/bin/libpcre.a'
 	ar -cr $(BUILD)/bin/libpcre.a "$(BUILD)/obj/pcre.o"
 endif
@@ -1486,14 +1497,14 @@ ifeq ($(ME_COM_HTTP),1)
 #
 #   libhttp
 #
-DEPS_126 += $(BUILD)/bin/libmpr.a
+DEPS_127 += $(BUILD)/bin/libmpr.a
 ifeq ($(ME_COM_PCRE),1)
-    DEPS_126 += $(BUILD)/bin/libpcre.a
+    DEPS_127 += $(BUILD)/bin/libpcre.a
 endif
-DEPS_126 += $(BUILD)/inc/http.h
-DEPS_126 += $(BUILD)/obj/httpLib.o
+DEPS_127 += $(BUILD)/inc/http.h
+DEPS_127 += $(BUILD)/obj/httpLib.o
 
-$(BUILD)/bin/libhttp.a: $(DEPS_126)
+$(BUILD)/bin/libhttp.a: $(DEPS_127)
 	@echo '      [Link] $(BUILD)/bin/libhttp.a'
 	ar -cr $(BUILD)/bin/libhttp.a "$(BUILD)/obj/httpLib.o"
 endif
@@ -1501,289 +1512,291 @@ endif
 #
 #   libejs
 #
-DEPS_127 += slots
+DEPS_128 += slots
 ifeq ($(ME_COM_HTTP),1)
-    DEPS_127 += $(BUILD)/bin/libhttp.a
-endif
-DEPS_127 += $(BUILD)/inc/ejs.cache.local.slots.h
-DEPS_127 += $(BUILD)/inc/ejs.db.sqlite.slots.h
-DEPS_127 += $(BUILD)/inc/ejs.slots.h
-DEPS_127 += $(BUILD)/inc/ejs.web.slots.h
-DEPS_127 += $(BUILD)/inc/ejs.zlib.slots.h
-DEPS_127 += $(BUILD)/inc/ejs.h
-DEPS_127 += $(BUILD)/inc/ejsByteCode.h
-DEPS_127 += $(BUILD)/inc/ejsByteCodeTable.h
-DEPS_127 += $(BUILD)/inc/ejsCompiler.h
-DEPS_127 += $(BUILD)/inc/ejsCustomize.h
-DEPS_127 += $(BUILD)/obj/ecAst.o
-DEPS_127 += $(BUILD)/obj/ecCodeGen.o
-DEPS_127 += $(BUILD)/obj/ecCompiler.o
-DEPS_127 += $(BUILD)/obj/ecLex.o
-DEPS_127 += $(BUILD)/obj/ecModuleWrite.o
-DEPS_127 += $(BUILD)/obj/ecParser.o
-DEPS_127 += $(BUILD)/obj/ecState.o
-DEPS_127 += $(BUILD)/obj/dtoa.o
-DEPS_127 += $(BUILD)/obj/ejsApp.o
-DEPS_127 += $(BUILD)/obj/ejsArray.o
-DEPS_127 += $(BUILD)/obj/ejsBlock.o
-DEPS_127 += $(BUILD)/obj/ejsBoolean.o
-DEPS_127 += $(BUILD)/obj/ejsByteArray.o
-DEPS_127 += $(BUILD)/obj/ejsCache.o
-DEPS_127 += $(BUILD)/obj/ejsCmd.o
-DEPS_127 += $(BUILD)/obj/ejsConfig.o
-DEPS_127 += $(BUILD)/obj/ejsDate.o
-DEPS_127 += $(BUILD)/obj/ejsDebug.o
-DEPS_127 += $(BUILD)/obj/ejsError.o
-DEPS_127 += $(BUILD)/obj/ejsFile.o
-DEPS_127 += $(BUILD)/obj/ejsFileSystem.o
-DEPS_127 += $(BUILD)/obj/ejsFrame.o
-DEPS_127 += $(BUILD)/obj/ejsFunction.o
-DEPS_127 += $(BUILD)/obj/ejsGC.o
-DEPS_127 += $(BUILD)/obj/ejsGlobal.o
-DEPS_127 += $(BUILD)/obj/ejsHttp.o
-DEPS_127 += $(BUILD)/obj/ejsIterator.o
-DEPS_127 += $(BUILD)/obj/ejsJSON.o
-DEPS_127 += $(BUILD)/obj/ejsLocalCache.o
-DEPS_127 += $(BUILD)/obj/ejsMath.o
-DEPS_127 += $(BUILD)/obj/ejsMemory.o
-DEPS_127 += $(BUILD)/obj/ejsMprLog.o
-DEPS_127 += $(BUILD)/obj/ejsNamespace.o
-DEPS_127 += $(BUILD)/obj/ejsNull.o
-DEPS_127 += $(BUILD)/obj/ejsNumber.o
-DEPS_127 += $(BUILD)/obj/ejsObject.o
-DEPS_127 += $(BUILD)/obj/ejsPath.o
-DEPS_127 += $(BUILD)/obj/ejsPot.o
-DEPS_127 += $(BUILD)/obj/ejsRegExp.o
-DEPS_127 += $(BUILD)/obj/ejsSocket.o
-DEPS_127 += $(BUILD)/obj/ejsString.o
-DEPS_127 += $(BUILD)/obj/ejsSystem.o
-DEPS_127 += $(BUILD)/obj/ejsTimer.o
-DEPS_127 += $(BUILD)/obj/ejsType.o
-DEPS_127 += $(BUILD)/obj/ejsUri.o
-DEPS_127 += $(BUILD)/obj/ejsVoid.o
-DEPS_127 += $(BUILD)/obj/ejsWebSocket.o
-DEPS_127 += $(BUILD)/obj/ejsWorker.o
-DEPS_127 += $(BUILD)/obj/ejsXML.o
-DEPS_127 += $(BUILD)/obj/ejsXMLList.o
-DEPS_127 += $(BUILD)/obj/ejsXMLLoader.o
-DEPS_127 += $(BUILD)/obj/ejsByteCode.o
-DEPS_127 += $(BUILD)/obj/ejsException.o
-DEPS_127 += $(BUILD)/obj/ejsHelper.o
-DEPS_127 += $(BUILD)/obj/ejsInterp.o
-DEPS_127 += $(BUILD)/obj/ejsLoader.o
-DEPS_127 += $(BUILD)/obj/ejsModule.o
-DEPS_127 += $(BUILD)/obj/ejsScope.o
-DEPS_127 += $(BUILD)/obj/ejsService.o
-
-$(BUILD)/bin/libejs.a: $(DEPS_127)
+    DEPS_128 += $(BUILD)/bin/libhttp.a
+endif
+DEPS_128 += $(BUILD)/inc/ejs.cache.local.slots.h
+DEPS_128 += $(BUILD)/inc/ejs.db.sqlite.slots.h
+DEPS_128 += $(BUILD)/inc/ejs.slots.h
+DEPS_128 += $(BUILD)/inc/ejs.web.slots.h
+DEPS_128 += $(BUILD)/inc/ejs.zlib.slots.h
+DEPS_128 += $(BUILD)/inc/ejs.h
+DEPS_128 += $(BUILD)/inc/ejsByteCode.h
+DEPS_128 += $(BUILD)/inc/ejsByteCodeTable.h
+DEPS_128 += $(BUILD)/inc/ejsCompiler.h
+DEPS_128 += $(BUILD)/inc/ejsCustomize.h
+DEPS_128 += $(BUILD)/obj/ecAst.o
+DEPS_128 += $(BUILD)/obj/ecCodeGen.o
+DEPS_128 += $(BUILD)/obj/ecCompiler.o
+DEPS_128 += $(BUILD)/obj/ecLex.o
+DEPS_128 += $(BUILD)/obj/ecModuleWrite.o
+DEPS_128 += $(BUILD)/obj/ecParser.o
+DEPS_128 += $(BUILD)/obj/ecState.o
+DEPS_128 += $(BUILD)/obj/dtoa.o
+DEPS_128 += $(BUILD)/obj/ejsApp.o
+DEPS_128 += $(BUILD)/obj/ejsArray.o
+DEPS_128 += $(BUILD)/obj/ejsBlock.o
+DEPS_128 += $(BUILD)/obj/ejsBoolean.o
+DEPS_128 += $(BUILD)/obj/ejsByteArray.o
+DEPS_128 += $(BUILD)/obj/ejsCache.o
+DEPS_128 += $(BUILD)/obj/ejsCmd.o
+DEPS_128 += $(BUILD)/obj/ejsConfig.o
+DEPS_128 += $(BUILD)/obj/ejsDate.o
+DEPS_128 += $(BUILD)/obj/ejsDebug.o
+DEPS_128 += $(BUILD)/obj/ejsError.o
+DEPS_128 += $(BUILD)/obj/ejsFile.o
+DEPS_128 += $(BUILD)/obj/ejsFileSystem.o
+DEPS_128 += $(BUILD)/obj/ejsFrame.o
+DEPS_128 += $(BUILD)/obj/ejsFunction.o
+DEPS_128 += $(BUILD)/obj/ejsGC.o
+DEPS_128 += $(BUILD)/obj/ejsGlobal.o
+DEPS_128 += $(BUILD)/obj/ejsHttp.o
+DEPS_128 += $(BUILD)/obj/ejsIterator.o
+DEPS_128 += $(BUILD)/obj/ejsJSON.o
+DEPS_128 += $(BUILD)/obj/ejsLocalCache.o
+DEPS_128 += $(BUILD)/obj/ejsMath.o
+DEPS_128 += $(BUILD)/obj/ejsMemory.o
+DEPS_128 += $(BUILD)/obj/ejsMprLog.o
+DEPS_128 += $(BUILD)/obj/ejsNamespace.o
+DEPS_128 += $(BUILD)/obj/ejsNull.o
+DEPS_128 += $(BUILD)/obj/ejsNumber.o
+DEPS_128 += $(BUILD)/obj/ejsObject.o
+DEPS_128 += $(BUILD)/obj/ejsPath.o
+DEPS_128 += $(BUILD)/obj/ejsPot.o
+DEPS_128 += $(BUILD)/obj/ejsRegExp.o
+DEPS_128 += $(BUILD)/obj/ejsSocket.o
+DEPS_128 += $(BUILD)/obj/ejsString.o
+DEPS_128 += $(BUILD)/obj/ejsSystem.o
+DEPS_128 += $(BUILD)/obj/ejsTimer.o
+DEPS_128 += $(BUILD)/obj/ejsType.o
+DEPS_128 += $(BUILD)/obj/ejsTypedArray.o
+DEPS_128 += $(BUILD)/obj/ejsUri.o
+DEPS_128 += $(BUILD)/obj/ejsVoid.o
+DEPS_128 += $(BUILD)/obj/ejsWebSocket.o
+DEPS_128 += $(BUILD)/obj/ejsWorker.o
+DEPS_128 += $(BUILD)/obj/ejsXML.o
+DEPS_128 += $(BUILD)/obj/ejsXMLList.o
+DEPS_128 += $(BUILD)/obj/ejsXMLLoader.o
+DEPS_128 += $(BUILD)/obj/ejsByteCode.o
+DEPS_128 += $(BUILD)/obj/ejsException.o
+DEPS_128 += $(BUILD)/obj/ejsHelper.o
+DEPS_128 += $(BUILD)/obj/ejsInterp.o
+DEPS_128 += $(BUILD)/obj/ejsLoader.o
+DEPS_128 += $(BUILD)/obj/ejsModule.o
+DEPS_128 += $(BUILD)/obj/ejsScope.o
+DEPS_128 += $(BUILD)/obj/ejsService.o
+
+$(BUILD)/bin/libejs.a: $(DEPS_128)
 	@echo '      [Link] $(BUILD)/bin/libejs.a'
-	ar -cr $(BUILD)/bin/libejs.a "$(BUILD)/obj/ecAst.o" "$(BUILD)/obj/ecCodeGen.o" "$(BUILD)/obj/ecCompiler.o" "$(BUILD)/obj/ecLex.o" "$(BUILD)/obj/ecModuleWrite.o" "$(BUILD)/obj/ecParser.o" "$(BUILD)/obj/ecState.o" "$(BUILD)/obj/dtoa.o" "$(BUILD)/obj/ejsApp.o" "$(BUILD)/obj/ejsArray.o" "$(BUILD)/obj/ejsBlock.o" "$(BUILD)/obj/ejsBoolean.o" "$(BUILD)/obj/ejsByteArray.o" "$(BUILD)/obj/ejsCache.o" "$(BUILD)/obj/ejsCmd.o" "$(BUILD)/obj/ejsConfig.o" "$(BUILD)/obj/ejsDate.o" "$(BUILD)/obj/ejsDebug.o" "$(BUILD)/obj/ejsError.o" "$(BUILD)/obj/ejsFile.o" "$(BUILD)/obj/ejsFileSystem.o" "$(BUILD)/obj/ejsFrame.o" "$(BUILD)/obj/ejsFunction.o" "$(BUILD)/obj/ejsGC.o" "$(BUILD)/obj/ejsGlobal.o" "$(BUILD)/obj/ejsHttp.o" "$(BUILD)/obj/ejsIterator.o" "$(BUILD)/obj/ejsJSON.o" "$(BUILD)/obj/ejsLocalCache.o" "$(BUILD)/obj/ejsMath.o" "$(BUILD)/obj/ejsMemory.o" "$(BUILD)/obj/ejsMprLog.o" "$(BUILD)/obj/ejsNamespace.o" "$(BUILD)/obj/ejsNull.o" "$(BUILD)/obj/ejsNumber.o" "$(BUILD)/obj/ejsObject.o" "$(BUILD)/obj/ejsPath.o" "$(BUILD)/obj/ejsPot.o" "$(BUILD)/obj/ejsRegExp.o" "$(BUILD)/obj/ejsSocket.o" "$(BUILD)/obj/ejsString.o" "$(BUILD)/obj/ejsSystem.o" "$(BUILD)/obj/ejsTimer.o" "$(BUILD)/obj/ejsType.o" "$(BUILD)/obj/ejsUri.o" "$(BUILD)/obj/ejsVoid.o" "$(BUILD)/obj/ejsWebSocket.o" "$(BUILD)/obj/ejsWorker.o" "$(BUILD)/obj/ejsXML.o" "$(BUILD)/obj/ejsXMLList.o" "$(BUILD)/obj/ejsXMLLoader.o" "$(BUILD)/obj/ejsByteCode.o" "$(BUILD)/obj/ejsException.o" "$(BUILD)/obj/ejsHelper.o" "$(BUILD)/obj/ejsInterp.o" "$(BUILD)/obj/ejsLoader.o" "$(BUILD)/obj/ejsModule.o" "$(BUILD)/obj/ejsScope.o" "$(BUILD)/obj/ejsService.o"
+	ar -cr $(BUILD)/bin/libejs.a "$(BUILD)/obj/ecAst.o" "$(BUILD)/obj/ecCodeGen.o" "$(BUILD)/obj/ecCompiler.o" "$(BUILD)/obj/ecLex.o" "$(BUILD)/obj/ecModuleWrite.o" "$(BUILD)/obj/ecParser.o" "$(BUILD)/obj/ecState.o" "$(BUILD)/obj/dtoa.o" "$(BUILD)/obj/ejsApp.o" "$(BUILD)/obj/ejsArray.o" "$(BUILD)/obj/ejsBlock.o" "$(BUILD)/obj/ejsBoolean.o" "$(BUILD)/obj/ejsByteArray.o" "$(BUILD)/obj/ejsCache.o" "$(BUILD)/obj/ejsCmd.o" "$(BUILD)/obj/ejsConfig.o" "$(BUILD)/obj/ejsDate.o" "$(BUILD)/obj/ejsDebug.o" "$(BUILD)/obj/ejsError.o" "$(BUILD)/obj/ejsFile.o" "$(BUILD)/obj/ejsFileSystem.o" "$(BUILD)/obj/ejsFrame.o" "$(BUILD)/obj/ejsFunction.o" "$(BUILD)/obj/ejsGC.o" "$(BUILD)/obj/ejsGlobal.o" "$(BUILD)/obj/ejsHttp.o" "$(BUILD)/obj/ejsIterator.o" "$(BUILD)/obj/ejsJSON.o" "$(BUILD)/obj/ejsLocalCache.o" "$(BUILD)/obj/ejsMath.o" "$(BUILD)/obj/ejsMemory.o" "$(BUILD)/obj/ejsMprLog.o" "$(BUILD)/obj/ejsNamespace.o" "$(BUILD)/obj/ejsNull.o" "$(BUILD)/obj/ejsNumber.o" "$(BUILD)/obj/ejsObject.o" "$(BUILD)/obj/ejsPath.o" "$(BUILD)/obj/ejsPot.o" "$(BUILD)/obj/ejsRegExp.o" "$(BUILD)/obj/ejsSocket.o" "$(BUILD)/obj/ejsString.o" "$(BUILD)/obj/ejsSystem.o" "$(BUILD)/obj/ejsTimer.o" "$(BUILD)/obj/ejsType.o" "$(BUILD)/obj/ejsTypedArray.o" "$(BUILD)/obj/ejsUri.o" "$(BUILD)/obj/ejsVoid.o" "$(BUILD)/obj/ejsWebSocket.o" "$(BUILD)/obj/ejsWorker.o" "$(BUILD)/obj/ejsXML.o" "$(BUILD)/obj/ejsXMLList.o" "$(BUILD)/obj/ejsXMLLoader.o" "$(BUILD)/obj/ejsByteCode.o" "$(BUILD)/obj/ejsException.o" "$(BUILD)/obj/ejsHelper.o" "$(BUILD)/obj/ejsInterp.o" "$(BUILD)/obj/ejsLoader.o" "$(BUILD)/obj/ejsModule.o" "$(BUILD)/obj/ejsScope.o" "$(BUILD)/obj/ejsService.o"
 
 #
 #   ejs
 #
-DEPS_128 += $(BUILD)/bin/libejs.a
-DEPS_128 += $(BUILD)/obj/ejs.o
+DEPS_129 += $(BUILD)/bin/libejs.a
+DEPS_129 += $(BUILD)/obj/ejs.o
 
 ifeq ($(ME_COM_MBEDTLS),1)
-    LIBS_128 += -lmbedtls
+    LIBS_129 += -lmbedtls
 endif
 ifeq ($(ME_COM_MBEDTLS),1)
-    LIBS_128 += -lmpr-mbedtls
+    LIBS_129 += -lmpr-mbedtls
 endif
 ifeq ($(ME_COM_MBEDTLS),1)
-    LIBS_128 += -lmbedtls
+    LIBS_129 += -lmbedtls
 endif
 ifeq ($(ME_COM_OPENSSL),1)
-    LIBS_128 += -lmpr-openssl
+    LIBS_129 += -lmpr-openssl
 endif
-LIBS_128 += -lmpr
+LIBS_129 += -lmpr
 ifeq ($(ME_COM_MBEDTLS),1)
-    LIBS_128 += -lmpr-mbedtls
+    LIBS_129 += -lmpr-mbedtls
 endif
 ifeq ($(ME_COM_PCRE),1)
-    LIBS_128 += -lpcre
+    LIBS_129 += -lpcre
 endif
 ifeq ($(ME_COM_HTTP),1)
-    LIBS_128 += -lhttp
+    LIBS_129 += -lhttp
 endif
 ifeq ($(ME_COM_PCRE),1)
-    LIBS_128 += -lpcre
+    LIBS_129 += -lpcre
 endif
-LIBS_128 += -lmpr
-LIBS_128 += -lejs
+LIBS_129 += -lmpr
+LIBS_129 += -lejs
 ifeq ($(ME_COM_HTTP),1)
-    LIBS_128 += -lhttp
+    LIBS_129 += -lhttp
 endif
 
-$(BUILD)/bin/ejs: $(DEPS_128)
+$(BUILD)/bin/ejs: $(DEPS_129)
 	@echo '      [Link] $(BUILD)/bin/ejs'
-	$(CC) -o $(BUILD)/bin/ejs -arch $(CC_ARCH) $(LDFLAGS) $(LIBPATHS) "$(BUILD)/obj/ejs.o" $(LIBPATHS_128) $(LIBS_128) $(LIBS_128) $(LIBS) -lpam -ledit 
+	$(CC) -o $(BUILD)/bin/ejs -arch $(CC_ARCH) $(LDFLAGS) $(LIBPATHS) "$(BUILD)/obj/ejs.o" $(LIBPATHS_129) $(LIBS_129) $(LIBS_129) $(LIBS) -lpam -ledit 
 
 #
 #   ejsc
 #
-DEPS_129 += $(BUILD)/bin/libejs.a
-DEPS_129 += $(BUILD)/obj/ejsc.o
+DEPS_130 += $(BUILD)/bin/libejs.a
+DEPS_130 += $(BUILD)/obj/ejsc.o
 
 ifeq ($(ME_COM_MBEDTLS),1)
-    LIBS_129 += -lmbedtls
+    LIBS_130 += -lmbedtls
 endif
 ifeq ($(ME_COM_MBEDTLS),1)
-    LIBS_129 += -lmpr-mbedtls
+    LIBS_130 += -lmpr-mbedtls
 endif
 ifeq ($(ME_COM_MBEDTLS),1)
-    LIBS_129 += -lmbedtls
+    LIBS_130 += -lmbedtls
 endif
 ifeq ($(ME_COM_OPENSSL),1)
-    LIBS_129 += -lmpr-openssl
+    LIBS_130 += -lmpr-openssl
 endif
-LIBS_129 += -lmpr
+LIBS_130 += -lmpr
 ifeq ($(ME_COM_MBEDTLS),1)
-    LIBS_129 += -lmpr-mbedtls
+    LIBS_130 += -lmpr-mbedtls
 endif
 ifeq ($(ME_COM_PCRE),1)
-    LIBS_129 += -lpcre
+    LIBS_130 += -lpcre
 endif
 ifeq ($(ME_COM_HTTP),1)
-    LIBS_129 += -lhttp
+    LIBS_130 += -lhttp
 endif
 ifeq ($(ME_COM_PCRE),1)
-    LIBS_129 += -lpcre
+    LIBS_130 += -lpcre
 endif
-LIBS_129 += -lmpr
-LIBS_129 += -lejs
+LIBS_130 += -lmpr
+LIBS_130 += -lejs
 ifeq ($(ME_COM_HTTP),1)
-    LIBS_129 += -lhttp
+    LIBS_130 += -lhttp
 endif
 
-$(BUILD)/bin/ejsc: $(DEPS_129)
+$(BUILD)/bin/ejsc: $(DEPS_130)
 	@echo '      [Link] $(BUILD)/bin/ejsc'
-	$(CC) -o $(BUILD)/bin/ejsc -arch $(CC_ARCH) $(LDFLAGS) $(LIBPATHS) "$(BUILD)/obj/ejsc.o" $(LIBPATHS_129) $(LIBS_129) $(LIBS_129) $(LIBS) -lpam 
+	$(CC) -o $(BUILD)/bin/ejsc -arch $(CC_ARCH) $(LDFLAGS) $(LIBPATHS) "$(BUILD)/obj/ejsc.o" $(LIBPATHS_130) $(LIBS_130) $(LIBS_130) $(LIBS) -lpam 
 
 #
 #   ejsmod
 #
-DEPS_130 += $(BUILD)/bin/libejs.a
-DEPS_130 += $(BUILD)/inc/ejsmod.h
-DEPS_130 += $(BUILD)/obj/ejsmod.o
-DEPS_130 += $(BUILD)/obj/doc.o
-DEPS_130 += $(BUILD)/obj/docFiles.o
-DEPS_130 += $(BUILD)/obj/listing.o
-DEPS_130 += $(BUILD)/obj/slotGen.o
+DEPS_131 += $(BUILD)/bin/libejs.a
+DEPS_131 += $(BUILD)/inc/ejsmod.h
+DEPS_131 += $(BUILD)/obj/ejsmod.o
+DEPS_131 += $(BUILD)/obj/doc.o
+DEPS_131 += $(BUILD)/obj/docFiles.o
+DEPS_131 += $(BUILD)/obj/listing.o
+DEPS_131 += $(BUILD)/obj/slotGen.o
 
 ifeq ($(ME_COM_MBEDTLS),1)
-    LIBS_130 += -lmbedtls
+    LIBS_131 += -lmbedtls
 endif
 ifeq ($(ME_COM_MBEDTLS),1)
-    LIBS_130 += -lmpr-mbedtls
+    LIBS_131 += -lmpr-mbedtls
 endif
 ifeq ($(ME_COM_MBEDTLS),1)
-    LIBS_130 += -lmbedtls
+    LIBS_131 += -lmbedtls
 endif
 ifeq ($(ME_COM_OPENSSL),1)
-    LIBS_130 += -lmpr-openssl
+    LIBS_131 += -lmpr-openssl
 endif
-LIBS_130 += -lmpr
+LIBS_131 += -lmpr
 ifeq ($(ME_COM_MBEDTLS),1)
-    LIBS_130 += -lmpr-mbedtls
+    LIBS_131 += -lmpr-mbedtls
 endif
 ifeq ($(ME_COM_PCRE),1)
-    LIBS_130 += -lpcre
+    LIBS_131 += -lpcre
 endif
 ifeq ($(ME_COM_HTTP),1)
-    LIBS_130 += -lhttp
+    LIBS_131 += -lhttp
 endif
 ifeq ($(ME_COM_PCRE),1)
-    LIBS_130 += -lpcre
+    LIBS_131 += -lpcre
 endif
-LIBS_130 += -lmpr
-LIBS_130 += -lejs
+LIBS_131 += -lmpr
+LIBS_131 += -lejs
 ifeq ($(ME_COM_HTTP),1)
-    LIBS_130 += -lhttp
+    LIBS_131 += -lhttp
 endif
 
-$(BUILD)/bin/ejsmod: $(DEPS_130)
+$(BUILD)/bin/ejsmod: $(DEPS_131)
 	@echo '      [Link] $(BUILD)/bin/ejsmod'
-	$(CC) -o $(BUILD)/bin/ejsmod -arch $(CC_ARCH) $(LDFLAGS) $(LIBPATHS) "$(BUILD)/obj/ejsmod.o" "$(BUILD)/obj/doc.o" "$(BUILD)/obj/docFiles.o" "$(BUILD)/obj/listing.o" "$(BUILD)/obj/slotGen.o" $(LIBPATHS_130) $(LIBS_130) $(LIBS_130) $(LIBS) -lpam 
+	$(CC) -o $(BUILD)/bin/ejsmod -arch $(CC_ARCH) $(LDFLAGS) $(LIBPATHS) "$(BUILD)/obj/ejsmod.o" "$(BUILD)/obj/doc.o" "$(BUILD)/obj/docFiles.o" "$(BUILD)/obj/listing.o" "$(BUILD)/obj/slotGen.o" $(LIBPATHS_131) $(LIBS_131) $(LIBS_131) $(LIBS) -lpam 
 
 #
 #   ejs.mod
 #
-DEPS_131 += src/core/App.es
-DEPS_131 += src/core/Args.es
-DEPS_131 += src/core/Array.es
-DEPS_131 += src/core/BinaryStream.es
-DEPS_131 += src/core/Block.es
-DEPS_131 += src/core/Boolean.es
-DEPS_131 += src/core/ByteArray.es
-DEPS_131 += src/core/Cache.es
-DEPS_131 += src/core/Cmd.es
-DEPS_131 += src/core/Compat.es
-DEPS_131 += src/core/Config.es
-DEPS_131 += src/core/Date.es
-DEPS_131 += src/core/Debug.es
-DEPS_131 += src/core/Emitter.es
-DEPS_131 += src/core/Error.es
-DEPS_131 += src/core/File.es
-DEPS_131 += src/core/FileSystem.es
-DEPS_131 += src/core/Frame.es
-DEPS_131 += src/core/Function.es
-DEPS_131 += src/core/GC.es
-DEPS_131 += src/core/Global.es
-DEPS_131 += src/core/Http.es
-DEPS_131 += src/core/Inflector.es
-DEPS_131 += src/core/Iterator.es
-DEPS_131 += src/core/JSON.es
-DEPS_131 += src/core/Loader.es
-DEPS_131 += src/core/LocalCache.es
-DEPS_131 += src/core/Locale.es
-DEPS_131 += src/core/Logger.es
-DEPS_131 += src/core/Math.es
-DEPS_131 += src/core/Memory.es
-DEPS_131 += src/core/MprLog.es
-DEPS_131 += src/core/Name.es
-DEPS_131 += src/core/Namespace.es
-DEPS_131 += src/core/Null.es
-DEPS_131 += src/core/Number.es
-DEPS_131 += src/core/Object.es
-DEPS_131 += src/core/Path.es
-DEPS_131 += src/core/Promise.es
-DEPS_131 += src/core/RegExp.es
-DEPS_131 += src/core/Socket.es
-DEPS_131 += src/core/Stream.es
-DEPS_131 += src/core/String.es
-DEPS_131 += src/core/System.es
-DEPS_131 += src/core/TextStream.es
-DEPS_131 += src/core/Timer.es
-DEPS_131 += src/core/Type.es
-DEPS_131 += src/core/Uri.es
-DEPS_131 += src/core/Void.es
-DEPS_131 += src/core/WebSocket.es
-DEPS_131 += src/core/Worker.es
-DEPS_131 += src/core/XML.es
-DEPS_131 += src/core/XMLHttp.es
-DEPS_131 += src/core/XMLList.es
-DEPS_131 += $(BUILD)/bin/ejsc
-DEPS_131 += $(BUILD)/bin/ejsmod
-
-$(BUILD)/bin/ejs.mod: $(DEPS_131)
+DEPS_132 += src/core/App.es
+DEPS_132 += src/core/Args.es
+DEPS_132 += src/core/Array.es
+DEPS_132 += src/core/BinaryStream.es
+DEPS_132 += src/core/Block.es
+DEPS_132 += src/core/Boolean.es
+DEPS_132 += src/core/ByteArray.es
+DEPS_132 += src/core/Cache.es
+DEPS_132 += src/core/Cmd.es
+DEPS_132 += src/core/Compat.es
+DEPS_132 += src/core/Config.es
+DEPS_132 += src/core/Date.es
+DEPS_132 += src/core/Debug.es
+DEPS_132 += src/core/Emitter.es
+DEPS_132 += src/core/Error.es
+DEPS_132 += src/core/File.es
+DEPS_132 += src/core/FileSystem.es
+DEPS_132 += src/core/Frame.es
+DEPS_132 += src/core/Function.es
+DEPS_132 += src/core/GC.es
+DEPS_132 += src/core/Global.es
+DEPS_132 += src/core/Http.es
+DEPS_132 += src/core/Inflector.es
+DEPS_132 += src/core/Iterator.es
+DEPS_132 += src/core/JSON.es
+DEPS_132 += src/core/Loader.es
+DEPS_132 += src/core/LocalCache.es
+DEPS_132 += src/core/Locale.es
+DEPS_132 += src/core/Logger.es
+DEPS_132 += src/core/Math.es
+DEPS_132 += src/core/Memory.es
+DEPS_132 += src/core/MprLog.es
+DEPS_132 += src/core/Name.es
+DEPS_132 += src/core/Namespace.es
+DEPS_132 += src/core/Null.es
+DEPS_132 += src/core/Number.es
+DEPS_132 += src/core/Object.es
+DEPS_132 += src/core/Path.es
+DEPS_132 += src/core/Promise.es
+DEPS_132 += src/core/RegExp.es
+DEPS_132 += src/core/Socket.es
+DEPS_132 += src/core/Stream.es
+DEPS_132 += src/core/String.es
+DEPS_132 += src/core/System.es
+DEPS_132 += src/core/TextStream.es
+DEPS_132 += src/core/Timer.es
+DEPS_132 += src/core/Type.es
+DEPS_132 += src/core/TypedArray.es
+DEPS_132 += src/core/Uri.es
+DEPS_132 += src/core/Void.es
+DEPS_132 += src/core/WebSocket.es
+DEPS_132 += src/core/Worker.es
+DEPS_132 += src/core/XML.es
+DEPS_132 += src/core/XMLHttp.es
+DEPS_132 += src/core/XMLList.es
+DEPS_132 += $(BUILD)/bin/ejsc
+DEPS_132 += $(BUILD)/bin/ejsmod
+
+$(BUILD)/bin/ejs.mod: $(DEPS_132)
 	( \
 	cd src/core; \
 	echo '   [Compile] Core EJS classes' ; \
-	"../../$(BUILD)/bin/ejsc" --out "../../$(BUILD)/bin/ejs.mod"  --optimize 9 --bind --require null App.es Args.es Array.es BinaryStream.es Block.es Boolean.es ByteArray.es Cache.es Cmd.es Compat.es Config.es Date.es Debug.es Emitter.es Error.es File.es FileSystem.es Frame.es Function.es GC.es Global.es Http.es Inflector.es Iterator.es JSON.es Loader.es LocalCache.es Locale.es Logger.es Math.es Memory.es MprLog.es Name.es Namespace.es Null.es Number.es Object.es Path.es Promise.es RegExp.es Socket.es Stream.es String.es System.es TextStream.es Timer.es Type.es Uri.es Void.es WebSocket.es Worker.es XML.es XMLHttp.es XMLList.es ; \
+	"../../$(BUILD)/bin/ejsc" --out "../../$(BUILD)/bin/ejs.mod"  --optimize 9 --bind --require null App.es Args.es Array.es BinaryStream.es Block.es Boolean.es ByteArray.es Cache.es Cmd.es Compat.es Config.es Date.es Debug.es Emitter.es Error.es File.es FileSystem.es Frame.es Function.es GC.es Global.es Http.es Inflector.es Iterator.es JSON.es Loader.es LocalCache.es Locale.es Logger.es Math.es Memory.es MprLog.es Name.es Namespace.es Null.es Number.es Object.es Path.es Promise.es RegExp.es Socket.es Stream.es String.es System.es TextStream.es Timer.es Type.es TypedArray.es Uri.es Void.es WebSocket.es Worker.es XML.es XMLHttp.es XMLList.es ; \
 	"../../$(BUILD)/bin/ejsmod" --cslots --dir "../../$(BUILD)/inc" --require null "../../$(BUILD)/bin/ejs.mod" ; \
 	)
 
 #
 #   ejs.db.mod
 #
-DEPS_132 += src/ejs.db/Database.es
-DEPS_132 += src/ejs.db/DatabaseConnector.es
-DEPS_132 += $(BUILD)/bin/ejsc
-DEPS_132 += $(BUILD)/bin/ejs.mod
+DEPS_133 += src/ejs.db/Database.es
+DEPS_133 += src/ejs.db/DatabaseConnector.es
+DEPS_133 += $(BUILD)/bin/ejsc
+DEPS_133 += $(BUILD)/bin/ejs.mod
 
-$(BUILD)/bin/ejs.db.mod: $(DEPS_132)
+$(BUILD)/bin/ejs.db.mod: $(DEPS_133)
 	( \
 	cd src/ejs.db; \
 	echo '   [Compile] ejs.db.mod' ; \
@@ -1793,12 +1806,12 @@ $(BUILD)/bin/ejs.db.mod: $(DEPS_132)
 #
 #   ejs.db.mapper.mod
 #
-DEPS_133 += src/ejs.db.mapper/Record.es
-DEPS_133 += $(BUILD)/bin/ejsc
-DEPS_133 += $(BUILD)/bin/ejs.mod
-DEPS_133 += $(BUILD)/bin/ejs.db.mod
+DEPS_134 += src/ejs.db.mapper/Record.es
+DEPS_134 += $(BUILD)/bin/ejsc
+DEPS_134 += $(BUILD)/bin/ejs.mod
+DEPS_134 += $(BUILD)/bin/ejs.db.mod
 
-$(BUILD)/bin/ejs.db.mapper.mod: $(DEPS_133)
+$(BUILD)/bin/ejs.db.mapper.mod: $(DEPS_134)
 	( \
 	cd src/ejs.db.mapper; \
 	echo '   [Compile] ejs.db.mapper.mod' ; \
@@ -1808,12 +1821,12 @@ $(BUILD)/bin/ejs.db.mapper.mod: $(DEPS_133)
 #
 #   ejs.db.sqlite.mod
 #
-DEPS_134 += src/ejs.db.sqlite/Sqlite.es
-DEPS_134 += $(BUILD)/bin/ejsc
-DEPS_134 += $(BUILD)/bin/ejsmod
-DEPS_134 += $(BUILD)/bin/ejs.mod
+DEPS_135 += src/ejs.db.sqlite/Sqlite.es
+DEPS_135 += $(BUILD)/bin/ejsc
+DEPS_135 += $(BUILD)/bin/ejsmod
+DEPS_135 += $(BUILD)/bin/ejs.mod
 
-$(BUILD)/bin/ejs.db.sqlite.mod: $(DEPS_134)
+$(BUILD)/bin/ejs.db.sqlite.mod: $(DEPS_135)
 	( \
 	cd src/ejs.db.sqlite; \
 	echo '   [Compile] ejs.db.sqlite.mod' ; \
@@ -1824,11 +1837,11 @@ $(BUILD)/bin/ejs.db.sqlite.mod: $(DEPS_134)
 #
 #   ejs.mail.mod
 #
-DEPS_135 += src/ejs.mail/Mail.es
-DEPS_135 += $(BUILD)/bin/ejsc
-DEPS_135 += $(BUILD)/bin/ejs.mod
+DEPS_136 += src/ejs.mail/Mail.es
+DEPS_136 += $(BUILD)/bin/ejsc
+DEPS_136 += $(BUILD)/bin/ejs.mod
 
-$(BUILD)/bin/ejs.mail.mod: $(DEPS_135)
+$(BUILD)/bin/ejs.mail.mod: $(DEPS_136)
 	( \
 	cd src/ejs.mail; \
 	"../../$(BUILD)/bin/ejsc" --out "../../$(BUILD)/bin/ejs.mail.mod"  --optimize 9 Mail.es ; \
@@ -1837,34 +1850,34 @@ $(BUILD)/bin/ejs.mail.mod: $(DEPS_135)
 #
 #   ejs.web.mod
 #
-DEPS_136 += src/ejs.web/Cascade.es
-DEPS_136 += src/ejs.web/CommonLog.es
-DEPS_136 += src/ejs.web/ContentType.es
-DEPS_136 += src/ejs.web/Controller.es
-DEPS_136 += src/ejs.web/Dir.es
-DEPS_136 += src/ejs.web/Google.es
-DEPS_136 += src/ejs.web/Head.es
-DEPS_136 += src/ejs.web/Html.es
-DEPS_136 += src/ejs.web/HttpServer.es
-DEPS_136 += src/ejs.web/MethodOverride.es
-DEPS_136 += src/ejs.web/Middleware.es
-DEPS_136 += src/ejs.web/Mvc.es
-DEPS_136 += src/ejs.web/Request.es
-DEPS_136 += src/ejs.web/Router.es
-DEPS_136 += src/ejs.web/Script.es
-DEPS_136 += src/ejs.web/Session.es
-DEPS_136 += src/ejs.web/ShowExceptions.es
-DEPS_136 += src/ejs.web/Static.es
-DEPS_136 += src/ejs.web/Template.es
-DEPS_136 += src/ejs.web/UploadFile.es
-DEPS_136 += src/ejs.web/UrlMap.es
-DEPS_136 += src/ejs.web/Utils.es
-DEPS_136 += src/ejs.web/View.es
-DEPS_136 += $(BUILD)/bin/ejsc
-DEPS_136 += $(BUILD)/bin/ejsmod
-DEPS_136 += $(BUILD)/bin/ejs.mod
+DEPS_137 += src/ejs.web/Cascade.es
+DEPS_137 += src/ejs.web/CommonLog.es
+DEPS_137 += src/ejs.web/ContentType.es
+DEPS_137 += src/ejs.web/Controller.es
+DEPS_137 += src/ejs.web/Dir.es
+DEPS_137 += src/ejs.web/Google.es
+DEPS_137 += src/ejs.web/Head.es
+DEPS_137 += src/ejs.web/Html.es
+DEPS_137 += src/ejs.web/HttpServer.es
+DEPS_137 += src/ejs.web/MethodOverride.es
+DEPS_137 += src/ejs.web/Middleware.es
+DEPS_137 += src/ejs.web/Mvc.es
+DEPS_137 += src/ejs.web/Request.es
+DEPS_137 += src/ejs.web/Router.es
+DEPS_137 += src/ejs.web/Script.es
+DEPS_137 += src/ejs.web/Session.es
+DEPS_137 += src/ejs.web/ShowExceptions.es
+DEPS_137 += src/ejs.web/Static.es
+DEPS_137 += src/ejs.web/Template.es
+DEPS_137 += src/ejs.web/UploadFile.es
+DEPS_137 += src/ejs.web/UrlMap.es
+DEPS_137 += src/ejs.web/Utils.es
+DEPS_137 += src/ejs.web/View.es
+DEPS_137 += $(BUILD)/bin/ejsc
+DEPS_137 += $(BUILD)/bin/ejsmod
+DEPS_137 += $(BUILD)/bin/ejs.mod
 
-$(BUILD)/bin/ejs.web.mod: $(DEPS_136)
+$(BUILD)/bin/ejs.web.mod: $(DEPS_137)
 	( \
 	cd src/ejs.web; \
 	echo '   [Compile] ejs.web.mod' ; \
@@ -1875,11 +1888,11 @@ $(BUILD)/bin/ejs.web.mod: $(DEPS_136)
 #
 #   ejs.template.mod
 #
-DEPS_137 += src/ejs.template/TemplateParser.es
-DEPS_137 += $(BUILD)/bin/ejsc
-DEPS_137 += $(BUILD)/bin/ejs.mod
+DEPS_138 += src/ejs.template/TemplateParser.es
+DEPS_138 += $(BUILD)/bin/ejsc
+DEPS_138 += $(BUILD)/bin/ejs.mod
 
-$(BUILD)/bin/ejs.template.mod: $(DEPS_137)
+$(BUILD)/bin/ejs.template.mod: $(DEPS_138)
 	( \
 	cd src/ejs.template; \
 	echo '   [Compile] ejs.template.mod' ; \
@@ -1889,11 +1902,11 @@ $(BUILD)/bin/ejs.template.mod: $(DEPS_137)
 #
 #   ejs.unix.mod
 #
-DEPS_138 += src/ejs.unix/Unix.es
-DEPS_138 += $(BUILD)/bin/ejsc
-DEPS_138 += $(BUILD)/bin/ejs.mod
+DEPS_139 += src/ejs.unix/Unix.es
+DEPS_139 += $(BUILD)/bin/ejsc
+DEPS_139 += $(BUILD)/bin/ejs.mod
 
-$(BUILD)/bin/ejs.unix.mod: $(DEPS_138)
+$(BUILD)/bin/ejs.unix.mod: $(DEPS_139)
 	( \
 	cd src/ejs.unix; \
 	echo '   [Compile] ejs.unix.mod' ; \
@@ -1903,14 +1916,14 @@ $(BUILD)/bin/ejs.unix.mod: $(DEPS_138)
 #
 #   ejs.mvc.mod
 #
-DEPS_139 += src/ejs.mvc/mvc.es
-DEPS_139 += $(BUILD)/bin/ejsc
-DEPS_139 += $(BUILD)/bin/ejs.mod
-DEPS_139 += $(BUILD)/bin/ejs.web.mod
-DEPS_139 += $(BUILD)/bin/ejs.template.mod
-DEPS_139 += $(BUILD)/bin/ejs.unix.mod
+DEPS_140 += src/ejs.mvc/mvc.es
+DEPS_140 += $(BUILD)/bin/ejsc
+DEPS_140 += $(BUILD)/bin/ejs.mod
+DEPS_140 += $(BUILD)/bin/ejs.web.mod
+DEPS_140 += $(BUILD)/bin/ejs.template.mod
+DEPS_140 += $(BUILD)/bin/ejs.unix.mod
 
-$(BUILD)/bin/ejs.mvc.mod: $(DEPS_139)
+$(BUILD)/bin/ejs.mvc.mod: $(DEPS_140)
 	( \
 	cd src/ejs.mvc; \
 	echo '   [Compile] ejs.mvc.mod' ; \
@@ -1921,10 +1934,10 @@ ifeq ($(ME_COM_ZLIB),1)
 #
 #   libzlib
 #
-DEPS_140 += $(BUILD)/inc/zlib.h
-DEPS_140 += $(BUILD)/obj/zlib.o
+DEPS_141 += $(BUILD)/inc/zlib.h
+DEPS_141 += $(BUILD)/obj/zlib.o
 
-$(BUILD)/bin/libzlib.a: $(DEPS_140)
+$(BUILD)/bin/libzlib.a: $(DEPS_141)
 	@echo '      [Link] $(BUILD)/bin/libzlib.a'
 	ar -cr $(BUILD)/bin/libzlib.a "$(BUILD)/obj/zlib.o"
 endif
@@ -1932,26 +1945,26 @@ endif
 #
 #   libejs.zlib
 #
-DEPS_141 += $(BUILD)/bin/libejs.a
-DEPS_141 += $(BUILD)/bin/ejs.mod
+DEPS_142 += $(BUILD)/bin/libejs.a
+DEPS_142 += $(BUILD)/bin/ejs.mod
 ifeq ($(ME_COM_ZLIB),1)
-    DEPS_141 += $(BUILD)/bin/libzlib.a
+    DEPS_142 += $(BUILD)/bin/libzlib.a
 endif
-DEPS_141 += $(BUILD)/obj/ejsZlib.o
+DEPS_142 += $(BUILD)/obj/ejsZlib.o
 
-$(BUILD)/bin/libejs.zlib.a: $(DEPS_141)
+$(BUILD)/bin/libejs.zlib.a: $(DEPS_142)
 	@echo '      [Link] $(BUILD)/bin/libejs.zlib.a'
 	ar -cr $(BUILD)/bin/libejs.zlib.a "$(BUILD)/obj/ejsZlib.o"
 
 #
 #   ejs.zlib.mod
 #
-DEPS_142 += src/ejs.zlib/Zlib.es
-DEPS_142 += $(BUILD)/bin/ejsc
-DEPS_142 += $(BUILD)/bin/ejs.mod
-DEPS_142 += $(BUILD)/bin/libejs.zlib.a
+DEPS_143 += src/ejs.zlib/Zlib.es
+DEPS_143 += $(BUILD)/bin/ejsc
+DEPS_143 += $(BUILD)/bin/ejs.mod
+DEPS_143 += $(BUILD)/bin/libejs.zlib.a
 
-$(BUILD)/bin/ejs.zlib.mod: $(DEPS_142)
+$(BUILD)/bin/ejs.zlib.mod: $(DEPS_143)
 	( \
 	cd src/ejs.zlib; \
 	echo '   [Compile] ejs.zlib.mod' ; \
@@ -1961,13 +1974,13 @@ $(BUILD)/bin/ejs.zlib.mod: $(DEPS_142)
 #
 #   ejs.tar.mod
 #
-DEPS_143 += src/ejs.tar/Tar.es
-DEPS_143 += $(BUILD)/bin/ejsc
-DEPS_143 += $(BUILD)/bin/ejs.mod
-DEPS_143 += $(BUILD)/bin/ejs.zlib.mod
-DEPS_143 += $(BUILD)/bin/libejs.zlib.a
+DEPS_144 += src/ejs.tar/Tar.es
+DEPS_144 += $(BUILD)/bin/ejsc
+DEPS_144 += $(BUILD)/bin/ejs.mod
+DEPS_144 += $(BUILD)/bin/ejs.zlib.mod
+DEPS_144 += $(BUILD)/bin/libejs.zlib.a
 
-$(BUILD)/bin/ejs.tar.mod: $(DEPS_143)
+$(BUILD)/bin/ejs.tar.mod: $(DEPS_144)
 	( \
 	cd src/ejs.tar; \
 	echo '   [Compile] ejs.tar.mod' ; \
@@ -1977,95 +1990,95 @@ $(BUILD)/bin/ejs.tar.mod: $(DEPS_143)
 #
 #   ejsrun
 #
-DEPS_144 += $(BUILD)/bin/libejs.a
-DEPS_144 += $(BUILD)/obj/ejsrun.o
+DEPS_145 += $(BUILD)/bin/libejs.a
+DEPS_145 += $(BUILD)/obj/ejsrun.o
 
 ifeq ($(ME_COM_MBEDTLS),1)
-    LIBS_144 += -lmbedtls
+    LIBS_145 += -lmbedtls
 endif
 ifeq ($(ME_COM_MBEDTLS),1)
-    LIBS_144 += -lmpr-mbedtls
+    LIBS_145 += -lmpr-mbedtls
 endif
 ifeq ($(ME_COM_MBEDTLS),1)
-    LIBS_144 += -lmbedtls
+    LIBS_145 += -lmbedtls
 endif
 ifeq ($(ME_COM_OPENSSL),1)
-    LIBS_144 += -lmpr-openssl
+    LIBS_145 += -lmpr-openssl
 endif
-LIBS_144 += -lmpr
+LIBS_145 += -lmpr
 ifeq ($(ME_COM_MBEDTLS),1)
-    LIBS_144 += -lmpr-mbedtls
+    LIBS_145 += -lmpr-mbedtls
 endif
 ifeq ($(ME_COM_PCRE),1)
-    LIBS_144 += -lpcre
+    LIBS_145 += -lpcre
 endif
 ifeq ($(ME_COM_HTTP),1)
-    LIBS_144 += -lhttp
+    LIBS_145 += -lhttp
 endif
 ifeq ($(ME_COM_PCRE),1)
-    LIBS_144 += -lpcre
+    LIBS_145 += -lpcre
 endif
-LIBS_144 += -lmpr
-LIBS_144 += -lejs
+LIBS_145 += -lmpr
+LIBS_145 += -lejs
 ifeq ($(ME_COM_HTTP),1)
-    LIBS_144 += -lhttp
+    LIBS_145 += -lhttp
 endif
 
-$(BUILD)/bin/ejsrun: $(DEPS_144)
+$(BUILD)/bin/ejsrun: $(DEPS_145)
 	@echo '      [Link] $(BUILD)/bin/ejsrun'
-	$(CC) -o $(BUILD)/bin/ejsrun -arch $(CC_ARCH) $(LDFLAGS) $(LIBPATHS) "$(BUILD)/obj/ejsrun.o" $(LIBPATHS_144) $(LIBS_144) $(LIBS_144) $(LIBS) -lpam 
+	$(CC) -o $(BUILD)/bin/ejsrun -arch $(CC_ARCH) $(LDFLAGS) $(LIBPATHS) "$(BUILD)/obj/ejsrun.o" $(LIBPATHS_145) $(LIBS_145) $(LIBS_145) $(LIBS) -lpam 
 
 ifeq ($(ME_COM_HTTP),1)
 #
 #   httpcmd
 #
-DEPS_145 += $(BUILD)/bin/libhttp.a
-DEPS_145 += $(BUILD)/obj/http.o
+DEPS_146 += $(BUILD)/bin/libhttp.a
+DEPS_146 += $(BUILD)/obj/http.o
 
 ifeq ($(ME_COM_MBEDTLS),1)
-    LIBS_145 += -lmbedtls
+    LIBS_146 += -lmbedtls
 endif
 ifeq ($(ME_COM_MBEDTLS),1)
-    LIBS_145 += -lmpr-mbedtls
+    LIBS_146 += -lmpr-mbedtls
 endif
 ifeq ($(ME_COM_MBEDTLS),1)
-    LIBS_145 += -lmbedtls
+    LIBS_146 += -lmbedtls
 endif
 ifeq ($(ME_COM_OPENSSL),1)
-    LIBS_145 += -lmpr-openssl
+    LIBS_146 += -lmpr-openssl
 endif
-LIBS_145 += -lmpr
+LIBS_146 += -lmpr
 ifeq ($(ME_COM_MBEDTLS),1)
-    LIBS_145 += -lmpr-mbedtls
+    LIBS_146 += -lmpr-mbedtls
 endif
 ifeq ($(ME_COM_PCRE),1)
-    LIBS_145 += -lpcre
+    LIBS_146 += -lpcre
 endif
-LIBS_145 += -lhttp
+LIBS_146 += -lhttp
 ifeq ($(ME_COM_PCRE),1)
-    LIBS_145 += -lpcre
+    LIBS_146 += -lpcre
 endif
-LIBS_145 += -lmpr
+LIBS_146 += -lmpr
 
-$(BUILD)/bin/http: $(DEPS_145)
+$(BUILD)/bin/http: $(DEPS_146)
 	@echo '      [Link] $(BUILD)/bin/http'
-	$(CC) -o $(BUILD)/bin/http -arch $(CC_ARCH) $(LDFLAGS) $(LIBPATHS) "$(BUILD)/obj/http.o" $(LIBPATHS_145) $(LIBS_145) $(LIBS_145) $(LIBS) 
+	$(CC) -o $(BUILD)/bin/http -arch $(CC_ARCH) $(LDFLAGS) $(LIBPATHS) "$(BUILD)/obj/http.o" $(LIBPATHS_146) $(LIBS_146) $(LIBS_146) $(LIBS) 
 endif
 
 #
 #   install-certs
 #
-DEPS_146 += src/certs/samples/ca.crt
-DEPS_146 += src/certs/samples/ca.key
-DEPS_146 += src/certs/samples/ec.crt
-DEPS_146 += src/certs/samples/ec.key
-DEPS_146 += src/certs/samples/roots.crt
-DEPS_146 += src/certs/samples/self.crt
-DEPS_146 += src/certs/samples/self.key
-DEPS_146 += src/certs/samples/test.crt
-DEPS_146 += src/certs/samples/test.key
-
-$(BUILD)/.install-certs-modified: $(DEPS_146)
+DEPS_147 += src/certs/samples/ca.crt
+DEPS_147 += src/certs/samples/ca.key
+DEPS_147 += src/certs/samples/ec.crt
+DEPS_147 += src/certs/samples/ec.key
+DEPS_147 += src/certs/samples/roots.crt
+DEPS_147 += src/certs/samples/self.crt
+DEPS_147 += src/certs/samples/self.key
+DEPS_147 += src/certs/samples/test.crt
+DEPS_147 += src/certs/samples/test.key
+
+$(BUILD)/.install-certs-modified: $(DEPS_147)
 	@echo '      [Copy] $(BUILD)/bin'
 	mkdir -p "$(BUILD)/bin"
 	cp src/certs/samples/ca.crt $(BUILD)/bin/ca.crt
@@ -2083,10 +2096,10 @@ ifeq ($(ME_COM_SQLITE),1)
 #
 #   libsql
 #
-DEPS_147 += $(BUILD)/inc/sqlite3.h
-DEPS_147 += $(BUILD)/obj/sqlite3.o
+DEPS_148 += $(BUILD)/inc/sqlite3.h
+DEPS_148 += $(BUILD)/obj/sqlite3.o
 
-$(BUILD)/bin/libsql.a: $(DEPS_147)
+$(BUILD)/bin/libsql.a: $(DEPS_148)
 	@echo '      [Link] $(BUILD)/bin/libsql.a'
 	ar -cr $(BUILD)/bin/libsql.a "$(BUILD)/obj/sqlite3.o"
 endif
@@ -2094,40 +2107,40 @@ endif
 #
 #   libejs.db.sqlite
 #
-DEPS_148 += $(BUILD)/bin/libmpr.a
-DEPS_148 += $(BUILD)/bin/libejs.a
-DEPS_148 += $(BUILD)/bin/ejs.mod
-DEPS_148 += $(BUILD)/bin/ejs.db.sqlite.mod
+DEPS_149 += $(BUILD)/bin/libmpr.a
+DEPS_149 += $(BUILD)/bin/libejs.a
+DEPS_149 += $(BUILD)/bin/ejs.mod
+DEPS_149 += $(BUILD)/bin/ejs.db.sqlite.mod
 ifeq ($(ME_COM_SQLITE),1)
-    DEPS_148 += $(BUILD)/bin/libsql.a
+    DEPS_149 += $(BUILD)/bin/libsql.a
 endif
-DEPS_148 += $(BUILD)/obj/ejsSqlite.o
+DEPS_149 += $(BUILD)/obj/ejsSqlite.o
 
-$(BUILD)/bin/libejs.db.sqlite.a: $(DEPS_148)
+$(BUILD)/bin/libejs.db.sqlite.a: $(DEPS_149)
 	@echo '      [Link] $(BUILD)/bin/libejs.db.sqlite.a'
 	ar -cr $(BUILD)/bin/libejs.db.sqlite.a "$(BUILD)/obj/ejsSqlite.o"
 
 #
 #   libejs.web
 #
-DEPS_149 += $(BUILD)/bin/libejs.a
-DEPS_149 += $(BUILD)/bin/ejs.mod
-DEPS_149 += $(BUILD)/inc/ejsWeb.h
-DEPS_149 += $(BUILD)/obj/ejsHttpServer.o
-DEPS_149 += $(BUILD)/obj/ejsRequest.o
-DEPS_149 += $(BUILD)/obj/ejsSession.o
-DEPS_149 += $(BUILD)/obj/ejsWeb.o
+DEPS_150 += $(BUILD)/bin/libejs.a
+DEPS_150 += $(BUILD)/bin/ejs.mod
+DEPS_150 += $(BUILD)/inc/ejsWeb.h
+DEPS_150 += $(BUILD)/obj/ejsHttpServer.o
+DEPS_150 += $(BUILD)/obj/ejsRequest.o
+DEPS_150 += $(BUILD)/obj/ejsSession.o
+DEPS_150 += $(BUILD)/obj/ejsWeb.o
 
-$(BUILD)/bin/libejs.web.a: $(DEPS_149)
+$(BUILD)/bin/libejs.web.a: $(DEPS_150)
 	@echo '      [Link] $(BUILD)/bin/libejs.web.a'
 	ar -cr $(BUILD)/bin/libejs.web.a "$(BUILD)/obj/ejsHttpServer.o" "$(BUILD)/obj/ejsRequest.o" "$(BUILD)/obj/ejsSession.o" "$(BUILD)/obj/ejsWeb.o"
 
 #
 #   mvc.es
 #
-DEPS_150 += src/ejs.mvc/mvc.es
+DEPS_151 += src/ejs.mvc/mvc.es
 
-$(BUILD)/bin/mvc.es: $(DEPS_150)
+$(BUILD)/bin/mvc.es: $(DEPS_151)
 	@echo '      [Copy] $(BUILD)/bin/mvc.es'
 	mkdir -p "$(BUILD)/bin"
 	cp src/ejs.mvc/mvc.es $(BUILD)/bin/mvc.es
@@ -2135,51 +2148,51 @@ $(BUILD)/bin/mvc.es: $(DEPS_150)
 #
 #   mvc
 #
-DEPS_151 += $(BUILD)/bin/libejs.a
-DEPS_151 += $(BUILD)/bin/mvc.es
-DEPS_151 += $(BUILD)/obj/ejsrun.o
+DEPS_152 += $(BUILD)/bin/libejs.a
+DEPS_152 += $(BUILD)/bin/mvc.es
+DEPS_152 += $(BUILD)/obj/ejsrun.o
 
 ifeq ($(ME_COM_MBEDTLS),1)
-    LIBS_151 += -lmbedtls
+    LIBS_152 += -lmbedtls
 endif
 ifeq ($(ME_COM_MBEDTLS),1)
-    LIBS_151 += -lmpr-mbedtls
+    LIBS_152 += -lmpr-mbedtls
 endif
 ifeq ($(ME_COM_MBEDTLS),1)
-    LIBS_151 += -lmbedtls
+    LIBS_152 += -lmbedtls
 endif
 ifeq ($(ME_COM_OPENSSL),1)
-    LIBS_151 += -lmpr-openssl
+    LIBS_152 += -lmpr-openssl
 endif
-LIBS_151 += -lmpr
+LIBS_152 += -lmpr
 ifeq ($(ME_COM_MBEDTLS),1)
-    LIBS_151 += -lmpr-mbedtls
+    LIBS_152 += -lmpr-mbedtls
 endif
 ifeq ($(ME_COM_PCRE),1)
-    LIBS_151 += -lpcre
+    LIBS_152 += -lpcre
 endif
 ifeq ($(ME_COM_HTTP),1)
-    LIBS_151 += -lhttp
+    LIBS_152 += -lhttp
 endif
 ifeq ($(ME_COM_PCRE),1)
-    LIBS_151 += -lpcre
+    LIBS_152 += -lpcre
 endif
-LIBS_151 += -lmpr
-LIBS_151 += -lejs
+LIBS_152 += -lmpr
+LIBS_152 += -lejs
 ifeq ($(ME_COM_HTTP),1)
-    LIBS_151 += -lhttp
+    LIBS_152 += -lhttp
 endif
 
-$(BUILD)/bin/mvc: $(DEPS_151)
+$(BUILD)/bin/mvc: $(DEPS_152)
 	@echo '      [Link] $(BUILD)/bin/mvc'
-	$(CC) -o $(BUILD)/bin/mvc -arch $(CC_ARCH) $(LDFLAGS) $(LIBPATHS) "$(BUILD)/obj/ejsrun.o" $(LIBPATHS_151) $(LIBS_151) $(LIBS_151) $(LIBS) -lpam 
+	$(CC) -o $(BUILD)/bin/mvc -arch $(CC_ARCH) $(LDFLAGS) $(LIBPATHS) "$(BUILD)/obj/ejsrun.o" $(LIBPATHS_152) $(LIBS_152) $(LIBS_152) $(LIBS) -lpam 
 
 #
 #   utest.es
 #
-DEPS_152 += src/ejs.utest/utest.es
+DEPS_153 += src/ejs.utest/utest.es
 
-$(BUILD)/bin/utest.es: $(DEPS_152)
+$(BUILD)/bin/utest.es: $(DEPS_153)
 	@echo '      [Copy] $(BUILD)/bin/utest.es'
 	mkdir -p "$(BUILD)/bin"
 	cp src/ejs.utest/utest.es $(BUILD)/bin/utest.es
@@ -2187,9 +2200,9 @@ $(BUILD)/bin/utest.es: $(DEPS_152)
 #
 #   utest.worker
 #
-DEPS_153 += src/ejs.utest/utest.worker
+DEPS_154 += src/ejs.utest/utest.worker
 
-$(BUILD)/bin/utest.worker: $(DEPS_153)
+$(BUILD)/bin/utest.worker: $(DEPS_154)
 	@echo '      [Copy] $(BUILD)/bin/utest.worker'
 	mkdir -p "$(BUILD)/bin"
 	cp src/ejs.utest/utest.worker $(BUILD)/bin/utest.worker
@@ -2197,105 +2210,105 @@ $(BUILD)/bin/utest.worker: $(DEPS_153)
 #
 #   utest
 #
-DEPS_154 += $(BUILD)/bin/libejs.a
-DEPS_154 += $(BUILD)/bin/utest.es
-DEPS_154 += $(BUILD)/bin/utest.worker
-DEPS_154 += $(BUILD)/obj/ejsrun.o
+DEPS_155 += $(BUILD)/bin/libejs.a
+DEPS_155 += $(BUILD)/bin/utest.es
+DEPS_155 += $(BUILD)/bin/utest.worker
+DEPS_155 += $(BUILD)/obj/ejsrun.o
 
 ifeq ($(ME_COM_MBEDTLS),1)
-    LIBS_154 += -lmbedtls
+    LIBS_155 += -lmbedtls
 endif
 ifeq ($(ME_COM_MBEDTLS),1)
-    LIBS_154 += -lmpr-mbedtls
+    LIBS_155 += -lmpr-mbedtls
 endif
 ifeq ($(ME_COM_MBEDTLS),1)
-    LIBS_154 += -lmbedtls
+    LIBS_155 += -lmbedtls
 endif
 ifeq ($(ME_COM_OPENSSL),1)
-    LIBS_154 += -lmpr-openssl
+    LIBS_155 += -lmpr-openssl
 endif
-LIBS_154 += -lmpr
+LIBS_155 += -lmpr
 ifeq ($(ME_COM_MBEDTLS),1)
-    LIBS_154 += -lmpr-mbedtls
+    LIBS_155 += -lmpr-mbedtls
 endif
 ifeq ($(ME_COM_PCRE),1)
-    LIBS_154 += -lpcre
+    LIBS_155 += -lpcre
 endif
 ifeq ($(ME_COM_HTTP),1)
-    LIBS_154 += -lhttp
+    LIBS_155 += -lhttp
 endif
 ifeq ($(ME_COM_PCRE),1)
-    LIBS_154 += -lpcre
+    LIBS_155 += -lpcre
 endif
-LIBS_154 += -lmpr
-LIBS_154 += -lejs
+LIBS_155 += -lmpr
+LIBS_155 += -lejs
 ifeq ($(ME_COM_HTTP),1)
-    LIBS_154 += -lhttp
+    LIBS_155 += -lhttp
 endif
 
-$(BUILD)/bin/utest: $(DEPS_154)
+$(BUILD)/bin/utest: $(DEPS_155)
 	@echo '      [Link] $(BUILD)/bin/utest'
-	$(CC) -o $(BUILD)/bin/utest -arch $(CC_ARCH) $(LDFLAGS) $(LIBPATHS) "$(BUILD)/obj/ejsrun.o" $(LIBPATHS_154) $(LIBS_154) $(LIBS_154) $(LIBS) -lpam 
+	$(CC) -o $(BUILD)/bin/utest -arch $(CC_ARCH) $(LDFLAGS) $(LIBPATHS) "$(BUILD)/obj/ejsrun.o" $(LIBPATHS_155) $(LIBS_155) $(LIBS_155) $(LIBS) -lpam 
 
 #
 #   watchdog
 #
-DEPS_155 += $(BUILD)/bin/libmpr.a
-DEPS_155 += $(BUILD)/obj/watchdog.o
+DEPS_156 += $(BUILD)/bin/libmpr.a
+DEPS_156 += $(BUILD)/obj/watchdog.o
 
 ifeq ($(ME_COM_MBEDTLS),1)
-    LIBS_155 += -lmbedtls
+    LIBS_156 += -lmbedtls
 endif
 ifeq ($(ME_COM_MBEDTLS),1)
-    LIBS_155 += -lmpr-mbedtls
+    LIBS_156 += -lmpr-mbedtls
 endif
 ifeq ($(ME_COM_MBEDTLS),1)
-    LIBS_155 += -lmbedtls
+    LIBS_156 += -lmbedtls
 endif
 ifeq ($(ME_COM_OPENSSL),1)
-    LIBS_155 += -lmpr-openssl
+    LIBS_156 += -lmpr-openssl
 endif
-LIBS_155 += -lmpr
+LIBS_156 += -lmpr
 ifeq ($(ME_COM_MBEDTLS),1)
-    LIBS_155 += -lmpr-mbedtls
+    LIBS_156 += -lmpr-mbedtls
 endif
 
-$(BUILD)/bin/ejsman: $(DEPS_155)
+$(BUILD)/bin/ejsman: $(DEPS_156)
 	@echo '      [Link] $(BUILD)/bin/ejsman'
-	$(CC) -o $(BUILD)/bin/ejsman -arch $(CC_ARCH) $(LDFLAGS) $(LIBPATHS) "$(BUILD)/obj/watchdog.o" $(LIBPATHS_155) $(LIBS_155) $(LIBS_155) $(LIBS) 
+	$(CC) -o $(BUILD)/bin/ejsman -arch $(CC_ARCH) $(LDFLAGS) $(LIBPATHS) "$(BUILD)/obj/watchdog.o" $(LIBPATHS_156) $(LIBS_156) $(LIBS_156) $(LIBS) 
 
 #
 #   www
 #
-DEPS_156 += src/ejs.web/www/images/banner.jpg
-DEPS_156 += src/ejs.web/www/images/favicon.ico
-DEPS_156 += src/ejs.web/www/images/splash.jpg
-DEPS_156 += src/ejs.web/www/js/jquery.ejs.min.js
-DEPS_156 += src/ejs.web/www/js/jquery.min.js
-DEPS_156 += src/ejs.web/www/js/jquery.simplemodal.min.js
-DEPS_156 += src/ejs.web/www/js/jquery.tablesorter.js
-DEPS_156 += src/ejs.web/www/js/jquery.tablesorter.min.js
-DEPS_156 += src/ejs.web/www/js/jquery.treeview.min.js
-DEPS_156 += src/ejs.web/www/js/tree-images/file.gif
-DEPS_156 += src/ejs.web/www/js/tree-images/folder-closed.gif
-DEPS_156 += src/ejs.web/www/js/tree-images/folder.gif
-DEPS_156 += src/ejs.web/www/js/tree-images/minus.gif
-DEPS_156 += src/ejs.web/www/js/tree-images/plus.gif
-DEPS_156 += src/ejs.web/www/js/tree-images/treeview-black-line.gif
-DEPS_156 += src/ejs.web/www/js/tree-images/treeview-black.gif
-DEPS_156 += src/ejs.web/www/js/tree-images/treeview-default-line.gif
-DEPS_156 += src/ejs.web/www/js/tree-images/treeview-default.gif
-DEPS_156 += src/ejs.web/www/js/tree-images/treeview-famfamfam-line.gif
-DEPS_156 += src/ejs.web/www/js/tree-images/treeview-famfamfam.gif
-DEPS_156 += src/ejs.web/www/js/tree-images/treeview-gray-line.gif
-DEPS_156 += src/ejs.web/www/js/tree-images/treeview-gray.gif
-DEPS_156 += src/ejs.web/www/js/tree-images/treeview-red-line.gif
-DEPS_156 += src/ejs.web/www/js/tree-images/treeview-red.gif
-DEPS_156 += src/ejs.web/www/js/treeview.css
-DEPS_156 += src/ejs.web/www/layout.css
-DEPS_156 += src/ejs.web/www/themes/default.css
-
-$(BUILD)/bin/www: $(DEPS_156)
+DEPS_157 += src/ejs.web/www/images/banner.jpg
+DEPS_157 += src/ejs.web/www/images/favicon.ico
+DEPS_157 += src/ejs.web/www/images/splash.jpg
+DEPS_157 += src/ejs.web/www/js/jquery.ejs.min.js
+DEPS_157 += src/ejs.web/www/js/jquery.min.js
+DEPS_157 += src/ejs.web/www/js/jquery.simplemodal.min.js
+DEPS_157 += src/ejs.web/www/js/jquery.tablesorter.js
+DEPS_157 += src/ejs.web/www/js/jquery.tablesorter.min.js
+DEPS_157 += src/ejs.web/www/js/jquery.treeview.min.js
+DEPS_157 += src/ejs.web/www/js/tree-images/file.gif
+DEPS_157 += src/ejs.web/www/js/tree-images/folder-closed.gif
+DEPS_157 += src/ejs.web/www/js/tree-images/folder.gif
+DEPS_157 += src/ejs.web/www/js/tree-images/minus.gif
+DEPS_157 += src/ejs.web/www/js/tree-images/plus.gif
+DEPS_157 += src/ejs.web/www/js/tree-images/treeview-black-line.gif
+DEPS_157 += src/ejs.web/www/js/tree-images/treeview-black.gif
+DEPS_157 += src/ejs.web/www/js/tree-images/treeview-default-line.gif
+DEPS_157 += src/ejs.web/www/js/tree-images/treeview-default.gif
+DEPS_157 += src/ejs.web/www/js/tree-images/treeview-famfamfam-line.gif
+DEPS_157 += src/ejs.web/www/js/tree-images/treeview-famfamfam.gif
+DEPS_157 += src/ejs.web/www/js/tree-images/treeview-gray-line.gif
+DEPS_157 += src/ejs.web/www/js/tree-images/treeview-gray.gif
+DEPS_157 += src/ejs.web/www/js/tree-images/treeview-red-line.gif
+DEPS_157 += src/ejs.web/www/js/tree-images/treeview-red.gif
+DEPS_157 += src/ejs.web/www/js/treeview.css
+DEPS_157 += src/ejs.web/www/layout.css
+DEPS_157 += src/ejs.web/www/themes/default.css
+
+$(BUILD)/bin/www: $(DEPS_157)
 	@echo '      [Copy] $(BUILD)/bin/www'
 	mkdir -p "$(BUILD)/bin/www/images"
 	cp src/ejs.web/www/images/banner.jpg $(BUILD)/bin/www/images/banner.jpg
@@ -2334,7 +2347,7 @@ $(BUILD)/bin/www: $(DEPS_156)
 #   installPrep
 #
 
-installPrep: $(DEPS_157)
+installPrep: $(DEPS_158)
 	if [ "`id -u`" != 0 ] ; \
 	then echo "Must run as root. Rerun with "sudo"" ; \
 	exit 255 ; \
@@ -2344,13 +2357,13 @@ installPrep: $(DEPS_157)
 #   stop
 #
 
-stop: $(DEPS_158)
+stop: $(DEPS_159)
 
 #
 #   installBinary
 #
 
-installBinary: $(DEPS_159)
+installBinary: $(DEPS_160)
 	mkdir -p "$(ME_APP_PREFIX)" ; \
 	rm -f "$(ME_APP_PREFIX)/latest" ; \
 	ln -s "$(VERSION)" "$(ME_APP_PREFIX)/latest" ; \
@@ -2570,24 +2583,24 @@ installBinary: $(DEPS_159)
 #   start
 #
 
-start: $(DEPS_160)
+start: $(DEPS_161)
 
 #
 #   install
 #
-DEPS_161 += installPrep
-DEPS_161 += stop
-DEPS_161 += installBinary
-DEPS_161 += start
+DEPS_162 += installPrep
+DEPS_162 += stop
+DEPS_162 += installBinary
+DEPS_162 += start
 
-install: $(DEPS_161)
+install: $(DEPS_162)
 
 #
 #   uninstall
 #
-DEPS_162 += stop
+DEPS_163 += stop
 
-uninstall: $(DEPS_162)
+uninstall: $(DEPS_163)
 	rm -fr "$(ME_VAPP_PREFIX)" ; \
 	rm -f "$(ME_APP_PREFIX)/latest" ; \
 	rmdir -p "$(ME_APP_PREFIX)" 2>/dev/null ; true
@@ -2596,6 +2609,6 @@ uninstall: $(DEPS_162)
 #   version
 #
 
-version: $(DEPS_163)
+version: $(DEPS_164)
 	echo $(VERSION)
 
@@ -400,13 +400,16 @@ module ejs {
             return false
         }
 
-	//TODO - comparator differ from ECMA
         /**
-            Sort the array. The array is sorted in lexical order. A compare function may be supplied.
+            Sort the array. The array is sorted in lexical order. A compare function may be supplied. The sort is stable
+                so that equal elements retain their relative order.
             @param compare Function to use to compare. A null comparator will use a text compare. The compare signature is:
+                function comparator (a, b): Number
+                The comparison function should return 0 if the items are equal, -1 if the item a is less and should
+                return 1 otherwise. For compatibility, comparators that declare three parameters are invoked as:
                 function comparator (array: Array, index1: Number, index2: Number): Number
-                The comparison function should return 0 if the items are equal, -1 if the item at index1 is less and should
-                return 1 otherwise.
+                where array is a temporary two element array, not the array being sorted, and index1 and index2 
+                are always 0 and 1.
             @param order If order is >= 0, then an ascending lexical order is used. Otherwise descending.
             @return the sorted array reference
             @spec ejs Added the order argument.
@@ -597,8 +597,7 @@ module ejs {
             Sample: "Sat, 16 Dec 2006 08:06:21 GMT"
             @return A string representing the date.
          */
-        function toUTCString(): String 
-            formatUTC("%a, %d %b %Y %T GMT")
+        native function toUTCString(): String 
 
 
         /**
@@ -88,7 +88,11 @@ module ejs {
             toJSON method.  The replace has the following signature:
 
                 function replacer(key: String, value: String): String
+        @option stream Stream If defined, the serialized output is written to the stream (via Stream.write) in chunks as 
+            it is generated rather than being returned as a string. Use this to write large responses directly to a 
+            Request or File. Writes to a blocking stream throttle the serializer.
         @return This function returns a string containing an object literal that can be used to reinstantiate an object.
+            If the stream option is used, this returns an empty string.
         @throws TypeError If the object could not be converted to a string.
         @spec ejs
      */ 
@@ -82,7 +82,7 @@ module ejs {
             @param codeReader Optional function to provide script code to use instead of reading from the path. 
             @return a hash of exported properties
          */
-        public static function load(id: String, path: Path, config = App.config, codeReader: Function? = null): Object {
+        public static function load(id: String, path: Path?, config = App.config, codeReader: Function? = null): Object {
             let initializer, code
             let cache: Path? = cached(id, config)
             if (path) {
@@ -144,7 +144,7 @@ module ejs {
         /** @hide */
         public static function cached(id: Path, config = App.config, cachedir: Path? = null): Path? {
             config ||= App.config
-            if (id && config.cache.app.enable) {
+            if (id && id.length > 0 && config.cache.app.enable) {
                 let dir = cachedir || Path(config.dirs.cache) || Path("cache")
                 if (dir.exists) {
                     return Path(dir).join(md5(id)).joinExt('.mod')
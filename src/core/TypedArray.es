@@ -0,0 +1,227 @@
+/*
+    TypedArray.es -- Int32Array, Float64Array and Uint8Array typed array classes
+
+    Copyright (c) All Rights Reserved. See details at the end of the file.
+ */
+
+module ejs {
+
+    /**
+        Int32Array provides a fixed length array of packed 32-bit signed integers. The elements are stored without boxing
+        in native byte order in a ByteArray $buffer. A typed array may be created with its own buffer or as a view of
+        an existing ByteArray. Several views may share the one buffer. The index operator [] reads and writes elements.
+        Stored values are converted to 32-bit integers, truncating fractions and wrapping out of range values.
+        @spec ejs
+        @stability prototype
+     */
+    final class Int32Array {
+
+        use default namespace public
+
+        /**
+            Size of each element in bytes
+         */
+        static const BYTES_PER_ELEMENT: Number = 4
+
+        /**
+            Create a new typed array.
+            @param source If a Number, the length of a new zero filled array. If an Array or typed array, a new array 
+                is created with a copy of the source elements. If a ByteArray, the typed array will be a view of the 
+                ByteArray storage starting at $byteOffset.
+            @param byteOffset Offset in bytes of the first element when creating a view of a ByteArray. Must be a 
+                multiple of the element size.
+            @param length Number of elements when creating a view. Set to -1 to use the rest of the ByteArray.
+         */
+        native function Int32Array(source: Object = 0, byteOffset: Number = 0, length: Number = -1)
+
+        /**
+            ByteArray storing the elements
+         */
+        native function get buffer(): ByteArray
+
+        /**
+            Offset in bytes of the first element in the $buffer
+         */
+        native function get byteOffset(): Number
+
+        /**
+            Set elements to a value.
+            @param value Value to store
+            @param start Index of the first element to set
+            @param end Index one past the last element to set. Set to -1 for the end of the array.
+            @return This array
+         */
+        native function fill(value: Number, start: Number = 0, end: Number = -1): Int32Array
+
+        /**
+            Iterator for this array to be used by "for (v in array)". This will return array indicies.
+         */
+        override iterator native function get(): Iterator
+
+        /**
+            Iterator for this array to be used by "for each (v in array)". This will return array elements.
+         */
+        override iterator native function getValues(): Iterator
+
+        /**
+            Number of elements in the array
+         */
+        native function get length(): Number
+
+        /**
+            Create a new typed array of the same type with the results of invoking a function on each element.
+            @param mapper Function invoked for each element. The function is called with the signature:
+                function mapper(value: Number, index: Number, array: Int32Array): Number
+            @return A new typed array
+         */
+        native function map(mapper: Function): Int32Array
+
+        /**
+            Copy elements into the array.
+            @param source Array or typed array of values to copy
+            @param offset Index at which to store the first element
+         */
+        native function set(source: Object, offset: Number = 0): Void
+
+        /**
+            Create a view of a range of elements. The view shares the $buffer of this array.
+            @param start Index of the first element
+            @param end Index one past the last element. Set to -1 for the end of the array.
+            @return A new typed array of the same type
+         */
+        native function subarray(start: Number = 0, end: Number = -1): Int32Array
+
+        /**
+            Compute the sum of all elements
+            @return The sum
+         */
+        native function sum(): Number
+
+        /**
+            Convert the array to a string of comma separated element values
+            @return A string
+         */
+        override native function toString(): String
+    }
+
+    /**
+        Float64Array provides a fixed length array of packed 64-bit floating point numbers. The elements are stored without boxing in native byte 
+        order in a ByteArray $buffer. See Int32Array for details.
+        @spec ejs
+        @stability prototype
+     */
+    final class Float64Array {
+
+        use default namespace public
+
+        /** @duplicate Int32Array.BYTES_PER_ELEMENT */
+        static const BYTES_PER_ELEMENT: Number = 8
+
+        /** @duplicate Int32Array.Int32Array */
+        native function Float64Array(source: Object = 0, byteOffset: Number = 0, length: Number = -1)
+
+        /** @duplicate Int32Array.buffer */
+        native function get buffer(): ByteArray
+
+        /** @duplicate Int32Array.byteOffset */
+        native function get byteOffset(): Number
+
+        /** @duplicate Int32Array.fill */
+        native function fill(value: Number, start: Number = 0, end: Number = -1): Float64Array
+
+        /** @duplicate Int32Array.get */
+        override iterator native function get(): Iterator
+
+        /** @duplicate Int32Array.getValues */
+        override iterator native function getValues(): Iterator
+
+        /** @duplicate Int32Array.length */
+        native function get length(): Number
+
+        /** @duplicate Int32Array.map */
+        native function map(mapper: Function): Float64Array
+
+        /** @duplicate Int32Array.set */
+        native function set(source: Object, offset: Number = 0): Void
+
+        /** @duplicate Int32Array.subarray */
+        native function subarray(start: Number = 0, end: Number = -1): Float64Array
+
+        /** @duplicate Int32Array.sum */
+        native function sum(): Number
+
+        /** @duplicate Int32Array.toString */
+        override native function toString(): String
+    }
+
+    /**
+        Uint8Array provides a fixed length array of packed 8-bit unsigned integers. Stored values are truncated and wrapped modulo 256. The elements are stored without boxing in native byte 
+        order in a ByteArray $buffer. See Int32Array for details.
+        @spec ejs
+        @stability prototype
+     */
+    final class Uint8Array {
+
+        use default namespace public
+
+        /** @duplicate Int32Array.BYTES_PER_ELEMENT */
+        static const BYTES_PER_ELEMENT: Number = 1
+
+        /** @duplicate Int32Array.Int32Array */
+        native function Uint8Array(source: Object = 0, byteOffset: Number = 0, length: Number = -1)
+
+        /** @duplicate Int32Array.buffer */
+        native function get buffer(): ByteArray
+
+        /** @duplicate Int32Array.byteOffset */
+        native function get byteOffset(): Number
+
+        /** @duplicate Int32Array.fill */
+        native function fill(value: Number, start: Number = 0, end: Number = -1): Uint8Array
+
+        /** @duplicate Int32Array.get */
+        override iterator native function get(): Iterator
+
+        /** @duplicate Int32Array.getValues */
+        override iterator native function getValues(): Iterator
+
+        /** @duplicate Int32Array.length */
+        native function get length(): Number
+
+        /** @duplicate Int32Array.map */
+        native function map(mapper: Function): Uint8Array
+
+        /** @duplicate Int32Array.set */
+        native function set(source: Object, offset: Number = 0): Void
+
+        /** @duplicate Int32Array.subarray */
+        native function subarray(start: Number = 0, end: Number = -1): Uint8Array
+
+        /** @duplicate Int32Array.sum */
+        native function sum(): Number
+
+        /** @duplicate Int32Array.toString */
+        override native function toString(): String
+    }
+}
+
+
+/*
+    @copy   default
+
+    Copyright (c) Embedthis Software. All Rights Reserved.
+
+    This software is distributed under commercial and open source licenses.
+    You may use the Embedthis Open Source license or you may acquire a 
+    commercial license from Embedthis Software. You agree to be fully bound
+    by the terms of either license. Consult the LICENSE.md distributed with
+    this software for full details and other copyrights.
+
+    Local variables:
+    tab-width: 4
+    c-basic-offset: 4
+    End:
+    vim: sw=4 ts=4 expandtab
+
+    @end
+ */
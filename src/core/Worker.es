@@ -25,7 +25,7 @@ module ejs {
 
         /**
             Callback function to receive incoming messages. This is invoked when postMessage is called in another Worker. 
-            The "this" object is set to the worker object.
+            The "this" object is set to the worker object. The posted message data is available as event.data.
             This is invoked as: function (event) { }
          */
         var onmessage: Function
@@ -133,11 +133,14 @@ module ejs {
         native static function lookup(name: String): Worker
 
         /**
-            Post a message to the Worker's parent
+            Post a message to the Worker's parent. The data is copied to the receiving interpreter and is delivered to 
+            the onmessage callback as the event.data property. Primitive values, Strings, Dates, ByteArrays, Arrays and 
+            Objects are copied directly. Other objects are copied via their toJSON method.
             @param data Data to pass to the worker's onmessage callback.
-            @param ports Not implemented
+            @param transfer Optional array of ByteArray objects to transfer to the receiver without copying. After
+                posting, the transferred byte arrays are empty in the sender.
          */
-        native function postMessage(data: Object, ports: Array? = null): Void
+        native function postMessage(data: Object, transfer: Array? = null): Void
 
         //  TODO - more description?
         /**
@@ -188,10 +191,10 @@ module ejs {
     /**
         Post a message to the Worker's parent. This is only valid inside Worker scripts.
         @param data Data to pass to the worker's onmessage callback.
-        @param ports Not implemented
+        @param transfer Optional array of ByteArray objects to transfer to the receiver without copying.
      */
-    function postMessage(data: Object, ports: Array? = null): Void
-        self.postMessage(data, ports)
+    function postMessage(data: Object, transfer: Array? = null): Void
+        self.postMessage(data, transfer)
 
     /**
         The error callback function.  This is the callback function to receive incoming data from postMessage() calls.
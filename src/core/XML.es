@@ -389,6 +389,103 @@ module ejs {
         override function valueOf(): XML
             this
     }
+
+    /**
+        The XMLReader class reads XML documents incrementally without building an XML object for the whole document.
+        Input is read in fixed size chunks so memory use does not grow with the size of the document. Documents can
+        be read in a pull style by calling $next repeatedly, or in a push style by defining observers via $on and 
+        calling $parse. Selected elements can be expanded into XML objects for convenient access to their content.
+        \n\n
+        Events are objects with a "type" property set to "start", "end", "text" or "comment". Start events have 
+        "name" and "attributes" properties. End events have a "name" property. Text and comment events have a 
+        "value" property. As with the XML class, processing instructions are ignored, white space only text is 
+        discarded and entities are not decoded.
+        @spec ejs
+        @stability prototype
+        @example
+            let reader = new XMLReader(Path("feed.xml"), {select: "item"})
+            reader.on("element", function(event, item) {
+                print(item.title)
+            })
+            reader.parse()
+     */
+    final class XMLReader {
+
+        use default namespace public
+
+        /**
+            Create a streaming XML reader.
+            @param input Source of the XML document. This may be a Stream such as a File, Socket or ByteArray, a Path
+                to a file or a String containing the XML text.
+            @param options Reader options
+            @option chunk Size of input reads in bytes. Defaults to 64K.
+            @option select Element name or array of element names to expand when parsing. Matching elements are 
+                delivered to "element" observers as XML objects instead of as individual events.
+         */
+        native function XMLReader(input: Object, options: Object? = null)
+
+        /**
+            Close the reader. This closes files opened by the reader and issues a "close" event.
+         */
+        native function close(): Void
+
+        /**
+            Number of currently open elements
+         */
+        native function get depth(): Number
+
+        /**
+            Expand the element of the last "start" event into an XML object. This reads the rest of the element 
+            including all its descendants. The next event returned will be the one following the element.
+            @return An XML object for the element
+            @throws StateError if the last event returned was not a "start" event
+            @throws SyntaxError if the element is not well formed
+         */
+        native function expand(): XML
+
+        /**
+            Current line number in the input
+         */
+        native function get lineNumber(): Number
+
+        /**
+            Read the next event from the document.
+            @return The next event object or null when the document has been fully read
+            @throws SyntaxError if the document is not well formed
+         */
+        native function next(): Object?
+
+        /**
+            Remove an observer from the reader.
+            @param name Event name previously used with $on. The name can also be an array of event names.
+            @param observer Observer function previously used with $on.
+         */
+        native function off(name, observer: Function): Void
+
+        /**
+            Add an observer for reader events. 
+            @param name Name of the event to listen for. The name can be an array of event names. The events are 
+                "start", "end", "text", "comment", "element" and "close". 
+            @param observer Callback observer function. The function is called with the following signature:
+                function (event: String, arg: Object): Void. The arg is the event object for start, end, text and 
+                comment events and the XML object for element events.
+            @return The reader
+            @event start Issued for the opening tag of each element that is not selected for expansion.
+            @event end Issued for the closing tag of each element that is not selected for expansion.
+            @event text Issued for element text and CDATA sections.
+            @event comment Issued for comments.
+            @event element Issued with an XML object for each element selected via the "select" option.
+            @event close Issued when the document has been fully read or the reader is closed.
+         */
+        native function on(name, observer: Function): XMLReader
+
+        /**
+            Read the entire document and issue events to observers. Elements selected via the "select" option are 
+            expanded and issued as "element" events. The reader is closed when parsing completes.
+            @throws SyntaxError if the document is not well formed
+         */
+        native function parse(): Void
+    }
 }
 
 
@@ -3,6 +3,7 @@
 
     This module implents the standard Array type. It provides the type methods and manages the special "length" property.
     The array elements with numeric indicies are stored in EjsArray.data[]. Non-numeric properties are stored in EjsArray.obj
+    Arrays of numbers are packed and store a vector of int or double in EjsArray.data. Elements are boxed when read.
 
     Copyright (c) All Rights Reserved. See details at the end of the file.
  */
@@ -25,6 +26,197 @@ static EjsArray *makeIntersection(Ejs *ejs, EjsArray *lhs, EjsArray *rhs);
 static EjsArray *makeUnion(Ejs *ejs, EjsArray *lhs, EjsArray *rhs);
 static EjsObj *setArrayLength(Ejs *ejs, EjsArray *ap, int argc, EjsObj **argv);
 
+/******************************** Packed Elements *****************************/
+/*
+    Packed arrays store numbers unboxed. Arrays start as packed integers and transition to packed doubles and then to
+    object references as required. Transitions only widen the element kind.
+ */
+#define arrayInts(ap)       ((int*) (ap)->data)
+#define arrayDoubles(ap)    ((MprNumber*) (ap)->data)
+#define elementSize(kind)   ((kind) == EJS_ARRAY_INTS ? sizeof(int) : \
+                            ((kind) == EJS_ARRAY_DOUBLES ? sizeof(MprNumber) : sizeof(EjsObj*)))
+#define elementAddress(ap, i) ((char*) (ap)->data + (i) * elementSize((ap)->kind))
+#define PACKED_MAX_INTEGER  1e15        /* Integral doubles up to this magnitude are formatted without exponents */
+
+/*
+    Test if a number can be stored as a packed integer. Negative zero must be stored as a double.
+ */
+static bool isPackedInt(MprNumber n)
+{
+    return n > -2147483649.0 && n < 2147483648.0 && n == (int) n && (n != 0 || 1 / n > 0);
+}
+
+
+/*
+    Return the narrowest element kind that can store a value
+ */
+static int valueKind(Ejs *ejs, EjsAny *value)
+{
+    if (value == 0 || !ejsIs(ejs, value, Number)) {
+        return EJS_ARRAY_OBJECTS;
+    }
+    return isPackedInt(((EjsNumber*) value)->value) ? EJS_ARRAY_INTS : EJS_ARRAY_DOUBLES;
+}
+
+
+/*
+    Return the narrowest element kind that can store both kinds
+ */
+static int widenKind(int kind, int other)
+{
+    if (kind == EJS_ARRAY_OBJECTS || other == EJS_ARRAY_OBJECTS) {
+        return EJS_ARRAY_OBJECTS;
+    }
+    return max(kind, other);
+}
+
+
+/*
+    Return the narrowest element kind that can store all the elements of an array
+ */
+static int arrayKind(Ejs *ejs, EjsArray *ap)
+{
+    int     i, kind;
+
+    if (ap->kind != EJS_ARRAY_OBJECTS) {
+        return ap->kind;
+    }
+    kind = EJS_ARRAY_INTS;
+    for (i = 0; i < ap->length && kind != EJS_ARRAY_OBJECTS; i++) {
+        kind = widenKind(kind, valueKind(ejs, ap->data[i]));
+    }
+    return kind;
+}
+
+
+static EjsAny *getElement(Ejs *ejs, EjsArray *ap, int index)
+{
+    switch (ap->kind) {
+    case EJS_ARRAY_INTS:
+        return ejsCreateNumber(ejs, arrayInts(ap)[index]);
+    case EJS_ARRAY_DOUBLES:
+        return ejsCreateNumber(ejs, arrayDoubles(ap)[index]);
+    default:
+        return ap->data[index];
+    }
+}
+
+
+/*
+    Store an element. The array kind must be able to store the value.
+ */
+static void setElement(EjsArray *ap, int index, EjsAny *value)
+{
+    switch (ap->kind) {
+    case EJS_ARRAY_INTS:
+        arrayInts(ap)[index] = (int) ((EjsNumber*) value)->value;
+        break;
+    case EJS_ARRAY_DOUBLES:
+        arrayDoubles(ap)[index] = ((EjsNumber*) value)->value;
+        break;
+    default:
+        ap->data[index] = value;
+    }
+}
+
+
+/*
+    Copy elements between arrays or within an array. The destination kind must be able to store the source elements.
+ */
+static void copyElements(Ejs *ejs, EjsArray *dest, int to, EjsArray *src, int from, int count)
+{
+    MprNumber   *dp;
+    int         *ip, i;
+
+    if (count <= 0) {
+        return;
+    }
+    if (dest->kind == src->kind) {
+        memmove(elementAddress(dest, to), elementAddress(src, from), count * elementSize(src->kind));
+
+    } else if (dest->kind == EJS_ARRAY_DOUBLES && src->kind == EJS_ARRAY_INTS) {
+        dp = &arrayDoubles(dest)[to];
+        ip = &arrayInts(src)[from];
+        for (i = 0; i < count; i++) {
+            dp[i] = ip[i];
+        }
+    } else {
+        for (i = 0; i < count; i++) {
+            setElement(dest, to + i, getElement(ejs, src, from + i));
+        }
+    }
+}
+
+
+/*
+    Convert the array elements to a new kind
+ */
+static int changeKind(Ejs *ejs, EjsArray *ap, int kind)
+{
+    EjsArray    old;
+    ssize       count;
+    int         i;
+
+    if (ap->kind == kind) {
+        return 0;
+    }
+    if (ap->data == 0) {
+        ap->kind = kind;
+        return 0;
+    }
+    old = *ap;
+    count = mprGetBlockSize(ap->data) / elementSize(ap->kind);
+    if ((ap->data = mprAlloc(count * elementSize(kind))) == 0) {
+        *ap = old;
+        return MPR_ERR_MEMORY;
+    }
+    ap->kind = kind;
+    copyElements(ejs, ap, 0, &old, 0, ap->length);
+    if (kind == EJS_ARRAY_OBJECTS) {
+        count = mprGetBlockSize(ap->data) / sizeof(EjsObj*);
+        for (i = ap->length; i < count; i++) {
+            ap->data[i] = ESV(undefined);
+        }
+    }
+    return 0;
+}
+
+
+/*
+    Widen the array kind if required to store the elements of another array
+ */
+static int widenArray(Ejs *ejs, EjsArray *ap, EjsArray *src)
+{
+    if (ap->kind == EJS_ARRAY_OBJECTS) {
+        return 0;
+    }
+    return changeKind(ejs, ap, widenKind(ap->kind, arrayKind(ejs, src)));
+}
+
+
+/*
+    Create an empty array of the given kind with room for size elements
+ */
+static EjsArray *createPackedArray(Ejs *ejs, int kind, int size)
+{
+    EjsArray    *ap;
+
+    if ((ap = ejsCreateArray(ejs, 0)) != 0) {
+        ap->kind = kind;
+        if (size > 0 && growArray(ejs, ap, size) < 0) {
+            ejsThrowMemoryError(ejs);
+            return 0;
+        }
+    }
+    return ap;
+}
+
+
+PUBLIC int ejsUnpackArray(Ejs *ejs, EjsArray *ap)
+{
+    return changeKind(ejs, ap, EJS_ARRAY_OBJECTS);
+}
+
 /******************************************************************************/
 /*
     Create a new array
@@ -37,6 +229,7 @@ static EjsArray *createArray(Ejs *ejs, EjsType *type, int numProp)
         return 0;
     }
     ap->length = 0;
+    ap->kind = EJS_ARRAY_INTS;
 #if FUTURE
     /*
         Clear isObject because we must NOT use direct slot access in the VM
@@ -79,6 +272,7 @@ PUBLIC EjsArray *ejsCloneArray(Ejs *ejs, EjsArray *ap, bool deep)
         ejsThrowMemoryError(ejs);
         return 0;
     }
+    newArray->kind = ap->kind;
     if (ap->length > 0) {
         if (growArray(ejs, newArray, ap->length) < 0) {
             ejsThrowMemoryError(ejs);
@@ -86,7 +280,9 @@ PUBLIC EjsArray *ejsCloneArray(Ejs *ejs, EjsArray *ap, bool deep)
         }
         src = ap->data;
         dest = newArray->data;
-        if (deep) {
+        if (ap->kind != EJS_ARRAY_OBJECTS) {
+            copyElements(ejs, newArray, 0, ap, 0, ap->length);
+        } else if (deep) {
             for (i = 0; i < ap->length; i++) {
                 dest[i] = ejsClone(ejs, src[i], deep);
             }
@@ -146,7 +342,7 @@ static EjsObj *getArrayProperty(Ejs *ejs, EjsArray *ap, int slotNum)
     if (slotNum < 0 || slotNum >= ap->length) {
         return ESV(undefined);
     }
-    return ap->data[slotNum];
+    return getElement(ejs, ap, slotNum);
 }
 
 
@@ -295,7 +491,7 @@ static EjsAny *invokeArrayOperator(Ejs *ejs, EjsAny *lhs, int opcode, EjsAny *rh
         Operator overload
      */
     case EJS_OP_ADD:
-        result = ejsCreateArray(ejs, 0);
+        result = createPackedArray(ejs, EJS_ARRAY_INTS, 0);
         pushArray(ejs, result, 1, &lhs);
         pushArray(ejs, result, 1, &rhs);
         return result;
@@ -322,14 +518,24 @@ static EjsAny *invokeArrayOperator(Ejs *ejs, EjsAny *lhs, int opcode, EjsAny *rh
 
 /*
     Create or update an array elements. If slotNum is < 0, then create the next free array slot. If slotNum is greater
-    than the array length, grow the array.
+    than the array length, grow the array. Packed arrays are widened if the value does not fit or if the update would
+    leave holes.
  */
 static int setArrayProperty(Ejs *ejs, EjsArray *ap, int slotNum, EjsAny *value)
 {
+    int     kind;
+
+    if (ap->kind != EJS_ARRAY_OBJECTS) {
+        kind = (slotNum <= ap->length) ? valueKind(ejs, value) : EJS_ARRAY_OBJECTS;
+        if (changeKind(ejs, ap, widenKind(ap->kind, kind)) < 0) {
+            ejsThrowMemoryError(ejs);
+            return EJS_ERR;
+        }
+    }
     if ((slotNum = checkSlot(ejs, ap, slotNum)) < 0) {
         return EJS_ERR;
     }
-    ap->data[slotNum] = value;
+    setElement(ap, slotNum, value);
     return slotNum;
 }
 
@@ -359,99 +565,175 @@ static int setArrayPropertyByName(Ejs *ejs, EjsArray *ap, EjsName qname, EjsObj
             return (ejs->service->potHelpers.setProperty)(ejs, ap, slotNum, value);
         }
     }
-    if ((slotNum = checkSlot(ejs, ap, ejsAtoi(ejs, qname.name, 10))) < 0) {
-        return EJS_ERR;
+    return setArrayProperty(ejs, ap, ejsAtoi(ejs, qname.name, 10), value);
+}
+
+
+/*
+    Transient hash set of array elements. Elements are hashed consistently with compareArrayElement: strings are
+    interned and hash by reference, numbers and paths hash by value and other objects hash by reference.
+ */
+typedef struct ElementSet {
+    EjsAny      **slots;                /* Open addressed table of elements. Null slots are empty */
+    int         mask;                   /* Table size - 1. The size is a power of 2 */
+} ElementSet;
+
+
+static uint hashElement(Ejs *ejs, EjsAny *vp)
+{
+    MprNumber   n;
+    uint64      bits;
+
+    if (ejsIs(ejs, vp, Number)) {
+        /* Zero and negative zero are equal as are all NaN values */
+        n = ((EjsNumber*) vp)->value;
+        if (n == 0) {
+            n = 0;
+        } else if (mprIsNan(n)) {
+            return 0;
+        }
+        memcpy(&bits, &n, sizeof(bits));
+    } else if (ejsIs(ejs, vp, Path)) {
+        return shash(((EjsPath*) vp)->value, slen(((EjsPath*) vp)->value));
+    } else {
+        bits = (uint64) PTOI(vp);
     }
-    ap->data[slotNum] = value;
-    return slotNum;
+    bits ^= bits >> 33;
+    bits *= 0xff51afd7ed558ccdULL;
+    bits ^= bits >> 33;
+    return (uint) bits;
 }
 
 
-static EjsArray *makeIntersection(Ejs *ejs, EjsArray *lhs, EjsArray *rhs)
+static int initSet(Ejs *ejs, ElementSet *set, int count)
 {
-    EjsArray    *result;
-    EjsObj      **l, **r, **resultSlots;
-    int         i, j, k;
+    int     size;
 
-    result = ejsCreateArray(ejs, 0);
-    l = lhs->data;
-    r = rhs->data;
+    for (size = 8; size < count * 2; size <<= 1) ;
+    if ((set->slots = mprAllocZeroed(size * sizeof(EjsAny*))) == 0) {
+        ejsThrowMemoryError(ejs);
+        return EJS_ERR;
+    }
+    set->mask = size - 1;
+    return 0;
+}
 
-    for (i = 0; i < lhs->length; i++) {
-        for (j = 0; j < rhs->length; j++) {
-            if (compareArrayElement(ejs, l[i], r[j])) {
-                resultSlots = result->data;
-                for (k = 0; k < result->length; k++) {
-                    if (compareArrayElement(ejs, l[i], resultSlots[k])) {
-                        break;
-                    }
-                }
-                if (result->length == 0 || k == result->length) {
-                    setArrayProperty(ejs, result, -1, l[i]);
-                }
-            }
+
+/*
+    Find an element in the set. Returns a reference to the matching slot or to the empty slot for the element.
+ */
+static EjsAny **findElement(Ejs *ejs, ElementSet *set, EjsAny *vp)
+{
+    EjsAny  **sp;
+    uint    index;
+
+    for (index = hashElement(ejs, vp) & set->mask; ; index = (index + 1) & set->mask) {
+        sp = &set->slots[index];
+        if (*sp == 0 || compareArrayElement(ejs, *sp, vp)) {
+            return sp;
         }
     }
-    return result;
 }
 
 
-static int addUnique(Ejs *ejs, EjsArray *ap, EjsObj *element)
+/*
+    Add an element to the set. Returns true if added or false if already present. The set must have been initialized
+    with a count large enough for all added elements.
+ */
+static bool addElement(Ejs *ejs, ElementSet *set, EjsAny *vp)
+{
+    EjsAny  **sp;
+
+    sp = findElement(ejs, set, vp);
+    if (*sp) {
+        return 0;
+    }
+    *sp = vp;
+    return 1;
+}
+
+
+static int addElements(Ejs *ejs, ElementSet *set, EjsArray *ap)
 {
     int     i;
 
-    for (i = 0; i < ap->length; i++) {
-        if (compareArrayElement(ejs, ap->data[i], element)) {
-            break;
-        }
+    if (initSet(ejs, set, ap->length) < 0) {
+        return EJS_ERR;
     }
-    if (i == ap->length) {
-        if (setArrayProperty(ejs, ap, -1, element) < 0) {
-            return EJS_ERR;
-        }
+    for (i = 0; i < ap->length; i++) {
+        addElement(ejs, set, getElement(ejs, ap, i));
     }
     return 0;
 }
 
 
-static EjsArray *makeUnion(Ejs *ejs, EjsArray *lhs, EjsArray *rhs)
+static EjsArray *makeIntersection(Ejs *ejs, EjsArray *lhs, EjsArray *rhs)
 {
     EjsArray    *result;
-    EjsObj      **l, **r;
+    ElementSet  others, seen;
+    EjsObj      *vp;
     int         i;
 
-    result = ejsCreateArray(ejs, 0);
-    l = lhs->data;
-    r = rhs->data;
-
+    result = createPackedArray(ejs, EJS_ARRAY_INTS, 0);
+    if (addElements(ejs, &others, rhs) < 0 || initSet(ejs, &seen, lhs->length) < 0) {
+        return 0;
+    }
     for (i = 0; i < lhs->length; i++) {
-        addUnique(ejs, result, l[i]);
+        vp = getElement(ejs, lhs, i);
+        if (*findElement(ejs, &others, vp) && addElement(ejs, &seen, vp)) {
+            if (setArrayProperty(ejs, result, -1, vp) < 0) {
+                return 0;
+            }
+        }
+    }
+    return result;
+}
+
+
+static EjsArray *makeUnion(Ejs *ejs, EjsArray *lhs, EjsArray *rhs)
+{
+    EjsArray    *result;
+    ElementSet  seen;
+    EjsObj      *vp;
+    int         i, count;
+
+    result = createPackedArray(ejs, EJS_ARRAY_INTS, 0);
+    count = lhs->length + rhs->length;
+    if (initSet(ejs, &seen, count) < 0) {
+        return 0;
     }
-    for (i = 0; i < rhs->length; i++) {
-        addUnique(ejs, result, r[i]);
+    for (i = 0; i < count; i++) {
+        vp = (i < lhs->length) ? getElement(ejs, lhs, i) : getElement(ejs, rhs, i - lhs->length);
+        if (addElement(ejs, &seen, vp)) {
+            if (setArrayProperty(ejs, result, -1, vp) < 0) {
+                return 0;
+            }
+        }
     }
     return result;
 }
 
 
+/*
+    Remove all elements of lhs that are present in rhs
+ */
 PUBLIC EjsArray *ejsRemoveItems(Ejs *ejs, EjsArray *lhs, EjsArray *rhs)
 {
-    EjsObj  **l, **r;
-    int     i, j, k;
-
-    l = lhs->data;
-    r = rhs->data;
+    ElementSet  others;
+    int         i, j;
 
-    for (j = 0; j < rhs->length; j++) {
-        for (i = 0; i < lhs->length; i++) {
-            if (compareArrayElement(ejs, l[i], r[j])) {
-                for (k = i + 1; k < lhs->length; k++) {
-                    l[k - 1] = l[k];
-                }
-                lhs->length--;
-            }
+    if (lhs->length == 0 || rhs->length == 0) {
+        return lhs;
+    }
+    if (addElements(ejs, &others, rhs) < 0) {
+        return 0;
+    }
+    for (i = j = 0; i < lhs->length; i++) {
+        if (*findElement(ejs, &others, getElement(ejs, lhs, i)) == 0) {
+            copyElements(ejs, lhs, j++, lhs, i, 1);
         }
     }
+    lhs->length = j;
     return lhs;
 }
 
@@ -494,8 +776,8 @@ static int checkSlot(Ejs *ejs, EjsArray *ap, int slotNum)
 static EjsArray *arrayConstructor(Ejs *ejs, EjsArray *ap, int argc, EjsObj **argv)
 {
     EjsArray    *args;
-    EjsObj      *arg0, **src, **dest;
-    int         size, i;
+    EjsObj      *arg0;
+    int         size;
 
     assert(argc == 1 && ejsIs(ejs, argv[0], Array));
 
@@ -511,7 +793,7 @@ static EjsArray *arrayConstructor(Ejs *ejs, EjsArray *ap, int argc, EjsObj **arg
             x = new Array(size);
          */
         size = ejsGetInt(ejs, arg0);
-        if (size > 0 && growArray(ejs, ap, size) < 0) {
+        if (size > 0 && (ejsUnpackArray(ejs, ap) < 0 || growArray(ejs, ap, size) < 0)) {
             ejsThrowMemoryError(ejs);
             return 0;
         }
@@ -521,15 +803,11 @@ static EjsArray *arrayConstructor(Ejs *ejs, EjsArray *ap, int argc, EjsObj **arg
             x = new Array(element0, element1, ..., elementN):
          */
         size = args->length;
-        if (size > 0 && growArray(ejs, ap, size) < 0) {
+        if (widenArray(ejs, ap, args) < 0 || growArray(ejs, ap, size) < 0) {
             ejsThrowMemoryError(ejs);
             return 0;
         }
-        src = args->data;
-        dest = ap->data;
-        for (i = 0; i < size; i++) {
-            dest[i] = src[i];
-        }
+        copyElements(ejs, ap, 0, args, 0, size);
     }
     ap->length = size;
     return ap;
@@ -588,6 +866,10 @@ static EjsArray *compactArray(Ejs *ejs, EjsArray *ap, int argc, EjsObj **argv)
     EjsObj      **data, **src, **dest;
     int         i, oldLen;
 
+    if (ap->kind != EJS_ARRAY_OBJECTS) {
+        /* Packed arrays do not contain null or undefined elements */
+        return ap;
+    }
     data = ap->data;
     src = dest = &data[0];
     for (i = 0; i < ap->length; i++, src++) {
@@ -614,45 +896,49 @@ static EjsArray *compactArray(Ejs *ejs, EjsArray *ap, int argc, EjsObj **argv)
 static EjsArray *concatArray(Ejs *ejs, EjsArray *ap, int argc, EjsObj **argv)
 {
     EjsArray    *args, *newArray, *vpa;
-    EjsObj          *vp, **src, **dest;
-    int         i, k, next;
+    EjsObj      *vp;
+    int         i, kind, next;
 
     assert(argc == 1 && ejsIs(ejs, argv[0], Array));
 
     args = ((EjsArray*) argv[0]);
 
-    newArray = ejsCreateArray(ejs, ap->length);
-    src = ap->data;
-    dest = newArray->data;
-
     /*
-        Copy the original array
+        The result is packed if the original array and all the args are packed
      */
-    for (next = 0; next < ap->length; next++) {
-        dest[next] = src[next];
+    kind = ap->kind;
+    for (i = 0; i < args->length && kind != EJS_ARRAY_OBJECTS; i++) {
+        vp = getElement(ejs, args, i);
+        kind = widenKind(kind, ejsIs(ejs, vp, Array) ? ((EjsArray*) vp)->kind : valueKind(ejs, vp));
     }
+    if ((newArray = createPackedArray(ejs, kind, ap->length)) == 0) {
+        return 0;
+    }
+    /*
+        Copy the original array
+     */
+    copyElements(ejs, newArray, 0, ap, 0, ap->length);
+    next = ap->length;
 
     /*
         Copy the args. If any element is itself an array, then flatten it and copy its elements.
      */
     for (i = 0; i < args->length; i++) {
-        vp = args->data[i];
+        vp = getElement(ejs, args, i);
         if (ejsIs(ejs, vp, Array)) {
             vpa = (EjsArray*) vp;
             if (growArray(ejs, newArray, next + vpa->length) < 0) {
                 ejsThrowMemoryError(ejs);
                 return 0;
             }
-            dest = newArray->data;
-            for (k = 0; k < vpa->length; k++) {
-                dest[next++] = vpa->data[k];
-            }
+            copyElements(ejs, newArray, next, vpa, 0, vpa->length);
+            next += vpa->length;
         } else {
             if (growArray(ejs, newArray, next + 1) < 0) {
                 ejsThrowMemoryError(ejs);
                 return 0;
             }
-            dest[next++] = vp;
+            setElement(newArray, next++, vp);
         }
     }
     return newArray;
@@ -677,6 +963,14 @@ static EjsNumber *nextArrayKey(Ejs *ejs, EjsIterator *ip, int argc, EjsObj **arg
     if (ap->length < ip->length) {
         ip->length = ap->length;
     }
+    if (ap->kind != EJS_ARRAY_OBJECTS) {
+        /* Packed arrays do not have holes */
+        if (ip->index < ip->length) {
+            return ejsCreateNumber(ejs, ip->index++);
+        }
+        ejsThrowStopIteration(ejs);
+        return 0;
+    }
     for (; ip->index < ip->length; ip->index++) {
         vp = data[ip->index];
         assert(vp);
@@ -719,6 +1013,14 @@ static EjsObj *nextArrayValue(Ejs *ejs, EjsIterator *ip, int argc, EjsObj **argv
     if (ap->length < ip->length) {
         ip->length = ap->length;
     }
+    if (ap->kind != EJS_ARRAY_OBJECTS) {
+        /* Packed arrays do not have holes */
+        if (ip->index < ip->length) {
+            return getElement(ejs, ap, ip->index++);
+        }
+        ejsThrowStopIteration(ejs);
+        return 0;
+    }
     for (; ip->index < ip->length; ip->index++) {
         vp = data[ip->index];
         assert(vp);
@@ -797,7 +1099,9 @@ static bool compareArrayElement(Ejs *ejs, EjsObj *v1, EjsObj *v2)
         return 0;
     }
     if (ejsIs(ejs, v1, Number)) {
-        return ((EjsNumber*) v1)->value == ((EjsNumber*) v2)->value;
+        /* NaN matches NaN. Packed arrays create a new NaN value for each access */
+        return ((EjsNumber*) v1)->value == ((EjsNumber*) v2)->value || 
+            (mprIsNan(((EjsNumber*) v1)->value) && mprIsNan(((EjsNumber*) v2)->value));
     }
     if (ejsIs(ejs, v1, String)) {
         return (EjsString*) v1 == (EjsString*) v2;
@@ -810,6 +1114,46 @@ static bool compareArrayElement(Ejs *ejs, EjsObj *v1, EjsObj *v2)
 }
 
 
+/*
+    Search a packed array for a number from start toward end (exclusive) stepping by one in the given direction.
+    NaN matches NaN as it does for boxed elements. Returns the index or -1 if not found.
+ */
+static int findNumber(EjsArray *ap, EjsAny *element, int start, int end, int step)
+{
+    MprNumber   n, *dp;
+    int         *ip, i, value;
+
+    n = ((EjsNumber*) element)->value;
+    if (ap->kind == EJS_ARRAY_INTS) {
+        if (!(n > -2147483649.0 && n < 2147483648.0 && n == (int) n)) {
+            return -1;
+        }
+        value = (int) n;
+        ip = arrayInts(ap);
+        for (i = start; i != end; i += step) {
+            if (ip[i] == value) {
+                return i;
+            }
+        }
+    } else if (mprIsNan(n)) {
+        dp = arrayDoubles(ap);
+        for (i = start; i != end; i += step) {
+            if (mprIsNan(dp[i])) {
+                return i;
+            }
+        }
+    } else {
+        dp = arrayDoubles(ap);
+        for (i = start; i != end; i += step) {
+            if (dp[i] == n) {
+                return i;
+            }
+        }
+    }
+    return -1;
+}
+
+
 /*
     Search for an item using strict equality "===". This call searches from
     the start of the array for the specified element.
@@ -836,6 +1180,12 @@ static EjsNumber *indexOfArray(Ejs *ejs, EjsArray *ap, int argc, EjsObj **argv)
     if (start < 0) {
         start = 0;
     }
+    if (ap->kind != EJS_ARRAY_OBJECTS) {
+        if (!ejsIs(ejs, element, Number)) {
+            return ESV(minusOne);
+        }
+        return ejsCreateNumber(ejs, findNumber(ap, element, start, ap->length, 1));
+    }
     for (i = start; i < ap->length; i++) {
         if (compareArrayElement(ejs, ap->data[i], element)) {
             return ejsCreateNumber(ejs, i);
@@ -854,8 +1204,7 @@ static EjsNumber *indexOfArray(Ejs *ejs, EjsArray *ap, int argc, EjsObj **argv)
 static EjsArray *insertArray(Ejs *ejs, EjsArray *ap, int argc, EjsObj **argv)
 {
     EjsArray    *args;
-    EjsObj          **src, **dest;
-    int         i, pos, delta, endInsert;
+    int         pos, oldLen;
 
     assert(argc == 2 && ejsIs(ejs, argv[1], Array));
 
@@ -870,21 +1219,13 @@ static EjsArray *insertArray(Ejs *ejs, EjsArray *ap, int argc, EjsObj **argv)
         pos = ap->length;
     }
     args = (EjsArray*) argv[1];
+    oldLen = ap->length;
 
-    if (growArray(ejs, ap, ap->length + args->length) < 0) {
+    if (widenArray(ejs, ap, args) < 0 || growArray(ejs, ap, ap->length + args->length) < 0) {
         return 0;
     }
-    delta = args->length;
-    dest = ap->data;
-    src = args->data;
-
-    endInsert = pos + delta;
-    for (i = ap->length - 1; i >= endInsert; i--) {
-        dest[i] = dest[i - delta];
-    }
-    for (i = 0; i < delta; i++) {
-        dest[pos++] = src[i];
-    }
+    copyElements(ejs, ap, pos + args->length, ap, pos, oldLen - pos);
+    copyElements(ejs, ap, pos, args, 0, args->length);
     return ap;
 }
 
@@ -897,6 +1238,41 @@ static EjsArray *insertArray(Ejs *ejs, EjsArray *ap, int argc, EjsObj **argv)
     function join(sep: String = undefined): String
  */
 #if OPTIMIZED || 1
+/*
+    Join a packed array. Integral numbers are formatted directly without creating number or string objects.
+ */
+static EjsString *joinPacked(Ejs *ejs, EjsArray *ap, EjsString *sep)
+{
+    EjsString       *sp;
+    MprBuf          *buf;
+    MprNumber       n;
+    char            *cp, nbuf[32];
+    int             i;
+
+    buf = mprCreateBuf(ap->length * (12 + (sep ? sep->length : 0)) + 1, -1);
+    for (i = 0; i < ap->length; i++) {
+        if (i > 0 && sep) {
+            mprPutBlockToBuf(buf, sep->value, sep->length);
+        }
+        if (ap->kind == EJS_ARRAY_INTS) {
+            cp = itosbuf(nbuf, sizeof(nbuf), arrayInts(ap)[i], 10);
+        } else {
+            n = arrayDoubles(ap)[i];
+            if (n > -PACKED_MAX_INTEGER && n < PACKED_MAX_INTEGER && n == (int64) n) {
+                cp = itosbuf(nbuf, sizeof(nbuf), (int64) n, 10);
+            } else {
+                sp = ejsToString(ejs, ejsCreateNumber(ejs, n));
+                mprPutBlockToBuf(buf, sp->value, sp->length);
+                continue;
+            }
+        }
+        mprPutStringToBuf(buf, cp);
+    }
+    mprAddNullToBuf(buf);
+    return ejsCreateStringFromBytes(ejs, mprGetBufStart(buf), mprGetBufLength(buf));
+}
+
+
 static EjsString *joinArray(Ejs *ejs, EjsArray *ap, int argc, EjsObj **argv)
 {
     EjsString       *sep, *sp;
@@ -905,6 +1281,9 @@ static EjsString *joinArray(Ejs *ejs, EjsArray *ap, int argc, EjsObj **argv)
     int             i, nonString;
 
     sep = (argc == 1) ? (EjsString*) argv[0] : NULL;
+    if (ap->kind != EJS_ARRAY_OBJECTS) {
+        return joinPacked(ejs, ap, sep);
+    }
     if (sep == ESV(empty) && ap->length == 1 && ejsIs(ejs, ap->data[0], String)) {
         /* Optimized path for joining [string]. This happens frequently with fun(...args) */
         return (EjsString*) ap->data[0];
@@ -1002,6 +1381,12 @@ static EjsNumber *lastArrayIndexOf(Ejs *ejs, EjsArray *ap, int argc, EjsObj **ar
     if (start < 0) {
         return ESV(minusOne);
     }
+    if (ap->kind != EJS_ARRAY_OBJECTS) {
+        if (!ejsIs(ejs, element, Number)) {
+            return ESV(minusOne);
+        }
+        return ejsCreateNumber(ejs, findNumber(ap, element, start, -1, -1));
+    }
     for (i = start; i >= 0; i--) {
         if (compareArrayElement(ejs, ap->data[i], element)) {
             return ejsCreateNumber(ejs, i);
@@ -1041,7 +1426,8 @@ static EjsObj *setArrayLength(Ejs *ejs, EjsArray *ap, int argc, EjsObj **argv)
         length = 0;
     }
     if (length > ap->length) {
-        if (growArray(ejs, ap, length) < 0) {
+        /* Growing leaves holes which cannot be stored in packed arrays */
+        if (ejsUnpackArray(ejs, ap) < 0 || growArray(ejs, ap, length) < 0) {
             return 0;
         }
         data = ap->data;
@@ -1065,7 +1451,8 @@ static EjsObj *popArray(Ejs *ejs, EjsArray *ap, int argc, EjsObj **argv)
     if (ap->length == 0) {
         return ESV(undefined);
     }
-    return ap->data[--ap->length];
+    ap->length--;
+    return getElement(ejs, ap, ap->length);
 }
 
 
@@ -1078,21 +1465,16 @@ static EjsObj *popArray(Ejs *ejs, EjsArray *ap, int argc, EjsObj **argv)
 static EjsNumber *pushArray(Ejs *ejs, EjsArray *ap, int argc, EjsAny **argv)
 {
     EjsArray    *args;
-    EjsObj      **src, **dest;
-    int         i, oldLen;
+    int         oldLen;
 
     assert(argc == 1 && ejsIs(ejs, argv[0], Array));
 
     args = (EjsArray*) argv[0];
     oldLen = ap->length;
-    if (growArray(ejs, ap, ap->length + args->length) < 0) {
+    if (widenArray(ejs, ap, args) < 0 || growArray(ejs, ap, ap->length + args->length) < 0) {
         return 0;
     }
-    dest = ap->data;
-    src = args->data;
-    for (i = 0; i < args->length; i++) {
-        dest[i + oldLen] = src[i];
-    }
+    copyElements(ejs, ap, oldLen, args, 0, args->length);
     return ejsCreateNumber(ejs, ap->length);
 }
 
@@ -1117,19 +1499,36 @@ static EjsArray *removeElements(Ejs *ejs, EjsArray *ap, int argc, EjsArray **arg
 static EjsArray *reverseArray(Ejs *ejs, EjsArray *ap, int argc, EjsObj **argv)
 {
     EjsObj      *tmp, **data;
-    int         i, j;
+    MprNumber   dtmp, *dp;
+    int         i, j, itmp, *ip;
 
     if (ap->length <= 1) {
         return ap;
     }
-    data = ap->data;
     i = (ap->length - 2) / 2;
     j = (ap->length + 1) / 2;
 
-    for (; i >= 0; i--, j++) {
-        tmp = data[i];
-        data[i] = data[j];
-        data[j] = tmp;
+    if (ap->kind == EJS_ARRAY_INTS) {
+        ip = arrayInts(ap);
+        for (; i >= 0; i--, j++) {
+            itmp = ip[i];
+            ip[i] = ip[j];
+            ip[j] = itmp;
+        }
+    } else if (ap->kind == EJS_ARRAY_DOUBLES) {
+        dp = arrayDoubles(ap);
+        for (; i >= 0; i--, j++) {
+            dtmp = dp[i];
+            dp[i] = dp[j];
+            dp[j] = dtmp;
+        }
+    } else {
+        data = ap->data;
+        for (; i >= 0; i--, j++) {
+            tmp = data[i];
+            data[i] = data[j];
+            data[j] = tmp;
+        }
     }
     return ap;
 }
@@ -1143,17 +1542,13 @@ static EjsArray *reverseArray(Ejs *ejs, EjsArray *ap, int argc, EjsObj **argv)
  */
 static EjsObj *shiftArray(Ejs *ejs, EjsArray *ap, int argc, EjsObj **argv)
 {
-    EjsObj         *result, **data;
-    int         i;
+    EjsObj      *result;
 
     if (ap->length == 0) {
         return ESV(undefined);
     }
-    data = ap->data;
-    result = data[0];
-    for (i = 1; i < ap->length; i++) {
-        data[i - 1] = data[i];
-    }
+    result = getElement(ejs, ap, 0);
+    copyElements(ejs, ap, 0, ap, 1, ap->length - 1);
     ap->length--;
     return result;
 }
@@ -1167,7 +1562,6 @@ static EjsObj *shiftArray(Ejs *ejs, EjsArray *ap, int argc, EjsObj **argv)
 static EjsArray *sliceArray(Ejs *ejs, EjsArray *ap, int argc, EjsObj **argv)
 {
     EjsArray    *result;
-    EjsObj          **src, **dest;
     int         start, end, step, i, j, len, size;
 
     assert(1 <= argc && argc <= 3);
@@ -1192,7 +1586,7 @@ static EjsArray *sliceArray(Ejs *ejs, EjsArray *ap, int argc, EjsObj **argv)
     if (start < 0) {
         start = 0;
     } else if (start >= ap->length) {
-        start = ap->length;
+        start = (step < 0) ? ap->length - 1 : ap->length;
     }
     if (end < 0) {
         end += ap->length;
@@ -1207,24 +1601,23 @@ static EjsArray *sliceArray(Ejs *ejs, EjsArray *ap, int argc, EjsObj **argv)
     /*
         This may allocate too many elements if abs(step) is > 1, but length will still be correct.
      */
-    result = ejsCreateArray(ejs, size);
-    if (result == 0) {
-        ejsThrowMemoryError(ejs);
+    if ((result = createPackedArray(ejs, ap->kind, size)) == 0) {
         return 0;
     }
-    src = ap->data;
-    dest = result->data;
-
     len = 0;
-    if (step > 0) {
+    if (step == 1) {
+        len = max(end - start, 0);
+        copyElements(ejs, result, 0, ap, start, len);
+
+    } else if (step > 0) {
         for (i = start, j = 0; i < end; i += step, j++) {
-            dest[j] = src[i];
+            copyElements(ejs, result, j, ap, i, 1);
             len++;
         }
 
     } else {
         for (i = start, j = 0; i > end; i += step, j++) {
-            dest[j] = src[i];
+            copyElements(ejs, result, j, ap, i, 1);
             len++;
         }
     }
@@ -1234,84 +1627,320 @@ static EjsArray *sliceArray(Ejs *ejs, EjsArray *ap, int argc, EjsObj **argv)
 
 
 /*
-    Quick sort partition
+    Array sorting. Arrays are sorted using a stable, iterative natural merge sort (TimSort without galloping). Runs of 
+    already ordered elements are detected and merged, so sorted and reversed input is sorted in linear time.
+    Without a comparator, elements are sorted in lexical order. Arrays of integers and arrays of strings are compared 
+    natively. Otherwise, the string key for each element is computed once before sorting.
+ */
+#define SORT_MIN_MERGE      32              /* Runs shorter than this are extended via binary insertion sort */
+#define SORT_MAX_RUNS       85              /* Maximum pending runs. Run lengths grow at least as fast as Fibonacci */
+#define SORT_MAX_INTEGER    1e15            /* Integers up to this magnitude convert to strings without exponents */
+
+#define SORT_STRINGS        1               /* Compare string keys */
+#define SORT_INTEGERS       2               /* Compare integer keys in lexical order */
+#define SORT_ELEMENTS       3               /* Run the comparator with elements: compare(a, b) */
+#define SORT_INDICIES       4               /* Run the comparator with an array and indicies: compare(array, i, j) */
+
+typedef struct SortItem {
+    EjsAny      *value;                     /* Array element */
+    EjsAny      *key;                       /* String key */
+    int64       num;                        /* Integer key */
+} SortItem;
+
+/*
+    Sort state. The sorter is a managed block so the elements and keys being sorted are marked while the comparator runs.
+ */
+typedef struct Sorter {
+    Ejs         *ejs;
+    SortItem    *items;                     /* Elements to sort */
+    SortItem    *tmp;                       /* Merge buffer */
+    EjsFunction *compare;                   /* Script comparator */
+    EjsArray    *pair;                      /* Array of the two elements to compare for SORT_INDICIES */
+    EjsAny      *argv[3];                   /* Comparator arguments */
+    int         kind;                       /* Comparison kind */
+    int         direction;                  /* Ascending if >= 0. Otherwise descending */
+    int         runBase[SORT_MAX_RUNS];     /* Pending runs to merge */
+    int         runLen[SORT_MAX_RUNS];
+    int         numRuns;
+    int         size;                       /* Number of items in the items and merge buffers */
+    SortItem    buffer[ARRAY_FLEX];         /* Storage for the items and the merge buffer */
+} Sorter;
+
+
+static void manageSorter(Sorter *sp, int flags)
+{
+    int     i;
+
+    if (flags & MPR_MANAGE_MARK) {
+        mprMark(sp->compare);
+        mprMark(sp->pair);
+        for (i = 0; i < 3; i++) {
+            mprMark(sp->argv[i]);
+        }
+        for (i = 0; i < sp->size; i++) {
+            mprMark(sp->buffer[i].value);
+            mprMark(sp->buffer[i].key);
+        }
+    }
+}
+
+/*
+    Compare integers in the lexical order of their decimal strings
+ */
+static int compareIntegers(int64 a, int64 b)
+{
+    char    abuf[32], bbuf[32];
+
+    if (a == b) {
+        return 0;
+    }
+    return scmp(itosbuf(abuf, sizeof(abuf), a, 10), itosbuf(bbuf, sizeof(bbuf), b, 10));
+}
+
+
+/*
+    Compare two items. Returns < 0 if a sorts before b, 0 if equal and > 0 if a sorts after b.
  */
-static int partition(Ejs *ejs, EjsArray *array, EjsFunction *compare, int direction, int p, int r)
+static int compareItems(Sorter *sp, SortItem *a, SortItem *b)
 {
-    EjsString   *sx, *so;
-    EjsNumber   *result;
-    EjsAny      *argv[3], *tmp;
-    EjsObj      *x;
-    int         i, j, order;
+    Ejs         *ejs;
+    EjsAny      *result;
+    MprNumber   n;
+    int         order;
 
-    x = array->data[r];
-    sx = 0;
+    ejs = sp->ejs;
+    if (ejs->exception) {
+        return 0;
+    }
+    switch (sp->kind) {
+    case SORT_STRINGS:
+        order = ejsCompareString(ejs, a->key, b->key);
+        break;
 
-    if (compare) {
-        if ((argv[1] = ejsCreateNumber(ejs, r)) == 0) {
+    case SORT_INTEGERS:
+        order = compareIntegers(a->num, b->num);
+        break;
+
+    case SORT_ELEMENTS:
+        sp->argv[0] = a->value;
+        sp->argv[1] = b->value;
+        if ((result = ejsRunFunction(ejs, sp->compare, NULL, 2, sp->argv)) == 0) {
             return 0;
         }
-    } else {
-        if ((sx = ejsToString(ejs, x)) == 0) {
+        n = ejsIs(ejs, result, Number) ? ejsGetNumber(ejs, result) : 0;
+        order = (n < 0) ? -1 : ((n > 0) ? 1 : 0);
+        break;
+
+    case SORT_INDICIES:
+    default:
+        sp->pair->data[0] = a->value;
+        sp->pair->data[1] = b->value;
+        sp->pair->length = 2;
+        if ((result = ejsRunFunction(ejs, sp->compare, NULL, 3, sp->argv)) == 0) {
             return 0;
         }
+        n = ejsIs(ejs, result, Number) ? ejsGetNumber(ejs, result) : 0;
+        order = (n < 0) ? -1 : ((n > 0) ? 1 : 0);
+        break;
     }
-    j = p - 1;
+    return (sp->direction < 0) ? -order : order;
+}
 
-    for (i = p; i < r; i++) {
-        if (compare) {
-            argv[0] = array;
-            argv[2] = ejsCreateNumber(ejs, i);
-            result = ejsRunFunction(ejs, compare, NULL, 3, argv);
-            if (!ejsIs(ejs, result, Number)) {
-                return 0;
+
+/*
+    Sort items[lo..hi) given that items[lo..start) is already sorted. Binary search minimizes comparisons.
+ */
+static void insertionSort(Sorter *sp, int lo, int hi, int start)
+{
+    SortItem    *items, pivot;
+    int         left, right, mid;
+
+    items = sp->items;
+    for (; start < hi; start++) {
+        pivot = items[start];
+        left = lo;
+        right = start;
+        while (left < right) {
+            mid = (left + right) >> 1;
+            if (compareItems(sp, &pivot, &items[mid]) < 0) {
+                right = mid;
+            } else {
+                left = mid + 1;
             }
-            order = ejsGetInt(ejs, result);
+        }
+        memmove(&items[left + 1], &items[left], (start - left) * sizeof(SortItem));
+        items[left] = pivot;
+    }
+}
+
+
+/*
+    Return the length of the run starting at lo. Strictly descending runs are reversed to preserve stability.
+ */
+static int countRun(Sorter *sp, int lo, int hi)
+{
+    SortItem    *items, tmp;
+    int         i, j, end;
 
+    items = sp->items;
+    end = lo + 1;
+    if (end == hi) {
+        return 1;
+    }
+    if (compareItems(sp, &items[end++], &items[lo]) < 0) {
+        while (end < hi && compareItems(sp, &items[end], &items[end - 1]) < 0) {
+            end++;
+        }
+        for (i = lo, j = end - 1; i < j; i++, j--) {
+            tmp = items[i];
+            items[i] = items[j];
+            items[j] = tmp;
+        }
+    } else {
+        while (end < hi && compareItems(sp, &items[end], &items[end - 1]) >= 0) {
+            end++;
+        }
+    }
+    return end - lo;
+}
+
+
+/*
+    Merge the adjacent sorted runs items[lo..mid) and items[mid..hi)
+ */
+static void mergeRuns(Sorter *sp, int lo, int mid, int hi)
+{
+    SortItem    *items, *tmp;
+    int         i, j, k, left, right, m, len;
+
+    items = sp->items;
+    if (compareItems(sp, &items[mid], &items[mid - 1]) >= 0) {
+        /* Already in order */
+        return;
+    }
+    /* Elements of the first run that sort before the second run and elements of the second run that sort after the
+       first run are already in place */
+    for (left = lo, right = mid; left < right; ) {
+        m = (left + right) >> 1;
+        if (compareItems(sp, &items[mid], &items[m]) < 0) {
+            right = m;
         } else {
-            if ((so = ejsToString(ejs, array->data[i])) == 0) {
-                return 0;
-            }
-            order = ejsCompareString(ejs, sx, so);
+            left = m + 1;
         }
-        order *= direction;
-        if (order > 0) {
-            j = j + 1;
-            tmp = array->data[j];
-            array->data[j] = array->data[i];
-            array->data[i] = tmp;
+    }
+    lo = left;
+    for (left = mid, right = hi; left < right; ) {
+        m = (left + right) >> 1;
+        if (compareItems(sp, &items[m], &items[mid - 1]) < 0) {
+            left = m + 1;
+        } else {
+            right = m;
+        }
+    }
+    hi = left;
+
+    tmp = sp->tmp;
+    len = mid - lo;
+    memcpy(tmp, &items[lo], len * sizeof(SortItem));
+    for (i = 0, j = mid, k = lo; i < len && j < hi; ) {
+        if (compareItems(sp, &items[j], &tmp[i]) < 0) {
+            items[k++] = items[j++];
+        } else {
+            items[k++] = tmp[i++];
+        }
+    }
+    memcpy(&items[k], &tmp[i], (len - i) * sizeof(SortItem));
+}
+
+
+static void mergeAt(Sorter *sp, int n)
+{
+    mergeRuns(sp, sp->runBase[n], sp->runBase[n + 1], sp->runBase[n + 1] + sp->runLen[n + 1]);
+    sp->runLen[n] += sp->runLen[n + 1];
+    if (n == sp->numRuns - 3) {
+        sp->runBase[n + 1] = sp->runBase[n + 2];
+        sp->runLen[n + 1] = sp->runLen[n + 2];
+    }
+    sp->numRuns--;
+}
+
+
+/*
+    Merge pending runs until the run lengths satisfy the TimSort invariants. This bounds the number of pending runs
+    and keeps merges balanced.
+ */
+static void collapseRuns(Sorter *sp, int force)
+{
+    int     *len, n;
+
+    len = sp->runLen;
+    while (sp->numRuns > 1) {
+        n = sp->numRuns - 2;
+        if (force) {
+            if (n > 0 && len[n - 1] < len[n + 1]) {
+                n--;
+            }
+        } else if ((n > 0 && len[n - 1] <= len[n] + len[n + 1]) || (n > 1 && len[n - 2] <= len[n - 1] + len[n])) {
+            if (len[n - 1] < len[n + 1]) {
+                n--;
+            }
+        } else if (len[n] > len[n + 1]) {
+            break;
         }
+        mergeAt(sp, n);
     }
-    array->data[r] = array->data[j + 1];
-    array->data[j + 1] = x;
-    return j + 1;
 }
 
 
-PUBLIC void quickSort(Ejs *ejs, EjsArray *ap, EjsFunction *compare, int direction, int p, int r)
+static int getMinRun(int n)
 {
-    int     q;
+    int     r;
 
-    if (p < r && !ejs->exception) {
-        q = partition(ejs, ap, compare, direction, p, r);
-        quickSort(ejs, ap, compare, direction, p, q - 1);
-        quickSort(ejs, ap, compare, direction, q + 1, r);
+    for (r = 0; n >= SORT_MIN_MERGE; n >>= 1) {
+        r |= (n & 1);
     }
+    return n + r;
 }
 
 
-/**
+static void sortItems(Sorter *sp, int count)
+{
+    int     lo, run, minRun, force;
+
+    minRun = getMinRun(count);
+    for (lo = 0; lo < count; lo += run) {
+        run = countRun(sp, lo, count);
+        if (run < minRun) {
+            force = min(minRun, count - lo);
+            insertionSort(sp, lo, lo + force, lo + run);
+            run = force;
+        }
+        sp->runBase[sp->numRuns] = lo;
+        sp->runLen[sp->numRuns] = run;
+        sp->numRuns++;
+        collapseRuns(sp, 0);
+    }
+    collapseRuns(sp, 1);
+}
+
+
+/*
     Sort the array using the supplied compare function
 
     function sort(compare: Function = null, direction: Number = 1): Array
 
-    Where compare is defined as:
-        function compare(a,b): Number
+    Where compare is defined as either of:
+        function compare(a, b): Number
+        function compare(array: Array, index1: Number, index2: Number): Number
  */
 PUBLIC EjsArray *ejsSortArray(Ejs *ejs, EjsArray *ap, int argc, EjsObj **argv)
 {
+    Sorter          *sorter;
+    SortItem        *items;
     EjsFunction     *compare;
-    int             direction;
+    EjsAny          *vp;
+    MprNumber       n;
+    int             count, i, strings, integers, packed;
 
     if (ap->length <= 1) {
         return ap;
@@ -1324,9 +1953,85 @@ PUBLIC EjsArray *ejsSortArray(Ejs *ejs, EjsArray *ap, int argc, EjsObj **argv)
         ejsThrowArgError(ejs, "Compare argument is not a function");
         return 0;
     }
-    direction = (argc >= 2) ? ejsGetInt(ejs, argv[1]) : 1;
-    quickSort(ejs, ap, compare, direction, 0, ap->length - 1);
-    return ap;
+    count = ap->length;
+    if ((sorter = mprAllocBlock(sizeof(Sorter) + count * 2 * sizeof(SortItem), 
+            MPR_ALLOC_ZERO | MPR_ALLOC_MANAGER)) == 0) {
+        ejsThrowMemoryError(ejs);
+        return 0;
+    }
+    mprSetManager(sorter, (MprManager) manageSorter);
+    mprAddRoot(sorter);
+    sorter->ejs = ejs;
+    sorter->compare = compare;
+    sorter->direction = (argc >= 2) ? ejsGetInt(ejs, argv[1]) : 1;
+    sorter->size = count * 2;
+    sorter->items = items = sorter->buffer;
+    sorter->tmp = &items[count];
+    strings = integers = 1;
+
+    /*
+        Packed integers are sorted without a comparator by their integer keys and are not boxed
+     */
+    packed = (ap->kind == EJS_ARRAY_INTS && !compare);
+    for (i = 0; i < count; i++) {
+        if (packed) {
+            items[i].value = 0;
+            items[i].num = arrayInts(ap)[i];
+            strings = 0;
+            continue;
+        }
+        vp = getElement(ejs, ap, i);
+        items[i].value = vp;
+        if (!compare) {
+            if (strings && !ejsIs(ejs, vp, String)) {
+                strings = 0;
+            }
+            if (integers) {
+                n = ejsIs(ejs, vp, Number) ? ejsGetNumber(ejs, vp) : 0.5;
+                if (n == (int64) n && n > -SORT_MAX_INTEGER && n < SORT_MAX_INTEGER) {
+                    items[i].num = (int64) n;
+                } else {
+                    integers = 0;
+                }
+            }
+        }
+    }
+    if (compare) {
+        if (compare->numArgs == 2) {
+            sorter->kind = SORT_ELEMENTS;
+        } else {
+            sorter->kind = SORT_INDICIES;
+            sorter->pair = ejsCreateArray(ejs, 2);
+            sorter->argv[0] = sorter->pair;
+            sorter->argv[1] = ejsCreateNumber(ejs, 0);
+            sorter->argv[2] = ejsCreateNumber(ejs, 1);
+        }
+    } else if (integers) {
+        sorter->kind = SORT_INTEGERS;
+    } else {
+        sorter->kind = SORT_STRINGS;
+        for (i = 0; i < count && !ejs->exception; i++) {
+            items[i].key = strings ? items[i].value : ejsToString(ejs, items[i].value);
+        }
+    }
+    if (!ejs->exception) {
+        sortItems(sorter, count);
+    }
+    if (!ejs->exception) {
+        /* The comparator may have modified the array */
+        count = min(count, ap->length);
+        if (packed) {
+            for (i = 0; i < count; i++) {
+                arrayInts(ap)[i] = (int) items[i].num;
+            }
+        } else {
+            for (i = 0; i < count; i++) {
+                setElement(ap, i, items[i].value);
+            }
+        }
+    }
+    mprRemoveRoot(sorter);
+    return ejs->exception ? 0 : ap;
 }
 
 
@@ -1339,8 +2044,7 @@ PUBLIC EjsArray *ejsSortArray(Ejs *ejs, EjsArray *ap, int argc, EjsObj **argv)
 static EjsArray *spliceArray(Ejs *ejs, EjsArray *ap, int argc, EjsObj **argv)
 {
     EjsArray    *result, *values;
-    EjsObj          **data, **dest, **items;
-    int         start, deleteCount, i, delta, endInsert, oldLen;
+    int         start, deleteCount, delta, oldLen;
 
     assert(1 <= argc && argc <= 3);
     
@@ -1365,30 +2069,23 @@ static EjsArray *spliceArray(Ejs *ejs, EjsArray *ap, int argc, EjsObj **argv)
         start = ap->length - 1;
     }
 
-    if (deleteCount < 0) {
-        deleteCount = ap->length - start + 1;
-    }
-    if (deleteCount > ap->length) {
-        deleteCount = ap->length;
+    if (deleteCount < 0 || deleteCount > (ap->length - start)) {
+        deleteCount = ap->length - start;
     }
-    result = ejsCreateArray(ejs, deleteCount);
-    if (result == 0) {
-        ejsThrowMemoryError(ejs);
+    if ((result = createPackedArray(ejs, ap->kind, deleteCount)) == 0) {
         return 0;
     }
-    data = ap->data;
-    dest = result->data;
-    items = values->data;
-
     /*
         Copy removed items to the result
      */
-    for (i = 0; i < deleteCount; i++) {
-        dest[i] = data[i + start];
-    }
+    copyElements(ejs, result, 0, ap, start, deleteCount);
+
     oldLen = ap->length;
     delta = values->length - deleteCount;
-    
+    if (widenArray(ejs, ap, values) < 0) {
+        ejsThrowMemoryError(ejs);
+        return 0;
+    }
     if (delta > 0) {
         /*
             Make room for items to insert
@@ -1396,31 +2093,13 @@ static EjsArray *spliceArray(Ejs *ejs, EjsArray *ap, int argc, EjsObj **argv)
         if (growArray(ejs, ap, ap->length + delta) < 0) {
             return 0;
         }
-        data = ap->data;
-        endInsert = start + delta;
-        for (i = ap->length - 1; i >= endInsert; i--) {
-            data[i] = data[i - delta];
-        }
-        
-    } else {
-        ap->length += delta;
-    }
-
-    /*
-        Copy in new values
-     */
-    for (i = 0; i < values->length; i++) {
-        data[start + i] = items[i];
     }
-
     /*
-        Remove holes
+        Move the trailing elements and copy in new values
      */
-    if (delta < 0) {
-        for (i = start + values->length; i < oldLen; i++) {
-            data[i] = data[i - delta];
-        }
-    }
+    copyElements(ejs, ap, start + values->length, ap, start + deleteCount, oldLen - start - deleteCount);
+    copyElements(ejs, ap, start, values, 0, values->length);
+    ap->length = oldLen + delta;
     return result;
 }
 
@@ -1458,6 +2137,9 @@ static EjsString *arrayToString(Ejs *ejs, EjsArray *ap, int argc, EjsObj **argv)
         return 0;
     }
     comma = ejsCreateStringFromAsc(ejs, ",");
+    if (ap->kind != EJS_ARRAY_OBJECTS) {
+        return joinPacked(ejs, ap, comma);
+    }
     for (i = 0; i < ap->length; i++) {
         vp = ap->data[i];
         rc = 0;
@@ -1484,22 +2166,21 @@ static EjsString *arrayToString(Ejs *ejs, EjsArray *ap, int argc, EjsObj **argv)
  */
 static EjsArray *uniqueArray(Ejs *ejs, EjsArray *ap, int argc, EjsObj **argv)
 {
-    EjsObj      **data;
-    int     i, j, k;
-
-    data = ap->data;
+    ElementSet  seen;
+    int         i, j;
 
-    for (i = 0; i < ap->length; i++) {
-        for (j = i + 1; j < ap->length; j++) {
-            if (compareArrayElement(ejs, data[i], data[j])) {
-                for (k = j + 1; k < ap->length; k++) {
-                    data[k - 1] = data[k];
-                }
-                ap->length--;
-                j--;
-            }
+    if (ap->length <= 1) {
+        return ap;
+    }
+    if (initSet(ejs, &seen, ap->length) < 0) {
+        return 0;
+    }
+    for (i = j = 0; i < ap->length; i++) {
+        if (addElement(ejs, &seen, getElement(ejs, ap, i))) {
+            copyElements(ejs, ap, j++, ap, i, 1);
         }
     }
+    ap->length = j;
     return ap;
 }
 
@@ -1510,8 +2191,7 @@ static EjsArray *uniqueArray(Ejs *ejs, EjsArray *ap, int argc, EjsObj **argv)
 static EjsArray *unshiftArray(Ejs *ejs, EjsArray *ap, int argc, EjsObj **argv)
 {
     EjsArray    *args;
-    EjsObj          **src, **dest;
-    int         i, delta, endInsert;
+    int         oldLen;
 
     assert(argc == 1 && ejsIs(ejs, argv[0], Array));
 
@@ -1519,20 +2199,12 @@ static EjsArray *unshiftArray(Ejs *ejs, EjsArray *ap, int argc, EjsObj **argv)
     if (args->length <= 0) {
         return ap;
     }
-    if (growArray(ejs, ap, ap->length + args->length) < 0) {
+    oldLen = ap->length;
+    if (widenArray(ejs, ap, args) < 0 || growArray(ejs, ap, ap->length + args->length) < 0) {
         return 0;
     }
-    delta = args->length;
-    dest = ap->data;
-    src = args->data;
-
-    endInsert = delta;
-    for (i = ap->length - 1; i >= endInsert; i--) {
-        dest[i] = dest[i - delta];
-    }
-    for (i = 0; i < delta; i++) {
-        dest[i] = src[i];
-    }
+    copyElements(ejs, ap, args->length, ap, 0, oldLen);
+    copyElements(ejs, ap, 0, args, 0, args->length);
     return ap;
 }
 
@@ -1541,7 +2213,7 @@ static EjsArray *unshiftArray(Ejs *ejs, EjsArray *ap, int argc, EjsObj **argv)
 static int growArray(Ejs *ejs, EjsArray *ap, int len)
 {
     EjsObj      **dp;
-    ssize       size, factor, count;
+    ssize       size, factor, count, esize;
     int         i;
 
     assert(ap);
@@ -1552,8 +2224,8 @@ static int growArray(Ejs *ejs, EjsArray *ap, int len)
     if (len <= ap->length) {
         return 0;
     }
-    size = mprGetBlockSize(ap->data);
-    size = (int) (mprGetBlockSize(ap->data) / sizeof(EjsObj*));
+    esize = elementSize(ap->kind);
+    size = (int) (mprGetBlockSize(ap->data) / esize);
 
     /*
         Allocate or grow the data structures.
@@ -1573,18 +2245,20 @@ static int growArray(Ejs *ejs, EjsArray *ap, int len)
         if (ap->data == 0) {
             assert(ap->length == 0);
             assert(count > 0);
-            if ((ap->data = mprAllocZeroed(sizeof(EjsObj*) * count)) == 0) {
+            if ((ap->data = mprAllocZeroed(esize * count)) == 0) {
                 return EJS_ERR;
             }
         } else {
             assert(size > 0);
-            if ((ap->data = mprRealloc(ap->data, sizeof(EjsObj*) * count)) == 0) {
+            if ((ap->data = mprRealloc(ap->data, esize * count)) == 0) {
                 return EJS_ERR;
             }
         }
-        dp = &ap->data[ap->length];
-        for (i = ap->length; i < count; i++) {
-            *dp++ = ESV(undefined);
+        if (ap->kind == EJS_ARRAY_OBJECTS) {
+            dp = &ap->data[ap->length];
+            for (i = ap->length; i < count; i++) {
+                *dp++ = ESV(undefined);
+            }
         }
     } else {
         mprNop(ITOP(size));
@@ -1613,7 +2287,7 @@ PUBLIC int ejsAppendArray(Ejs *ejs, EjsArray *dest, EjsArray *src)
     int     next;
 
     for (next = 0; next < src->length; next++) {
-        if (ejsSetProperty(ejs, dest, dest->length, src->data[next]) < 0) {
+        if (ejsSetProperty(ejs, dest, dest->length, getElement(ejs, src, next)) < 0) {
             return MPR_ERR_MEMORY;
         }
     }
@@ -1640,7 +2314,7 @@ PUBLIC EjsAny *ejsGetFirstItem(Ejs *ejs, EjsArray *ap)
     if (ap == 0 || ap->length == 0) {
         return 0;
     }
-    return ap->data[0];
+    return getElement(ejs, ap, 0);
 }
 
 
@@ -1651,7 +2325,7 @@ PUBLIC EjsAny *ejsGetLastItem(Ejs *ejs, EjsArray *ap)
     if (ap == 0 || ap->length == 0) {
         return 0;
     }
-    return ap->data[ap->length - 1];
+    return getElement(ejs, ap, ap->length - 1);
 }
 
 
@@ -1668,7 +2342,7 @@ PUBLIC EjsAny *ejsGetNextItem(Ejs *ejs, EjsArray *ap, int *next)
     }
     index = *next;
     if (index < ap->length) {
-        item = ap->data[index];
+        item = getElement(ejs, ap, index);
         *next = ++index;
         return item;
     }
@@ -1692,7 +2366,7 @@ PUBLIC EjsAny *ejsGetPrevItem(Ejs *ejs, EjsArray *ap, int *next)
 
     if (--index < ap->length && index >= 0) {
         *next = index;
-        return ap->data[index];
+        return getElement(ejs, ap, index);
     }
     return 0;
 }
@@ -1724,6 +2398,10 @@ PUBLIC int ejsLookupItem(Ejs *ejs, EjsArray *ap, EjsAny *item)
 
     assert(ap);
     
+    if (ap->kind != EJS_ARRAY_OBJECTS) {
+        i = ejsIs(ejs, item, Number) ? findNumber(ap, item, 0, ap->length, 1) : -1;
+        return (i < 0) ? MPR_ERR_CANT_FIND : i;
+    }
     for (i = 0; i < ap->length; i++) {
         if (ap->data[i] == item) {
             return i;
@@ -1737,16 +2415,14 @@ PUBLIC int ejsRemoveItem(Ejs *ejs, EjsArray *ap, EjsAny *item, int compact)
 {
     int     i;
 
-    for (i = 0; i < ap->length; i++) {
-        if (ap->data[i] == item) {
-            deleteArrayProperty(ejs, ap, i);
-            if (compact) {
-                compactArray(ejs, ap, 0, NULL);
-            }
-            return i;
-        }
+    if ((i = ejsLookupItem(ejs, ap, item)) < 0) {
+        return MPR_ERR_CANT_FIND;
     }
-    return MPR_ERR_CANT_FIND;
+    deleteArrayProperty(ejs, ap, i);
+    if (compact) {
+        compactArray(ejs, ap, 0, NULL);
+    }
+    return i;
 }
 
 
@@ -1806,9 +2482,11 @@ static void manageArray(EjsArray *ap, int flags)
     if (flags & MPR_MANAGE_MARK) {
         length = ap->length;
         data = ap->data;
-        for (i = length - 1; i >= 0; i--) {
-            if ((vp = data[i]) != 0) {
-                mprMark(vp);
+        if (ap->kind == EJS_ARRAY_OBJECTS) {
+            for (i = length - 1; i >= 0; i--) {
+                if ((vp = data[i]) != 0) {
+                    mprMark(vp);
+                }
             }
         }
         mprMark(data);
@@ -40,16 +40,19 @@ PUBLIC EjsAny *ejsCacheRead(Ejs *ejs, EjsObj *cache, EjsString *key, EjsObj *opt
 
 PUBLIC EjsAny *ejsCacheReadObj(Ejs *ejs, EjsObj *cache, EjsString *key, EjsObj *options)
 {
-    EjsAny  *value, *argv[3], *result;
+    EjsAny  *adapter, *value, *argv[3], *result;
     int     prior;
 
+    if (!options && (adapter = ejsGetLocalCache(ejs, cache)) != 0) {
+        return ejsReadLocalCacheObj(ejs, adapter, key);
+    }
     prior = ejsBlockGC(ejs);
     argv[0] = key;
     argv[1] = (options) ? options : ESV(null);
-    if ((value = ejsRunFunctionBySlot(ejs, cache, ES_Cache_read, 2, argv)) == 0 || value == ESV(null)) {
-        return 0;
+    result = 0;
+    if ((value = ejsRunFunctionBySlot(ejs, cache, ES_Cache_read, 2, argv)) != 0 && value != ESV(null)) {
+        result = ejsDeserialize(ejs, value);
     }
-    result = ejsDeserialize(ejs, value);
     ejsUnblockGC(ejs, prior);
     return result;
 }
@@ -98,9 +101,13 @@ PUBLIC EjsNumber *ejsCacheWrite(Ejs *ejs, EjsObj *cache, EjsString *key, EjsStri
 
 PUBLIC EjsNumber *ejsCacheWriteObj(Ejs *ejs, EjsObj *cache, EjsString *key, EjsAny *value, EjsObj *options)
 {
-    EjsAny  *argv[3], *result;
+    EjsAny  *adapter, *argv[3], *result;
     int     prior;
 
+    if ((adapter = ejsGetLocalCache(ejs, cache)) != 0 && (!options || 
+            (!ejsGetPropertyByName(ejs, options, EN("mode")) && !ejsGetPropertyByName(ejs, options, EN("version"))))) {
+        return ejsWriteLocalCacheObj(ejs, adapter, key, value, options);
+    }
     prior = ejsBlockGC(ejs);
     argv[0] = key;
     argv[1] = ejsSerialize(ejs, value, 0);
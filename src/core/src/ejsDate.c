@@ -25,6 +25,38 @@
 #define getNumber(ejs, a) ejsGetNumber(ejs, ejsToNumber(ejs, a))
 #define getInt(ejs, a) ((int) ejsGetNumber(ejs, ejsToNumber(ejs, a)))
 
+/*
+    Number of recently formatted dates to cache per interpreter. Must be a power of 2.
+ */
+#ifndef ME_MAX_DATE_CACHE
+    #define ME_MAX_DATE_CACHE 8
+#endif
+
+#define RFC1123_FORMAT "%a, %d %b %Y %T GMT"
+
+/*
+    Cache of formatted dates. Formatted output has a resolution of one second, so HTTP headers and log lines that 
+    format the current time with the same layout reuse the result until the second changes.
+ */
+typedef struct DateCacheEntry {
+    EjsString       *layout;            /* Layout string (compared by reference) */
+    EjsString       *result;            /* Formatted result */
+    MprTime         seconds;            /* Time in seconds that was formatted */
+    int             utc;                /* Formatted using UTC */
+} DateCacheEntry;
+
+typedef struct EjsDateCache {
+    DateCacheEntry  entries[ME_MAX_DATE_CACHE];
+    EjsString       *rfc1123;           /* Interned RFC1123_FORMAT layout used by toUTCString */
+} EjsDateCache;
+
+static cchar *dayNames[] = { "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat" };
+static cchar *monthNames[] = { "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
+
+static EjsDateCache *getDateCache(Ejs *ejs);
+static EjsString *formatDate(Ejs *ejs, MprTime when, EjsString *layout, int utc);
+static int parseTime(MprTime *when, cchar *str, int zoneFlags, struct tm *defaults);
+
 /******************************************************************************/
 /*
     Cast the operand to the specified type
@@ -271,7 +303,7 @@ static EjsDate *date_Date(Ejs *ejs, EjsDate *date, int argc, EjsObj **argv)
             date->value = ejsGetNumber(ejs, vp);
 
         } else if (ejsIs(ejs, vp, String)) {
-            if (mprParseTime(&date->value, ejsToMulti(ejs, vp), MPR_LOCAL_TIMEZONE, NULL) < 0) {
+            if (parseTime(&date->value, ejsToMulti(ejs, vp), MPR_LOCAL_TIMEZONE, NULL) < 0) {
                 ejsThrowArgError(ejs, "Cannot parse date string: %@", ejsToString(ejs, vp));
                 return 0;
             }
@@ -432,7 +464,7 @@ static EjsNumber *date_elapsed(Ejs *ejs, EjsDate *dp, int argc, EjsObj **argv)
  */
 static EjsString *date_format(Ejs *ejs, EjsDate *dp, int argc, EjsObj **argv)
 {
-    return ejsCreateStringFromAsc(ejs, mprFormatLocalTime(ejsToMulti(ejs, argv[0]), dp->value));
+    return formatDate(ejs, dp->value, ejsToString(ejs, argv[0]), 0);
 }
 
 
@@ -441,7 +473,7 @@ static EjsString *date_format(Ejs *ejs, EjsDate *dp, int argc, EjsObj **argv)
  */
 static EjsString *date_formatUTC(Ejs *ejs, EjsDate *dp, int argc, EjsObj **argv)
 {
-    return ejsCreateStringFromAsc(ejs, mprFormatUniversalTime(ejsToMulti(ejs, argv[0]), dp->value));
+    return formatDate(ejs, dp->value, ejsToString(ejs, argv[0]), 1);
 }
 
 
@@ -704,7 +736,7 @@ static EjsNumber *date_parse(Ejs *ejs, EjsDate *unused, int argc, EjsObj **argv)
 {
     MprTime     when;
 
-    if (mprParseTime(&when, ejsToMulti(ejs, argv[0]), MPR_LOCAL_TIMEZONE, NULL) < 0) {
+    if (parseTime(&when, ejsToMulti(ejs, argv[0]), MPR_LOCAL_TIMEZONE, NULL) < 0) {
         ejsThrowArgError(ejs, "Cannot parse date string: %@", ejsToString(ejs, argv[0]));
         return 0;
     }
@@ -726,7 +758,7 @@ static EjsDate *date_parseDate(Ejs *ejs, EjsDate *unused, int argc, EjsObj **arg
     } else {
         defaults = 0;
     }
-    if (mprParseTime(&when, ejsToMulti(ejs, argv[0]), MPR_LOCAL_TIMEZONE, defaults) < 0) {
+    if (parseTime(&when, ejsToMulti(ejs, argv[0]), MPR_LOCAL_TIMEZONE, defaults) < 0) {
         ejsThrowArgError(ejs, "Cannot parse date string: %@", ejsToString(ejs, argv[0]));
         return 0;
     }
@@ -748,7 +780,7 @@ static EjsDate *date_parseUTCDate(Ejs *ejs, EjsDate *unused, int argc, EjsObj **
     } else {
         defaults = 0;
     }
-    if (mprParseTime(&when, ejsToMulti(ejs, argv[0]), MPR_UTC_TIMEZONE, defaults) < 0) {
+    if (parseTime(&when, ejsToMulti(ejs, argv[0]), MPR_UTC_TIMEZONE, defaults) < 0) {
         ejsThrowArgError(ejs, "Cannot parse date string: %@", ejsToString(ejs, argv[0]));
         return 0;
     }
@@ -933,6 +965,22 @@ static EjsString *date_toISOString(Ejs *ejs, EjsDate *dp, int argc, EjsObj **arg
 }
 
 
+/*
+    Return the date in the RFC 1123 format used by HTTP headers. Sample: "Sat, 16 Dec 2006 08:06:21 GMT"
+
+    function toUTCString(): String
+ */
+static EjsString *date_toUTCString(Ejs *ejs, EjsDate *dp, int argc, EjsObj **argv)
+{
+    EjsDateCache    *cache;
+
+    if ((cache = getDateCache(ejs)) == 0) {
+        return 0;
+    }
+    return formatDate(ejs, dp->value, cache->rfc1123, 1);
+}
+
+
 /*
     Serialize using JSON encoding. This uses the ISO date format
 
@@ -1021,11 +1069,302 @@ static EjsObj *date_set_year(Ejs *ejs, EjsDate *dp, int argc, EjsObj **argv)
     return 0;
 }
 
+/********************************** Fast Paths ********************************/
+
+static void manageDateCache(EjsDateCache *cache, int flags)
+{
+    DateCacheEntry  *ep;
+    int             i;
+
+    if (flags & MPR_MANAGE_MARK) {
+        for (i = 0; i < ME_MAX_DATE_CACHE; i++) {
+            ep = &cache->entries[i];
+            mprMark(ep->layout);
+            mprMark(ep->result);
+        }
+        mprMark(cache->rfc1123);
+    }
+}
+
+
+/*
+    Format a date using the RFC 1123 layout used by HTTP headers. Equivalent to formatting with RFC1123_FORMAT.
+ */
+static char *formatRfc1123(MprTime when)
+{
+    struct tm   tm;
+
+    mprDecodeUniversalTime(&tm, when);
+    return sfmt("%s, %02d %s %d %02d:%02d:%02d GMT", dayNames[tm.tm_wday], tm.tm_mday, monthNames[tm.tm_mon], 
+        tm.tm_year + 1900, tm.tm_hour, tm.tm_min, tm.tm_sec);
+}
+
+
+/*
+    Format a date and cache the result. Layouts have a resolution of one second, so the cache is keyed by the layout 
+    string, time zone and the time in seconds.
+ */
+static EjsDateCache *getDateCache(Ejs *ejs)
+{
+    EjsDateCache    *cache;
+
+    if ((cache = ejs->dateCache) == 0) {
+        if ((cache = mprAllocObj(EjsDateCache, manageDateCache)) == 0) {
+            return 0;
+        }
+        cache->rfc1123 = ejsCreateStringFromAsc(ejs, RFC1123_FORMAT);
+        ejs->dateCache = cache;
+    }
+    return cache;
+}
+
+
+static EjsString *formatDate(Ejs *ejs, MprTime when, EjsString *layout, int utc)
+{
+    EjsDateCache    *cache;
+    DateCacheEntry  *ep;
+    MprTime         seconds;
+    cchar           *fmt;
+    char            *str;
+
+    if (layout == 0 || (cache = getDateCache(ejs)) == 0) {
+        return 0;
+    }
+    seconds = when / TPS - (when % TPS < 0);
+    ep = &cache->entries[((PTOI(layout) >> 4) ^ utc) & (ME_MAX_DATE_CACHE - 1)];
+    if (ep->layout == layout && ep->seconds == seconds && ep->utc == utc && ep->result) {
+        return ep->result;
+    }
+    fmt = ejsToMulti(ejs, layout);
+    if (utc && smatch(fmt, RFC1123_FORMAT) && when >= 0) {
+        str = formatRfc1123(when);
+    } else if (utc) {
+        str = mprFormatUniversalTime(fmt, when);
+    } else {
+        str = mprFormatLocalTime(fmt, when);
+    }
+    ep->layout = layout;
+    ep->seconds = seconds;
+    ep->utc = utc;
+    ep->result = ejsCreateStringFromAsc(ejs, str);
+    return ep->result;
+}
+
+
+static int parseNumber(cchar **cp, int digits)
+{
+    cchar   *s;
+    int     value;
+
+    value = 0;
+    for (s = *cp; digits-- > 0; s++) {
+        if (!isdigit((uchar) *s)) {
+            return -1;
+        }
+        value = value * 10 + (*s - '0');
+    }
+    *cp = s;
+    return value;
+}
+
+
+static int parseMonthName(cchar **cp)
+{
+    int     i;
+
+    for (i = 0; i < 12; i++) {
+        if (strncmp(*cp, monthNames[i], 3) == 0) {
+            *cp += 3;
+            return i;
+        }
+    }
+    return -1;
+}
+
+
+/*
+    Parse a numeric time zone offset of the form "+HH:MM" or "+HHMM". Returns the offset in milliseconds.
+ */
+static int parseZoneOffset(cchar **cp, MprTime *offset)
+{
+    cchar   *s;
+    int     sign, hours, minutes;
+
+    s = *cp;
+    if (*s != '+' && *s != '-') {
+        return -1;
+    }
+    sign = (*s++ == '-') ? -1 : 1;
+    if ((hours = parseNumber(&s, 2)) < 0) {
+        return -1;
+    }
+    if (*s == ':') {
+        s++;
+    }
+    if ((minutes = parseNumber(&s, 2)) < 0 || hours > 23 || minutes > 59) {
+        return -1;
+    }
+    *offset = sign * (hours * 60 + minutes) * 60 * TPS;
+    *cp = s;
+    return 0;
+}
+
+
+/*
+    Return the number of days in a month. The year is the full year and the month is zero based.
+ */
+static int getDaysInMonth(int year, int month)
+{
+    static int  days[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+
+    if (month == 1 && (year % 4) == 0 && ((year % 100) != 0 || (year % 400) == 0)) {
+        return 29;
+    }
+    return days[month];
+}
+
+
+/*
+    Validate the parsed fields and convert to a time. Out of range fields are rejected so the general parser can report.
+ */
+static int makeFastTime(MprTime *when, struct tm *tm, int msec, MprTime offset)
+{
+    if (tm->tm_mon < 0 || tm->tm_mon > 11 || tm->tm_mday < 1 || tm->tm_mday > getDaysInMonth(tm->tm_year, tm->tm_mon) ||
+            tm->tm_hour > 23 || tm->tm_min > 59 || tm->tm_sec > 60) {
+        return -1;
+    }
+    tm->tm_year -= 1900;
+    *when = mprMakeUniversalTime(tm) + msec - offset;
+    return 0;
+}
+
+
+/*
+    RFC 1123 as used by HTTP: "Sun, 06 Nov 1994 08:49:37 GMT". The day name is not validated.
+ */
+static int parseRfc1123(MprTime *when, cchar *str)
+{
+    struct tm   tm;
+    cchar       *cp;
+
+    memset(&tm, 0, sizeof(tm));
+    cp = str;
+    if (!isalpha((uchar) cp[0]) || !isalpha((uchar) cp[1]) || !isalpha((uchar) cp[2]) || cp[3] != ',' || cp[4] != ' ') {
+        return -1;
+    }
+    cp += 5;
+    if ((tm.tm_mday = parseNumber(&cp, 2)) < 0 || *cp++ != ' ') {
+        return -1;
+    }
+    if ((tm.tm_mon = parseMonthName(&cp)) < 0 || *cp++ != ' ') {
+        return -1;
+    }
+    if ((tm.tm_year = parseNumber(&cp, 4)) < 0 || *cp++ != ' ') {
+        return -1;
+    }
+    if ((tm.tm_hour = parseNumber(&cp, 2)) < 0 || *cp++ != ':' || (tm.tm_min = parseNumber(&cp, 2)) < 0 || 
+            *cp++ != ':' || (tm.tm_sec = parseNumber(&cp, 2)) < 0) {
+        return -1;
+    }
+    if (!smatch(cp, " GMT")) {
+        return -1;
+    }
+    return makeFastTime(when, &tm, 0, 0);
+}
+
+
+/*
+    ISO 8601 with an explicit time zone: "1994-11-06T08:49:37.123Z" or "1994-11-06T08:49:37-08:00". 
+    Fractional seconds are optional. Dates without a time zone are left to the general parser as they use local time.
+ */
+static int parseIso8601(MprTime *when, cchar *str)
+{
+    struct tm   tm;
+    MprTime     offset;
+    cchar       *cp;
+    int         msec, scale;
+
+    memset(&tm, 0, sizeof(tm));
+    cp = str;
+    if ((tm.tm_year = parseNumber(&cp, 4)) < 0 || *cp++ != '-' || (tm.tm_mon = parseNumber(&cp, 2)) < 0 || 
+            *cp++ != '-' || (tm.tm_mday = parseNumber(&cp, 2)) < 0 || *cp++ != 'T') {
+        return -1;
+    }
+    if ((tm.tm_hour = parseNumber(&cp, 2)) < 0 || *cp++ != ':' || (tm.tm_min = parseNumber(&cp, 2)) < 0 || 
+            *cp++ != ':' || (tm.tm_sec = parseNumber(&cp, 2)) < 0) {
+        return -1;
+    }
+    msec = 0;
+    if (*cp == '.') {
+        for (cp++, scale = 100; isdigit((uchar) *cp); cp++, scale /= 10) {
+            msec += (*cp - '0') * scale;
+        }
+    }
+    offset = 0;
+    if (*cp == 'Z') {
+        cp++;
+    } else if (parseZoneOffset(&cp, &offset) < 0) {
+        return -1;
+    }
+    if (*cp) {
+        return -1;
+    }
+    tm.tm_mon--;
+    return makeFastTime(when, &tm, msec, offset);
+}
+
+
+/*
+    Common log format as used by web server logs: "06/Nov/1994:08:49:37 -0800"
+ */
+static int parseCommonLog(MprTime *when, cchar *str)
+{
+    struct tm   tm;
+    MprTime     offset;
+    cchar       *cp;
+
+    memset(&tm, 0, sizeof(tm));
+    cp = str;
+    if ((tm.tm_mday = parseNumber(&cp, 2)) < 0 || *cp++ != '/' || (tm.tm_mon = parseMonthName(&cp)) < 0 || 
+            *cp++ != '/' || (tm.tm_year = parseNumber(&cp, 4)) < 0 || *cp++ != ':') {
+        return -1;
+    }
+    if ((tm.tm_hour = parseNumber(&cp, 2)) < 0 || *cp++ != ':' || (tm.tm_min = parseNumber(&cp, 2)) < 0 || 
+            *cp++ != ':' || (tm.tm_sec = parseNumber(&cp, 2)) < 0 || *cp++ != ' ') {
+        return -1;
+    }
+    if (parseZoneOffset(&cp, &offset) < 0 || *cp) {
+        return -1;
+    }
+    return makeFastTime(when, &tm, 0, offset);
+}
+
+
+/*
+    Parse a date string. The fixed formats used by HTTP, JSON and web server logs are tried first before falling back 
+    to the general purpose mprParseTime tokenizer.
+ */
+static int parseTime(MprTime *when, cchar *str, int zoneFlags, struct tm *defaults)
+{
+    if (str && isdigit((uchar) *str)) {
+        if (str[1] && str[2] == '/') {
+            if (parseCommonLog(when, str) == 0) {
+                return 0;
+            }
+        } else if (parseIso8601(when, str) == 0) {
+            return 0;
+        }
+    } else if (str && isalpha((uchar) *str) && parseRfc1123(when, str) == 0) {
+        return 0;
+    }
+    return mprParseTime(when, str, zoneFlags, defaults);
+}
+
+
 /*********************************** Factory **********************************/
 /*
     Create an initialized date object. Set to the current time if value is zero.
  */
-
 PUBLIC EjsDate *ejsCreateDate(Ejs *ejs, MprTime value)
 {
     EjsDate *vp;
@@ -1093,6 +1432,7 @@ PUBLIC void ejsConfigureDateType(Ejs *ejs)
     ejsBindMethod(ejs, prototype, ES_Date_toJSON, date_toJSON);
     ejsBindMethod(ejs, prototype, ES_Date_toISOString, date_toISOString);
     ejsBindMethod(ejs, prototype, ES_Date_toString, date_toString);
+    ejsBindMethod(ejs, prototype, ES_Date_toUTCString, date_toUTCString);
     ejsBindAccess(ejs, prototype, ES_Date_year, date_year, date_set_year);
 }
 
@@ -150,7 +150,10 @@ static EjsObj *fun_applyFunction(Ejs *ejs, EjsFunction *fun, int argc, EjsObj **
     assert(argc > 1);
     args = (EjsArray*) argv[1];
     assert(ejsIs(ejs, args, Array));
-
+    if (ejsUnpackArray(ejs, args) < 0) {
+        ejsThrowMemoryError(ejs);
+        return 0;
+    }
     save = fun->boundThis;
     thisObj = argv[0];
     if (thisObj == ESV(null)) {
@@ -8,19 +8,40 @@
 
 #include    "ejs.h"
 
+#if ME_CHAR_LEN == 1 && defined(__SSE2__) && defined(__GNUC__)
+    #include    <emmintrin.h>
+    #define JSON_SIMD 1
+#else
+    #define JSON_SIMD 0
+#endif
+
 /*********************************** Locals ***********************************/
 
+#define JSON_KEY_CACHE      64          /* Size of the per-parse key cache (power of 2) */
+#define JSON_STACK_INCR     64          /* Initial size of the parse value stack */
+
 typedef struct JsonState {
-    wchar      *data;
-    wchar      *end;
-    wchar      *next;
-    wchar      *error;
+    wchar       *data;                  /* Start of input */
+    wchar       *end;                   /* End of input */
+    wchar       *next;                  /* Next input character */
+    wchar       *error;                 /* Location of a parse error */
+    EjsAny      **stack;                /* Parsed array elements and object key/value pairs */
+    int         stackSize;              /* Allocated size of stack */
+    int         sp;                     /* Next free stack entry */
+    MprBuf      *buf;                   /* Buffer to decode escaped strings */
+    EjsString   *keys[JSON_KEY_CACHE];  /* Recently used property keys */
 } JsonState;
 
+#define isIdChar(c) (isalnum((uchar) (c)) || (c) == '_' || (c) == '-' || (c) == '+' || (c) == '.' || (c) == '\\')
+
+#define JSON_CHUNK          (64 * 1024) /* Size of chunks written to a serialization stream */
+
 typedef struct Json {
     MprBuf      *buf;
     EjsObj      *current;
-    EjsObj      *options;           /* Options object */
+    EjsObj      *options;           /* Options object passed to nested toJSON methods. Excludes the stream */
+    EjsObj      *stream;            /* Stream to receive serialized output */
+    EjsFunction *write;             /* Stream write method */
     EjsFunction *replacer;
     char        *indentString;
     int         indentCount;
@@ -39,9 +60,30 @@ typedef struct Json {
 
 /***************************** Forward Declarations ***************************/
 
-static EjsObj *parseLiteral(Ejs *ejs, JsonState *js);
-static EjsObj *parseLiteralInner(Ejs *ejs, MprBuf *buf, JsonState *js);
+static EjsString *createKey(Ejs *ejs, JsonState *js, wchar *str, ssize len);
+static int matchId(wchar *str, ssize len, cchar *id);
+static EjsAny *parseArray(Ejs *ejs, JsonState *js);
+static int parseHex4(wchar *cp, wchar *end);
+static EjsAny *parseId(Ejs *ejs, JsonState *js, int top);
+static EjsString *parseKey(Ejs *ejs, JsonState *js);
+static MprNumber parseNumber(Ejs *ejs, wchar *cp, wchar *end);
+static MprNumber parseDouble(wchar *cp, wchar *end);
+static EjsAny *parseObject(Ejs *ejs, JsonState *js);
+static EjsAny *parseRegExp(Ejs *ejs, JsonState *js, int top);
+static EjsString *parseString(Ejs *ejs, JsonState *js, int isKey);
+static int parseUnicode(JsonState *js, wchar **cpp);
+static EjsAny *parseValue(Ejs *ejs, JsonState *js, int top);
+static int pushValue(Ejs *ejs, JsonState *js, EjsAny *vp);
+static void putUnicode(MprBuf *buf, int c);
+static wchar *scanSpace(wchar *cp, wchar *end);
+static wchar *scanString(wchar *cp, wchar *end, int quote);
+static int skipSeparator(JsonState *js, int close);
+static int skipSpace(JsonState *js);
 static EjsString *serialize(Ejs *ejs, EjsAny *vp, Json *json);
+static int flushJson(Ejs *ejs, Json *json);
+static int setStream(Ejs *ejs, Json *json, EjsObj *options);
+static int writeStream(Ejs *ejs, Json *json, EjsString *data);
+static int writeValue(Ejs *ejs, EjsAny *vp, EjsFunction *fn, Json *json);
 
 /*********************************** Locals ***********************************/
 /*
@@ -63,8 +105,12 @@ static EjsString *g_serialize(Ejs *ejs, EjsObj *unused, int argc, EjsObj **argv)
 }
 
 
-//  TODO - convert to use MPR json parser
-
+/*
+    Parse a JSON string. This is a single pass recursive descent parser that builds arrays and objects directly. 
+    It supports the relaxed JSON permitted by serialize(): unquoted keys and values, single and back quoted strings, 
+    comments, trailing commas, hex and octal numbers, undefined and regular expression literals.
+    Top level unquoted values are returned as strings (except null and undefined).
+ */
 PUBLIC EjsAny *ejsDeserialize(Ejs *ejs, EjsString *str)
 {
     EjsObj      *obj;
@@ -77,10 +123,21 @@ PUBLIC EjsAny *ejsDeserialize(Ejs *ejs, EjsString *str)
     if (str->length == 0) {
         return ESV(empty);
     }
+    memset(&js, 0, sizeof(js));
     js.next = js.data = str->value;
     js.end = &js.data[str->length];
-    js.error = 0;
-    if ((obj = parseLiteral(ejs, &js)) == 0) {
+
+    if ((obj = parseValue(ejs, &js, 1)) != 0) {
+        if (skipSpace(&js) && js.next < js.end) {
+            /* Trailing garbage */
+            js.error = js.next;
+            obj = 0;
+        }
+    }
+    if (obj == 0) {
+        if (ejs->exception) {
+            return 0;
+        }
         if (js.error) {
             ejsThrowSyntaxError(ejs, 
                 "Cannot parse object literal. Error at position %d.\n"
@@ -99,321 +156,598 @@ PUBLIC EjsAny *ejsDeserialize(Ejs *ejs, EjsString *str)
 }
 
 
-static EjsObj *parseLiteral(Ejs *ejs, JsonState *js)
+static EjsAny *parseValue(Ejs *ejs, JsonState *js, int top)
 {
-    assert(js);
+    wchar   *cp;
 
-    return parseLiteralInner(ejs, mprCreateBuf(0, 0), js);
+    if (!skipSpace(js)) {
+        return 0;
+    }
+    cp = js->next;
+    if (cp >= js->end) {
+        js->error = cp;
+        return 0;
+    }
+    switch (*cp) {
+    case '{':
+        return parseObject(ejs, js);
+    case '[':
+        return parseArray(ejs, js);
+    case '"':
+    case '\'':
+    case '`':
+        return parseString(ejs, js, 0);
+    case '/':
+        return parseRegExp(ejs, js, top);
+    default:
+        return parseId(ejs, js, top);
+    }
 }
 
 
-typedef enum Token {
-    TOK_ERR,            /* Error */
-    TOK_EOF,            /* End of input */
-    TOK_LBRACE,         /* { */
-    TOK_LBRACKET,       /* [ */
-    TOK_RBRACE,         /* } */
-    TOK_RBRACKET,       /* ] */
-    TOK_COLON,          /* : */
-    TOK_COMMA,          /* , */
-    TOK_ID,             /* Unquoted ID */
-    TOK_QID,            /* Quoted ID */
-} Token;
+static EjsAny *parseObject(Ejs *ejs, JsonState *js)
+{
+    EjsPot      *obj;
+    EjsString   *key;
+    EjsAny      *vp;
+    EjsName     qname;
+    int         base, count, i;
 
+    base = js->sp;
+    js->next++;
+    while (1) {
+        if (!skipSpace(js)) {
+            return 0;
+        }
+        if (js->next >= js->end) {
+            js->error = js->next;
+            return 0;
+        }
+        if (*js->next == '}') {
+            js->next++;
+            break;
+        }
+        if ((key = parseKey(ejs, js)) == 0) {
+            return 0;
+        }
+        if (!skipSpace(js)) {
+            return 0;
+        }
+        if (js->next >= js->end || *js->next != ':') {
+            js->error = js->next;
+            return 0;
+        }
+        js->next++;
+        if ((vp = parseValue(ejs, js, 0)) == 0) {
+            return 0;
+        }
+        if (pushValue(ejs, js, key) < 0 || pushValue(ejs, js, vp) < 0) {
+            return 0;
+        }
+        if (!skipSeparator(js, '}')) {
+            return 0;
+        }
+    }
+    count = (js->sp - base) / 2;
+    if ((obj = ejsCreatePot(ejs, ESV(Object), count)) == 0) {
+        ejsThrowMemoryError(ejs);
+        return 0;
+    }
+    /*
+        The property slots are pre-allocated. Define properties in order so duplicate keys take the last value.
+     */
+    obj->numProp = 0;
+    qname.space = ESV(empty);
+    for (i = base; i < js->sp; i += 2) {
+        qname.name = js->stack[i];
+        if (ejsSetPropertyByName(ejs, obj, qname, js->stack[i + 1]) < 0) {
+            ejsThrowMemoryError(ejs);
+            return 0;
+        }
+    }
+    js->sp = base;
+    return obj;
+}
 
-static wchar *skipComments(wchar *cp, wchar *end)
+
+static EjsAny *parseArray(Ejs *ejs, JsonState *js)
 {
-    int     inComment;
+    EjsArray    *ap;
+    EjsAny      *vp;
+    int         base, count;
 
-    for (; cp < end && isspace((uchar) *cp); cp++) {}
+    base = js->sp;
+    js->next++;
+    while (1) {
+        if (!skipSpace(js)) {
+            return 0;
+        }
+        if (js->next >= js->end) {
+            js->error = js->next;
+            return 0;
+        }
+        if (*js->next == ']') {
+            js->next++;
+            break;
+        }
+        if ((vp = parseValue(ejs, js, 0)) == 0) {
+            return 0;
+        }
+        if (pushValue(ejs, js, vp) < 0) {
+            return 0;
+        }
+        if (!skipSeparator(js, ']')) {
+            return 0;
+        }
+    }
+    count = js->sp - base;
+    if ((ap = ejsCreateArray(ejs, count)) == 0) {
+        return 0;
+    }
+    if (count > 0) {
+        memcpy(ap->data, &js->stack[base], count * sizeof(EjsAny*));
+    }
+    js->sp = base;
+    return ap;
+}
 
-    while (cp < &end[-1]) {
-        if (cp < &end[-1] && *cp == '/' && cp[1] == '*') {
-            inComment = 1;
-            for (cp += 2; cp < &end[-1]; cp++) {
-                if (*cp == '*' && cp[1] == '/') {
-                    inComment = 0;
-                    cp += 2;
-                    break;
-                }
-            }
-            if (inComment) {
-                return 0;
-            }
-            while (cp < end && isspace((uchar) *cp)) cp++;
-
-        } else  if (cp < &end[-1] && *cp == '/' && cp[1] == '/') {
-            inComment = 1;
-            for (cp += 2; cp < end; cp++) {
-                if (*cp == '\n') {
-                    inComment = 0;
-                    cp++;
-                    break;
-                }
-            }
-            if (inComment) {
+
+/*
+    Parse a property key. Keys are frequently repeated (arrays of objects), so recent keys are cached.
+ */
+static EjsString *parseKey(Ejs *ejs, JsonState *js)
+{
+    wchar   *start, *cp;
+    int     c;
+
+    c = *js->next;
+    if (c == '"' || c == '\'' || c == '`') {
+        return parseString(ejs, js, 1);
+    }
+    for (start = cp = js->next; cp < js->end && isIdChar(*cp); cp++) {}
+    if (cp == start) {
+        js->error = cp;
+        return 0;
+    }
+    js->next = cp;
+    return createKey(ejs, js, start, cp - start);
+}
+
+
+static EjsString *createKey(Ejs *ejs, JsonState *js, wchar *str, ssize len)
+{
+    EjsString   *sp;
+    uint        hash;
+    ssize       i;
+
+    for (hash = (uint) len, i = 0; i < len; i++) {
+        hash = hash * 31 + (uchar) str[i];
+    }
+    hash &= JSON_KEY_CACHE - 1;
+    sp = js->keys[hash];
+    if (sp && sp->length == len && memcmp(sp->value, str, len * sizeof(wchar)) == 0) {
+        return sp;
+    }
+    if ((sp = ejsCreateString(ejs, str, len)) != 0) {
+        js->keys[hash] = sp;
+    }
+    return sp;
+}
+
+
+/*
+    Parse a quoted string. Strings without escapes are created directly from the input.
+ */
+static EjsString *parseString(Ejs *ejs, JsonState *js, int isKey)
+{
+    wchar   *start, *cp, *end;
+    int     quote, c;
+
+    end = js->end;
+    quote = *js->next;
+    start = js->next + 1;
+    cp = scanString(start, end, quote);
+    if (cp < end && *cp == quote) {
+        js->next = cp + 1;
+        return isKey ? createKey(ejs, js, start, cp - start) : ejsCreateString(ejs, start, cp - start);
+    }
+    if (js->buf == 0) {
+        js->buf = mprCreateBuf(0, 0);
+    } else {
+        mprFlushBuf(js->buf);
+    }
+    mprPutBlockToBuf(js->buf, (char*) start, (cp - start) * sizeof(wchar));
+    while (cp < end && *cp != quote) {
+        if (*cp != '\\') {
+            start = cp;
+            cp = scanString(cp, end, quote);
+            mprPutBlockToBuf(js->buf, (char*) start, (cp - start) * sizeof(wchar));
+            continue;
+        }
+        if (++cp >= end) {
+            break;
+        }
+        c = *cp++;
+        switch (c) {
+        case 'b': c = '\b'; break;
+        case 'f': c = '\f'; break;
+        case 'n': c = '\n'; break;
+        case 'r': c = '\r'; break;
+        case 't': c = '\t'; break;
+        case 'u':
+            if ((c = parseUnicode(js, &cp)) < 0) {
                 return 0;
             }
-            while (cp < end && isspace((uchar) *cp)) cp++;
-
-        } else {
+            putUnicode(js->buf, c);
+            continue;
+        default:
             break;
         }
+        putUnicode(js->buf, c);
     }
-    return cp;
+    if (cp >= end) {
+        /* Unterminated string */
+        js->error = js->next;
+        return 0;
+    }
+    js->next = cp + 1;
+    return ejsCreateString(ejs, (wchar*) mprGetBufStart(js->buf), mprGetBufLength(js->buf) / sizeof(wchar));
 }
 
 
-Token getNextJsonToken(MprBuf *buf, wchar **token, JsonState *js)
+/*
+    Parse the hex digits of a \uXXXX escape including surrogate pairs. On entry, cp points after the "u".
+ */
+static int parseUnicode(JsonState *js, wchar **cpp)
 {
-    wchar       *start, *cp, *end, *next;
-    wchar       *src, *dest;
-    int         quote, tid, c, isReg;
+    wchar   *cp;
+    int     c, lo;
 
-    if (buf) {
-        mprFlushBuf(buf);
+    cp = *cpp;
+    if ((c = parseHex4(cp, js->end)) < 0) {
+        js->error = cp;
+        return -1;
     }
-    cp = js->next;
-    end = js->end;
-    cp = skipComments(cp, end);
-    next = cp + 1;
-    quote = -1;
-    isReg = 0;
-
-    if (*cp == '\0') {
-        tid = TOK_EOF;
-
-    } else  if (*cp == '{') {
-        tid = TOK_LBRACE;
-
-    } else if (*cp == '[') {
-        tid = TOK_LBRACKET;
-
-    } else if (*cp == '}' || *cp == ']') {
-        tid = *cp == '}' ? TOK_RBRACE: TOK_RBRACKET;
-        while (*++cp && isspace((uchar) *cp)) ;
-        /*
-            Detect missing comma after closing brace/bracket
-         */
-        if (*cp && *cp != ',' && *cp != '}' && *cp != ']' && *cp != '/') {
-            js->error = cp;
-            return TOK_ERR;
-        }
-        if (*cp == ',' || *cp == ':') {
-            cp++;
+    cp += 4;
+    if (c >= 0xD800 && c <= 0xDBFF && &cp[6] <= js->end && cp[0] == '\\' && cp[1] == 'u') {
+        if ((lo = parseHex4(&cp[2], js->end)) >= 0xDC00 && lo <= 0xDFFF) {
+            c = 0x10000 + ((c - 0xD800) << 10) + (lo - 0xDC00);
+            cp += 6;
         }
-        next = cp;
+    }
+    *cpp = cp;
+    return c;
+}
 
-    } else {
-        if (*cp == '"' || *cp == '\'' || *cp == '`') {
-            tid = TOK_QID;
-            quote = *cp++;
-            for (start = cp; cp < end; cp++) {
-                if (*cp == '\\' && &cp[1] < end) {
-                    cp++;
-                } else if (*cp == quote) {
-                    break;
-                }
-            }
-            if (*cp != quote) {
-                js->error = cp;
-                return TOK_ERR;
-            }
-            if (buf) {
-                mprPutBlockToBuf(buf, (char*) start, (cp - start));
-            }
-            cp++;
 
-        } else if (*cp == '/') {
-            tid = TOK_ID;
-            isReg = 1;
-            for (start = cp++; cp < end; cp++) {
-                if (*cp == '\\') {
-                    if (cp[1] == '/') {
-                        cp++;
-                    }
-                    continue;
-                }
-                if (*cp == '/') {
-                    break;
-                }
-            }
-            if (*cp != '/') {
-                js->error = cp;
-                return TOK_ERR;
-            }
-            if (buf) {
-                mprPutBlockToBuf(buf, (char*) start, (cp - start + 1));
-            }
-            cp++;
+static int parseHex4(wchar *cp, wchar *end)
+{
+    int     c, i, value;
 
+    if (&cp[4] > end) {
+        return -1;
+    }
+    for (value = 0, i = 0; i < 4; i++) {
+        c = tolower((uchar) cp[i]);
+        if (isdigit((uchar) c)) {
+            value = (value << 4) + (c - '0');
+        } else if (c >= 'a' && c <= 'f') {
+            value = (value << 4) + (c - 'a' + 10);
         } else {
-            /*
-                Note: this is for keys and values
-             */
-            tid = TOK_ID;
-            for (start = cp; cp < end; cp++) {
-                if (*cp == '\\') {
-                    continue;
-                }
-                /* 
-                    Not an allowable character outside quotes (TODO - removed space 
-                    Should really keep state for parsing keys or values and not allow -,+,. in keys
-                 */
-                if (!(isalnum((uchar) *cp) || *cp == '_' || *cp == '-' || *cp == '+' || *cp == '.')) {
-                    break;
-                }
-            }
-            if (buf) {
-                mprPutBlockToBuf(buf, (char*) start, (int) (cp - start));
-            }
-        }
-        if (buf) {
-            mprAddNullToBuf(buf);
-        }
-        while (*cp && isspace((int) *cp)) cp++;
-        if (*cp == ',' || *cp == ':') {
-            cp++;
-        } else if (*cp != '}' && *cp != ']' && *cp != '\0' && *cp != '\n' && *cp != '\r' && *cp != ' ') {
-            js->error = cp;
-            return TOK_ERR;
-        }
-        next = cp;
-
-        if (buf) {
-            for (dest = src = (wchar*) buf->start; src < (wchar*) buf->end; ) {
-                c = *src++;
-                if (c == '\\' && !isReg) {
-                    c = *src++;
-                    if (c == 'r') {
-                        c = '\r';
-                    } else if (c == 'n') {
-                        c = '\n';
-                    } else if (c == 'b') {
-                        c = '\b';
-                    }
-                }
-                *dest++ = c;
-            }
-            *dest = '\0';
-            *token = (wchar*) mprGetBufStart(buf);
+            return -1;
         }
     }
-    js->next = next;
-    return tid;
+    return value;
 }
 
 
-Token peekNextJsonToken(JsonState *js)
+static void putUnicode(MprBuf *buf, int c)
 {
-    JsonState   discard = *js;
-    return getNextJsonToken(NULL, NULL, &discard);
+#if ME_CHAR_LEN == 1
+    if (c < 0x80) {
+        mprPutCharToBuf(buf, c);
+    } else if (c < 0x800) {
+        mprPutCharToBuf(buf, 0xC0 | (c >> 6));
+        mprPutCharToBuf(buf, 0x80 | (c & 0x3F));
+    } else if (c < 0x10000) {
+        mprPutCharToBuf(buf, 0xE0 | (c >> 12));
+        mprPutCharToBuf(buf, 0x80 | ((c >> 6) & 0x3F));
+        mprPutCharToBuf(buf, 0x80 | (c & 0x3F));
+    } else {
+        mprPutCharToBuf(buf, 0xF0 | (c >> 18));
+        mprPutCharToBuf(buf, 0x80 | ((c >> 12) & 0x3F));
+        mprPutCharToBuf(buf, 0x80 | ((c >> 6) & 0x3F));
+        mprPutCharToBuf(buf, 0x80 | (c & 0x3F));
+    }
+#else
+    wchar   w;
+
+    w = (wchar) c;
+    mprPutBlockToBuf(buf, (char*) &w, sizeof(wchar));
+#endif
 }
 
 
 /*
-    Parse an object literal string pointed to by js->next into the given buffer. Update js->next to point
-    to the next input token in the object literal. Supports nested object literals.
+    Parse an unquoted token: numbers, true, false, null, undefined and bare words
  */
-static EjsObj *parseLiteralInner(Ejs *ejs, MprBuf *buf, JsonState *js)
+static EjsAny *parseId(Ejs *ejs, JsonState *js, int top)
 {
-    EjsAny      *obj, *vp;
-    MprBuf      *valueBuf;
-    wchar       *token, *key, *value;
-    int         tid, isArray;
+    wchar   *start, *cp;
+    ssize   len;
+    int     c;
 
-    isArray = 0;
-
-    tid = getNextJsonToken(buf, &token, js);
-    if (tid == TOK_ERR || tid == TOK_EOF) {
+    for (start = cp = js->next; cp < js->end && isIdChar(*cp); cp++) {}
+    if ((len = cp - start) == 0) {
+        js->error = cp;
         return 0;
     }
-    if (tid == TOK_LBRACKET) {
-        isArray = 1;
-        obj = (EjsObj*) ejsCreateArray(ejs, 0);
-    } else if (tid == TOK_LBRACE) {
-        obj = ejsCreateEmptyPot(ejs);
-    } else {
-        return ejsParse(ejs, token, S_String);
+    js->next = cp;
+    c = *start;
+    if (top) {
+        /* Compatibility: top level tokens are strings */
+        if (matchId(start, len, "null")) {
+            return ESV(null);
+        } else if (matchId(start, len, "undefined")) {
+            return ESV(undefined);
+        }
+        return ejsCreateString(ejs, start, len);
     }
-    if (obj == 0) {
-        ejsThrowMemoryError(ejs);
-        return 0;
+    if (isdigit((uchar) c) || c == '-' || c == '+' || c == '.') {
+        return ejsCreateNumber(ejs, parseNumber(ejs, start, cp));
+
+    } else if (matchId(start, len, "true")) {
+        return ESV(true);
+
+    } else if (matchId(start, len, "false")) {
+        return ESV(false);
+
+    } else if (matchId(start, len, "null")) {
+        return ESV(null);
+
+    } else if (matchId(start, len, "undefined")) {
+        return ESV(undefined);
     }
-    while (1) {
-        vp = 0;
-        tid = peekNextJsonToken(js);
-        if (tid == TOK_ERR) {
+    return ejsCreateString(ejs, start, len);
+}
+
+
+static int matchId(wchar *str, ssize len, cchar *id)
+{
+    ssize   i;
+
+    for (i = 0; i < len; i++) {
+        if (id[i] == '\0' || str[i] != (wchar) id[i]) {
             return 0;
-        } else if (tid == TOK_EOF) {
-            break;
-        } else if (tid == TOK_RBRACE || tid == TOK_RBRACKET) {
-            getNextJsonToken(buf, &key, js);
-            break;
         }
-        if (tid == TOK_LBRACKET) {
-            /* For array values */
-            vp = parseLiteral(ejs, js);
-            assert(vp);
-            
-        } else if (tid == TOK_LBRACE) {
-            /* For object values */
-            vp = parseLiteral(ejs, js);
-            assert(vp);
-            
-        } else if (isArray) {
-            tid = getNextJsonToken(buf, &value, js);
-            vp = ejsParse(ejs, value, (tid == TOK_QID) ? S_String: -1);
-            assert(vp);
-            
-        } else {
-            getNextJsonToken(buf, &key, js);
-            tid = peekNextJsonToken(js);
-            if (tid == TOK_ERR) {
-                return 0;
-            } else if (tid == TOK_EOF) {
-                break;
-            } else if (tid == TOK_LBRACE || tid == TOK_LBRACKET) {
-                vp = parseLiteral(ejs, js);
-
-            } else if (tid == TOK_ID || tid == TOK_QID) {
-                valueBuf = mprCreateBuf(0, 0);
-                getNextJsonToken(valueBuf, &value, js);
-                if (tid == TOK_QID) {
-                    vp = ejsCreateString(ejs, value, strlen(value));
-                } else {
-                    if (mcmp(value, "null") == 0) {
-                        vp = ESV(null);
-                    } else if (mcmp(value, "undefined") == 0) {
-                        vp = ESV(undefined);
-                    } else {
-                        vp = ejsParse(ejs, value, -1);
-                    }
-                }
-                assert(vp);
+    }
+    return id[i] == '\0';
+}
+
+
+/*
+    Parse a number token directly. Supports hex (0x), octal (leading 0), integer and floating formats.
+ */
+static MprNumber parseNumber(Ejs *ejs, wchar *cp, wchar *end)
+{
+    MprNumber   n;
+    wchar       *sp;
+    int64       num;
+    int         c, negative, digits;
+
+    negative = 0;
+    if (*cp == '-' || *cp == '+') {
+        negative = (*cp++ == '-');
+    }
+    if (cp >= end || (*cp != '.' && !isdigit((uchar) *cp))) {
+        return ((EjsNumber*) ESV(nan))->value;
+    }
+    num = 0;
+    if (*cp == '0' && &cp[1] < end && tolower((uchar) cp[1]) == 'x') {
+        for (cp += 2; cp < end; cp++) {
+            c = tolower((uchar) *cp);
+            if (isdigit((uchar) c)) {
+                num = (num << 4) + (c - '0');
+            } else if (c >= 'a' && c <= 'f') {
+                num = (num << 4) + (c - 'a' + 10);
             } else {
-                getNextJsonToken(buf, &value, js);
-                js->error = js->next;
-                return 0;
+                break;
             }
         }
-        if (vp == 0) {
-            js->error = js->next;
-            return 0;
+    } else {
+        for (sp = cp; sp < end; sp++) {
+            if (*sp == '.' || *sp == 'e' || *sp == 'E') {
+                n = parseDouble(cp, end);
+                return negative ? -n : n;
+            }
         }
-        if (isArray) {
-            if (ejsSetProperty(ejs, obj, -1, vp) < 0) {
-                ejsThrowMemoryError(ejs);
-                return 0;
+        if (*cp == '0') {
+            for (cp++; cp < end && *cp >= '0' && *cp <= '7'; cp++) {
+                num = (num << 3) + (*cp - '0');
             }
         } else {
-            if (ejsSetPropertyByName(ejs, obj, WEN(key), vp) < 0) {
-                ejsThrowMemoryError(ejs);
+            for (digits = 0; cp < end && isdigit((uchar) *cp); cp++, digits++) {
+                if (digits >= 18) {
+                    /* Too big for an int64 */
+                    n = parseDouble(&cp[-digits], end);
+                    return negative ? -n : n;
+                }
+                num = (num * 10) + (*cp - '0');
+            }
+        }
+    }
+    return (MprNumber) (negative ? -num : num);
+}
+
+
+/*
+    Parse a floating point number. The token is bounded by a non-numeric character so strtod will stop within the token.
+    Wide tokens are first narrowed.
+ */
+static MprNumber parseDouble(wchar *cp, wchar *end)
+{
+#if ME_CHAR_LEN > 1
+    char    nbuf[64], *buf;
+    ssize   i, len;
+
+    len = end - cp;
+    if ((buf = (len < (ssize) sizeof(nbuf)) ? nbuf : mprAlloc(len + 1)) == 0) {
+        return 0;
+    }
+    for (i = 0; i < len && cp[i] < 0x80; i++) {
+        buf[i] = (char) cp[i];
+    }
+    buf[i] = '\0';
+    return strtod(buf, NULL);
+#else
+    return strtod((char*) cp, NULL);
+#endif
+}
+
+
+static EjsAny *parseRegExp(Ejs *ejs, JsonState *js, int top)
+{
+    wchar   *start, *cp, *end;
+
+    end = js->end;
+    start = js->next;
+    for (cp = start + 1; cp < end && *cp != '/'; cp++) {
+        if (*cp == '\\' && &cp[1] < end) {
+            cp++;
+        }
+    }
+    if (cp >= end) {
+        js->error = start;
+        return 0;
+    }
+    /* Flags */
+    for (cp++; cp < end && isalpha((uchar) *cp); cp++) {}
+    js->next = cp;
+#if ME_COM_PCRE
+    if (!top) {
+        return ejsParseRegExp(ejs, ejsCreateString(ejs, start, cp - start));
+    }
+#endif
+    return ejsCreateString(ejs, start, cp - start);
+}
+
+
+/*
+    Skip white space and comments. Return false for an unterminated comment.
+ */
+static int skipSpace(JsonState *js)
+{
+    wchar   *cp, *end;
+
+    cp = js->next;
+    end = js->end;
+    while (cp < end) {
+        if (isspace((uchar) *cp)) {
+            cp = scanSpace(cp + 1, end);
+
+        } else if (*cp == '/' && &cp[1] < end && cp[1] == '*') {
+            for (cp += 2; &cp[1] < end && !(cp[0] == '*' && cp[1] == '/'); cp++) {}
+            if (&cp[1] >= end) {
+                js->error = js->next;
                 return 0;
             }
+            cp += 2;
+
+        } else if (*cp == '/' && &cp[1] < end && cp[1] == '/') {
+            for (cp += 2; cp < end && *cp != '\n'; cp++) {}
+
+        } else {
+            break;
         }
     }
-    return obj;
+    js->next = cp;
+    return 1;
+}
+
+
+/*
+    Skip a comma after an array element or object property. The closing bracket must follow if there is no comma.
+ */
+static int skipSeparator(JsonState *js, int close)
+{
+    if (!skipSpace(js)) {
+        return 0;
+    }
+    if (js->next < js->end) {
+        if (*js->next == ',') {
+            js->next++;
+            return 1;
+        } else if (*js->next == close) {
+            return 1;
+        }
+    }
+    js->error = js->next;
+    return 0;
+}
+
+
+static int pushValue(Ejs *ejs, JsonState *js, EjsAny *vp)
+{
+    if (js->sp >= js->stackSize) {
+        js->stackSize = max(js->stackSize * 2, JSON_STACK_INCR);
+        if ((js->stack = mprRealloc(js->stack, js->stackSize * sizeof(EjsAny*))) == 0) {
+            ejsThrowMemoryError(ejs);
+            return MPR_ERR_MEMORY;
+        }
+    }
+    js->stack[js->sp++] = vp;
+    return 0;
+}
+
+
+/*
+    Return the first quote or backslash character in a string
+ */
+static wchar *scanString(wchar *cp, wchar *end, int quote)
+{
+#if JSON_SIMD
+    __m128i     vquote, vslash, data;
+    int         mask;
+
+    vquote = _mm_set1_epi8((char) quote);
+    vslash = _mm_set1_epi8('\\');
+    while (end - cp >= 16) {
+        data = _mm_loadu_si128((__m128i*) cp);
+        mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(data, vquote), _mm_cmpeq_epi8(data, vslash)));
+        if (mask) {
+            return cp + __builtin_ctz(mask);
+        }
+        cp += 16;
+    }
+#endif
+    for (; cp < end && *cp != quote && *cp != '\\'; cp++) {}
+    return cp;
+}
+
+
+/*
+    Return the first non-white space character. Indented output has long runs of spaces.
+ */
+static wchar *scanSpace(wchar *cp, wchar *end)
+{
+#if JSON_SIMD
+    __m128i     data, space;
+    int         mask;
+
+    while (end - cp >= 16) {
+        data = _mm_loadu_si128((__m128i*) cp);
+        space = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(data, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(data, _mm_set1_epi8('\n'))),
+            _mm_or_si128(_mm_cmpeq_epi8(data, _mm_set1_epi8('\t')), _mm_cmpeq_epi8(data, _mm_set1_epi8('\r'))));
+        mask = ~_mm_movemask_epi8(space) & 0xFFFF;
+        if (mask) {
+            cp += __builtin_ctz(mask);
+            break;
+        }
+        cp += 16;
+    }
+#endif
+    for (; cp < end && isspace((uchar) *cp); cp++) {}
+    return cp;
 }
 
 
@@ -427,15 +761,25 @@ PUBLIC EjsString *ejsToJSON(Ejs *ejs, EjsAny *vp, EjsObj *options)
     EjsFunction     *fn;
     EjsString       *result;
     EjsObj          *argv[1];
+    Json            json;
     int             argc;
 
     fn = (EjsFunction*) ejsGetPropertyByName(ejs, TYPE(vp)->prototype, N(NULL, "toJSON"));
     if (!ejsIsFunction(ejs, fn) || (fn->isNativeProc && fn->body.proc == (EjsProc) ejsObjToJSON)) {
         result = ejsSerializeWithOptions(ejs, vp, options);
     } else {
-        argv[0] = options;
+        memset(&json, 0, sizeof(Json));
+        json.options = options;
+        if (options && setStream(ejs, &json, options) < 0) {
+            return 0;
+        }
+        argv[0] = json.options;
         argc = options ? 1 : 0;
         result = (EjsString*) ejsRunFunction(ejs, fn, vp, argc, argv);
+        if (result && json.stream) {
+            /* Custom toJSON result is written to the stream here, once */
+            result = (writeStream(ejs, &json, ejsToString(ejs, result)) < 0) ? 0 : ESV(empty);
+        }
     }
     return result;
 }
@@ -447,6 +791,7 @@ PUBLIC EjsString *ejsSerializeWithOptions(Ejs *ejs, EjsAny *vp, EjsObj *options)
 {
     Json        json;
     EjsObj      *arg;
+    EjsString   *result;
     int         enable;
 
     memset(&json, 0, sizeof(Json));
@@ -505,8 +850,17 @@ PUBLIC EjsString *ejsSerializeWithOptions(Ejs *ejs, EjsAny *vp, EjsObj *options)
         if (!ejsIsFunction(ejs, json.replacer)) {
             json.replacer = NULL;
         }
+        if (setStream(ejs, &json, options) < 0) {
+            return 0;
+        }
     }
-    return serialize(ejs, vp, &json);
+    if (!json.stream) {
+        return serialize(ejs, vp, &json);
+    }
+    mprAddRoot(json.options);
+    result = serialize(ejs, vp, &json);
+    mprRemoveRoot(json.options);
+    return result;
 }
 
 
@@ -536,7 +890,6 @@ static EjsString *serialize(Ejs *ejs, EjsAny *vp, Json *json)
     EjsTrait    *trait;
     EjsObj      *pp, *obj, *replacerArgs[2];
     wchar       *cp;
-    cchar       *key;
     int         c, isArray, i, j, count, slotNum, quotes, sameline, items;
 
     /*
@@ -547,12 +900,16 @@ static EjsString *serialize(Ejs *ejs, EjsAny *vp, Json *json)
     if (count == 0 && TYPE(vp) != ESV(Object) && TYPE(vp) != ESV(Array)) {
         //  OPT - need some flag for this test.
         if (!ejsIsDefined(ejs, vp) || ejsIs(ejs, vp, Boolean) || ejsIs(ejs, vp, Number)) {
-            return ejsToString(ejs, vp);
+            result = ejsToString(ejs, vp);
         } else if (json->regexp) {
-            return ejsToString(ejs, vp);
+            result = ejsToString(ejs, vp);
         } else {
-            return ejsToLiteralString(ejs, vp);
+            result = ejsToLiteralString(ejs, vp);
         }
+        if (json->stream && json->nest == 0 && result) {
+            return (writeStream(ejs, json, result) < 0) ? 0 : ESV(empty);
+        }
+        return result;
     }
     obj = vp;
     json->nest++;
@@ -586,15 +943,21 @@ static EjsString *serialize(Ejs *ejs, EjsAny *vp, Json *json)
                 continue;
             }
             if (isArray) {
-                key = itos(slotNum);
-                qname.name = ejsCreateStringFromAsc(ejs, key);
+                /* Array keys are not emitted. Only create the key if required by the replacer. */
+                qname.name = json->replacer ? ejsCreateStringFromAsc(ejs, itos(slotNum)) : 0;
                 qname.space = ESV(empty);
             } else {
                 qname = ejsGetPropertyName(ejs, vp, slotNum);
             }
-
+            if (json->stream && mprGetBufLength(json->buf) >= JSON_CHUNK) {
+                if (flushJson(ejs, json) < 0) {
+                    SET_VISITED(obj, 0);
+                    json->nest--;
+                    return 0;
+                }
+            }
             quotes = json->quotes;
-            if (!quotes) {
+            if (!quotes && !isArray) {
                 //  UNICODE
                 for (cp = qname.name->value; cp < &qname.name->value[qname.name->length]; cp++) {
                     if (!isalnum((uchar) *cp) && *cp != '_') {
@@ -641,15 +1004,17 @@ static EjsString *serialize(Ejs *ejs, EjsAny *vp, Json *json)
                 }
             }
             fn = (EjsFunction*) ejsGetPropertyByName(ejs, TYPE(pp)->prototype, N(NULL, "toJSON"));
-            // OPT - check that this is going directly to serialize most of the time
-            if (!ejsIsFunction(ejs, fn) || (fn->isNativeProc && fn->body.proc == (EjsProc) ejsObjToJSON)) {
+            if (!json->replacer && writeValue(ejs, pp, fn, json)) {
+                /* Primitive value written directly to the buffer */
+                sv = 0;
+            } else if (!ejsIsFunction(ejs, fn) || (fn->isNativeProc && fn->body.proc == (EjsProc) ejsObjToJSON)) {
                 sv = serialize(ejs, pp, json);
             } else {
-                sv = (EjsString*) ejsRunFunction(ejs, fn, pp, 1, &json->options);
+                sv = (EjsString*) ejsRunFunction(ejs, fn, pp, json->options ? 1 : 0, &json->options);
             }
             if (sv == 0 || !ejsIs(ejs, sv, String)) {
                 if (ejs->exception) {
-                    ejsThrowTypeError(ejs, "Cannot serialize property %@", qname.name);
+                    ejsThrowTypeError(ejs, "Cannot serialize property %@", qname.name ? qname.name : ESV(empty));
                     SET_VISITED(obj, 0);
                     return 0;
                 }
@@ -706,7 +1071,11 @@ static EjsString *serialize(Ejs *ejs, EjsAny *vp, Json *json)
     mprAddNullToWideBuf(json->buf);
 
     if (--json->nest == 0) {
-        result = ejsCreateString(ejs, mprGetBufStart(json->buf), mprGetBufLength(json->buf) / sizeof(wchar));
+        if (json->stream) {
+            result = (flushJson(ejs, json) < 0) ? 0 : ESV(empty);
+        } else {
+            result = ejsCreateString(ejs, mprGetBufStart(json->buf), mprGetBufLength(json->buf) / sizeof(wchar));
+        }
         mprRemoveRoot(json->buf);
     } else {
         result = 0;
@@ -715,6 +1084,121 @@ static EjsString *serialize(Ejs *ejs, EjsAny *vp, Json *json)
 }
 
 
+/*
+    Write primitive values directly to the serialization buffer without creating intermediate strings.
+    Return false if the value must be serialized via its toJSON method.
+ */
+static int writeValue(Ejs *ejs, EjsAny *vp, EjsFunction *fn, Json *json)
+{
+    EjsString   *sp;
+    MprNumber   n;
+    wchar       *cp, *start, *end;
+    char        nbuf[32];
+    int         c;
+
+    if (TYPE(vp) == ESV(String)) {
+        if (!ejsIsFunction(ejs, fn) || !fn->isNativeProc || fn->body.proc != (EjsProc) ejsToLiteralString) {
+            return 0;
+        }
+        sp = (EjsString*) vp;
+        end = &sp->value[sp->length];
+        mprPutCharToWideBuf(json->buf, '"');
+        for (start = cp = sp->value; cp < end; cp++) {
+            c = *cp;
+            if (c == '"' || c == '\\' || (c == '\n' && !json->multiline)) {
+                mprPutBlockToBuf(json->buf, (char*) start, (cp - start) * sizeof(wchar));
+                mprPutCharToWideBuf(json->buf, '\\');
+                mprPutCharToWideBuf(json->buf, c == '\n' ? 'n' : c);
+                start = cp + 1;
+            }
+        }
+        mprPutBlockToBuf(json->buf, (char*) start, (cp - start) * sizeof(wchar));
+        mprPutCharToWideBuf(json->buf, '"');
+        return 1;
+    }
+    if (ejsIsFunction(ejs, fn) && !(fn->isNativeProc && fn->body.proc == (EjsProc) ejsObjToJSON)) {
+        return 0;
+    }
+    if (TYPE(vp) == ESV(Number)) {
+        n = ((EjsNumber*) vp)->value;
+        if (n > -1e15 && n < 1e15 && n == (MprNumber) (int64) n) {
+            mprPutStringToWideBuf(json->buf, itosbuf(nbuf, sizeof(nbuf), (int64) n, 10));
+        } else {
+            sp = ejsToString(ejs, vp);
+            mprPutBlockToBuf(json->buf, (char*) sp->value, sp->length * sizeof(wchar));
+        }
+        return 1;
+
+    } else if (vp == ESV(true) || vp == ESV(false)) {
+        mprPutStringToWideBuf(json->buf, vp == ESV(true) ? "true" : "false");
+        return 1;
+
+    } else if (vp == ESV(null) || vp == ESV(undefined)) {
+        mprPutStringToWideBuf(json->buf, vp == ESV(null) ? "null" : "undefined");
+        return 1;
+    }
+    return 0;
+}
+
+
+/*
+    Write the buffered output to the serialization stream
+ */
+static int flushJson(Ejs *ejs, Json *json)
+{
+    EjsString   *chunk;
+    ssize       len;
+
+    if ((len = mprGetBufLength(json->buf) / sizeof(wchar)) > 0) {
+        chunk = ejsCreateString(ejs, (wchar*) mprGetBufStart(json->buf), len);
+        mprFlushBuf(json->buf);
+        return writeStream(ejs, json, chunk);
+    }
+    return 0;
+}
+
+
+/*
+    Define the stream to receive serialized output from the options.stream property. Nested toJSON methods are given
+    a copy of the options without the stream so they return their output to be written in place by the caller.
+ */
+static int setStream(Ejs *ejs, Json *json, EjsObj *options)
+{
+    EjsObj      *stream;
+
+    if ((stream = ejsGetPropertyByName(ejs, options, EN("stream"))) == 0 || !ejsIsDefined(ejs, stream)) {
+        return 0;
+    }
+    json->write = ejsGetPropertyByName(ejs, stream, N(NULL, "write"));
+    if (!ejsIsFunction(ejs, json->write)) {
+        json->write = ejsGetPropertyByName(ejs, TYPE(stream)->prototype, N(NULL, "write"));
+        if (!ejsIsFunction(ejs, json->write)) {
+            ejsThrowArgError(ejs, "Stream option does not have a write method");
+            return MPR_ERR_BAD_ARGS;
+        }
+    }
+    json->stream = stream;
+    json->options = ejsClone(ejs, options, 0);
+    ejsDeletePropertyByName(ejs, json->options, EN("stream"));
+    return 0;
+}
+
+
+static int writeStream(Ejs *ejs, Json *json, EjsString *data)
+{
+    EjsAny      *arg;
+
+    arg = data;
+    if (json->write->isNativeProc && json->write->rest) {
+        /* Native methods expect rest arguments as an array */
+        arg = ejsCreateArray(ejs, 1);
+        ejsSetProperty(ejs, arg, 0, data);
+    }
+    ejsRunFunction(ejs, json->write, json->stream, 1, &arg);
+    return ejs->exception ? MPR_ERR_CANT_WRITE : 0;
+}
+
+
 PUBLIC void ejsConfigureJSONType(Ejs *ejs)
 {
     ejsFinalizeScriptType(ejs, N("ejs", "JSON"), sizeof(EjsPot), ejsManagePot, EJS_TYPE_POT);
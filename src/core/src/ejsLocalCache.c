@@ -10,21 +10,54 @@
 
 /************************************ Locals **********************************/
 
-//  TODO - should this be refactored to use MprCache?
-
 #define CACHE_TIMER_PERIOD  (60 * TPS)
-#define CACHE_HASH_SIZE     257
+#define CACHE_HASH_SIZE     61              /* Hash size per shard */
 #define CACHE_LIFESPAN      (86400 * TPS)
+#define CACHE_SHARDS        16              /* Number of independently locked shards. Must be a power of 2 */
+#define CACHE_WHEEL_SLOTS   256             /* Expiry timer wheel slots. Must be a power of 2 */
+#define CACHE_WHEEL_TICK    TPS             /* Time spanned by each timer wheel slot */
+
+typedef struct CacheItem
+{
+    EjsString   *key;                   /* Original key */
+    EjsString   *data;                  /* Cache data */
+    EjsAny      *value;                 /* Object value. Never modified after writing so readers can copy it unlocked */
+    ssize       size;                   /* Memory used by the key and data or value */
+    MprTime     expires;                /* Fixed expiry date. If zero, key is imortal. */
+    MprTicks    lifespan;               /* Lifespan after each access to key (msec) */
+    int64       version;
+    struct CacheItem *prev;             /* LRU list toward the most recently used item */
+    struct CacheItem *next;             /* LRU list toward the least recently used item */
+    struct CacheItem *wprev;            /* Previous item in the timer wheel slot */
+    struct CacheItem *wnext;            /* Next item in the timer wheel slot */
+    int         slot;                   /* Timer wheel slot. Set to -1 if the item does not expire */
+} CacheItem;
+
+/*
+    Cache shard. Keys are distributed over shards by hash so that unrelated keys do not contend for one lock.
+    Each shard keeps its items on an LRU list for eviction and in a timer wheel for expiry. The lists are linked
+    through the items so that all list operations are O(1).
+ */
+typedef struct CacheShard
+{
+    MprHash     *store;                 /* Key/value store */
+    MprMutex    *mutex;                 /* Shard lock */
+    CacheItem   *mru;                   /* Most recently used item. Head of the LRU list */
+    CacheItem   *lru;                   /* Least recently used item. Tail of the LRU list */
+    CacheItem   *wheel[CACHE_WHEEL_SLOTS];  /* Timer wheel of items indexed by expiry time */
+    MprTime     wheelTick;              /* Last timer wheel tick pruned */
+    ssize       numKeys;                /* Number of keys in the shard */
+    ssize       usedMem;                /* Memory in use for keys and data in the shard */
+} CacheShard;
 
 typedef struct EjsLocalCache
 {
     EjsObj          obj;                /* Object base */
-    MprHash         *store;             /* Key/value store */
-    MprMutex        *mutex;             /* Cache lock */
+    CacheShard      *shards;            /* Key/value store shards */
+    MprMutex        *mutex;             /* Lock for the pruning timer */
     MprEvent        *timer;             /* Pruning timer */
     MprTicks        lifespan;           /* Default lifespan (msec) */
     int             resolution;         /* Frequence for pruner */
-    ssize           usedMem;            /* Memory in use for keys and data */
     ssize           maxKeys;            /* Max number of keys */
     ssize           maxMem;             /* Max memory for session data */
     struct EjsLocalCache *shared;       /* Shared common cache */
@@ -32,22 +65,20 @@ typedef struct EjsLocalCache
 
 static EjsLocalCache *shared;           /* Singleton shared cache */
 
-typedef struct CacheItem
-{
-    EjsString   *key;                   /* Original key */
-    EjsString   *data;                  /* Cache data */
-    MprTime     expires;                /* Fixed expiry date. If zero, key is imortal. */
-    MprTicks    lifespan;               /* Lifespan after each access to key (msec) */
-    int64       version;
-} CacheItem;
-
 /*********************************** Forwards *********************************/
 
+static EjsLocalCache *cloneLocalCache(Ejs *ejs, EjsLocalCache *src, bool deep);
+static CacheShard *createShards();
+static void evictItems(EjsLocalCache *cache, CacheShard *start);
+static EjsString *getItemData(Ejs *ejs, CacheItem *item);
 static void localPruner(EjsLocalCache *cache, MprEvent *event);
 static void manageLocalCache(EjsLocalCache *cache, int flags);
 static void manageCacheItem(CacheItem *item, int flags);
-static void removeItem(EjsLocalCache *cache, CacheItem *item);
+static void removeItem(CacheShard *shard, CacheItem *item);
+static void setExpiry(CacheShard *shard, CacheItem *item, MprTime expires);
 static void setLocalLimits(Ejs *ejs, EjsLocalCache *cache, EjsPot *options);
+static void startPruner(EjsLocalCache *cache);
+static void touchItem(CacheShard *shard, CacheItem *item);
 
 /************************************* Code ***********************************/
 /*
@@ -65,7 +96,10 @@ static EjsLocalCache *localConstructor(Ejs *ejs, EjsLocalCache *cache, int argc,
         cache->shared = shared;
     } else {
         cache->mutex = mprCreateLock();
-        cache->store = mprCreateHash(CACHE_HASH_SIZE, 0);
+        if ((cache->shards = createShards()) == 0) {
+            ejsThrowMemoryError(ejs);
+            return 0;
+        }
         cache->maxMem = MAXSSIZE;
         cache->maxKeys = MAXSSIZE;
         cache->resolution = CACHE_TIMER_PERIOD;
@@ -92,6 +126,15 @@ static EjsVoid *sl_destroy(Ejs *ejs, EjsLocalCache *cache, int argc, EjsObj **ar
 }
 
 
+/*
+    Get the shard for a key
+ */
+static CacheShard *getShard(EjsLocalCache *cache, EjsString *key)
+{
+    return &cache->shards[ejsHashString(key) & (CACHE_SHARDS - 1)];
+}
+
+
 /*
     function expire(key: String, expires: Date): Boolean
  */
@@ -100,6 +143,7 @@ static EjsAny *sl_expire(Ejs *ejs, EjsLocalCache *cache, int argc, EjsAny **argv
     EjsString   *key;
     EjsDate     *expires;
     CacheItem   *item;
+    CacheShard  *shard;
 
     if (cache->shared) {
         cache = cache->shared;
@@ -107,20 +151,24 @@ static EjsAny *sl_expire(Ejs *ejs, EjsLocalCache *cache, int argc, EjsAny **argv
     }
     key = argv[0];
     expires = argv[1];
+    shard = getShard(cache, key);
 
-    lock(cache);
+    lock(shard);
     //  UNICODE
-    if ((item = mprLookupKey(cache->store, key->value)) == 0) {
-        unlock(cache);
+    if ((item = mprLookupKey(shard->store, key->value)) == 0) {
+        unlock(shard);
         return ESV(false);
     }
     item->lifespan = 0;
     if (expires == ESV(null)) {
-        removeItem(cache, item);
+        removeItem(shard, item);
     } else {
-        item->expires = ejsGetDate(ejs, expires);
+        setExpiry(shard, item, ejsGetDate(ejs, expires));
+    }
+    unlock(shard);
+    if (expires != ESV(null)) {
+        startPruner(cache);
     }
-    unlock(cache);
     return ESV(true);
 }
 
@@ -130,8 +178,9 @@ static EjsAny *sl_expire(Ejs *ejs, EjsLocalCache *cache, int argc, EjsAny **argv
  */
 static EjsAny *sl_inc(Ejs *ejs, EjsLocalCache *cache, int argc, EjsAny **argv)
 {
-    EjsString   *key;
+    EjsString   *key, *result;
     CacheItem   *item;
+    CacheShard  *shard;
     int64       amount;
 
     if (cache->shared) {
@@ -140,27 +189,40 @@ static EjsAny *sl_inc(Ejs *ejs, EjsLocalCache *cache, int argc, EjsAny **argv)
     }
     key = argv[0];
     amount = (argc >= 2) ? ejsGetInt(ejs, argv[1]) : 1;
+    shard = getShard(cache, key);
 
-    lock(cache);
+    lock(shard);
     //  UNICODE
-    if ((item = mprLookupKey(cache->store, key->value)) == 0) {
+    if ((item = mprLookupKey(shard->store, key->value)) == 0) {
         if ((item = mprAllocObj(CacheItem, manageCacheItem)) == 0) {
-            unlock(cache);
+            unlock(shard);
             ejsThrowMemoryError(ejs);
             return 0;
         }
+        item->key = key;
+        item->slot = -1;
+        item->lifespan = cache->lifespan;
+        mprAddKey(shard->store, key->value, item);
+        shard->numKeys++;
     } else {
-        amount += stoi(item->data->value);
-    }
-    if (item->data) {
-        cache->usedMem -= item->data->length;
+        amount += stoi(getItemData(ejs, item)->value);
     }
     item->data = ejsCreateStringFromAsc(ejs, itos(amount));
-    cache->usedMem += item->data->length;
-    item->expires = mprGetTime() + item->lifespan;
+    item->value = 0;
+    shard->usedMem -= item->size;
+    item->size = key->length + item->data->length;
+    shard->usedMem += item->size;
+    if (item->lifespan) {
+        setExpiry(shard, item, mprGetTime() + item->lifespan);
+    }
     item->version++;
-    unlock(cache);
-    return item->data;
+    touchItem(shard, item);
+    result = item->data;
+    unlock(shard);
+
+    startPruner(cache);
+    evictItems(cache, shard);
+    return result;
 }
 
 
@@ -195,6 +257,7 @@ static EjsAny *sl_read(Ejs *ejs, EjsLocalCache *cache, int argc, EjsAny **argv)
     EjsAny      *result;
     EjsPot      *options;
     CacheItem   *item;
+    CacheShard  *shard;
     int         getVersion;
 
     if (cache->shared) {
@@ -208,14 +271,16 @@ static EjsAny *sl_read(Ejs *ejs, EjsLocalCache *cache, int argc, EjsAny **argv)
         options = argv[1];
         getVersion = ejsGetPropertyByName(ejs, options, EN("version")) == ESV(true);
     }
-    lock(cache);
+    shard = getShard(cache, key);
+    lock(shard);
     //  UNICODE
-    if ((item = mprLookupKey(cache->store, key->value)) == 0) {
-        unlock(cache);
+    if ((item = mprLookupKey(shard->store, key->value)) == 0) {
+        unlock(shard);
         return ESV(null);
     }
     if (item->expires && item->expires <= mprGetTime()) {
-        unlock(cache);
+        removeItem(shard, item);
+        unlock(shard);
         return ESV(null);
     }
 #if UNUSED && FUTURE
@@ -225,14 +290,15 @@ static EjsAny *sl_read(Ejs *ejs, EjsLocalCache *cache, int argc, EjsAny **argv)
         item->expires = mprGetTime() + item->lifespan;
     }
 #endif
+    touchItem(shard, item);
     if (getVersion) {
         result = ejsCreatePot(ejs, ESV(Object), 2);
         ejsSetPropertyByName(ejs, result, EN("version"), ejsCreateNumber(ejs, (MprNumber) item->version));
-        ejsSetPropertyByName(ejs, result, EN("data"), item->data);
+        ejsSetPropertyByName(ejs, result, EN("data"), getItemData(ejs, item));
     } else {
-        result = item->data;
+        result = getItemData(ejs, item);
     }
-    unlock(cache);
+    unlock(shard);
     return result;
 }
 
@@ -245,30 +311,43 @@ static EjsBoolean *sl_remove(Ejs *ejs, EjsLocalCache *cache, int argc, EjsAny **
     EjsString   *key;
     EjsAny      *result;
     CacheItem   *item;
+    CacheShard  *shard;
+    int         i;
 
     if (cache->shared) {
         cache = cache->shared;
         assert(cache == shared);
     }
     key = argv[0];
-    lock(cache);
     if (ejsIsDefined(ejs, key)) {
+        shard = getShard(cache, key);
+        lock(shard);
         //  UNICODE
-        if ((item = mprLookupKey(cache->store, key->value)) != 0) {
-            cache->usedMem -= (key->length + item->data->length);
-            mprRemoveKey(cache->store, key->value);
+        if ((item = mprLookupKey(shard->store, key->value)) != 0) {
+            removeItem(shard, item);
             result = ESV(true);
         } else {
             result = ESV(false);
         }
+        unlock(shard);
 
     } else {
         /* Remove all keys */
-        result = mprGetHashLength(cache->store) ? ESV(true) : ESV(false);
-        cache->store = mprCreateHash(CACHE_HASH_SIZE, 0);
-        cache->usedMem = 0;
+        result = ESV(false);
+        for (i = 0; i < CACHE_SHARDS; i++) {
+            shard = &cache->shards[i];
+            lock(shard);
+            if (shard->numKeys) {
+                result = ESV(true);
+            }
+            shard->store = mprCreateHash(CACHE_HASH_SIZE, 0);
+            shard->mru = shard->lru = 0;
+            memset(shard->wheel, 0, sizeof(shard->wheel));
+            shard->numKeys = 0;
+            shard->usedMem = 0;
+            unlock(shard);
+        }
     }
-    unlock(cache);
     return result;
 }
 
@@ -318,6 +397,7 @@ static EjsVoid *sl_setLimits(Ejs *ejs, EjsLocalCache *cache, int argc, EjsAny **
         assert(cache == shared);
     }
     setLocalLimits(ejs, cache, argv[0]);
+    evictItems(cache, &cache->shards[0]);
     return 0;
 }
 
@@ -328,6 +408,7 @@ static EjsVoid *sl_setLimits(Ejs *ejs, EjsLocalCache *cache, int argc, EjsAny **
 static EjsNumber *sl_write(Ejs *ejs, EjsLocalCache *cache, int argc, EjsAny **argv)
 {
     CacheItem   *item;
+    CacheShard  *shard;
     EjsString   *key, *value, *sp;
     EjsPot      *options;
     EjsAny      *vp;
@@ -376,136 +457,401 @@ static EjsNumber *sl_write(Ejs *ejs, EjsLocalCache *cache, int argc, EjsAny **ar
             checkVersion = 1;
         }
     }
-    lock(cache);
-    if ((kp = mprLookupKeyEntry(cache->store, key->value)) != 0) {
+    shard = getShard(cache, key);
+    lock(shard);
+    if ((kp = mprLookupKeyEntry(shard->store, key->value)) != 0) {
         exists++;
         item = (CacheItem*) kp->data;
         if (checkVersion) {
             if (item->version != version) {
-                unlock(cache);
+                unlock(shard);
                 if (throw) {
                     ejsThrowStateError(ejs, "Key version does not match");
                 }
                 return ESV(null);
             }
         }
+        if (add) {
+            unlock(shard);
+            return ESV(null);
+        }
     } else {
         if ((item = mprAllocObj(CacheItem, manageCacheItem)) == 0) {
-            unlock(cache);
+            unlock(shard);
             ejsThrowMemoryError(ejs);
             return 0;
         }
         //  UNICODE
-        mprAddKey(cache->store, key->value, item);
+        mprAddKey(shard->store, key->value, item);
         set = 1;
         item->key = key;
+        item->slot = -1;
+        shard->numKeys++;
     }
-    oldLen = (item->data) ? (item->key->length + item->data->length) : 0;
-    if (set) {
-        item->data = value;
-    } else if (add) {
-        if (exists) {
-            return ESV(null);
-        }
+    oldLen = item->size;
+    if (set || add) {
         item->data = value;
     } else if (append) {
-        item->data = ejsJoinString(ejs, item->data, value);
+        item->data = ejsJoinString(ejs, getItemData(ejs, item), value);
     } else if (prepend) {
-        item->data = ejsJoinString(ejs, value, item->data);
+        item->data = ejsJoinString(ejs, value, getItemData(ejs, item));
     }
+    item->value = 0;
     if (expires) {
         /* Expires takes precedence over lifespan */
-        item->expires = expires;
         item->lifespan = 0;
+        setExpiry(shard, item, expires);
     } else if (lifespan == 0) {
         /* Never expires */
-        item->expires = 0;
+        item->lifespan = 0;
+        setExpiry(shard, item, 0);
     } else {
         item->lifespan = lifespan;
-        item->expires = mprGetTime() + item->lifespan;
+        setExpiry(shard, item, mprGetTime() + item->lifespan);
     }
     item->version++;
-    len = item->key->length + item->data->length;
+    touchItem(shard, item);
+    len = item->size = item->key->length + item->data->length;
+    shard->usedMem += (len - oldLen);
+    unlock(shard);
 
-    cache->usedMem += (len - oldLen);
+    startPruner(cache);
+    evictItems(cache, shard);
+    //  UNICODE
+    return ejsCreateNumber(ejs, (MprNumber) len);
+}
 
-    if (cache->timer == 0) {
-        mprDebug("ejs cache", 5, "Start LocalCache pruner with resolution %d", cache->resolution);
-        /* 
-            Use the MPR dispatcher incase this VM is destroyed 
-         */
-        cache->timer = mprCreateTimerEvent(MPR->dispatcher, "localCacheTimer", cache->resolution, localPruner, cache, 
-            MPR_EVENT_STATIC_DATA); 
+
+/*
+    Test for a LocalCache by its clone helper. Each interpreter that loads the core module has its own LocalCache type.
+ */
+static bool isLocalCache(EjsAny *obj)
+{
+    return obj && TYPE(obj)->helpers.clone == (EjsCloneHelper) cloneLocalCache;
+}
+
+
+PUBLIC EjsAny *ejsGetLocalCache(Ejs *ejs, EjsObj *cache)
+{
+    EjsAny  *adapter;
+
+    if (isLocalCache(cache)) {
+        return cache;
     }
-    unlock(cache);
+    if (TYPE(cache) == ejsGetProperty(ejs, ejs->global, ES_Cache) && 
+            (adapter = ejsGetProperty(ejs, cache, ES_Cache_adapter)) != 0 && isLocalCache(adapter)) {
+        return adapter;
+    }
+    return 0;
+}
+
+
+/*
+    Read an object from the cache. Objects written by ejsWriteLocalCacheObj are stored in native form and a private copy
+    is returned for the caller. Other values are deserialized from JSON.
+ */
+PUBLIC EjsAny *ejsReadLocalCacheObj(Ejs *ejs, EjsObj *obj, EjsString *key)
+{
+    EjsLocalCache   *cache;
+    EjsString       *data;
+    EjsAny          *value;
+    CacheItem       *item;
+    CacheShard      *shard;
+
+    cache = (EjsLocalCache*) obj;
+    if (cache->shared) {
+        cache = cache->shared;
+        assert(cache == shared);
+    }
+    shard = getShard(cache, key);
+    lock(shard);
     //  UNICODE
-    return ejsCreateNumber(ejs, (MprNumber) len);
+    if ((item = mprLookupKey(shard->store, key->value)) == 0) {
+        unlock(shard);
+        return 0;
+    }
+    if (item->expires && item->expires <= mprGetTime()) {
+        removeItem(shard, item);
+        unlock(shard);
+        return 0;
+    }
+    touchItem(shard, item);
+    value = item->value;
+    data = item->data;
+    unlock(shard);
+
+    /* Stored values are never modified, so they can be copied without holding the lock */
+    if (value) {
+        return ejsCopyValue(ejs, value, 1, NULL);
+    }
+    return data ? ejsDeserialize(ejs, data) : 0;
 }
 
 
-static void removeItem(EjsLocalCache *cache, CacheItem *item)
+/*
+    Write an object to the cache. The object is copied and stored in native form without serialization. The copy is 
+    private to the cache and is shared by all interpreters. Only the lifespan and expires options are supported.
+ */
+PUBLIC EjsNumber *ejsWriteLocalCacheObj(Ejs *ejs, EjsObj *obj, EjsString *key, EjsAny *value, EjsObj *options)
 {
-    lock(cache);
+    EjsLocalCache   *cache;
+    EjsAny          *vp;
+    CacheItem       *item;
+    CacheShard      *shard;
+    MprTime         expires;
+    MprTicks        lifespan;
+    ssize           size;
+
+    cache = (EjsLocalCache*) obj;
+    if (cache->shared) {
+        cache = cache->shared;
+        assert(cache == shared);
+    }
+    expires = 0;
+    lifespan = cache->lifespan;
+    if (options && ejsIsDefined(ejs, options)) {
+        if ((vp = ejsGetPropertyByName(ejs, options, EN("lifespan"))) != 0) {
+            lifespan = ejsGetInt64(ejs, vp) * TPS;
+        }
+        if ((vp = ejsGetPropertyByName(ejs, options, EN("expires"))) != 0 && ejsIs(ejs, vp, Date)) {
+            expires = ejsGetDate(ejs, vp);
+        }
+    }
+    size = key->length;
+    if ((value = ejsCopyValue(ejs, value, 0, &size)) == 0) {
+        return 0;
+    }
+    shard = getShard(cache, key);
+    lock(shard);
+    //  UNICODE
+    if ((item = mprLookupKey(shard->store, key->value)) == 0) {
+        if ((item = mprAllocObj(CacheItem, manageCacheItem)) == 0) {
+            unlock(shard);
+            ejsThrowMemoryError(ejs);
+            return 0;
+        }
+        mprAddKey(shard->store, key->value, item);
+        item->key = key;
+        item->slot = -1;
+        shard->numKeys++;
+    }
+    item->value = value;
+    item->data = 0;
+    shard->usedMem += size - item->size;
+    item->size = size;
+    if (expires) {
+        item->lifespan = 0;
+        setExpiry(shard, item, expires);
+    } else {
+        item->lifespan = lifespan;
+        setExpiry(shard, item, lifespan ? mprGetTime() + lifespan : 0);
+    }
+    item->version++;
+    touchItem(shard, item);
+    unlock(shard);
+
+    startPruner(cache);
+    evictItems(cache, shard);
+    return ejsCreateNumber(ejs, (MprNumber) size);
+}
+
+
+/*
+    Get the item data as a string. Object values are serialized on demand. Must be called with the shard locked.
+ */
+static EjsString *getItemData(Ejs *ejs, CacheItem *item)
+{
+    if (item->data == 0 && item->value) {
+        item->data = ejsSerialize(ejs, item->value, 0);
+    }
+    return item->data;
+}
+
+
+/*
+    Move an item to the head of the shard LRU list. Must be called with the shard locked.
+ */
+static void touchItem(CacheShard *shard, CacheItem *item)
+{
+    if (shard->mru == item) {
+        return;
+    }
+    if (item->prev) {
+        item->prev->next = item->next;
+        if (item->next) {
+            item->next->prev = item->prev;
+        } else {
+            shard->lru = item->prev;
+        }
+    }
+    item->prev = 0;
+    item->next = shard->mru;
+    if (shard->mru) {
+        shard->mru->prev = item;
+    }
+    shard->mru = item;
+    if (shard->lru == 0) {
+        shard->lru = item;
+    }
+}
+
+
+/*
+    Set the expiry time for an item and move it to the corresponding timer wheel slot. Items that never expire are
+    not in the wheel. Must be called with the shard locked.
+ */
+static void setExpiry(CacheShard *shard, CacheItem *item, MprTime expires)
+{
+    int     slot;
+
+    slot = expires ? (int) ((expires / CACHE_WHEEL_TICK) & (CACHE_WHEEL_SLOTS - 1)) : -1;
+    item->expires = expires;
+    if (slot == item->slot) {
+        return;
+    }
+    if (item->slot >= 0) {
+        if (item->wprev) {
+            item->wprev->wnext = item->wnext;
+        } else {
+            shard->wheel[item->slot] = item->wnext;
+        }
+        if (item->wnext) {
+            item->wnext->wprev = item->wprev;
+        }
+    }
+    item->slot = slot;
+    item->wprev = 0;
+    if (slot >= 0) {
+        item->wnext = shard->wheel[slot];
+        if (item->wnext) {
+            item->wnext->wprev = item;
+        }
+        shard->wheel[slot] = item;
+    } else {
+        item->wnext = 0;
+    }
+}
+
+
+/*
+    Remove an item from the shard. Must be called with the shard locked.
+ */
+static void removeItem(CacheShard *shard, CacheItem *item)
+{
+    setExpiry(shard, item, 0);
+    if (item->prev) {
+        item->prev->next = item->next;
+    } else {
+        shard->mru = item->next;
+    }
+    if (item->next) {
+        item->next->prev = item->prev;
+    } else {
+        shard->lru = item->prev;
+    }
+    item->prev = item->next = 0;
     //UNICODE
-    mprRemoveKey(cache->store, item->key->value);
-    cache->usedMem -= (item->key->length + item->data->length);
-    unlock(cache);
+    mprRemoveKey(shard->store, item->key->value);
+    shard->numKeys--;
+    shard->usedMem -= item->size;
 }
 
 
 /*
-    Check for expired keys
+    Evict least recently used items while the cache is over its key or memory limits. Eviction starts with the given 
+    shard and continues with subsequent shards. The totals are summed without locking and may be slightly stale.
  */
-static void localPruner(EjsLocalCache *cache, MprEvent *event)
+static void evictItems(EjsLocalCache *cache, CacheShard *start)
 {
-    MprTime         when, factor;
-    MprKey          *kp;
-    CacheItem       *item;
-    ssize           excessKeys;
+    CacheShard  *shard;
+    ssize       numKeys, usedMem;
+    int         i, next;
 
-    if (mprTryLock(cache->mutex)) {
-        when = mprGetTime();
-        /*
-            Prune keys expiring first.
-         */
-        for (kp = 0; (kp = mprGetNextKey(cache->store, kp)) != 0; ) {
-            item = (CacheItem*) kp->data;
-#if KEEP
-            mprDebug("ejs cache", 6, "LocalCache: \"%@\" lifespan %d, expires in %d secs", item->key, 
-                    item->lifespan / 1000, (item->expires - when) / 1000);
-#endif
-            if (item->expires && item->expires <= when) {
-                mprDebug("ejs cache", 5, "LocalCache prune expired key %s", kp->key);
-                removeItem(cache, item);
-            }
+    if (cache->maxKeys == MAXSSIZE && cache->maxMem == MAXSSIZE) {
+        return;
+    }
+    numKeys = usedMem = 0;
+    for (i = 0; i < CACHE_SHARDS; i++) {
+        numKeys += cache->shards[i].numKeys;
+        usedMem += cache->shards[i].usedMem;
+    }
+    next = (int) (start - cache->shards);
+    for (i = 0; i < CACHE_SHARDS && (numKeys > cache->maxKeys || usedMem > cache->maxMem); i++) {
+        shard = &cache->shards[(next + i) & (CACHE_SHARDS - 1)];
+        lock(shard);
+        while (shard->lru && (numKeys > cache->maxKeys || usedMem > cache->maxMem)) {
+            mprDebug("ejs cache", 5, "LocalCache too big, keys %Ld, mem %Ld, evict key %s", 
+                (int64) numKeys, (int64) usedMem, shard->lru->key->value);
+            numKeys--;
+            usedMem -= shard->lru->size;
+            removeItem(shard, shard->lru);
         }
-        assert(cache->usedMem >= 0);
+        unlock(shard);
+    }
+}
 
-        /*
-            If too many keys or too much memory used. Prune oldest first.
+
+/*
+    Start the pruning timer if not already running
+ */
+static void startPruner(EjsLocalCache *cache)
+{
+    if (cache->timer) {
+        return;
+    }
+    lock(cache);
+    if (cache->timer == 0) {
+        mprDebug("ejs cache", 5, "Start LocalCache pruner with resolution %d", cache->resolution);
+        /* 
+            Use the MPR dispatcher incase this VM is destroyed 
          */
-        if (cache->maxKeys < MAXSSIZE || cache->maxMem < MAXSSIZE) {
-            excessKeys = mprGetHashLength(cache->store) - cache->maxKeys;
-            for (factor = 3600; factor < (86400 * 1000); factor *= 4) {
-                if (excessKeys > 0 || cache->usedMem > cache->maxMem) {
-                    for (kp = 0; (kp = mprGetNextKey(cache->store, kp)) != 0; ) {
-                        item = (CacheItem*) kp->data;
-                        if (item->expires && item->expires <= when) {
-                            mprDebug("ejs cache", 5, "LocalCache too big execess keys %Ld, mem %Ld, prune key %s", 
-                                    excessKeys, (cache->maxMem - cache->usedMem), kp->key);
-                            removeItem(cache, item);
-                            excessKeys--;
-                        }
-                    }
-                    when += factor;
-                } else {
-                    break;
+        cache->timer = mprCreateTimerEvent(MPR->dispatcher, "localCacheTimer", cache->resolution, localPruner, cache, 
+            MPR_EVENT_STATIC_DATA); 
+    }
+    unlock(cache);
+}
+
+
+/*
+    Check for expired keys. Only the timer wheel slots for the time elapsed since the last run are examined. Items in 
+    these slots that expire on a later turn of the wheel are retained.
+ */
+static void localPruner(EjsLocalCache *cache, MprEvent *event)
+{
+    MprTime         when, tick, last;
+    CacheShard      *shard;
+    CacheItem       *item, *next;
+    ssize           numKeys;
+    int             i;
+
+    when = mprGetTime();
+    tick = when / CACHE_WHEEL_TICK;
+    numKeys = 0;
+    for (i = 0; i < CACHE_SHARDS; i++) {
+        shard = &cache->shards[i];
+        lock(shard);
+        last = max(shard->wheelTick, tick - CACHE_WHEEL_SLOTS + 1);
+        for (; last <= tick; last++) {
+            for (item = shard->wheel[last & (CACHE_WHEEL_SLOTS - 1)]; item; item = next) {
+                next = item->wnext;
+                if (item->expires <= when) {
+                    mprDebug("ejs cache", 5, "LocalCache prune expired key %s", item->key->value);
+                    removeItem(shard, item);
                 }
             }
         }
-        assert(cache->usedMem >= 0);
-
-        if (mprGetHashLength(cache->store) == 0) {
+        /* The current slot is examined again on the next run as its items may not have expired yet */
+        shard->wheelTick = tick;
+        numKeys += shard->numKeys;
+        assert(shard->usedMem >= 0);
+        unlock(shard);
+    }
+    if (numKeys == 0) {
+        lock(cache);
+        for (i = 0, numKeys = 0; i < CACHE_SHARDS; i++) {
+            numKeys += cache->shards[i].numKeys;
+        }
+        if (numKeys == 0) {
             mprRemoveEvent(event);
             cache->timer = 0;
         }
@@ -514,10 +860,45 @@ static void localPruner(EjsLocalCache *cache, MprEvent *event)
 }
 
 
+static void manageShards(CacheShard *shards, int flags)
+{
+    int     i;
+
+    if (flags & MPR_MANAGE_MARK) {
+        for (i = 0; i < CACHE_SHARDS; i++) {
+            mprMark(shards[i].store);
+            mprMark(shards[i].mutex);
+        }
+    }
+}
+
+
+static CacheShard *createShards()
+{
+    CacheShard  *shards, *shard;
+    MprTime     tick;
+    int         i;
+
+    if ((shards = mprAllocBlock(sizeof(CacheShard) * CACHE_SHARDS, MPR_ALLOC_ZERO | MPR_ALLOC_MANAGER)) == 0) {
+        return 0;
+    }
+    mprSetManager(shards, (MprManager) manageShards);
+    tick = mprGetTime() / CACHE_WHEEL_TICK;
+    for (i = 0; i < CACHE_SHARDS; i++) {
+        shard = &shards[i];
+        if ((shard->store = mprCreateHash(CACHE_HASH_SIZE, 0)) == 0 || (shard->mutex = mprCreateLock()) == 0) {
+            return 0;
+        }
+        shard->wheelTick = tick;
+    }
+    return shards;
+}
+
+
 static void manageLocalCache(EjsLocalCache *cache, int flags) 
 {
     if (flags & MPR_MANAGE_MARK) {
-        mprMark(cache->store);
+        mprMark(cache->shards);
         mprMark(cache->mutex);
         mprMark(cache->timer);
         mprMark(cache->shared);
@@ -535,6 +916,7 @@ static void manageCacheItem(CacheItem *item, int flags)
     if (flags & MPR_MANAGE_MARK) {
         mprMark(item->key);
         mprMark(item->data);
+        mprMark(item->value);
     }
 }
 
@@ -551,12 +933,13 @@ static EjsLocalCache *cloneLocalCache(Ejs *ejs, EjsLocalCache *src, bool deep)
     } else if (src == shared) {
         dest->shared = src;
     } else {
-        dest->store = mprCreateHash(CACHE_HASH_SIZE, 0);
+        if ((dest->shards = createShards()) == 0) {
+            return 0;
+        }
         dest->mutex = mprCreateLock();
         dest->timer = 0;
         dest->lifespan = src->lifespan;
         dest->resolution = src->resolution;
-        dest->usedMem = src->usedMem;
         dest->maxMem = src->maxMem;
         dest->maxKeys = src->maxKeys;
         dest->shared = src->shared;
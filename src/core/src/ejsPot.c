@@ -359,7 +359,7 @@ PUBLIC int ejsLookupPotProperty(struct Ejs *ejs, EjsPot *obj, EjsName qname)
          */
         assert(props->hash);
         assert(props->hash->size > 0);
-        index = whash(qname.name->value, qname.name->length) % props->hash->size;
+        index = ejsHashString(qname.name) % props->hash->size;
         if (qname.space) {
             assert(hash->buckets);
             assert(index < hash->size);
@@ -775,7 +775,7 @@ static int hashProperty(Ejs *ejs, EjsPot *obj, int slotNum, EjsName qname)
     }
     hash = props->hash;
     slots = props->slots;
-    index = whash(qname.name->value, qname.name->length) % hash->size;
+    index = ejsHashString(qname.name) % hash->size;
 
     /* Scan the collision chain */
     lastSlot = -1;
@@ -897,7 +897,7 @@ static void removeHashEntry(Ejs *ejs, EjsPot *obj, EjsName qname)
         assert(0);
         return;
     }
-    index = whash(qname.name->value, qname.name->length) % obj->properties->hash->size;
+    index = ejsHashString(qname.name) % obj->properties->hash->size;
     slotNum = obj->properties->hash->buckets[index];
     lastSlot = -1;
     buckets = obj->properties->hash->buckets;
@@ -13,9 +13,13 @@
 #if !defined(ME_MAX_REGEX_MATCHES)
     #define ME_MAX_REGEX_MATCHES 64
 #endif
+#if !defined(ME_MAX_REGEX_CACHE)
+    #define ME_MAX_REGEX_CACHE 256
+#endif
 
 /********************************* Forwards ***********************************/
 
+static int compileRegExp(Ejs *ejs, EjsRegExp *rp);
 static char *makeFlags(EjsRegExp *rp);
 static int parseFlags(EjsRegExp *rp, wchar *flags);
 
@@ -74,20 +78,13 @@ static EjsAny *castRegExp(Ejs *ejs, EjsRegExp *rp, EjsType *type)
 
 static EjsRegExp *regex_Constructor(Ejs *ejs, EjsRegExp *rp, int argc, EjsObj **argv)
 {
-    cchar       *errMsg;
-    int         column, errCode;
-
     rp->pattern = wclone(ejsToString(ejs, argv[0])->value);
     rp->options = PCRE_JAVASCRIPT_COMPAT;
 
     if (argc == 2) {
         rp->options |= parseFlags(rp, ejsToString(ejs, argv[1])->value);
     }
-    if (rp->compiled) {
-        free(rp->compiled);
-    }
-    if ((rp->compiled = pcre_compile2(rp->pattern, rp->options, &errCode, &errMsg, &column, NULL)) == 0) {
-        ejsThrowArgError(ejs, "Cannot compile regular expression '%s'. Error %s at column %d", rp->pattern, errMsg, column);
+    if (compileRegExp(ejs, rp) < 0) {
         return 0;
     }
     return rp;
@@ -228,17 +225,13 @@ PUBLIC EjsString *ejsRegExpToString(Ejs *ejs, EjsRegExp *rp)
 PUBLIC EjsRegExp *ejsCreateRegExp(Ejs *ejs, cchar *pattern, cchar *flags)
 {
     EjsRegExp   *rp;
-    cchar       *errMsg;
-    int         column, errCode;
 
     if ((rp = ejsCreateObj(ejs, ESV(RegExp), 0)) == 0) {
         return 0;
     }
     rp->pattern = sclone(pattern);
     rp->options = parseFlags(rp, (wchar*) flags);
-    rp->compiled = pcre_compile2(rp->pattern, rp->options, &errCode, &errMsg, &column, NULL);
-    if (rp->compiled == NULL) {
-        ejsThrowArgError(ejs, "Cannot compile regular expression '%s'. Error %s at column %d", rp->pattern, errMsg, column);
+    if (compileRegExp(ejs, rp) < 0) {
         return 0;
     }
     return rp;
@@ -252,10 +245,8 @@ PUBLIC EjsRegExp *ejsCreateRegExp(Ejs *ejs, cchar *pattern, cchar *flags)
 PUBLIC EjsRegExp *ejsParseRegExp(Ejs *ejs, EjsString *pattern)
 {
     EjsRegExp   *rp;
-    cchar       *errMsg;
     char        *cp, *dp;
     wchar       *flags;
-    int         column, errCode;
 
     if (pattern->length == 0 || pattern->value[0] != '/') {
         ejsThrowArgError(ejs, "Bad regular expression pattern. Must start with '/'");
@@ -291,14 +282,126 @@ PUBLIC EjsRegExp *ejsParseRegExp(Ejs *ejs, EjsString *pattern)
     } else {
         rp->pattern = sclone(&pattern->value[1]);
     }
-    rp->compiled = pcre_compile2(rp->pattern, rp->options, &errCode, &errMsg, &column, NULL);
-    if (rp->compiled == NULL) {
-        ejsThrowArgError(ejs, "Cannot compile regular expression '%s'. Error %s at column %d", rp->pattern, errMsg, column);
+    if (compileRegExp(ejs, rp) < 0) {
         return 0;
     }
     return rp;
 }
 
+/*********************************** Pattern Cache ****************************/
+/*
+    Compiled patterns are shared over all interpreters. RegExp objects reference their shared pattern so that patterns 
+    discarded from the cache remain valid until no longer used.
+ */
+
+static void managePattern(EjsRegExpPattern *pp, int flags)
+{
+    if (flags & MPR_MANAGE_MARK) {
+        mprMark(pp->key);
+
+    } else if (flags & MPR_MANAGE_FREE) {
+        if (pp->compiled) {
+            free(pp->compiled);
+            pp->compiled = 0;
+        }
+    }
+}
+
+
+static void manageRegExpCache(EjsRegExpCache *cache, int flags)
+{
+    if (flags & MPR_MANAGE_MARK) {
+        /* Patterns on the LRU list are marked via the hash */
+        mprMark(cache->patterns);
+        mprMark(cache->mutex);
+    }
+}
+
+
+PUBLIC EjsRegExpCache *ejsCreateRegExpCache(EjsService *sp)
+{
+    EjsRegExpCache  *cache;
+
+    if ((cache = mprAllocObj(EjsRegExpCache, manageRegExpCache)) == 0) {
+        return 0;
+    }
+    cache->patterns = mprCreateHash(ME_MAX_REGEX_CACHE, 0);
+    cache->mutex = mprCreateLock();
+    cache->max = ME_MAX_REGEX_CACHE;
+    cache->lru.next = cache->lru.prev = &cache->lru;
+    return cache;
+}
+
+
+static void unlinkPattern(EjsRegExpPattern *pp)
+{
+    pp->prev->next = pp->next;
+    pp->next->prev = pp->prev;
+}
+
+
+/*
+    Append the pattern as the most recently used
+ */
+static void appendPattern(EjsRegExpCache *cache, EjsRegExpPattern *pp)
+{
+    pp->next = &cache->lru;
+    pp->prev = cache->lru.prev;
+    cache->lru.prev->next = pp;
+    cache->lru.prev = pp;
+}
+
+
+/*
+    Compile the pattern or reuse a compiled pattern from the cache. The cache key includes only the options that
+    affect compilation, so the "g" and "y" flags share compiled patterns.
+ */
+static int compileRegExp(Ejs *ejs, EjsRegExp *rp)
+{
+    EjsRegExpCache      *cache;
+    EjsRegExpPattern    *pp, *oldest;
+    cchar               *errMsg;
+    char                *key;
+    void                *compiled;
+    int                 column, errCode;
+
+    cache = ejs->service->regexpCache;
+    key = sfmt("%x:%s", rp->options, rp->pattern);
+
+    lock(cache);
+    if ((pp = mprLookupKey(cache->patterns, key)) != 0) {
+        unlinkPattern(pp);
+        appendPattern(cache, pp);
+
+    } else {
+        if ((compiled = pcre_compile2(rp->pattern, rp->options, &errCode, &errMsg, &column, NULL)) == 0) {
+            unlock(cache);
+            ejsThrowArgError(ejs, "Cannot compile regular expression '%s'. Error %s at column %d", rp->pattern, errMsg, 
+                column);
+            return EJS_ERR;
+        }
+        if ((pp = mprAllocObj(EjsRegExpPattern, managePattern)) == 0) {
+            free(compiled);
+            unlock(cache);
+            ejsThrowMemoryError(ejs);
+            return EJS_ERR;
+        }
+        pp->key = key;
+        pp->compiled = compiled;
+        if (mprGetHashLength(cache->patterns) >= cache->max) {
+            oldest = cache->lru.next;
+            unlinkPattern(oldest);
+            mprRemoveKey(cache->patterns, oldest->key);
+        }
+        mprAddKey(cache->patterns, key, pp);
+        appendPattern(cache, pp);
+    }
+    unlock(cache);
+    rp->shared = pp;
+    rp->compiled = pp->compiled;
+    return 0;
+}
+
 
 static int parseFlags(EjsRegExp *rp, wchar *flags)
 {
@@ -381,12 +484,7 @@ static void manageRegExp(EjsRegExp *rp, int flags)
 {
     if (flags & MPR_MANAGE_MARK) {
         mprMark(rp->pattern);
-
-    } else if (flags & MPR_MANAGE_FREE) {
-        if (rp->compiled) {
-            free(rp->compiled);
-            rp->compiled = 0;
-        }
+        mprMark(rp->shared);
     }
 }
 
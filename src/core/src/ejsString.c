@@ -404,7 +404,7 @@ static EjsBoolean *containsString(Ejs *ejs, EjsString *sp, int argc, EjsObj **ar
 
     if (ejsIs(ejs, pat, String)) {
         spat = (EjsString*) pat;
-        return ejsCreateBoolean(ejs, wcontains(sp->value, spat->value) != 0);
+        return ejsCreateBoolean(ejs, spat->length > 0 && ejsContainsString(ejs, sp, spat) >= 0);
 
     } else if (ejsIs(ejs, pat, RegExp)) {
         EjsRegExp   *rp;
@@ -1868,40 +1868,66 @@ static EjsString *buildString(Ejs *ejs, EjsString *result, wchar *str, ssize len
 }
 
 
+/*
+    Find the first occurrence of a pattern that fits entirely within the first len characters of a string. Candidate 
+    positions are located by scanning for the first pattern character and are then confirmed by comparing the rest 
+    of the pattern. For single byte characters, the scan and compare use memchr and memcmp which the C library 
+    implements with word or vector instructions. Returns the index or -1 if not found.
+ */
+static ssize findPattern(const wchar *str, ssize len, const wchar *pattern, ssize patternLength)
+{
+    const wchar     *cp, *last;
+
+    if (patternLength <= 0) {
+        return 0;
+    }
+    if (patternLength > len) {
+        return -1;
+    }
+    last = &str[len - patternLength];
+    for (cp = str; cp <= last; cp++) {
+#if ME_CHAR_LEN == 1
+        if ((cp = memchr(cp, pattern[0], last - cp + 1)) == 0) {
+            return -1;
+        }
+#else
+        for (; cp <= last && *cp != pattern[0]; cp++) ;
+        if (cp > last) {
+            return -1;
+        }
+#endif
+        if (memcmp(&cp[1], &pattern[1], (patternLength - 1) * sizeof(wchar)) == 0) {
+            return cp - str;
+        }
+    }
+    return -1;
+}
+
+
 /*
     Find a substring. Search forward or backwards. Return the index in the string where the pattern was found.
     Return -1 if not found.
  */
 static ssize indexof(wchar *str, ssize len, EjsString *pattern, ssize patternLength, int dir)
 {
-    wchar       *s1, *s2;
-    ssize       i, j;
+    wchar       *pat, first, final;
+    ssize       i;
 
     assert(dir == 1 || dir == -1);
 
+    if (patternLength <= 0) {
+        return (len <= 0) ? -1 : ((dir > 0) ? 0 : len - 1);
+    }
     if (dir > 0) {
-        for (i = 0; i < len; i++) {
-            s1 = &str[i];
-            for (j = 0, s2 = pattern->value; j < patternLength; s1++, s2++, j++) {
-                if (*s1 != *s2) {
-                    break;
-                }
-            }
-            if (*s2 == '\0') {
-                return i;
-            }
-        }
-    } else {
-        for (i = len - 1; i >= 0; i--) {
-            s1 = &str[i];
-            for (j = 0, s2 = pattern->value; j < patternLength; s1++, s2++, j++) {
-                if (*s1 != *s2) {
-                    break;
-                }
-            }
-            if (*s2 == '\0') {
-                return i;
-            }
+        return findPattern(str, len, pattern->value, patternLength);
+    }
+    pat = pattern->value;
+    first = pat[0];
+    final = pat[patternLength - 1];
+    for (i = len - patternLength; i >= 0; i--) {
+        if (str[i] == first && str[i + patternLength - 1] == final && 
+                memcmp(&str[i], pat, patternLength * sizeof(wchar)) == 0) {
+            return i;
         }
     }
     return -1;
@@ -2159,17 +2185,20 @@ PUBLIC int ejsContainsStringAnyCase(Ejs *ejs, EjsString *sp, EjsString *pat)
 
 PUBLIC int ejsContainsAsc(Ejs *ejs, EjsString *sp, cchar *pat)
 {
-    ssize   len;
-    int     i, j, k;
-
     assert(sp);
 
     if (pat == 0 || *pat == '\0' || sp == 0) {
         return 0;
     }
+#if ME_CHAR_LEN == 1
+    return (int) findPattern(sp->value, sp->length, pat, slen(pat));
+#else
+{
+    ssize   len;
+    int     i, j, k;
+
     len = strlen(pat);
-    
-    for (i = 0; i < sp->length; i++) {
+    for (i = 0; i <= sp->length - len; i++) {
         for (j = 0, k = i; j < len; j++, k++) {
             if (sp->value[k] != pat[j]) {
                 break;
@@ -2181,30 +2210,20 @@ PUBLIC int ejsContainsAsc(Ejs *ejs, EjsString *sp, cchar *pat)
     }
     return -1;
 }
+#endif
+}
 
 
 PUBLIC int ejsContainsString(Ejs *ejs, EjsString *sp, EjsString *pat)
 {
-    int     i, j, k;
-
     assert(sp);
     assert(pat);
     assert(pat->value);
 
-    if (pat == 0) {
-        return -1;
-    }
-    for (i = 0; i < sp->length; i++) {
-        for (j = 0, k = i; j < pat->length; j++, k++) {
-            if (sp->value[k] != pat->value[j]) {
-                break;
-            }
-        }
-        if (j == pat->length) {
-            return i;
-        }
+    if (pat == 0 || pat->length == 0) {
+        return (pat && sp->length > 0) ? 0 : -1;
     }
-    return -1;
+    return (int) findPattern(sp->value, sp->length, pat->value, pat->length);
 }
 
 
@@ -2379,6 +2398,21 @@ static void revive(EjsString *sp)
 }
 
 
+/*
+    Return the hash for a string. The hash is computed on first use and cached in the string header. Interned strings
+    are hashed when they are interned so property and intern lookups never rehash the string value.
+ */
+PUBLIC uint ejsHashString(EjsString *sp)
+{
+    assert(sp);
+
+    if (sp->hash == 0) {
+        sp->hash = whash(sp->value, sp->length);
+    }
+    return sp->hash;
+}
+
+
 /*
     Intern a unicode string. Lookup a string and return an interned string (this may be an existing interned string)
  */
@@ -2386,7 +2420,6 @@ PUBLIC EjsString *ejsInternString(EjsString *str)
 {
     EjsString   *head, *sp;
     EjsIntern   *ip;
-    ssize       i, len;
     int         index, step;
 
     ip = ((EjsService*) MPR->ejsService)->intern;
@@ -2394,7 +2427,7 @@ PUBLIC EjsString *ejsInternString(EjsString *str)
 
     lock(ip);
     ip->accesses++;
-    index = whash(str->value, str->length) % ip->size;
+    index = ejsHashString(str) % ip->size;
     if ((head = &ip->buckets[index]) != NULL) {
         for (sp = head->next; sp != head; sp = sp->next, step++) {
             if (str == sp) {
@@ -2402,21 +2435,11 @@ PUBLIC EjsString *ejsInternString(EjsString *str)
                 unlock(ip);
                 return sp;
             }
-            if (sp->length == str->length) {
-                //  TODO but they are the same?
-                len = min(sp->length, str->length);
-                //  OPT
-                for (i = 0; i < len; i++) {
-                    if (sp->value[i] != str->value[i]) {
-                        break;
-                    }
-                }
-                if (i == sp->length && i == str->length) {
-                    ip->reuse++;
-                    revive(sp);
-                    unlock(ip);
-                    return sp;
-                }
+            if (sp->length == str->length && memcmp(sp->value, str->value, str->length * sizeof(wchar)) == 0) {
+                ip->reuse++;
+                revive(sp);
+                unlock(ip);
+                return sp;
             }
         }
     }
@@ -2439,7 +2462,7 @@ PUBLIC EjsString *ejsInternWide(Ejs *ejs, wchar *value, ssize len)
 {
     EjsString   *head, *sp;
     EjsIntern   *ip;
-    ssize       i, end;
+    uint        hash;
     int         index, step;
 
     assert(0 <= len && len < MAXINT);
@@ -2450,23 +2473,15 @@ PUBLIC EjsString *ejsInternWide(Ejs *ejs, wchar *value, ssize len)
     lock(ip);
     //  TODO - accesses should be debug only
     ip->accesses++;
-    index = whash(value, len) % ip->size;
+    hash = whash(value, len);
+    index = hash % ip->size;
     if ((head = &ip->buckets[index]) != NULL) {
         for (sp = head->next; sp != head; sp = sp->next, step++) {
-            //  TODO - why not compare sp->value with value?
-            if (sp->length == len) {
-                end = min(sp->length, len);
-                for (i = 0; i < end && value[i]; i++) {
-                    if (sp->value[i] != value[i]) {
-                        break;
-                    }
-                }
-                if (i == sp->length) {
-                    ip->reuse++;
-                    revive(sp);
-                    unlock(ip);
-                    return sp;
-                }
+            if (sp->length == len && memcmp(sp->value, value, len * sizeof(wchar)) == 0) {
+                ip->reuse++;
+                revive(sp);
+                unlock(ip);
+                return sp;
             }
         }
     }
@@ -2475,6 +2490,7 @@ PUBLIC EjsString *ejsInternWide(Ejs *ejs, wchar *value, ssize len)
         sp->value[len] = 0;
     }
     sp->length = len;
+    sp->hash = hash;
     ip->count++;
     linkString(head, sp);
     if (step > EJS_MAX_COLLISIONS && ip->count > (ip->size/2)) {
@@ -2491,7 +2507,8 @@ PUBLIC EjsString *ejsInternAsc(Ejs *ejs, cchar *value, ssize len)
 {
     EjsString   *head, *sp;
     EjsIntern   *ip;
-    ssize       i, end;
+    ssize       i;
+    uint        hash;
     int         index, step;
 
     assert(0 <= len && len < MAXINT);
@@ -2502,16 +2519,20 @@ PUBLIC EjsString *ejsInternAsc(Ejs *ejs, cchar *value, ssize len)
     lock(ip);
     ip->accesses++;
     assert(ip->size > 0);
-    index = shash(value, len) % ip->size;
+    hash = shash(value, len);
+    index = hash % ip->size;
     if ((head = &ip->buckets[index]) != NULL) {
         for (sp = head->next; sp != head; sp = sp->next, step++) {
             if (sp->length == len) {
-                end = min(len, sp->length);
-                for (i = 0; i < end && value[i]; i++) {
+#if ME_CHAR_LEN == 1
+                i = memcmp(sp->value, value, len) == 0 ? len : 0;
+#else
+                for (i = 0; i < len; i++) {
                     if (sp->value[i] != (uchar) value[i]) {
                         break;
                     }
                 }
+#endif
                 if (i == sp->length) {
                     ip->reuse++;
                     revive(sp);
@@ -2529,6 +2550,8 @@ PUBLIC EjsString *ejsInternAsc(Ejs *ejs, cchar *value, ssize len)
         sp->length = len;
 #else
         memcpy(sp->value, value, len * sizeof(wchar));
+        /* Same as whash for single byte characters */
+        sp->hash = hash;
 #endif
         sp->value[len] = 0;
     }
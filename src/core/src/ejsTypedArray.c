@@ -0,0 +1,681 @@
+/*
+    ejsTypedArray.c - Int32Array, Float64Array and Uint8Array typed array classes
+    Copyright (c) All Rights Reserved. See details at the end of the file.
+ */
+
+/********************************** Includes **********************************/
+
+#include    "ejs.h"
+
+/***************************** Forward Declarations ***************************/
+/*
+    Int32Array, Float64Array and Uint8Array store unboxed elements in a ByteArray buffer. The element data is located 
+    via the buffer on each access as the buffer storage may be reallocated if it grows.
+ */
+#define typedData(ta) (&((EjsTypedArray*) ta)->buffer->value[((EjsTypedArray*) ta)->offset])
+
+static EjsString *ta_toString(Ejs *ejs, EjsTypedArray *ta, int argc, EjsObj **argv);
+
+/*********************************** Support **********************************/
+
+static int getTypedKind(Ejs *ejs, EjsType *type)
+{
+    if (type == EST(Float64Array)) {
+        return EJS_TYPED_FLOAT64;
+    } else if (type == EST(Int32Array)) {
+        return EJS_TYPED_INT32;
+    }
+    return EJS_TYPED_UINT8;
+}
+
+
+static EjsType *getTypedType(Ejs *ejs, int kind)
+{
+    if (kind == EJS_TYPED_FLOAT64) {
+        return EST(Float64Array);
+    } else if (kind == EJS_TYPED_INT32) {
+        return EST(Int32Array);
+    }
+    return EST(Uint8Array);
+}
+
+
+static int getTypedElementSize(int kind)
+{
+    if (kind == EJS_TYPED_FLOAT64) {
+        return sizeof(double);
+    } else if (kind == EJS_TYPED_INT32) {
+        return sizeof(int);
+    }
+    return sizeof(uchar);
+}
+
+
+/*
+    Return the number of usable elements. A view may extend past the end of a buffer that has since shrunk.
+ */
+static ME_INLINE int typedLength(EjsTypedArray *ta)
+{
+    ssize   avail;
+
+    avail = (ta->buffer->size - ta->offset) / ta->size;
+    if (avail < ta->length) {
+        return (avail < 0) ? 0 : (int) avail;
+    }
+    return ta->length;
+}
+
+
+/*
+    Convert to a 32-bit integer. Fractions are truncated and out of range values wrap.
+ */
+static ME_INLINE int toInt32(double value)
+{
+    if (value > -2147483649.0 && value < 2147483648.0) {
+        return (int) value;
+    }
+    if (mprIsNan(value) || mprIsInfinite(value)) {
+        return 0;
+    }
+    return (int) (uint) (int64) fmod(value, 4294967296.0);
+}
+
+
+static double toTypedValue(Ejs *ejs, EjsAny *value)
+{
+    EjsNumber   *np;
+
+    if (value && ejsIs(ejs, value, Number)) {
+        return ((EjsNumber*) value)->value;
+    }
+    if (value == 0 || (np = ejsToNumber(ejs, value)) == 0) {
+        return 0;
+    }
+    return np->value;
+}
+
+
+static ME_INLINE double getTypedValue(EjsTypedArray *ta, uchar *data, int index)
+{
+    if (ta->kind == EJS_TYPED_FLOAT64) {
+        return ((double*) data)[index];
+    } else if (ta->kind == EJS_TYPED_INT32) {
+        return ((int*) data)[index];
+    }
+    return data[index];
+}
+
+
+static ME_INLINE void setTypedValue(EjsTypedArray *ta, uchar *data, int index, double value)
+{
+    if (ta->kind == EJS_TYPED_FLOAT64) {
+        ((double*) data)[index] = value;
+    } else if (ta->kind == EJS_TYPED_INT32) {
+        ((int*) data)[index] = toInt32(value);
+    } else {
+        data[index] = (uchar) toInt32(value);
+    }
+}
+
+
+/*
+    Allocate a new zero filled buffer for length elements
+ */
+static int allocTypedBuffer(Ejs *ejs, EjsTypedArray *ta, ssize length)
+{
+    if (length < 0 || length > (MAXINT / ta->size)) {
+        ejsThrowArgError(ejs, "Bad array length");
+        return EJS_ERR;
+    }
+    if ((ta->buffer = ejsCreateByteArray(ejs, max(length * ta->size, 1))) == 0) {
+        return EJS_ERR;
+    }
+    ta->buffer->resizable = 0;
+    ta->offset = 0;
+    ta->length = (int) length;
+    return 0;
+}
+
+
+/*
+    Copy elements from an Array or typed array starting at the given element offset
+ */
+static int copyElements(Ejs *ejs, EjsTypedArray *ta, EjsAny *source, int offset)
+{
+    EjsTypedArray   *src;
+    EjsArray        *ap;
+    double          value;
+    int             i, count;
+
+    src = 0;
+    ap = 0;
+    if (ejsIsTypedArray(ejs, source)) {
+        src = source;
+        count = typedLength(src);
+    } else if (ejsIs(ejs, source, Array)) {
+        ap = source;
+        count = ap->length;
+    } else {
+        ejsThrowArgError(ejs, "Source must be an array");
+        return EJS_ERR;
+    }
+    if (offset < 0 || count > (typedLength(ta) - offset)) {
+        ejsThrowOutOfBoundsError(ejs, "Source is too large");
+        return EJS_ERR;
+    }
+    if (src && src->kind == ta->kind) {
+        memmove(typedData(ta) + offset * ta->size, typedData(src), count * ta->size);
+
+    } else if (src) {
+        if (src->buffer == ta->buffer) {
+            /* Overlapping views of different kinds */
+            src = ejsClone(ejs, src, 1);
+        }
+        for (i = 0; i < count; i++) {
+            setTypedValue(ta, typedData(ta), offset + i, getTypedValue(src, typedData(src), i));
+        }
+    } else {
+        for (i = 0; i < count && i < ap->length; i++) {
+            /* Conversion may run script, so the buffer is located for each element */
+            value = toTypedValue(ejs, ejsGetProperty(ejs, ap, i));
+            if (ejs->exception) {
+                return EJS_ERR;
+            }
+            if ((offset + i) < typedLength(ta)) {
+                setTypedValue(ta, typedData(ta), offset + i, value);
+            }
+        }
+    }
+    return 0;
+}
+
+
+static EjsTypedArray *createView(Ejs *ejs, EjsTypedArray *ta, ssize offset, int length)
+{
+    EjsTypedArray   *view;
+
+    if ((view = ejsCreateObj(ejs, TYPE(ta), 0)) == 0) {
+        return 0;
+    }
+    view->kind = ta->kind;
+    view->size = ta->size;
+    view->buffer = ta->buffer;
+    view->offset = offset;
+    view->length = length;
+    return view;
+}
+
+/******************************************************************************/
+
+static EjsAny *castTypedArray(Ejs *ejs, EjsTypedArray *ta, EjsType *type)
+{
+    switch (type->sid) {
+    case S_Boolean:
+        return ESV(true);
+
+    case S_String:
+        return ta_toString(ejs, ta, 0, 0);
+
+    default:
+        ejsThrowTypeError(ejs, "Cannot cast to this type");
+        return 0;
+    }
+}
+
+
+/*
+    A shallow clone is another view of the same buffer. A deep clone copies the elements.
+ */
+static EjsTypedArray *cloneTypedArray(Ejs *ejs, EjsTypedArray *ta, bool deep)
+{
+    EjsTypedArray   *result;
+
+    if (!deep) {
+        return createView(ejs, ta, ta->offset, ta->length);
+    }
+    if ((result = ejsCreateTypedArray(ejs, ta->kind, typedLength(ta))) == 0) {
+        return 0;
+    }
+    memcpy(typedData(result), typedData(ta), result->length * ta->size);
+    return result;
+}
+
+
+static ssize getTypedArrayPropertyCount(Ejs *ejs, EjsTypedArray *ta)
+{
+    return typedLength(ta);
+}
+
+
+static EjsAny *getTypedArrayProperty(Ejs *ejs, EjsTypedArray *ta, int slotNum)
+{
+    return ejsGetTypedArrayElement(ejs, ta, slotNum);
+}
+
+
+static int lookupTypedArrayProperty(Ejs *ejs, EjsTypedArray *ta, EjsName qname)
+{
+    int     index;
+
+    if (qname.name == 0 || !isdigit((uchar) qname.name->value[0])) {
+        return EJS_ERR;
+    }
+    index = ejsAtoi(ejs, qname.name, 10);
+    if (index < typedLength(ta)) {
+        return index;
+    }
+    return EJS_ERR;
+}
+
+
+static int setTypedArrayProperty(Ejs *ejs, EjsTypedArray *ta, int slotNum, EjsAny *value)
+{
+    return ejsSetTypedArrayElement(ejs, ta, slotNum, value);
+}
+
+/********************************** Methods *********************************/
+/*
+    function Int32Array(source: Object = 0, byteOffset: Number = 0, length: Number = -1)
+ */
+static EjsTypedArray *ta_TypedArray(Ejs *ejs, EjsTypedArray *ta, int argc, EjsObj **argv)
+{
+    EjsByteArray    *buffer;
+    EjsAny          *source;
+    ssize           offset, length;
+
+    source = (argc >= 1) ? argv[0] : ESV(zero);
+    ta->kind = getTypedKind(ejs, TYPE(ta));
+    ta->size = getTypedElementSize(ta->kind);
+
+    if (ejsIs(ejs, source, ByteArray)) {
+        buffer = source;
+        offset = (argc >= 2) ? ejsGetInt(ejs, argv[1]) : 0;
+        if (offset < 0 || offset > buffer->size || (offset % ta->size) != 0) {
+            ejsThrowArgError(ejs, "Bad byte offset");
+            return 0;
+        }
+        length = (argc >= 3) ? ejsGetInt(ejs, argv[2]) : -1;
+        if (length < 0) {
+            length = (buffer->size - offset) / ta->size;
+        } else if ((offset + length * ta->size) > buffer->size) {
+            ejsThrowOutOfBoundsError(ejs, "View exceeds the size of the byte array");
+            return 0;
+        }
+        ta->buffer = buffer;
+        ta->offset = offset;
+        ta->length = (int) length;
+        return ta;
+    }
+    if (ejsIs(ejs, source, Array)) {
+        length = ((EjsArray*) source)->length;
+    } else if (ejsIsTypedArray(ejs, source)) {
+        length = typedLength(source);
+    } else {
+        length = ejsGetInt(ejs, source);
+        source = 0;
+    }
+    if (allocTypedBuffer(ejs, ta, length) < 0) {
+        return 0;
+    }
+    if (source && copyElements(ejs, ta, source, 0) < 0) {
+        return 0;
+    }
+    return ta;
+}
+
+
+/*
+    function get buffer(): ByteArray
+ */
+static EjsByteArray *ta_buffer(Ejs *ejs, EjsTypedArray *ta, int argc, EjsObj **argv)
+{
+    return ta->buffer;
+}
+
+
+/*
+    function get byteOffset(): Number
+ */
+static EjsNumber *ta_byteOffset(Ejs *ejs, EjsTypedArray *ta, int argc, EjsObj **argv)
+{
+    return ejsCreateNumber(ejs, (MprNumber) ta->offset);
+}
+
+
+/*
+    function fill(value: Number, start: Number = 0, end: Number = -1): Int32Array
+ */
+static EjsTypedArray *ta_fill(Ejs *ejs, EjsTypedArray *ta, int argc, EjsObj **argv)
+{
+    double      value, *dp;
+    uchar       *data;
+    int         *ip, i, iv, start, end, length;
+
+    value = toTypedValue(ejs, argv[0]);
+    start = (argc >= 2) ? ejsGetInt(ejs, argv[1]) : 0;
+    end = (argc >= 3) ? ejsGetInt(ejs, argv[2]) : -1;
+    length = typedLength(ta);
+    if (end < 0 || end > length) {
+        end = length;
+    }
+    if (start < 0) {
+        start = 0;
+    }
+    if (start >= end) {
+        return ta;
+    }
+    data = typedData(ta);
+    if (ta->kind == EJS_TYPED_FLOAT64) {
+        dp = (double*) data;
+        for (i = start; i < end; i++) {
+            dp[i] = value;
+        }
+    } else if (ta->kind == EJS_TYPED_INT32) {
+        ip = (int*) data;
+        iv = toInt32(value);
+        for (i = start; i < end; i++) {
+            ip[i] = iv;
+        }
+    } else {
+        memset(&data[start], (uchar) toInt32(value), end - start);
+    }
+    return ta;
+}
+
+
+/*
+    Function to iterate and return the next element index.
+    NOTE: this is not a method of Int32Array. Rather, it is a callback function for Iterator
+ */
+static EjsNumber *nextTypedArrayKey(Ejs *ejs, EjsIterator *ip, int argc, EjsObj **argv)
+{
+    EjsTypedArray   *ta;
+
+    ta = (EjsTypedArray*) ip->target;
+    if (ip->index < typedLength(ta)) {
+        return ejsCreateNumber(ejs, ip->index++);
+    }
+    ejsThrowStopIteration(ejs);
+    return 0;
+}
+
+
+/*
+    Return the default iterator. This returns the array index names.
+    iterator native function get(): Iterator
+ */
+static EjsIterator *ta_get(Ejs *ejs, EjsTypedArray *ta, int argc, EjsObj **argv)
+{
+    return ejsCreateIterator(ejs, ta, -1, nextTypedArrayKey, 0, NULL);
+}
+
+
+/*
+    Function to iterate and return the next element value.
+    NOTE: this is not a method of Int32Array. Rather, it is a callback function for Iterator
+ */
+static EjsNumber *nextTypedArrayValue(Ejs *ejs, EjsIterator *ip, int argc, EjsObj **argv)
+{
+    EjsTypedArray   *ta;
+
+    ta = (EjsTypedArray*) ip->target;
+    if (ip->index < typedLength(ta)) {
+        return ejsCreateNumber(ejs, getTypedValue(ta, typedData(ta), ip->index++));
+    }
+    ejsThrowStopIteration(ejs);
+    return 0;
+}
+
+
+/*
+    Return an iterator to return the next array element value.
+    iterator native function getValues(): Iterator
+ */
+static EjsIterator *ta_getValues(Ejs *ejs, EjsTypedArray *ta, int argc, EjsObj **argv)
+{
+    return ejsCreateIterator(ejs, ta, -1, nextTypedArrayValue, 0, NULL);
+}
+
+
+/*
+    function get length(): Number
+ */
+static EjsNumber *ta_length(Ejs *ejs, EjsTypedArray *ta, int argc, EjsObj **argv)
+{
+    return ejsCreateNumber(ejs, typedLength(ta));
+}
+
+
+/*
+    function map(mapper: Function): Int32Array
+ */
+static EjsTypedArray *ta_map(Ejs *ejs, EjsTypedArray *ta, int argc, EjsObj **argv)
+{
+    EjsTypedArray   *result;
+    EjsAny          *funArgs[3], *value;
+    int             i, length;
+
+    length = typedLength(ta);
+    if ((result = ejsCreateTypedArray(ejs, ta->kind, length)) == 0) {
+        return 0;
+    }
+    mprAddRoot(result);
+    for (i = 0; i < length && i < typedLength(ta); i++) {
+        funArgs[0] = ejsCreateNumber(ejs, getTypedValue(ta, typedData(ta), i));
+        funArgs[1] = ejsCreateNumber(ejs, i);
+        funArgs[2] = ta;
+        if ((value = ejsRunFunction(ejs, (EjsFunction*) argv[0], 0, 3, funArgs)) == 0) {
+            break;
+        }
+        setTypedValue(result, typedData(result), i, toTypedValue(ejs, value));
+    }
+    mprRemoveRoot(result);
+    return ejs->exception ? 0 : result;
+}
+
+
+/*
+    function set(source: Object, offset: Number = 0): Void
+ */
+static EjsObj *ta_set(Ejs *ejs, EjsTypedArray *ta, int argc, EjsObj **argv)
+{
+    copyElements(ejs, ta, argv[0], (argc >= 2) ? ejsGetInt(ejs, argv[1]) : 0);
+    return 0;
+}
+
+
+/*
+    function subarray(start: Number = 0, end: Number = -1): Int32Array
+ */
+static EjsTypedArray *ta_subarray(Ejs *ejs, EjsTypedArray *ta, int argc, EjsObj **argv)
+{
+    int     start, end, length;
+
+    start = (argc >= 1) ? ejsGetInt(ejs, argv[0]) : 0;
+    end = (argc >= 2) ? ejsGetInt(ejs, argv[1]) : -1;
+    length = typedLength(ta);
+    if (end < 0 || end > length) {
+        end = length;
+    }
+    if (start < 0) {
+        start = 0;
+    } else if (start > end) {
+        start = end;
+    }
+    return createView(ejs, ta, ta->offset + start * ta->size, end - start);
+}
+
+
+/*
+    function sum(): Number
+ */
+static EjsNumber *ta_sum(Ejs *ejs, EjsTypedArray *ta, int argc, EjsObj **argv)
+{
+    uchar       *data;
+    double      *dp, sum;
+    int64       isum;
+    int         *ip, i, length;
+
+    data = typedData(ta);
+    length = typedLength(ta);
+    if (ta->kind == EJS_TYPED_FLOAT64) {
+        dp = (double*) data;
+        sum = 0;
+        for (i = 0; i < length; i++) {
+            sum += dp[i];
+        }
+        return ejsCreateNumber(ejs, sum);
+    }
+    isum = 0;
+    if (ta->kind == EJS_TYPED_INT32) {
+        ip = (int*) data;
+        for (i = 0; i < length; i++) {
+            isum += ip[i];
+        }
+    } else {
+        for (i = 0; i < length; i++) {
+            isum += data[i];
+        }
+    }
+    return ejsCreateNumber(ejs, (MprNumber) isum);
+}
+
+
+/*
+    function toString(): String
+ */
+static EjsString *ta_toString(Ejs *ejs, EjsTypedArray *ta, int argc, EjsObj **argv)
+{
+    MprBuf      *buf;
+    int         i, length;
+
+    buf = mprCreateBuf(0, 0);
+    length = typedLength(ta);
+    for (i = 0; i < length; i++) {
+        if (i > 0) {
+            mprPutCharToBuf(buf, ',');
+        }
+        mprPutStringToBuf(buf, ejsToMulti(ejs, ejsCreateNumber(ejs, getTypedValue(ta, typedData(ta), i))));
+    }
+    mprAddNullToBuf(buf);
+    return ejsCreateStringFromAsc(ejs, mprGetBufStart(buf));
+}
+
+/********************************* Public Support API *****************************/
+
+PUBLIC EjsAny *ejsGetTypedArrayElement(Ejs *ejs, EjsTypedArray *ta, int index)
+{
+    if (index < 0 || index >= typedLength(ta)) {
+        ejsThrowOutOfBoundsError(ejs, "Bad array subscript");
+        return 0;
+    }
+    return ejsCreateNumber(ejs, getTypedValue(ta, typedData(ta), index));
+}
+
+
+PUBLIC int ejsSetTypedArrayElement(Ejs *ejs, EjsTypedArray *ta, int index, EjsAny *value)
+{
+    double  v;
+
+    v = toTypedValue(ejs, value);
+    if (index < 0 || index >= typedLength(ta)) {
+        ejsThrowOutOfBoundsError(ejs, "Bad array subscript");
+        return EJS_ERR;
+    }
+    setTypedValue(ta, typedData(ta), index, v);
+    return index;
+}
+
+/*********************************** Factory **********************************/
+
+PUBLIC EjsTypedArray *ejsCreateTypedArray(Ejs *ejs, int kind, int length)
+{
+    EjsTypedArray   *ta;
+
+    if ((ta = ejsCreateObj(ejs, getTypedType(ejs, kind), 0)) == 0) {
+        return 0;
+    }
+    ta->kind = kind;
+    ta->size = getTypedElementSize(kind);
+    if (allocTypedBuffer(ejs, ta, length) < 0) {
+        return 0;
+    }
+    return ta;
+}
+
+
+static void manageTypedArray(EjsTypedArray *ta, int flags)
+{
+    if (flags & MPR_MANAGE_MARK) {
+        mprMark(ta->buffer);
+        mprMark(TYPE(ta));
+    }
+}
+
+
+/*
+    The typed array classes declare identical members in the same order and so share slot numbers
+ */
+static void configureTypedArrayType(Ejs *ejs, cchar *name)
+{
+    EjsType     *type;
+    EjsHelpers  *helpers;
+    EjsPot      *prototype;
+
+    if ((type = ejsFinalizeScriptType(ejs, N("ejs", name), sizeof(EjsTypedArray), manageTypedArray,
+            EJS_TYPE_OBJ | EJS_TYPE_NUMERIC_INDICIES | EJS_TYPE_VIRTUAL_SLOTS | EJS_TYPE_MUTABLE_INSTANCES)) == 0) {
+        return;
+    }
+    helpers = &type->helpers;
+    helpers->cast = (EjsCastHelper) castTypedArray;
+    helpers->clone = (EjsCloneHelper) cloneTypedArray;
+    helpers->getProperty = (EjsGetPropertyHelper) getTypedArrayProperty;
+    helpers->getPropertyCount = (EjsGetPropertyCountHelper) getTypedArrayPropertyCount;
+    helpers->lookupProperty = (EjsLookupPropertyHelper) lookupTypedArrayProperty;
+    helpers->setProperty = (EjsSetPropertyHelper) setTypedArrayProperty;
+
+    prototype = type->prototype;
+    ejsBindConstructor(ejs, type, ta_TypedArray);
+    ejsBindAccess(ejs, prototype, ES_Int32Array_buffer, ta_buffer, 0);
+    ejsBindAccess(ejs, prototype, ES_Int32Array_byteOffset, ta_byteOffset, 0);
+    ejsBindMethod(ejs, prototype, ES_Int32Array_fill, ta_fill);
+    ejsBindMethod(ejs, prototype, ES_Int32Array_iterator_get, ta_get);
+    ejsBindMethod(ejs, prototype, ES_Int32Array_iterator_getValues, ta_getValues);
+    ejsBindAccess(ejs, prototype, ES_Int32Array_length, ta_length, 0);
+    ejsBindMethod(ejs, prototype, ES_Int32Array_map, ta_map);
+    ejsBindMethod(ejs, prototype, ES_Int32Array_set, ta_set);
+    ejsBindMethod(ejs, prototype, ES_Int32Array_subarray, ta_subarray);
+    ejsBindMethod(ejs, prototype, ES_Int32Array_sum, ta_sum);
+    ejsBindMethod(ejs, prototype, ES_Int32Array_toString, ta_toString);
+}
+
+
+PUBLIC void ejsConfigureTypedArrayTypes(Ejs *ejs)
+{
+    assert(ES_Float64Array_toString == ES_Int32Array_toString && ES_Uint8Array_toString == ES_Int32Array_toString);
+    assert(ES_Float64Array_buffer == ES_Int32Array_buffer && ES_Uint8Array_buffer == ES_Int32Array_buffer);
+    configureTypedArrayType(ejs, "Int32Array");
+    configureTypedArrayType(ejs, "Float64Array");
+    configureTypedArrayType(ejs, "Uint8Array");
+}
+
+
+/*
+    @copy   default
+
+    Copyright (c) Embedthis Software. All Rights Reserved.
+
+    This software is distributed under commercial and open source licenses.
+    You may use the Embedthis Open Source license or you may acquire a 
+    commercial license from Embedthis Software. You agree to be fully bound
+    by the terms of either license. Consult the LICENSE.md distributed with
+    this software for full details and other copyrights.
+
+    Local variables:
+    tab-width: 4
+    c-basic-offset: 4
+    End:
+    vim: sw=4 ts=4 expandtab
+
+    @end
+ */
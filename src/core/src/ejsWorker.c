@@ -12,12 +12,54 @@
 typedef struct Message {
     EjsWorker   *worker;
     cchar       *callback;
-    char        *data;
+    MprBuf      *data;                  /* Encoded message data */
+    MprList     *transfers;             /* ByteArray buffers transferred with the message */
     EjsObj      *message;
     EjsObj      *stack;
     int         callbackSlot;
 } Message;
 
+/*
+    Message encoding tags. Messages are encoded in the sending interpreter and decoded in the receiving interpreter.
+    Fixed size numbers are stored in little-endian byte order. Worker messages store strings as wide characters and may
+    transfer buffer pointers. Values encoded for storage by ejsEncodeValue are prefixed by MSG_VERSION, store strings
+    as UTF-8 and never contain pointers.
+ */
+#define MSG_UNDEFINED   1
+#define MSG_NULL        2
+#define MSG_TRUE        3
+#define MSG_FALSE       4
+#define MSG_NUMBER      5               /* MprNumber */
+#define MSG_STRING      6               /* Length, characters */
+#define MSG_ARRAY       7               /* Length, elements */
+#define MSG_OBJECT      8               /* Count, (key, value) pairs */
+#define MSG_KEY         9               /* Length, characters. Defines the next key index */
+#define MSG_KEYREF      10              /* Key index of a previously defined key */
+#define MSG_DATE        11              /* MprTime */
+#define MSG_BYTES       12              /* Length, readPosition, writePosition, bytes */
+#define MSG_TRANSFER    13              /* Buffer pointer, size, readPosition, writePosition */
+#define MSG_JSON        14              /* Length, characters. Values with a custom toJSON */
+
+#define MSG_VERSION     0x81            /* Encoding version of stored values */
+#define MSG_MAX_DEPTH   99
+
+typedef struct Encoder {
+    MprBuf      *buf;
+    MprHash     *keys;                  /* Map of property names to key indicies */
+    MprList     *transfers;             /* Buffers transferred to the receiver */
+    MprList     *detach;                /* Transferred ByteArrays to empty once the message is encoded */
+    EjsArray    *transferList;          /* ByteArrays to transfer rather than copy */
+    int         depth;
+    int         message;                /* Encoding an in-process worker message */
+} Encoder;
+
+typedef struct Decoder {
+    uchar       *next;
+    uchar       *end;
+    MprList     *keys;                  /* Property names by key index */
+    int         message;                /* Decoding an in-process worker message. Otherwise pointers are rejected */
+} Decoder;
+
 /*********************************** Forwards *********************************/
 
 static void addWorker(Ejs *ejs, EjsWorker *worker);
@@ -27,6 +69,8 @@ static void loadFile(EjsWorker *insideWorker, cchar *filename);
 static void removeWorker(EjsWorker *worker);
 static int workerMain(EjsWorker *worker, MprEvent *event);
 static EjsObj *workerPreload(Ejs *ejs, EjsWorker *worker, int argc, EjsObj **argv);
+static EjsAny *decodeMessage(Ejs *ejs, Message *msg);
+static int encodeMessage(Ejs *ejs, Message *msg, EjsAny *vp, EjsArray *transferList);
 
 /************************************ Methods *********************************/
 
@@ -462,7 +506,7 @@ static EjsWorker *workerLookup(Ejs *ejs, EjsObj *unused, int argc, EjsObj **argv
 static int doMessage(Message *msg, MprEvent *mprEvent)
 {
     Ejs         *ejs;
-    EjsObj      *event, *frame;
+    EjsObj      *event, *frame, *data;
     EjsWorker   *worker;
     EjsFunction *callback;
     EjsObj      *argv[1];
@@ -493,7 +537,11 @@ static int doMessage(Message *msg, MprEvent *mprEvent)
     }
     worker->event = event;
     if (msg->data) {
-        ejsSetProperty(ejs, event, ES_Event_data, ejsCreateStringFromAsc(ejs, msg->data));
+        if ((data = decodeMessage(ejs, msg)) == 0) {
+            worker->event = 0;
+            return 0;
+        }
+        ejsSetProperty(ejs, event, ES_Event_data, data);
     }
     if (msg->message) {
         ejsSetProperty(ejs, event, ES_ErrorEvent_message, msg->message);
@@ -613,6 +661,7 @@ static void manageMessage(Message *msg, int flags)
 {
     if (flags & MPR_MANAGE_MARK) {
         mprMark(msg->data);
+        mprMark(msg->transfers);
         mprMark(msg->message);
         mprMark(msg->stack);
     }
@@ -625,36 +674,685 @@ static Message *createMessage()
 }
 
 
+/*
+    Message encoding. Messages are encoded using a compact binary format in the sending interpreter. Each value is
+    prefixed by a type tag. Strings are length prefixed and property names are sent once per message and thereafter
+    referenced by index. Values with a custom toJSON method are encoded as JSON text.
+ */
+static void putLength(MprBuf *buf, ssize len)
+{
+    while (len >= 0x80) {
+        mprPutCharToBuf(buf, (int) ((len & 0x7F) | 0x80));
+        len >>= 7;
+    }
+    mprPutCharToBuf(buf, (int) len);
+}
+
+
+static void putInt(MprBuf *buf, uint64 value, int size)
+{
+    int     i;
+
+    for (i = 0; i < size; i++) {
+        mprPutCharToBuf(buf, (int) ((value >> (i * 8)) & 0xFF));
+    }
+}
+
+
+static void putNumber(MprBuf *buf, MprNumber number)
+{
+    uint64  value;
+
+    memcpy(&value, &number, sizeof(value));
+    putInt(buf, value, sizeof(value));
+}
+
+
+static void putChars(Encoder *enc, int tag, wchar *value, ssize len)
+{
+#if ME_CHAR_LEN > 1
+    char    *str;
+
+    if (!enc->message) {
+        len = wtom(NULL, MAXSSIZE, value, len);
+        if ((str = mprAlloc(len + 1)) != 0) {
+            wtom(str, len + 1, value, len);
+            mprPutCharToBuf(enc->buf, tag);
+            putLength(enc->buf, len);
+            mprPutBlockToBuf(enc->buf, str, len);
+        }
+        return;
+    }
+#endif
+    mprPutCharToBuf(enc->buf, tag);
+    putLength(enc->buf, len);
+    mprPutBlockToBuf(enc->buf, (char*) value, len * sizeof(wchar));
+}
+
+
+static void putKey(Encoder *enc, EjsString *name)
+{
+    MprKey  *kp;
+    int     index;
+
+    if (enc->keys == 0) {
+        enc->keys = mprCreateHash(0, MPR_HASH_UNICODE | MPR_HASH_STATIC_ALL | MPR_HASH_STABLE);
+    }
+    if ((kp = mprLookupKeyEntry(enc->keys, name->value)) != 0) {
+        mprPutCharToBuf(enc->buf, MSG_KEYREF);
+        putLength(enc->buf, PTOI(kp->data) - 1);
+    } else {
+        index = mprGetHashLength(enc->keys);
+        mprAddKey(enc->keys, name->value, ITOP(index + 1));
+        putChars(enc, MSG_KEY, name->value, name->length);
+    }
+}
+
+
+/*
+    Test if a value is serialized by the default Object.toJSON
+ */
+static int isPlainObject(Ejs *ejs, EjsAny *vp)
+{
+    EjsFunction     *fn;
+
+    if (!ejsIsPot(ejs, vp)) {
+        return 0;
+    }
+    if (TYPE(vp) == ESV(Object) || TYPE(vp) == ESV(Array)) {
+        return 1;
+    }
+    if (ejsGetLength(ejs, vp) == 0) {
+        return 0;
+    }
+    fn = (EjsFunction*) ejsGetPropertyByName(ejs, TYPE(vp)->prototype, N(NULL, "toJSON"));
+    return !ejsIsFunction(ejs, fn) || (fn->isNativeProc && fn->body.proc == (EjsProc) ejsObjToJSON);
+}
+
+
+static int encodeByteArray(Ejs *ejs, Encoder *enc, EjsByteArray *ap)
+{
+    MprBuf  *buf;
+    uchar   *value;
+    int     i;
+
+    buf = enc->buf;
+    if (enc->transferList) {
+        for (i = 0; i < enc->transferList->length; i++) {
+            if (enc->transferList->data[i] == (EjsObj*) ap) {
+                /*
+                    Transfer ownership of the buffer to the receiver. The sender's ByteArray is emptied by 
+                    encodeMessage once the whole message is encoded. Later references in the message receive an 
+                    empty ByteArray.
+                 */
+                value = (mprLookupItem(enc->detach, ap) < 0) ? ap->value : 0;
+                mprPutCharToBuf(buf, MSG_TRANSFER);
+                mprPutBlockToBuf(buf, (char*) &value, sizeof(uchar*));
+                putLength(buf, value ? ap->size : 0);
+                putLength(buf, value ? ap->readPosition : 0);
+                putLength(buf, value ? ap->writePosition : 0);
+                if (value) {
+                    mprAddItem(enc->transfers, value);
+                }
+                mprAddItem(enc->detach, ap);
+                return 0;
+            }
+        }
+    }
+    mprPutCharToBuf(buf, MSG_BYTES);
+    putLength(buf, ap->writePosition);
+    putLength(buf, ap->readPosition);
+    mprPutBlockToBuf(buf, (char*) ap->value, ap->writePosition);
+    return 0;
+}
+
+
+static int encodeValue(Ejs *ejs, Encoder *enc, EjsAny *vp)
+{
+    EjsString   *str;
+    EjsTrait    *trait;
+    EjsName     qname;
+    EjsObj      *pp;
+    MprBuf      *buf;
+    MprNumber   number;
+    ssize       offset;
+    int         count, i, isArray, length, slotNum, visited;
+
+    buf = enc->buf;
+    offset = 0;
+    if (vp == 0 || ejsIs(ejs, vp, Void)) {
+        mprPutCharToBuf(buf, MSG_UNDEFINED);
+
+    } else if (ejsIs(ejs, vp, Null)) {
+        mprPutCharToBuf(buf, MSG_NULL);
+
+    } else if (ejsIs(ejs, vp, Boolean)) {
+        mprPutCharToBuf(buf, vp == ESV(true) ? MSG_TRUE : MSG_FALSE);
+
+    } else if (ejsIs(ejs, vp, Number)) {
+        number = ejsGetNumber(ejs, vp);
+        mprPutCharToBuf(buf, MSG_NUMBER);
+        putNumber(buf, number);
+
+    } else if (ejsIs(ejs, vp, String)) {
+        str = (EjsString*) vp;
+        putChars(enc, MSG_STRING, str->value, str->length);
+
+    } else if (ejsIs(ejs, vp, Date)) {
+        mprPutCharToBuf(buf, MSG_DATE);
+        putInt(buf, (uint64) ((EjsDate*) vp)->value, sizeof(MprTime));
+
+    } else if (ejsIs(ejs, vp, ByteArray)) {
+        return encodeByteArray(ejs, enc, vp);
+
+    } else if (isPlainObject(ejs, vp)) {
+        /* Cyclic references and objects nested too deeply are encoded as empty, the same as JSON */
+        isArray = ejsIs(ejs, vp, Array);
+        visited = VISITED(vp);
+        length = (++enc->depth <= MSG_MAX_DEPTH && !visited) ? ejsGetLength(ejs, vp) : 0;
+        if (isArray) {
+            mprPutCharToBuf(buf, MSG_ARRAY);
+            putLength(buf, length);
+        } else {
+            /* The count is not known until hidden properties are skipped, so reserve a fixed size count */
+            mprPutCharToBuf(buf, MSG_OBJECT);
+            offset = mprGetBufLength(buf);
+            putInt(buf, 0, sizeof(int));
+        }
+        if (!visited) {
+            SET_VISITED(vp, 1);
+        }
+        for (slotNum = count = 0; slotNum < length; slotNum++) {
+            pp = ejsGetProperty(ejs, vp, slotNum);
+            if (!isArray) {
+                trait = ejsGetPropertyTraits(ejs, vp, slotNum);
+                if (pp == 0 || (trait && (trait->attributes & (EJS_TRAIT_HIDDEN | EJS_TRAIT_DELETED | 
+                        EJS_FUN_INITIALIZER | EJS_FUN_MODULE_INITIALIZER)))) {
+                    continue;
+                }
+                qname = ejsGetPropertyName(ejs, vp, slotNum);
+                putKey(enc, qname.name);
+            }
+            if (encodeValue(ejs, enc, pp) < 0) {
+                SET_VISITED(vp, visited);
+                return EJS_ERR;
+            }
+            count++;
+        }
+        SET_VISITED(vp, visited);
+        enc->depth--;
+        if (!isArray) {
+            for (i = 0; i < (int) sizeof(int); i++) {
+                ((uchar*) mprGetBufStart(buf))[offset + i] = (uchar) ((count >> (i * 8)) & 0xFF);
+            }
+        }
+
+    } else {
+        if ((str = ejsToJSON(ejs, vp, NULL)) == 0) {
+            return EJS_ERR;
+        }
+        putChars(enc, MSG_JSON, str->value, str->length);
+    }
+    return ejs->exception ? EJS_ERR : 0;
+}
+
+
+/*
+    Encode a message. Transferred ByteArrays are emptied only if the entire message is encoded, so the sender keeps 
+    its data if encoding fails.
+ */
+static int encodeMessage(Ejs *ejs, Message *msg, EjsAny *vp, EjsArray *transferList)
+{
+    Encoder         enc;
+    EjsByteArray    *ap;
+    int             next;
+
+    memset(&enc, 0, sizeof(Encoder));
+    enc.buf = msg->data = mprCreateBuf(ME_MAX_BUFFER, -1);
+    enc.transfers = msg->transfers = mprCreateList(0, MPR_LIST_STABLE);
+    enc.detach = mprCreateList(0, MPR_LIST_STABLE);
+    enc.transferList = transferList;
+    enc.message = 1;
+    if (encodeValue(ejs, &enc, vp) < 0) {
+        return EJS_ERR;
+    }
+    for (ITERATE_ITEMS(enc.detach, ap, next)) {
+        ap->value = 0;
+        ap->size = ap->readPosition = ap->writePosition = 0;
+    }
+    return 0;
+}
+
+
+static int getLength(Decoder *dec, ssize *len)
+{
+    ssize   value;
+    int     c, shift;
+
+    for (value = 0, shift = 0; dec->next < dec->end && shift < 64; shift += 7) {
+        c = *dec->next++;
+        value |= ((ssize) (c & 0x7F)) << shift;
+        if (!(c & 0x80)) {
+            *len = value;
+            return 0;
+        }
+    }
+    return EJS_ERR;
+}
+
+
+static int getBlock(Decoder *dec, void *dest, ssize len)
+{
+    if ((dec->end - dec->next) < len) {
+        return EJS_ERR;
+    }
+    memcpy(dest, dec->next, len);
+    dec->next += len;
+    return 0;
+}
+
+
+static int getInt(Decoder *dec, uint64 *value, int size)
+{
+    int     i;
+
+    if ((dec->end - dec->next) < size) {
+        return EJS_ERR;
+    }
+    for (*value = 0, i = 0; i < size; i++) {
+        *value |= ((uint64) *dec->next++) << (i * 8);
+    }
+    return 0;
+}
+
+
+static EjsString *getChars(Ejs *ejs, Decoder *dec)
+{
+    EjsString   *str;
+    ssize       len;
+
+#if ME_CHAR_LEN > 1
+    if (!dec->message) {
+        if (getLength(dec, &len) < 0 || len < 0 || (dec->end - dec->next) < len) {
+            return 0;
+        }
+        str = ejsCreateStringFromMulti(ejs, (cchar*) dec->next, len);
+        dec->next += len;
+        return str;
+    }
+#endif
+    if (getLength(dec, &len) < 0 || len < 0 || (dec->end - dec->next) / (ssize) sizeof(wchar) < len) {
+        return 0;
+    }
+    str = ejsCreateString(ejs, (wchar*) dec->next, len);
+    dec->next += len * sizeof(wchar);
+    return str;
+}
+
+
+static EjsString *decodeKey(Ejs *ejs, Decoder *dec)
+{
+    EjsString   *key;
+    ssize       index;
+
+    if (dec->next >= dec->end) {
+        return 0;
+    }
+    if (*dec->next++ == MSG_KEYREF) {
+        if (getLength(dec, &index) < 0) {
+            return 0;
+        }
+        return mprGetItem(dec->keys, (int) index);
+    }
+    if ((key = getChars(ejs, dec)) != 0) {
+        mprAddItem(dec->keys, key);
+    }
+    return key;
+}
+
+
+static EjsAny *decodeValue(Ejs *ejs, Decoder *dec)
+{
+    EjsArray        *ap;
+    EjsByteArray    *bp;
+    EjsPot          *obj;
+    EjsString       *str;
+    EjsAny          *vp;
+    EjsName         qname;
+    MprNumber       number;
+    uchar           *value;
+    uint64          bits;
+    ssize           len, size, readPosition, writePosition;
+    int             count, i;
+
+    if (dec->next >= dec->end) {
+        return 0;
+    }
+    switch (*dec->next++) {
+    case MSG_UNDEFINED:
+        return ESV(undefined);
+
+    case MSG_NULL:
+        return ESV(null);
+
+    case MSG_TRUE:
+        return ESV(true);
+
+    case MSG_FALSE:
+        return ESV(false);
+
+    case MSG_NUMBER:
+        if (getInt(dec, &bits, sizeof(bits)) < 0) {
+            return 0;
+        }
+        memcpy(&number, &bits, sizeof(number));
+        return ejsCreateNumber(ejs, number);
+
+    case MSG_STRING:
+        return getChars(ejs, dec);
+
+    case MSG_DATE:
+        if (getInt(dec, &bits, sizeof(MprTime)) < 0) {
+            return 0;
+        }
+        return ejsCreateDate(ejs, (MprTime) bits);
+
+    case MSG_ARRAY:
+        if (getLength(dec, &len) < 0 || len > (dec->end - dec->next) || (ap = ejsCreateArray(ejs, (int) len)) == 0) {
+            return 0;
+        }
+        for (i = 0; i < len; i++) {
+            if ((vp = decodeValue(ejs, dec)) == 0) {
+                return 0;
+            }
+            ap->data[i] = vp;
+        }
+        return ap;
+
+    case MSG_OBJECT:
+        if (getInt(dec, &bits, sizeof(int)) < 0) {
+            return 0;
+        }
+        count = (int) bits;
+        if (count < 0 || count > (dec->end - dec->next)) {
+            return 0;
+        }
+        if ((obj = ejsCreatePot(ejs, ESV(Object), count)) == 0) {
+            return 0;
+        }
+        /* The property slots are pre-allocated */
+        obj->numProp = 0;
+        qname.space = ESV(empty);
+        for (i = 0; i < count; i++) {
+            if ((qname.name = decodeKey(ejs, dec)) == 0 || (vp = decodeValue(ejs, dec)) == 0) {
+                return 0;
+            }
+            if (ejsSetPropertyByName(ejs, obj, qname, vp) < 0) {
+                return 0;
+            }
+        }
+        return obj;
+
+    case MSG_BYTES:
+        if (getLength(dec, &len) < 0 || getLength(dec, &readPosition) < 0 || len > (dec->end - dec->next)) {
+            return 0;
+        }
+        if ((bp = ejsCreateByteArray(ejs, len)) == 0) {
+            return 0;
+        }
+        getBlock(dec, bp->value, len);
+        bp->writePosition = len;
+        bp->readPosition = min(readPosition, len);
+        return bp;
+
+    case MSG_TRANSFER:
+        /* Buffer pointers are only valid in a message from another interpreter in this process */
+        if (!dec->message || getBlock(dec, &value, sizeof(uchar*)) < 0 || getLength(dec, &size) < 0 || 
+                getLength(dec, &readPosition) < 0 || getLength(dec, &writePosition) < 0) {
+            return 0;
+        }
+        if ((bp = ejsCreateByteArray(ejs, 1)) == 0) {
+            return 0;
+        }
+        if (value) {
+            /* Adopt the sender's buffer without copying */
+            bp->value = value;
+            bp->size = size;
+            bp->readPosition = readPosition;
+            bp->writePosition = writePosition;
+        }
+        return bp;
+
+    case MSG_JSON:
+        if ((str = getChars(ejs, dec)) == 0) {
+            return 0;
+        }
+        return ejsDeserialize(ejs, str);
+    }
+    return 0;
+}
+
+
+/*
+    Decode a message in the receiving interpreter
+ */
+static EjsAny *decodeMessage(Ejs *ejs, Message *msg)
+{
+    Decoder     dec;
+    EjsAny      *vp;
+
+    dec.next = (uchar*) mprGetBufStart(msg->data);
+    dec.end = (uchar*) mprGetBufEnd(msg->data);
+    dec.keys = mprCreateList(0, MPR_LIST_STABLE);
+    dec.message = 1;
+    if ((vp = decodeValue(ejs, &dec)) == 0 && !ejs->exception) {
+        ejsThrowStateError(ejs, "Cannot decode worker message");
+    }
+    return vp;
+}
+
+
+/*
+    Encode a value so it can be stored outside the interpreter. The encoding is independent of byte order and 
+    character width. ByteArrays are copied.
+ */
+PUBLIC MprBuf *ejsEncodeValue(Ejs *ejs, EjsAny *vp)
+{
+    Encoder     enc;
+
+    memset(&enc, 0, sizeof(Encoder));
+    enc.buf = mprCreateBuf(ME_MAX_BUFFER, -1);
+    mprPutCharToBuf(enc.buf, MSG_VERSION);
+    if (encodeValue(ejs, &enc, vp) < 0) {
+        return 0;
+    }
+    return enc.buf;
+}
+
+
+/*
+    Decode a stored value. The data is untrusted, so tags that carry pointers are rejected.
+ */
+PUBLIC EjsAny *ejsDecodeValue(Ejs *ejs, cchar *data, ssize len)
+{
+    Decoder     dec;
+    EjsAny      *vp;
+
+    dec.next = (uchar*) data;
+    dec.end = (uchar*) &data[len];
+    dec.keys = mprCreateList(0, MPR_LIST_STABLE);
+    dec.message = 0;
+    vp = 0;
+    if (len > 0 && *dec.next++ == MSG_VERSION) {
+        vp = decodeValue(ejs, &dec);
+    }
+    if (vp == 0 || dec.next != dec.end) {
+        if (!ejs->exception) {
+            ejsThrowStateError(ejs, "Cannot decode value");
+        }
+        return 0;
+    }
+    return vp;
+}
+
+
+/*
+    Copy a value so that it can be shared by interpreters. Plain objects and arrays are copied deeply. Strings, numbers
+    and other immutable values are not copied. Values with a custom toJSON are copied via JSON. The approximate memory
+    used by the value is added to *size. If readOnly is set, cyclic references are not detected so that the value is 
+    not modified and may be read concurrently. Values that were produced by a prior copy have no cycles.
+ */
+static EjsAny *copyValue(Ejs *ejs, EjsAny *vp, int readOnly, int depth, ssize *size)
+{
+    EjsArray        *ap;
+    EjsByteArray    *bp, *src;
+    EjsPot          *obj;
+    EjsString       *str;
+    EjsTrait        *trait;
+    EjsName         qname;
+    EjsAny          *pp, *result;
+    int             isArray, length, slotNum, visited;
+
+    if (vp == 0 || ejsIs(ejs, vp, Void) || ejsIs(ejs, vp, Null) || ejsIs(ejs, vp, Boolean)) {
+        *size += 1;
+        return vp ? vp : ESV(undefined);
+
+    } else if (ejsIs(ejs, vp, Number)) {
+        *size += sizeof(MprNumber);
+        return vp;
+
+    } else if (ejsIs(ejs, vp, String)) {
+        *size += ((EjsString*) vp)->length * sizeof(wchar);
+        return vp;
+
+    } else if (ejsIs(ejs, vp, Date)) {
+        *size += sizeof(MprTime);
+        return ejsCreateDate(ejs, ((EjsDate*) vp)->value);
+
+    } else if (ejsIs(ejs, vp, ByteArray)) {
+        src = vp;
+        if ((bp = ejsCreateByteArray(ejs, src->writePosition)) == 0) {
+            return 0;
+        }
+        memcpy(bp->value, src->value, src->writePosition);
+        bp->writePosition = src->writePosition;
+        bp->readPosition = src->readPosition;
+        *size += src->writePosition;
+        return bp;
+
+    } else if (isPlainObject(ejs, vp)) {
+        /* Cyclic references and objects nested too deeply are copied as empty, the same as JSON */
+        isArray = ejsIs(ejs, vp, Array);
+        visited = readOnly ? 0 : VISITED(vp);
+        length = (++depth <= MSG_MAX_DEPTH && !visited) ? ejsGetLength(ejs, vp) : 0;
+        ap = 0;
+        obj = 0;
+        if (isArray) {
+            result = ap = ejsCreateArray(ejs, length);
+        } else {
+            result = obj = ejsCreatePot(ejs, ESV(Object), length);
+            if (obj) {
+                obj->numProp = 0;
+            }
+        }
+        if (result == 0) {
+            return 0;
+        }
+        if (!readOnly) {
+            SET_VISITED(vp, 1);
+        }
+        qname.space = ESV(empty);
+        for (slotNum = 0; slotNum < length; slotNum++) {
+            pp = ejsGetProperty(ejs, vp, slotNum);
+            if (!isArray) {
+                trait = ejsGetPropertyTraits(ejs, vp, slotNum);
+                if (pp == 0 || (trait && (trait->attributes & (EJS_TRAIT_HIDDEN | EJS_TRAIT_DELETED | 
+                        EJS_FUN_INITIALIZER | EJS_FUN_MODULE_INITIALIZER)))) {
+                    continue;
+                }
+                qname.name = ejsGetPropertyName(ejs, vp, slotNum).name;
+                *size += qname.name->length * sizeof(wchar);
+            }
+            if ((pp = copyValue(ejs, pp, readOnly, depth, size)) == 0) {
+                result = 0;
+                break;
+            }
+            if (isArray) {
+                ap->data[slotNum] = pp;
+            } else if (ejsSetPropertyByName(ejs, obj, qname, pp) < 0) {
+                result = 0;
+                break;
+            }
+        }
+        if (!readOnly) {
+            SET_VISITED(vp, visited);
+        }
+        return result;
+
+    } else {
+        if ((str = ejsToJSON(ejs, vp, NULL)) == 0) {
+            return 0;
+        }
+        *size += str->length * sizeof(wchar);
+        return ejsDeserialize(ejs, str);
+    }
+}
+
+
+PUBLIC EjsAny *ejsCopyValue(Ejs *ejs, EjsAny *vp, int readOnly, ssize *size)
+{
+    ssize   unused;
+
+    unused = 0;
+    return copyValue(ejs, vp, readOnly, 0, size ? size : &unused);
+}
+
+
 /*
     Post a message to this worker. Note: the worker is the destination worker which may be the parent.
 
-    function postMessage(data: Object, ports: Array = null): Void
+    function postMessage(data: Object, transfer: Array = null): Void
  */
 static EjsObj *workerPostMessage(Ejs *ejs, EjsWorker *worker, int argc, EjsObj **argv)
 {
-    EjsString       *data;
+    EjsArray        *transfer;
     EjsWorker       *target;
     MprDispatcher   *dispatcher;
     Message         *msg;
+    int             i;
 
     if (worker->state >= EJS_WORKER_CLOSED) {
         ejsThrowStateError(ejs, "Worker has completed");
         return 0;
     }
+    transfer = (argc >= 2 && ejsIs(ejs, argv[1], Array)) ? (EjsArray*) argv[1] : 0;
+    if (transfer) {
+        if (ejsUnpackArray(ejs, transfer) < 0) {
+            ejsThrowMemoryError(ejs);
+            return 0;
+        }
+        for (i = 0; i < transfer->length; i++) {
+            if (!ejsIs(ejs, transfer->data[i], ByteArray)) {
+                ejsThrowArgError(ejs, "Only ByteArray objects can be transferred");
+                return 0;
+            }
+        }
+    }
     /*
-        Create the event with serialized data in the originating interpreter. It owns the data.
+        Create the event with encoded data in the originating interpreter. It owns the data.
      */
     ejsBlockGC(ejs);
-    if ((data = ejsToJSON(ejs, argv[0], NULL)) == 0) {
-        ejsThrowArgError(ejs, "Cannot serialize message data");
-        return 0;
-    }
     if ((msg = createMessage()) == 0) {
         ejsThrowMemoryError(ejs);
         return 0;
     }
+    if (encodeMessage(ejs, msg, argv[0], transfer) < 0) {
+        if (!ejs->exception) {
+            ejsThrowArgError(ejs, "Cannot serialize message data");
+        }
+        return 0;
+    }
     target = worker->pair;
-    msg->data = ejsToMulti(ejs, data);
     msg->worker = target;
     msg->callback = "onmessage";
     msg->callbackSlot = ES_Worker_onmessage;
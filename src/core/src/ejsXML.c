@@ -163,6 +163,9 @@ static int deleteXmlPropertyByName(Ejs *ejs, EjsXML *xml, EjsName qname)
             }
         }
     }
+    if (removed) {
+        ejsModifyXML(ejs);
+    }
     return (removed) ? 0 : EJS_ERR;
 }
 
@@ -463,6 +466,7 @@ static int setXmlPropertyByName(Ejs *ejs, EjsXML *xml, EjsName qname, EjsObj *va
         //  TODO spec requires this -- but why? -- surely throw?
         return 0;
     }
+    ejsModifyXML(ejs);
 
     /*
         Massage the value type.
@@ -586,9 +590,120 @@ static bool deepCompare(EjsXML *lhs, EjsXML *rhs)
 }
 
 
+/*
+    Descendant name index. Maps element and attribute names to the matching descendants in document order.
+    The index is discarded when any XML tree in the interpreter is modified.
+ */
+typedef struct EjsXMLIndex {
+    MprHash         *elements;          /* Outermost descendant elements by name */
+    MprHash         *attributes;        /* Descendant attributes by name */
+    MprList         *allAttributes;     /* All descendant attributes */
+    int             generation;         /* Value of ejs->xmlGeneration when built */
+} EjsXMLIndex;
+
+
+static void manageXmlIndex(EjsXMLIndex *index, int flags)
+{
+    if (flags & MPR_MANAGE_MARK) {
+        mprMark(index->elements);
+        mprMark(index->attributes);
+        mprMark(index->allAttributes);
+    }
+}
+
+
+static void addToIndex(MprHash *hash, EjsXML *node)
+{
+    MprList     *list;
+
+    if ((list = mprLookupKey(hash, node->qname.name->value)) == 0) {
+        list = mprCreateList(0, MPR_LIST_STABLE);
+        mprAddKey(hash, node->qname.name->value, list);
+    }
+    mprAddItem(list, node);
+}
+
+
+/*
+    Index the descendants of a node. An element is not indexed under a name if it is nested inside another descendant
+    element of the same name. The open hash counts the open elements of each name.
+ */
+static void indexDescendants(EjsXMLIndex *index, EjsXML *xml, MprHash *open)
+{
+    EjsXML      *item;
+    MprKey      *kp;
+    int         next;
+
+    if (xml->attributes) {
+        for (next = 0; (item = mprGetNextItem(xml->attributes, &next)) != 0; ) {
+            if (item->qname.name) {
+                addToIndex(index->attributes, item);
+                mprAddItem(index->allAttributes, item);
+            }
+        }
+    }
+    if (xml->elements) {
+        for (next = 0; (item = mprGetNextItem(xml->elements, &next)) != 0; ) {
+            if (item->qname.name == 0) {
+                indexDescendants(index, item, open);
+                continue;
+            }
+            if ((kp = mprLookupKeyEntry(open, item->qname.name->value)) == 0) {
+                kp = mprAddKey(open, item->qname.name->value, 0);
+            }
+            if (kp->data == 0) {
+                addToIndex(index->elements, item);
+            }
+            kp->data = ITOP(PTOI(kp->data) + 1);
+            indexDescendants(index, item, open);
+            kp->data = ITOP(PTOI(kp->data) - 1);
+        }
+    }
+}
+
+
+static EjsXMLIndex *getXmlIndex(Ejs *ejs, EjsXML *xml)
+{
+    EjsXMLIndex *index;
+    int         flags;
+
+    if ((index = xml->index) != 0 && index->generation == ejs->xmlGeneration) {
+        return index;
+    }
+    if ((index = mprAllocObj(EjsXMLIndex, manageXmlIndex)) == 0) {
+        return 0;
+    }
+    flags = MPR_HASH_UNICODE | MPR_HASH_STATIC_KEYS | MPR_HASH_STABLE;
+    index->elements = mprCreateHash(0, flags);
+    index->attributes = mprCreateHash(0, flags);
+    index->allAttributes = mprCreateList(0, MPR_LIST_STABLE);
+    index->generation = ejs->xmlGeneration;
+    indexDescendants(index, xml, mprCreateHash(0, flags | MPR_HASH_STATIC_VALUES));
+    xml->index = index;
+    return index;
+}
+
+
+static EjsXML *appendListToXml(Ejs *ejs, EjsXML *result, MprList *list)
+{
+    EjsXML      *item;
+    int         next;
+
+    for (next = 0; (item = mprGetNextItem(list, &next)) != 0; ) {
+        result = ejsAppendToXML(ejs, result, item);
+    }
+    return result;
+}
+
+
+/*
+    Get the descendants for ".name", ".*", ".@name" and ".@*"
+ */
 PUBLIC EjsXML *ejsGetXMLDescendants(Ejs *ejs, EjsXML *xml, EjsName qname)
 {
+    EjsXMLIndex     *index;
     EjsXML          *item, *result;
+    MprList         *list;
     int             next;
 
     result = ejsCreateXMLList(ejs, xml, qname);
@@ -596,29 +711,28 @@ PUBLIC EjsXML *ejsGetXMLDescendants(Ejs *ejs, EjsXML *xml, EjsName qname)
         return 0;
     }
     if (qname.name->value[0] == '.' && qname.name->value[1] == '@') {
-        if (xml->attributes) {
-            for (next = 0; (item = mprGetNextItem(xml->attributes, &next)) != 0; ) {
-                if (qname.name->value[2] == '*' || wcmp(item->qname.name->value, &qname.name->value[2]) == 0) {
-                    result = ejsAppendToXML(ejs, result, item);
-                }
-            }
+        if ((index = getXmlIndex(ejs, xml)) == 0) {
+            return 0;
+        }
+        if (qname.name->value[2] == '*') {
+            list = index->allAttributes;
+        } else {
+            list = mprLookupKey(index->attributes, &qname.name->value[2]);
         }
+        result = appendListToXml(ejs, result, list);
+
+    } else if (qname.name->value[0] == '*') {
         if (xml->elements) {
             for (next = 0; (item = mprGetNextItem(xml->elements, &next)) != 0; ) {
-                result = ejsAppendToXML(ejs, result, ejsGetXMLDescendants(ejs, item, qname));
+                result = ejsAppendToXML(ejs, result, item);
             }
         }
 
     } else {
-        if (xml->elements) {
-            for (next = 0; (item = mprGetNextItem(xml->elements, &next)) != 0; ) {
-                if (qname.name->value[0] == '*' || wcmp(item->qname.name->value, &qname.name->value[1]) == 0) {
-                    result = ejsAppendToXML(ejs, result, item);
-                } else {
-                    result = ejsAppendToXML(ejs, result, ejsGetXMLDescendants(ejs, item, qname));
-                }
-            }
+        if ((index = getXmlIndex(ejs, xml)) == 0) {
+            return 0;
         }
+        result = appendListToXml(ejs, result, mprLookupKey(index->elements, &qname.name->value[1]));
     }
     return result;
 }
@@ -876,6 +990,7 @@ PUBLIC EjsXML *ejsSetXMLElement(Ejs *ejs, EjsXML *xml, int index, EjsXML *node)
 
     if (xml->kind != EJS_XML_LIST) {
         node->parent = xml;
+        ejsModifyXML(ejs);
     }
     mprSetItem(xml->elements, index, node);
     return xml;
@@ -893,6 +1008,9 @@ PUBLIC EjsXML *ejsAppendToXML(Ejs *ejs, EjsXML *xml, EjsXML *node)
     if (xml->elements == 0) {
         xml->elements = mprCreateList(-1, 0);
     }
+    if (xml->kind != EJS_XML_LIST) {
+        ejsModifyXML(ejs);
+    }
     if (node->kind == EJS_XML_LIST) {
         for (next = 0; (elt = mprGetNextItem(node->elements, &next)) != 0; ) {
             if (xml->kind != EJS_XML_LIST) {
@@ -919,6 +1037,7 @@ PUBLIC int ejsAppendAttributeToXML(Ejs *ejs, EjsXML *parent, EjsXML *node)
         parent->attributes = mprCreateList(-1, 0);
     }
     node->parent = parent;
+    ejsModifyXML(ejs);
     return mprAddItem(parent->attributes, node);
 }
 
@@ -994,6 +1113,7 @@ PUBLIC EjsXML *ejsConfigureXML(Ejs *ejs, EjsXML *xml, int kind, EjsString *name,
     xml->qname.name = name;
     xml->kind = kind;
     xml->parent = parent;
+    ejsModifyXML(ejs);
     if (value) {
         xml->value = value;
     }
@@ -1034,7 +1154,7 @@ PUBLIC void ejsManageXML(EjsXML *xml, int flags)
         mprMark(xml->targetObject);
         mprMark(xml->attributes);
         mprMark(xml->elements);
-        mprMark(xml->namespaces);
+        mprMark(xml->index);
         mprMark(xml->qname.name);
         mprMark(xml->qname.space);
         mprMark(xml->value);
@@ -135,6 +135,7 @@ static int deleteXmlListPropertyByName(Ejs *ejs, EjsXML *list, EjsName qname)
                     //  TODO - let q be the property of parent where parent[q] == x[i]
                     mprRemoveItem(elt->parent->elements, elt);
                     elt->parent = 0;
+                    ejsModifyXML(ejs);
                 }
             }
         }
@@ -423,6 +424,7 @@ static EjsXML *createElement(Ejs *ejs, EjsXML *list, EjsXML *targetObject, EjsNa
                 Insert into the target object
              */
             mprInsertItemAtPos(targetObject->elements, j + 1, elt);
+            ejsModifyXML(ejs);
         }
 
         if (ejsIsXML(ejs, value)) {
@@ -455,6 +457,7 @@ static int updateElement(Ejs *ejs, EjsXML *list, EjsXML *elt, int index, EjsObj
         value = ejsCast(ejs, value, String);                //  TODO - seem to be doing this in too many places
     }
     mprSetItem(list->elements, index, value);
+    ejsModifyXML(ejs);
 
     if (elt->kind == EJS_XML_ATTRIBUTE) {
         assert(ejsIs(ejs, value, String));
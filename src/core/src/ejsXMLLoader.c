@@ -285,6 +285,767 @@ static void indent(MprBuf *bp, int level)
 }
 
 
+/*********************************** XMLReader ********************************/
+/*
+    Streaming XML reader. MprXml is a recursive push parser that must consume the entire document in one call, so it 
+    cannot pause between events. The reader uses a small incremental tokenizer that follows the same lexical rules and
+    resumes when more input is read. A token that is split across input chunks is rescanned once the rest is read.
+ */
+
+#ifndef ME_XML_READER_CHUNK
+    #define ME_XML_READER_CHUNK (64 * 1024)
+#endif
+
+/*
+    Tokenizer results
+ */
+#define XR_ERROR        -1              /* Syntax error. Exception thrown */
+#define XR_MORE         0               /* More input required */
+#define XR_START        1               /* Element start tag. May be a solo element */
+#define XR_END          2               /* Element end tag */
+#define XR_TEXT         3               /* Element data or CDATA */
+#define XR_COMMENT      4               /* Comment */
+#define XR_SKIP         5               /* Ignored input: white space, processing instructions and declarations */
+
+typedef struct XmlToken {
+    EjsString       *name;              /* Element name */
+    EjsString       *value;             /* Text or comment value */
+    MprList         *attributes;        /* Attribute names and values in alternate items */
+    int             solo;               /* Solo element "<name/>" */
+} XmlToken;
+
+static void manageXMLReader(EjsXMLReader *rp, int flags)
+{
+    if (flags & MPR_MANAGE_MARK) {
+        mprMark(rp->input);
+        mprMark(rp->emitter);
+        mprMark(rp->chunk);
+        mprMark(rp->read);
+        mprMark(rp->last);
+        mprMark(rp->pending);
+        mprMark(rp->select);
+        mprMark(rp->buf);
+        mprMark(rp->file);
+        mprMark(rp->stack);
+    }
+}
+
+
+static int readerError(Ejs *ejs, EjsXMLReader *rp, cchar *msg)
+{
+    ejsThrowSyntaxError(ejs, "XML error at line %d: %s", rp->lineNumber, msg);
+    return XR_ERROR;
+}
+
+
+/*
+    Read the next chunk of input into the reader buffer. Returns the number of bytes read, zero at the end of input 
+    or a negative MPR error code.
+ */
+static ssize fillReader(Ejs *ejs, EjsXMLReader *rp)
+{
+    EjsByteArray    *ba;
+    EjsAny          *result, *arg;
+    ssize           nbytes;
+    int             paused;
+
+    if (rp->eof) {
+        return 0;
+    }
+    mprCompactBuf(rp->buf);
+    if (mprGetBufSpace(rp->buf) <= rp->chunkSize && mprGrowBuf(rp->buf, rp->chunkSize + 1) < 0) {
+        ejsThrowMemoryError(ejs);
+        return MPR_ERR_MEMORY;
+    }
+    nbytes = 0;
+    if (rp->file) {
+        if ((nbytes = mprReadFile(rp->file, mprGetBufEnd(rp->buf), rp->chunkSize)) > 0) {
+            mprAdjustBufEnd(rp->buf, nbytes);
+        }
+    } else if (rp->read) {
+        ba = rp->chunk;
+        ba->readPosition = ba->writePosition = 0;
+        arg = ba;
+        /*
+            The stream read runs script. Block GC as the caller may hold unreferenced tokens.
+         */
+        paused = ejsBlockGC(ejs);
+        result = ejsRunFunction(ejs, rp->read, rp->input, 1, &arg);
+        ejsUnblockGC(ejs, paused);
+        if (ejs->exception) {
+            return MPR_ERR_CANT_READ;
+        }
+        if (ejsIs(ejs, result, Number) && (nbytes = ejsGetByteArrayAvailableData(ba)) > 0) {
+            mprPutBlockToBuf(rp->buf, (cchar*) &ba->value[ba->readPosition], nbytes);
+        }
+    }
+    if (nbytes <= 0) {
+        rp->eof = 1;
+    }
+    mprAddNullToBuf(rp->buf);
+    return nbytes;
+}
+
+
+/*
+    Consume input from the reader buffer and maintain the line number
+ */
+static void consumeInput(EjsXMLReader *rp, cchar *upto)
+{
+    cchar   *cp, *end;
+
+    end = upto;
+    for (cp = mprGetBufStart(rp->buf); (cp = memchr(cp, '\n', end - cp)) != 0; cp++) {
+        rp->lineNumber++;
+    }
+    mprAdjustBufStart(rp->buf, upto - mprGetBufStart(rp->buf));
+}
+
+
+/*
+    Test if the input starts with a prefix. Returns 1 if it does, 0 if not and -1 if more input is required to decide.
+ */
+static int startsWith(EjsXMLReader *rp, cchar *start, cchar *end, cchar *prefix)
+{
+    ssize   len;
+
+    len = slen(prefix);
+    if ((end - start) < len) {
+        if (strncmp(start, prefix, end - start) == 0) {
+            return rp->eof ? 0 : -1;
+        }
+        return 0;
+    }
+    return strncmp(start, prefix, len) == 0;
+}
+
+
+/*
+    Find a terminating sequence in the input. Returns a reference to the sequence or null if not found.
+ */
+static cchar *findSequence(cchar *start, cchar *end, cchar *seq)
+{
+    cchar   *cp;
+    ssize   len;
+
+    len = slen(seq);
+    for (cp = start; cp <= end - len && (cp = memchr(cp, seq[0], end - len - cp + 1)) != 0; cp++) {
+        if (strncmp(cp, seq, len) == 0) {
+            return cp;
+        }
+    }
+    return 0;
+}
+
+
+static cchar *skipSpace(cchar *cp, cchar *end)
+{
+    while (cp < end && isspace((uchar) *cp)) {
+        cp++;
+    }
+    return cp;
+}
+
+
+static cchar *getNameEnd(cchar *cp, cchar *end)
+{
+    while (cp < end && !isspace((uchar) *cp) && *cp != '>' && *cp != '/' && *cp != '=') {
+        cp++;
+    }
+    return cp;
+}
+
+
+/*
+    Parse an element start tag between "<" and ">". The tag has been fully read.
+ */
+static int parseStartTag(Ejs *ejs, EjsXMLReader *rp, cchar *cp, cchar *end, XmlToken *tok)
+{
+    cchar   *name, *value;
+    int     quote;
+
+    name = cp;
+    cp = getNameEnd(cp, end);
+    if (cp == name) {
+        return readerError(ejs, rp, "Missing element name");
+    }
+    tok->name = ejsCreateStringFromBytes(ejs, name, cp - name);
+    tok->attributes = 0;
+    tok->solo = 0;
+    while (1) {
+        cp = skipSpace(cp, end);
+        if (cp >= end) {
+            break;
+        }
+        if (*cp == '/') {
+            if (cp + 1 != end) {
+                return readerError(ejs, rp, "Syntax error");
+            }
+            tok->solo = 1;
+            break;
+        }
+        name = cp;
+        cp = getNameEnd(cp, end);
+        if (cp == name) {
+            return readerError(ejs, rp, "Syntax error");
+        }
+        if (tok->attributes == 0) {
+            tok->attributes = mprCreateList(0, 0);
+        }
+        mprAddItem(tok->attributes, ejsCreateStringFromBytes(ejs, name, cp - name));
+        cp = skipSpace(cp, end);
+        if (cp >= end || *cp != '=') {
+            return readerError(ejs, rp, sfmt("Missing assignment for attribute \"%@\"", mprGetLastItem(tok->attributes)));
+        }
+        cp = skipSpace(cp + 1, end);
+        if (cp >= end) {
+            return readerError(ejs, rp, "Missing attribute value");
+        }
+        if (*cp == '"' || *cp == '\'') {
+            quote = *cp++;
+            value = cp;
+            if ((cp = memchr(cp, quote, end - cp)) == 0) {
+                return readerError(ejs, rp, "Unterminated attribute value");
+            }
+            mprAddItem(tok->attributes, ejsCreateStringFromBytes(ejs, value, cp - value));
+            cp++;
+        } else {
+            value = cp;
+            while (cp < end && !isspace((uchar) *cp) && *cp != '/') {
+                cp++;
+            }
+            mprAddItem(tok->attributes, ejsCreateStringFromBytes(ejs, value, cp - value));
+        }
+    }
+    return XR_START;
+}
+
+
+/*
+    Get the next token from the buffered input. Returns XR_MORE if the buffer does not hold a complete token.
+ */
+static int getToken(Ejs *ejs, EjsXMLReader *rp, XmlToken *tok)
+{
+    cchar   *start, *end, *cp, *name;
+    int     quote, rc;
+
+    start = mprGetBufStart(rp->buf);
+    end = mprGetBufEnd(rp->buf);
+    if (start >= end) {
+        return XR_MORE;
+    }
+    if (*start != '<') {
+        /*
+            Element data up to the next tag. White space only data is discarded.
+         */
+        if ((cp = memchr(start, '<', end - start)) == 0) {
+            if (!rp->eof) {
+                return XR_MORE;
+            }
+            cp = end;
+        }
+        if (skipSpace(start, cp) == cp) {
+            consumeInput(rp, cp);
+            return XR_SKIP;
+        }
+        if (mprGetListLength(rp->stack) == 0) {
+            return readerError(ejs, rp, "Data outside of an element");
+        }
+        tok->value = ejsCreateStringFromBytes(ejs, start, cp - start);
+        consumeInput(rp, cp);
+        return XR_TEXT;
+    }
+    if ((rc = startsWith(rp, start, end, "<!--")) != 0) {
+        if (rc < 0) {
+            return XR_MORE;
+        }
+        if ((cp = findSequence(start + 4, end, "-->")) == 0) {
+            return rp->eof ? readerError(ejs, rp, "Unterminated comment") : XR_MORE;
+        }
+        tok->value = ejsCreateStringFromBytes(ejs, start + 4, cp - start - 4);
+        consumeInput(rp, cp + 3);
+        return XR_COMMENT;
+    }
+    if ((rc = startsWith(rp, start, end, "<![CDATA[")) != 0) {
+        if (rc < 0) {
+            return XR_MORE;
+        }
+        if ((cp = findSequence(start + 9, end, "]]>")) == 0) {
+            return rp->eof ? readerError(ejs, rp, "Unterminated CDATA section") : XR_MORE;
+        }
+        tok->value = ejsCreateStringFromBytes(ejs, start + 9, cp - start - 9);
+        consumeInput(rp, cp + 3);
+        return XR_TEXT;
+    }
+    if ((rc = startsWith(rp, start, end, "<?")) != 0) {
+        if (rc < 0) {
+            return XR_MORE;
+        }
+        if ((cp = findSequence(start + 2, end, "?>")) == 0) {
+            return rp->eof ? readerError(ejs, rp, "Unterminated processing instruction") : XR_MORE;
+        }
+        consumeInput(rp, cp + 2);
+        return XR_SKIP;
+    }
+    /*
+        Find the end of the tag, ignoring ">" inside quoted attribute values
+     */
+    for (quote = 0, cp = start + 1; cp < end; cp++) {
+        if (quote) {
+            if (*cp == quote) {
+                quote = 0;
+            }
+        } else if (*cp == '"' || *cp == '\'') {
+            quote = *cp;
+        } else if (*cp == '>') {
+            break;
+        }
+    }
+    if (cp >= end) {
+        return rp->eof ? readerError(ejs, rp, "Unterminated element") : XR_MORE;
+    }
+    if (start[1] == '!') {
+        /* Declarations such as DOCTYPE */
+        consumeInput(rp, cp + 1);
+        return XR_SKIP;
+    }
+    if (start[1] == '/') {
+        name = skipSpace(start + 2, cp);
+        end = getNameEnd(name, cp);
+        if (skipSpace(end, cp) != cp) {
+            return readerError(ejs, rp, "Syntax error");
+        }
+        tok->name = ejsCreateStringFromBytes(ejs, name, end - name);
+        consumeInput(rp, cp + 1);
+        return XR_END;
+    }
+    if ((rc = parseStartTag(ejs, rp, start + 1, cp, tok)) < 0) {
+        return rc;
+    }
+    consumeInput(rp, cp + 1);
+    return rc;
+}
+
+
+/*
+    Get the next significant token and maintain the stack of open elements. Returns zero at the end of the document.
+ */
+static int nextToken(Ejs *ejs, EjsXMLReader *rp, XmlToken *tok)
+{
+    EjsString   *open;
+    int         rc;
+
+    while (1) {
+        if ((rc = getToken(ejs, rp, tok)) == XR_MORE) {
+            if (rp->eof) {
+                if (mprGetListLength(rp->stack) > 0) {
+                    return readerError(ejs, rp, sfmt("Missing closing element for \"%@\"", 
+                        mprGetLastItem(rp->stack)));
+                }
+                return 0;
+            }
+            if (fillReader(ejs, rp) < 0) {
+                return XR_ERROR;
+            }
+            continue;
+        }
+        if (rc == XR_START) {
+            if (mprGetListLength(rp->stack) >= ME_XML_MAX_NODE_DEPTH) {
+                return readerError(ejs, rp, "XML nodes nested too deeply");
+            }
+            if (!tok->solo) {
+                mprPushItem(rp->stack, tok->name);
+            }
+        } else if (rc == XR_END) {
+            if ((open = mprPopItem(rp->stack)) == 0) {
+                return readerError(ejs, rp, sfmt("Unexpected closing element \"%@\"", tok->name));
+            }
+            if (ejsCompareString(ejs, open, tok->name) != 0) {
+                return readerError(ejs, rp, sfmt("Closing element name \"%@\" does not match opening name \"%@\"", 
+                    tok->name, open));
+            }
+        }
+        if (rc != XR_SKIP) {
+            return rc;
+        }
+    }
+}
+
+
+static EjsObj *createEvent(Ejs *ejs, cchar *type, EjsString *name, EjsString *value)
+{
+    EjsObj      *event;
+
+    event = ejsCreateEmptyPot(ejs);
+    ejsSetPropertyByName(ejs, event, EN("type"), ejsCreateStringFromAsc(ejs, type));
+    if (name) {
+        ejsSetPropertyByName(ejs, event, EN("name"), name);
+    }
+    if (value) {
+        ejsSetPropertyByName(ejs, event, EN("value"), value);
+    }
+    return event;
+}
+
+
+/*
+    Create an XML element from a start event
+ */
+static EjsXML *createElement(Ejs *ejs, EjsObj *event, EjsXML *parent)
+{
+    EjsXML      *xml, *node;
+    EjsObj      *attributes;
+    EjsName     qname;
+    int         i, count;
+
+    qname.name = ejsGetPropertyByName(ejs, event, EN("name"));
+    qname.space = NULL;
+    xml = ejsCreateXML(ejs, EJS_XML_ELEMENT, qname, parent, NULL);
+    attributes = ejsGetPropertyByName(ejs, event, EN("attributes"));
+    count = ejsGetLength(ejs, attributes);
+    for (i = 0; i < count; i++) {
+        qname = ejsGetPropertyName(ejs, attributes, i);
+        qname.space = NULL;
+        node = ejsCreateXML(ejs, EJS_XML_ATTRIBUTE, qname, xml, ejsGetProperty(ejs, attributes, i));
+        ejsAppendAttributeToXML(ejs, xml, node);
+    }
+    return xml;
+}
+
+
+/*
+    Expand the element of the last start event into an XML object
+ */
+static EjsXML *expandElement(Ejs *ejs, EjsXMLReader *rp)
+{
+    EjsXML      *root, *xml, *node;
+    XmlToken    tok;
+    EjsName     qname;
+    int         next, rc;
+
+    if (rp->last == 0) {
+        ejsThrowStateError(ejs, "The last event was not a start event");
+        return 0;
+    }
+    root = xml = createElement(ejs, rp->last, NULL);
+    rp->last = 0;
+    if (rp->pending) {
+        /* Solo element */
+        rp->pending = 0;
+        return root;
+    }
+    qname.name = qname.space = NULL;
+    while ((rc = nextToken(ejs, rp, &tok)) > 0) {
+        switch (rc) {
+        case XR_START:
+            qname.name = tok.name;
+            node = ejsCreateXML(ejs, EJS_XML_ELEMENT, qname, xml, NULL);
+            if (tok.attributes) {
+                for (next = 0; (qname.name = mprGetNextItem(tok.attributes, &next)) != 0; ) {
+                    ejsAppendAttributeToXML(ejs, node, 
+                        ejsCreateXML(ejs, EJS_XML_ATTRIBUTE, qname, node, mprGetNextItem(tok.attributes, &next)));
+                }
+            }
+            ejsAppendToXML(ejs, xml, node);
+            if (!tok.solo) {
+                xml = node;
+            }
+            break;
+
+        case XR_END:
+            if (xml == root) {
+                return root;
+            }
+            xml = xml->parent;
+            break;
+
+        case XR_TEXT:
+            ejsAppendToXML(ejs, xml, ejsCreateXML(ejs, EJS_XML_TEXT, N(NULL, NULL), xml, tok.value));
+            break;
+
+        case XR_COMMENT:
+            ejsAppendToXML(ejs, xml, ejsCreateXML(ejs, EJS_XML_COMMENT, N(NULL, NULL), xml, tok.value));
+            break;
+        }
+    }
+    if (rc == 0) {
+        readerError(ejs, rp, "Unexpected end of input");
+    }
+    return 0;
+}
+
+
+/*
+    Read the next event. Returns null at the end of the document or on errors.
+ */
+static EjsObj *readEvent(Ejs *ejs, EjsXMLReader *rp)
+{
+    EjsObj      *event, *attributes;
+    XmlToken    tok;
+    EjsString   *name;
+    int         next, rc;
+
+    rp->last = 0;
+    if ((event = rp->pending) != 0) {
+        rp->pending = 0;
+        return event;
+    }
+    if ((rc = nextToken(ejs, rp, &tok)) <= 0) {
+        return 0;
+    }
+    switch (rc) {
+    case XR_START:
+        event = createEvent(ejs, "start", tok.name, NULL);
+        attributes = ejsCreateEmptyPot(ejs);
+        if (tok.attributes) {
+            for (next = 0; (name = mprGetNextItem(tok.attributes, &next)) != 0; ) {
+                ejsSetPropertyByName(ejs, attributes, EN(ejsToMulti(ejs, name)), mprGetNextItem(tok.attributes, &next));
+            }
+        }
+        ejsSetPropertyByName(ejs, event, EN("attributes"), attributes);
+        if (tok.solo) {
+            rp->pending = createEvent(ejs, "end", tok.name, NULL);
+        }
+        rp->last = event;
+        break;
+    case XR_END:
+        event = createEvent(ejs, "end", tok.name, NULL);
+        break;
+    case XR_TEXT:
+        event = createEvent(ejs, "text", NULL, tok.value);
+        break;
+    case XR_COMMENT:
+        event = createEvent(ejs, "comment", NULL, tok.value);
+        break;
+    }
+    return event;
+}
+
+
+static bool isSelected(Ejs *ejs, EjsXMLReader *rp, EjsObj *event)
+{
+    EjsString   *name;
+    int         i;
+
+    if (rp->select == 0) {
+        return 0;
+    }
+    name = ejsGetPropertyByName(ejs, event, EN("name"));
+    for (i = 0; i < rp->select->length; i++) {
+        if (ejsCompareString(ejs, ejsToString(ejs, ejsGetProperty(ejs, rp->select, i)), name) == 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+
+static void closeReader(Ejs *ejs, EjsXMLReader *rp)
+{
+    if (rp->file && !ejsIs(ejs, rp->input, File)) {
+        mprCloseFile(rp->file);
+    }
+    rp->file = 0;
+    rp->input = 0;
+    rp->eof = 1;
+    mprFlushBuf(rp->buf);
+    ejsSendEvent(ejs, rp->emitter, "close", rp, rp);
+}
+
+
+/*
+    function XMLReader(input: Object, options: Object? = null)
+ */
+static EjsXMLReader *xr_XMLReader(Ejs *ejs, EjsXMLReader *rp, int argc, EjsObj **argv)
+{
+    EjsObj      *input, *options, *vp;
+    EjsFile     *fp;
+    cchar       *path;
+
+    input = argv[0];
+    options = (argc >= 2) ? argv[1] : 0;
+    rp->chunkSize = ME_XML_READER_CHUNK;
+    rp->lineNumber = 1;
+    rp->stack = mprCreateList(0, 0);
+    rp->buf = mprCreateBuf(ME_MAX_BUFFER, -1);
+
+    if (ejsIsDefined(ejs, options)) {
+        if ((vp = ejsGetPropertyByName(ejs, options, EN("chunk"))) != 0 && ejsIsDefined(ejs, vp)) {
+            rp->chunkSize = max((ssize) ejsGetNumber(ejs, vp), 1);
+        }
+        if ((vp = ejsGetPropertyByName(ejs, options, EN("select"))) != 0 && ejsIsDefined(ejs, vp)) {
+            if (ejsIs(ejs, vp, Array)) {
+                rp->select = (EjsArray*) vp;
+            } else {
+                rp->select = ejsCreateArray(ejs, 1);
+                ejsSetProperty(ejs, rp->select, 0, ejsToString(ejs, vp));
+            }
+        }
+    }
+    if (ejsIs(ejs, input, String)) {
+        mprPutStringToBuf(rp->buf, ejsToMulti(ejs, input));
+        mprAddNullToBuf(rp->buf);
+        rp->eof = 1;
+
+    } else if (ejsIs(ejs, input, Path)) {
+        path = ((EjsPath*) input)->value;
+        if ((rp->file = mprOpenFile(path, O_RDONLY | O_BINARY, 0)) == 0) {
+            ejsThrowIOError(ejs, "Cannot open: %s", path);
+            return 0;
+        }
+
+    } else if (ejsIs(ejs, input, File)) {
+        fp = (EjsFile*) input;
+        if ((rp->file = fp->file) == 0) {
+            ejsThrowStateError(ejs, "File is not open");
+            return 0;
+        }
+
+    } else if (ejsIsDefined(ejs, input)) {
+        rp->read = ejsGetPropertyByName(ejs, input, N(NULL, "read"));
+        if (!ejsIsFunction(ejs, rp->read)) {
+            rp->read = ejsGetPropertyByName(ejs, TYPE(input)->prototype, N(NULL, "read"));
+            if (!ejsIsFunction(ejs, rp->read)) {
+                ejsThrowArgError(ejs, "XMLReader input does not have a read method");
+                return 0;
+            }
+        }
+        rp->chunk = ejsCreateByteArray(ejs, rp->chunkSize);
+
+    } else {
+        ejsThrowArgError(ejs, "Missing XMLReader input");
+        return 0;
+    }
+    rp->input = input;
+    return rp;
+}
+
+
+/*
+    function close(): Void
+ */
+static EjsObj *xr_close(Ejs *ejs, EjsXMLReader *rp, int argc, EjsObj **argv)
+{
+    if (rp->input) {
+        closeReader(ejs, rp);
+    }
+    return 0;
+}
+
+
+/*
+    function get depth(): Number
+ */
+static EjsNumber *xr_depth(Ejs *ejs, EjsXMLReader *rp, int argc, EjsObj **argv)
+{
+    return ejsCreateNumber(ejs, mprGetListLength(rp->stack));
+}
+
+
+/*
+    function expand(): XML
+ */
+static EjsXML *xr_expand(Ejs *ejs, EjsXMLReader *rp, int argc, EjsObj **argv)
+{
+    return expandElement(ejs, rp);
+}
+
+
+/*
+    function get lineNumber(): Number
+ */
+static EjsNumber *xr_lineNumber(Ejs *ejs, EjsXMLReader *rp, int argc, EjsObj **argv)
+{
+    return ejsCreateNumber(ejs, rp->lineNumber);
+}
+
+
+/*
+    function next(): Object?
+ */
+static EjsObj *xr_next(Ejs *ejs, EjsXMLReader *rp, int argc, EjsObj **argv)
+{
+    EjsObj  *event;
+
+    if ((event = readEvent(ejs, rp)) == 0) {
+        return ejs->exception ? 0 : ESV(null);
+    }
+    return event;
+}
+
+
+/*
+    function off(name, observer: Function): Void
+ */
+static EjsObj *xr_off(Ejs *ejs, EjsXMLReader *rp, int argc, EjsObj **argv)
+{
+    ejsRemoveObserver(ejs, rp->emitter, argv[0], (EjsFunction*) argv[1]);
+    return 0;
+}
+
+
+/*
+    function on(name, observer: Function): XMLReader
+ */
+static EjsXMLReader *xr_on(Ejs *ejs, EjsXMLReader *rp, int argc, EjsObj **argv)
+{
+    ejsAddObserver(ejs, &rp->emitter, argv[0], (EjsFunction*) argv[1]);
+    return rp;
+}
+
+
+/*
+    function parse(): Void
+ */
+static EjsObj *xr_parse(Ejs *ejs, EjsXMLReader *rp, int argc, EjsObj **argv)
+{
+    EjsObj      *event;
+    EjsXML      *xml;
+    EjsString   *type;
+
+    while ((event = readEvent(ejs, rp)) != 0) {
+        type = ejsGetPropertyByName(ejs, event, EN("type"));
+        if (rp->last && isSelected(ejs, rp, event)) {
+            if ((xml = expandElement(ejs, rp)) == 0) {
+                break;
+            }
+            ejsSendEvent(ejs, rp->emitter, "element", rp, xml);
+        } else {
+            ejsSendEvent(ejs, rp->emitter, ejsToMulti(ejs, type), rp, event);
+        }
+        if (ejs->exception || rp->input == 0) {
+            break;
+        }
+    }
+    if (!ejs->exception && rp->input) {
+        closeReader(ejs, rp);
+    }
+    return 0;
+}
+
+
+PUBLIC void ejsConfigureXMLReaderType(Ejs *ejs)
+{
+    EjsType     *type;
+    EjsPot      *prototype;
+
+    if ((type = ejsFinalizeScriptType(ejs, N("ejs", "XMLReader"), sizeof(EjsXMLReader), manageXMLReader,
+            EJS_TYPE_OBJ | EJS_TYPE_MUTABLE_INSTANCES)) == 0) {
+        return;
+    }
+    prototype = type->prototype;
+    ejsBindConstructor(ejs, type, xr_XMLReader);
+    ejsBindMethod(ejs, prototype, ES_XMLReader_close, xr_close);
+    ejsBindAccess(ejs, prototype, ES_XMLReader_depth, xr_depth, NULL);
+    ejsBindMethod(ejs, prototype, ES_XMLReader_expand, xr_expand);
+    ejsBindAccess(ejs, prototype, ES_XMLReader_lineNumber, xr_lineNumber, NULL);
+    ejsBindMethod(ejs, prototype, ES_XMLReader_next, xr_next);
+    ejsBindMethod(ejs, prototype, ES_XMLReader_off, xr_off);
+    ejsBindMethod(ejs, prototype, ES_XMLReader_on, xr_on);
+    ejsBindMethod(ejs, prototype, ES_XMLReader_parse, xr_parse);
+}
+
+
 /*
     @copy   default
 
@@ -186,6 +186,50 @@ assert(a.sort(caseless) == "abc,def,XYZ")
 assert(a.sort() == "XYZ,abc,def")
 assert(a.reverse() == "def,abc,XYZ")
 
+//  Comparators may take the elements to compare
+a = [ "def", "XYZ", "abc" ]
+assert(a.sort(function(x, y) caseless([x, y], 0, 1)) == "abc,def,XYZ")
+
+//  Default sort is lexical and stable
+assert([ 10, 9, 1, -2, 100 ].sort() == "-2,1,10,100,9")
+assert([ 2.5, 10, "b", 1 ].sort() == "1,10,2.5,b")
+a = []
+for (i = 0; i < 100; i++) {
+    a.push({ key: i % 3, order: i })
+}
+a.sort(function(x, y) x.key - y.key)
+for (i = 1; i < a.length; i++) {
+    assert(a[i - 1].key < a[i].key || (a[i - 1].key == a[i].key && a[i - 1].order < a[i].order))
+}
+
+//  Elements are retained while the comparator runs even if they are removed from the array
+a = []
+for (i = 0; i < 200; i++) {
+    a.push({ key: i % 7, order: i })
+}
+let cleared = false
+a.sort(function(x, y) {
+    if (!cleared) {
+        cleared = true
+        for (let j = 0; j < a.length; j++) {
+            a[j] = null
+        }
+        GC.run()
+    }
+    return x.key - y.key
+})
+for (i = 1; i < a.length; i++) {
+    assert(a[i - 1].key < a[i].key || (a[i - 1].key == a[i].key && a[i - 1].order < a[i].order))
+}
+
+//  Large sorted input
+a = []
+for (i = 0; i < 10000; i++) {
+    a.push(i)
+}
+a.sort(function(x, y) x - y, -1)
+assert(a[0] == 9999 && a[9999] == 0)
+
 // splice
 
 a = [ 1, 2, 3, 4, 5]
@@ -217,6 +261,12 @@ a = [ 1, 2, 1, "blue", "red", "blue", 1, 4 ]
 assert(a.unique() == "1,2,blue,red,4")
 a = [ 1, 2, 2, 2, 3, 5, 2 ]
 assert(a.unique() == "1,2,3,5")
+a = []
+for (i = 0; i < 10000; i++) {
+    a.push("tag" + (i % 100))
+}
+assert(a.unique().length == 100)
+assert(a[0] == "tag0" && a[99] == "tag99")
 
 // unshift
 
@@ -278,3 +328,6 @@ assert(c == "3")
 
 a = [1,2,3,4,5,6,7]
 assert((a - [0,1,2]) == "3,4,5,6,7")
+assert(([1,1,2,2,3,3] - [1,2]) == "3,3")
+assert(([1,2,2,3] | [3,4,4,1]) == "1,2,3,4")
+assert(([1,2,2,3,4] & [4,2,2]) == "2,4")
@@ -0,0 +1,121 @@
+/*
+    Test packed arrays of numbers and element kind transitions
+ */
+
+//  Integers
+
+a = [3, 1, 2]
+a.push(10, 20)
+assert(a == "3,1,2,10,20")
+assert(a.length == 5)
+assert(a.indexOf(10) == 3)
+assert(a.indexOf(-0) == -1)
+assert(a.indexOf("10") == -1)
+assert(a.lastIndexOf(3) == 0)
+assert(a.join("-") == "3-1-2-10-20")
+assert(a.sort() == "1,10,2,20,3")
+assert(a.sort(function(x, y) x - y) == "1,2,3,10,20")
+assert(a.reverse() == "20,10,3,2,1")
+assert(a.slice(1, 3) == "10,3")
+assert(a.slice(3, 0, -1) == "2,3,10")
+assert(a.pop() == 1)
+assert(a.shift() == 20)
+assert(a == "10,3,2")
+assert([-1, 2147483647, -2147483648, 2147483648] == "-1,2147483647,-2147483648,2147483648")
+
+//  Transition to doubles
+
+a = [1, 2]
+a.push(2.5)
+assert(a == "1,2,2.5")
+assert(a.indexOf(2.5) == 2)
+assert(a.indexOf(2) == 1)
+a[0] = -0
+assert(a.indexOf(0) == 0)
+a = [1, 2, 3]
+a[1] = 0.25
+assert(a[1] == 0.25)
+assert([1e20, 1e15, 123456789012, NaN].join(",") == "100000000000000000000,1000000000000000,123456789012,NaN")
+
+//  NaN matches NaN in packed and boxed arrays
+
+a = [1, NaN, 2]
+assert(a.indexOf(NaN) == 1)
+assert(a.lastIndexOf(NaN) == 1)
+assert(a.contains(NaN))
+assert([1, 2].indexOf(NaN) == -1)
+assert(!["a", 1].contains(NaN))
+assert(["a", NaN].indexOf(NaN) == 1)
+assert([NaN, 1, NaN, 2.5, NaN].unique().length == 3)
+assert(([1, NaN, 2] - [NaN]) == "1,2")
+assert(([NaN, 1] & [2, NaN]).length == 1)
+assert(([NaN] | [NaN, 1]).length == 2)
+
+//  Transition to objects
+
+a = [1, 2]
+a.push("three")
+assert(a == "1,2,three")
+assert(a.indexOf("three") == 2)
+a = [1, 2]
+a[0] = null
+assert(a[0] === null)
+
+//  Holes
+
+a = [1, 2, 3]
+a[5] = 6
+assert(a.length == 6)
+assert(a[4] === undefined)
+a = [1, 2, 3]
+a.length = 5
+assert(a.length == 5)
+assert(a[3] === undefined)
+a = [1, 2, 3]
+delete a[1]
+assert(a[1] === undefined)
+
+//  Iteration
+
+a = []
+for (i = 0; i < 100; i++) {
+    a.push(i * 0.5)
+}
+sum = 0
+for each (v in a) {
+    sum += v
+}
+assert(sum == 2475)
+count = 0
+for (i in a) {
+    count++
+}
+assert(count == 100)
+
+//  Mixed operations
+
+assert([5, 1].concat([2, 3], 7, [8.5]) == "5,1,2,3,7,8.5")
+assert([1, 2].concat(["a"]) == "1,2,a")
+a = [1, 2, 3, 4, 5]
+assert(a.splice(1, 2, 9, 9.5) == "2,3")
+assert(a == "1,9,9.5,4,5")
+assert(a.splice(-1, -1) == "5")
+a.unshift(0)
+a.insert(2, "x")
+assert(a == "0,1,x,9,9.5,4")
+assert([1, 1, 2, 2, 3].unique() == "1,2,3")
+assert(([1, 2, 3, 4] - [2, 3]) == "1,4")
+assert(([1, 2] | [2, 3]) == "1,2,3")
+assert(([1, 2, 3] & [2, 3, 4]) == "2,3")
+assert([1.5, 2].clone() == "1.5,2")
+assert(new Array(1, 2, 3.5) == "1,2,3.5")
+assert(new Array(3).length == 3)
+
+//  Native functions receiving packed arrays
+
+assert(Math.max.apply(null, [1, 9, 3]) == 9)
+function add(x, y, z) { return x + y + z }
+assert(add.apply(null, [1, 2, 3.5]) == 6.5)
+assert(add.bind(null, 1, 2)(3) == 6)
+assert(new Int32Array([1, 2, 3]).sum() == 6)
+assert(serialize([1, 2.5, 3]) == "[1,2.5,3]")
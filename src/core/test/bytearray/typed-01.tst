@@ -0,0 +1,78 @@
+/*
+    Typed array tests
+ */
+
+//  Construction from a length, array and typed array
+let f = new Float64Array(4)
+assert(f.length == 4)
+assert(f[0] == 0 && f[3] == 0)
+assert(f.buffer.size == 32)
+assert(Float64Array.BYTES_PER_ELEMENT == 8)
+
+let i = new Int32Array([1, 2.7, -3, 4294967297])
+assert(i.length == 4)
+assert(i.toString() == "1,2,-3,1")
+
+let u = new Uint8Array(i)
+assert(u.toString() == "1,2,253,1")
+u[0] = 257
+assert(u[0] == 1)
+
+//  Index access and bounds
+f[1] = 1.5
+f[2] = "2.5"
+assert(f[1] == 1.5 && f[2] == 2.5)
+let caught
+try {
+    f[4] = 1
+} catch (e) {
+    caught = e
+}
+assert(caught is OutOfBoundsError)
+
+//  Bulk operations
+f = new Float64Array(1000)
+f.fill(0.5)
+assert(f.sum() == 500)
+f.fill(2, 10, 20)
+assert(f[9] == 0.5 && f[10] == 2 && f[19] == 2 && f[20] == 0.5)
+let m = f.map(function (v, index) v * 2)
+assert(m is Float64Array && m.length == 1000)
+assert(m[0] == 1 && m[10] == 4)
+assert(new Int32Array([1, 2, 3]).map(function (v) v + 0.5).toString() == "1,2,3")
+assert(new Int32Array([2147483647, 2147483647]).sum() == 4294967294)
+
+i = new Int32Array(5)
+i.set([7, 8], 2)
+assert(i.toString() == "0,0,7,8,0")
+i.set(new Float64Array([1.9, -1.9]))
+assert(i.toString() == "1,-1,7,8,0")
+
+//  Views share the buffer
+let ba = new ByteArray(16, false)
+let view = new Int32Array(ba, 4, 2)
+assert(view.length == 2 && view.byteOffset == 4)
+view[0] = 0x01020304
+assert(new Int32Array(ba)[1] == 0x01020304)
+let bytes = new Uint8Array(ba)
+assert(bytes.length == 16)
+bytes.fill(0)
+assert(view[0] == 0)
+
+let sub = i.subarray(2, 4)
+assert(sub.toString() == "7,8")
+sub[0] = 70
+assert(i[2] == 70)
+assert(sub.buffer == i.buffer)
+
+//  Iteration
+let total = 0
+for each (v in new Int32Array([1, 2, 3])) {
+    total += v
+}
+assert(total == 6)
+let keys = []
+for (k in new Uint8Array(3)) {
+    keys.push(k)
+}
+assert(keys == "0,1,2")
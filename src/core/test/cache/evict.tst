@@ -0,0 +1,50 @@
+/*
+    Eviction tests
+ */
+
+//  Least recently used keys are evicted when over the key limit
+cache = new Cache("local", {shared: false, keys: 100})
+for (i = 0; i < 100; i++) {
+    cache.write("key-" + i, "value-" + i)
+}
+assert(cache.read("key-0") == "value-0")
+for (i = 100; i < 150; i++) {
+    cache.write("key-" + i, "value-" + i)
+}
+assert(cache.read("key-0") == "value-0")
+assert(cache.read("key-149") == "value-149")
+let count = 0
+for (i = 0; i < 150; i++) {
+    if (cache.read("key-" + i)) {
+        count++
+    }
+}
+assert(count <= 100 && count >= 90)
+cache.destroy()
+
+//  Memory limit
+cache = new Cache("local", {shared: false, memory: 10000})
+for (i = 0; i < 1000; i++) {
+    cache.write("key-" + i, "x".times(100))
+}
+count = 0
+for (i = 0; i < 1000; i++) {
+    if (cache.read("key-" + i)) {
+        count++
+    }
+}
+assert(count > 0 && count < 100)
+assert(cache.read("key-999"))
+cache.destroy()
+
+//  Remove all keys
+cache = new LocalCache({shared: false})
+for (i = 0; i < 100; i++) {
+    cache.write("key-" + i, "value")
+}
+assert(cache.remove(null))
+assert(cache.read("key-1") == null)
+assert(!cache.remove(null))
+cache.write("key-1", "again")
+assert(cache.read("key-1") == "again")
+cache.destroy()
@@ -0,0 +1,47 @@
+/*
+    Test fixed format date parsing and formatting
+ */
+
+//  RFC 1123
+
+when = 784111777000
+assert(Date.parse("Sun, 06 Nov 1994 08:49:37 GMT") == when)
+assert(Date.parseUTCDate("Sun, 06 Nov 1994 08:49:37 GMT").time == when)
+assert(new Date("Sun, 06 Nov 1994 08:49:37 GMT").time == when)
+assert(new Date(when).toUTCString() == "Sun, 06 Nov 1994 08:49:37 GMT")
+assert(new Date(when).formatUTC("%a, %d %b %Y %T GMT") == "Sun, 06 Nov 1994 08:49:37 GMT")
+assert(new Date(when + 999).toUTCString() == "Sun, 06 Nov 1994 08:49:37 GMT")
+assert(new Date(when + 1000).toUTCString() == "Sun, 06 Nov 1994 08:49:38 GMT")
+assert(new Date(0).toUTCString() == "Thu, 01 Jan 1970 00:00:00 GMT")
+
+//  ISO 8601
+
+assert(Date.parse("1994-11-06T08:49:37Z") == when)
+assert(Date.parse("1994-11-06T08:49:37.250Z") == when + 250)
+assert(Date.parse("1994-11-06T14:19:37+05:30") == when)
+assert(Date.parse("1994-11-06T00:49:37-0800") == when)
+assert(Date.parse("2000-02-29T23:59:59Z") == 951868799000)
+assert(Date.parse("1969-12-31T23:59:59Z") == -1000)
+assert(Date.parse(new Date(when).toJSON().slice(1, -1)) == when)
+
+//  Common log format
+
+assert(Date.parse("06/Nov/1994:08:49:37 +0000") == when)
+assert(Date.parse("06/Nov/1994:01:49:37 -0700") == when)
+
+//  Days past the end of the month are not normalised into the next month
+
+assert(Date.parse("31/Feb/1994:08:49:37 +0000") != Date.parse("03/Mar/1994:08:49:37 +0000"))
+assert(Date.parse("29/Feb/2000:08:49:37 +0000") == Date.parse("2000-02-29T08:49:37Z"))
+
+//  Short numeric strings
+
+assert(Date.parse("1") != null)
+
+//  Formatting the same second with different layouts
+
+d = new Date(when)
+assert(d.formatUTC("%Y") == "1994")
+assert(d.formatUTC("%H:%M") == "08:49")
+assert(d.formatUTC("%Y") == "1994")
+assert(new Date(when + 86400000).formatUTC("%Y-%m-%d") == "1994-11-07")
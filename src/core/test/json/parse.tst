@@ -0,0 +1,42 @@
+/*
+    JSON parsing of standard and relaxed input
+ */
+
+//  Escapes
+o = deserialize('{"s": "a\\tb\\u0041\\n\\/\\\\", "k\\"ey": 1}')
+assert(o.s == "a\tbA\n/\\")
+assert(o['k"ey'] == 1)
+s = deserialize('["\\u00e9"]')[0]
+assert(s.length == 2 && s.charCodeAt(0) == 0xC3 && s.charCodeAt(1) == 0xA9)
+
+//  Numbers
+o = deserialize('[0, -3, 2.5, 1e3, -1.5e-3, 0x10, 017, 123456789012345678901234]')
+assert(o[0] == 0 && o[1] == -3 && o[2] == 2.5 && o[3] == 1000 && o[4] == -0.0015)
+assert(o[5] == 16 && o[6] == 15)
+assert(o[7] > 1.2e23 && o[7] < 1.3e23)
+
+//  Relaxed syntax
+o = deserialize("/* comment */ {a: 'single', `b`: [1, 2,], c: true, d: null, e: undefined, // line\n}")
+assert(o.a == "single")
+assert(o.b.length == 2)
+assert(o.c === true && o.d === null && o.e === undefined)
+
+//  Repeated keys in arrays of objects
+o = deserialize('[{"id": 1, "name": "a"}, {"id": 2, "name": "b"}, {"id": 3, "name": "c", "name": "d"}]')
+assert(o.length == 3 && o[1].id == 2 && o[2].name == "d")
+assert(Object.getOwnPropertyCount(o[2]) == 2)
+
+//  Top level tokens are strings
+assert(deserialize('77') is String)
+assert(deserialize('"x"') == "x")
+
+//  Errors
+for each (s in ['[1 2]', '{a 1}', '[', '{"a": 1', '"abc', '{a:1} x', '[1,,2]', '/* x']) {
+    let caught = false
+    try {
+        deserialize(s)
+    } catch (e) {
+        caught = true
+    }
+    assert(caught)
+}
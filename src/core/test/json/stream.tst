@@ -0,0 +1,60 @@
+/*
+    Serialize to a stream
+ */
+
+let items = []
+for (i = 0; i < 5000; i++) {
+    items.push({id: i, name: "item " + i, tags: ["a", "b"], ok: true, none: null})
+}
+let expected = serialize(items)
+
+//  Custom stream object
+let chunks = 0
+let sink = { data: "", write: function(data) { chunks++; this.data += data; return data.length } }
+assert(serialize(items, {stream: sink}) == "")
+assert(sink.data == expected)
+assert(chunks > 1)
+
+sink = { data: "", write: function(data) { this.data += data } }
+serialize(items, {stream: sink, pretty: true})
+assert(sink.data == serialize(items, {pretty: true}))
+
+//  Top level values
+sink = { data: "", write: function(data) { this.data += data } }
+serialize("text", {stream: sink})
+assert(sink.data == '"text"')
+
+//  File stream
+let path = Path("stream.tmp")
+let file = File(path, "w")
+serialize(items, {stream: file})
+file.close()
+assert(path.readString() == expected)
+path.remove()
+
+//  Stream without a write method
+let caught = false
+try {
+    serialize(items, {stream: {}})
+} catch (e) {
+    caught = true
+}
+assert(caught)
+
+//  Nested custom toJSON while streaming
+class Point {
+    var x, y
+    function Point(x, y) { this.x = x; this.y = y }
+    override function toJSON(options = null): String serialize({x: x, y: y}, options)
+}
+let shapes = {a: 1, b: [new Point(1, 2), new Point(3, 4)], c: new Point(5, 6)}
+expected = serialize(shapes)
+assert(deserialize(expected).c.y == 6)
+sink = { data: "", write: function(data) { this.data += data } }
+assert(serialize(shapes, {stream: sink}) == "")
+assert(sink.data == expected)
+
+//  Top level custom toJSON is written to the stream once
+sink = { data: "", write: function(data) { this.data += data } }
+serialize(new Point(7, 8), {stream: sink})
+assert(sink.data == serialize(new Point(7, 8)))
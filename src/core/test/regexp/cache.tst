@@ -0,0 +1,45 @@
+/*
+    Test compiled pattern sharing
+ */
+
+//  Objects sharing a compiled pattern keep independent state
+
+a = /(\d+)/g
+b = /(\d+)/g
+a.exec("abc 12 def 34")
+assert(a.lastIndex == 6)
+assert(b.lastIndex == 0)
+assert(b.exec("56") == "56,56")
+
+//  Flags that change compilation are not shared
+
+assert(!new RegExp("abc").test("ABC"))
+assert(new RegExp("abc", "i").test("ABC"))
+assert(!new RegExp("abc").test("ABC"))
+assert(/abc/g.global && !/abc/.global)
+
+//  Failed compiles are not cached
+
+for (i = 0; i < 2; i++) {
+    caught = false
+    try {
+        new RegExp("a(b")
+    } catch (e) {
+        caught = true
+    }
+    assert(caught)
+}
+
+//  More patterns than the cache holds
+
+list = []
+for (i = 0; i < 400; i++) {
+    list.push(new RegExp("^x" + i + "$"))
+}
+for (i = 0; i < 400; i++) {
+    assert(list[i].test("x" + i))
+    assert(!list[i].test("x" + (i + 1)))
+}
+for (i = 0; i < 400; i++) {
+    assert(/^lit(\d+)$/.exec("lit" + i)[1] == i)
+}
@@ -0,0 +1,39 @@
+/*
+    Test property lookup and interning with long string keys
+ */
+
+prefix = ""
+for (i = 0; i < 200; i++) {
+    prefix += "k"
+}
+o = {}
+for (i = 0; i < 500; i++) {
+    o[prefix + i] = i
+}
+for (i = 0; i < 500; i++) {
+    assert(o[prefix + i] == i)
+}
+assert(o[prefix + "x"] === undefined)
+delete o[prefix + 7]
+assert(o[prefix + 7] === undefined)
+assert(o[prefix + 8] == 8)
+
+//  Equal strings built in different ways are the same key
+
+a = prefix + "abc"
+b = prefix.slice(0) + "ab" + "c"
+o = {}
+o[a] = 1
+assert(o[b] == 1)
+assert(a == b)
+assert(a === b)
+
+//  Local cache shards by key hash
+
+cache = new Cache("local")
+cache.write(prefix + "one", "1")
+cache.write(prefix + "two", "2")
+assert(cache.read(prefix + "one") == "1")
+assert(cache.read(prefix + "two") == "2")
+assert(cache.read(prefix + "three") == null)
+cache.destroy()
@@ -0,0 +1,40 @@
+/*
+    Test substring search
+ */
+
+s = "abcabcabd"
+assert(s.indexOf("abd") == 6)
+assert(s.indexOf("abc") == 0)
+assert(s.indexOf("abc", 1) == 3)
+assert(s.indexOf("abx") == -1)
+assert(s.indexOf("d") == 8)
+assert(s.indexOf("abcabcabdx") == -1)
+assert(s.lastIndexOf("abc") == 3)
+assert(s.lastIndexOf("d") == 8)
+assert(s.lastIndexOf("a") == 6)
+assert(s.lastIndexOf("x") == -1)
+assert(s.contains("cab"))
+assert(!s.contains("cba"))
+assert("".indexOf("a") == -1)
+assert("a".indexOf("ab") == -1)
+assert("aaa".lastIndexOf("aa") == 1)
+
+//  Long strings
+
+long = ""
+for (i = 0; i < 1000; i++) {
+    long += "abcdefgh"
+}
+long += "needle"
+assert(long.indexOf("needle") == 8000)
+assert(long.lastIndexOf("needle") == 8000)
+assert(long.indexOf("hab") == 7)
+assert(long.lastIndexOf("hab") == 7991)
+assert(long.indexOf("needles") == -1)
+assert(long.contains("hneedle"))
+assert(long.replace("needle", "pin").indexOf("pin") == 8000)
+
+//  Trim with a pattern
+
+assert("--abc--".trim("-") == "abc")
+assert("xyxyabcxy".trim("xy") == "abc")
@@ -0,0 +1,20 @@
+/*
+    Message worker. Post typed data to the parent.
+ */
+
+let bytes = new ByteArray
+bytes.write("Hello World")
+postMessage({
+    name: "Mary", 
+    age: 42, 
+    active: true, 
+    nothing: null,
+    when: new Date(1234567890000),
+    path: Path("/tmp/file.txt"),
+    items: [1, "two", { name: "three" }, [4]],
+    people: [{ name: "Joe", age: 21 }, { name: "Jane", age: 22 }],
+    bytes: bytes,
+}, [bytes])
+
+//  Transferred byte arrays are emptied in the sender
+postMessage(bytes.length == 0 && bytes.size == 0)
@@ -0,0 +1,75 @@
+/*
+    Message encoding tests
+ */
+var w: Worker
+var messages = []
+
+//  Typed values are received directly without deserializing
+w = new Worker("message.es")
+w.onmessage = function (e) {
+    messages.push(e.data)
+}
+Worker.join(w)
+assert(messages.length == 2)
+
+let result = messages[0]
+assert(result.name == "Mary")
+assert(result.age == 42)
+assert(result.active === true)
+assert(result.nothing === null)
+assert(result.when is Date)
+assert(result.when.time == 1234567890000)
+assert(result.path == "/tmp/file.txt")
+assert(result.items.length == 4)
+assert(result.items[1] == "two")
+assert(result.items[2].name == "three")
+assert(result.items[3][0] == 4)
+assert(result.people[1].name == "Jane")
+assert(result.people[1].age == 22)
+assert(result.bytes is ByteArray)
+assert(result.bytes.toString() == "Hello World")
+assert(messages[1] === true)
+
+
+//  Only byte arrays can be transferred
+let caught
+try {
+    w = new Worker
+    w.postMessage({}, [{}])
+} catch (e) {
+    caught = true
+}
+assert(caught)
+
+
+//  Transferred byte arrays are received by the worker and emptied in the sender
+let received
+let bytes = new ByteArray
+bytes.write("Hello Worker")
+w = new Worker("transfer.es")
+w.onmessage = function (e) {
+    received = e.data
+}
+w.postMessage(bytes, [bytes])
+assert(bytes.length == 0 && bytes.size == 0)
+Worker.join(w)
+assert(received == "Hello Worker")
+
+
+//  Transferred byte arrays are kept by the sender if the message cannot be encoded
+class Unencodable {
+    function toJSON() {
+        throw new Error("Cannot encode")
+    }
+}
+bytes = new ByteArray
+bytes.write("Hello")
+caught = false
+try {
+    w = new Worker
+    w.postMessage({ bytes: bytes, bad: new Unencodable }, [bytes])
+} catch (e) {
+    caught = true
+}
+assert(caught)
+assert(bytes.toString() == "Hello")
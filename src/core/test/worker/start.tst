@@ -28,7 +28,7 @@ assert(exitCount == 1)
 //  Test receiving a message from the started script
 w = new Worker("worker.es")
 w.onmessage = function (e) {
-    let o = deserialize(e.data)
+    let o = e.data
     assert(o.name == "Mary")
     assert(o.address == "123 Park Ave")
 }
@@ -0,0 +1,9 @@
+/*
+    Transfer worker. Return the contents of a transferred byte array to the parent.
+ */
+
+onmessage = function (e) {
+    postMessage(e.data is ByteArray ? e.data.toString() : null)
+    exit()
+}
+App.run()
@@ -0,0 +1,60 @@
+/*
+    Test descendant queries and the descendant index
+ */
+
+var doc: XML = <catalog>
+    <book id="1" lang="en"><title>First</title><price>10</price></book>
+    <book id="2"><title>Second</title><price>20</price>
+        <book id="3"><title>Nested</title></book>
+    </book>
+    <shelf><book id="4"><title>Fourth</title></book></shelf>
+</catalog>
+
+//  Element descendants in document order. Nested elements of the same name are not repeated.
+
+assert(doc..book.length() == 3)
+assert(doc..book.@id == "1 2 4")
+assert(doc..title.length() == 4)
+assert(doc..title == "<title>First</title> <title>Second</title> <title>Nested</title> <title>Fourth</title>")
+assert(doc..price.length() == 2)
+assert(doc..missing.length() == 0)
+assert(doc.book[1]..book.@id == "3")
+
+//  Attribute descendants
+
+assert(doc..@id == "1 2 3 4")
+assert(doc..@lang == "en")
+assert(doc..@*.length() == 5)
+assert(doc..@missing.length() == 0)
+
+//  Repeated queries return fresh lists
+
+let first = doc..title
+let second = doc..title
+assert(first.length() == second.length())
+assert(first[0] == second[0])
+
+//  Modifications invalidate the index
+
+doc.shelf.book.title = "Renamed"
+assert(doc..title[3] == "Renamed")
+doc.shelf.magazine = "News"
+assert(doc..magazine.length() == 1)
+doc.shelf.@floor = "2"
+assert(doc..@floor == "2")
+doc.shelf = <shelf><book id="5"/><book id="6"/></shelf>
+assert(doc..book.length() == 4)
+assert(doc..title.length() == 3)
+assert(doc..magazine.length() == 0)
+assert(doc..@id == "1 2 3 5 6")
+doc.book[0].@id = "9"
+assert(doc..@id == "9 2 3 5 6")
+
+//  Many queries on a large document
+
+let xml = new XML("<root>" + "<item><name>a</name><value>1</value></item>".times(500) + "</root>")
+let total = 0
+for (i = 0; i < 200; i++) {
+    total += xml..value.length()
+}
+assert(total == 100000)
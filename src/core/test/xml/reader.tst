@@ -0,0 +1,126 @@
+/*
+    Test the streaming XMLReader
+ */
+
+const DOC = '<?xml version="1.0"?>\n<!DOCTYPE order>\n<order id="7" status=open>\n  <!-- first -->\n' +
+    '  <item sku="a1">Apple</item>\n  <item sku="b2"/>\n  <note><![CDATA[<raw> & data]]></note>\n</order>\n'
+
+//  Pull events
+
+let reader = new XMLReader(DOC)
+let events = []
+let e
+while ((e = reader.next()) != null) {
+    events.push(e.type + ":" + (e.name || e.value))
+}
+assert(events.join(",") == "start:order,comment: first ,start:item,text:Apple,end:item,start:item,end:item," +
+    "start:note,text:<raw> & data,end:note,end:order")
+assert(reader.lineNumber == 9)
+
+//  Attributes and depth
+
+reader = new XMLReader(DOC)
+e = reader.next()
+assert(e.attributes.id == "7")
+assert(e.attributes.status == "open")
+assert(reader.depth == 1)
+reader.next()
+e = reader.next()
+assert(e.name == "item" && e.attributes.sku == "a1")
+assert(reader.depth == 2)
+
+//  Expand a subtree into XML
+
+let xml = reader.expand()
+assert(xml is XML)
+assert(xml.@sku == "a1")
+assert(xml == "Apple")
+e = reader.next()
+assert(e.type == "start" && e.attributes.sku == "b2")
+xml = reader.expand()
+assert(xml.name() == "item" && xml.@sku == "b2")
+assert(reader.next().name == "note")
+reader = new XMLReader("<a><b x='1'><c>one</c><c>two</c></b></a>")
+reader.next()
+reader.next()
+xml = reader.expand()
+assert(xml.c.length() == 2)
+assert(xml.c[1] == "two")
+assert(reader.next().type == "end")
+assert(reader.next() == null)
+
+//  Expand only after a start event
+
+reader = new XMLReader(DOC)
+reader.next()
+reader.next()
+let caught
+try { reader.expand() } catch (err) { caught = err }
+assert(caught is StateError)
+
+//  Push events with selected elements expanded
+
+let items = []
+let names = []
+let closed = false
+reader = new XMLReader(DOC, {select: "item"})
+reader.on("element", function(event, xml) { items.push(xml.@sku) })
+reader.on("start", function(event, e) { names.push(e.name) })
+reader.on("close", function(event) { closed = true })
+reader.parse()
+assert(items.join(",") == "a1,b2")
+assert(names.join(",") == "order,note")
+assert(closed)
+
+//  Input from a path and read in small chunks across token boundaries
+
+let path = Path("reader.tmp")
+let doc = "<list>\n"
+for (i = 0; i < 200; i++) {
+    doc += '  <entry n="' + i + '"><!-- c ' + i + ' --><![CDATA[v' + i + ']]></entry>\n'
+}
+doc += "</list>\n"
+path.write(doc)
+for each (chunk in [1, 7, 1024]) {
+    let sum = 0
+    let count = 0
+    reader = new XMLReader(path, {chunk: chunk, select: ["entry"]})
+    reader.on("element", function(event, xml) { sum += (xml.@n cast Number); count++ })
+    reader.parse()
+    assert(count == 200)
+    assert(sum == 19900)
+}
+
+//  Input from a stream
+
+let ba = new ByteArray
+ba.write(doc)
+reader = new XMLReader(ba, {chunk: 100})
+count = 0
+while ((e = reader.next()) != null) {
+    if (e.type == "text") {
+        count++
+    }
+}
+assert(count == 200)
+path.remove()
+
+//  Syntax errors
+
+for each (bad in ["<a><b></a>", "<a>", "</a>", "<a", "<a x></a>", "<a><!-- x</a>"]) {
+    caught = null
+    try {
+        reader = new XMLReader(bad)
+        while (reader.next()) {}
+    } catch (err) {
+        caught = err
+    }
+    assert(caught is SyntaxError)
+}
+caught = null
+try {
+    new XMLReader("<a>\n<b>\n</c></a>").parse()
+} catch (err) {
+    caught = err
+}
+assert(caught.message.contains("line 3"))
@@ -28,12 +28,16 @@ module ejs.db.mapper {
         static var  _belongsTo: Array? = null    //  List of belonging associations
 
         /*
-            Queries to cache. Indexed by model name and optionally query string. Contains cache options for this model.
-            Created on demand if cache() is called.
+            Cache options indexed by model name. Created on demand if cache() is called.
          */
         static var _cacheOptions: Object = {}
         static var _caching: Boolean?
 
+        /*
+            Default query cache lifespan in seconds. Bounds the staleness of cached results after writes by other processes.
+         */
+        private static const DefaultCacheLifespan = 3600
+
         static var  _className: String          //  Model class name
         static var  _columns: Object            //  List of columns in this database table
         static var  _hasOne: Array? = null      //  List of 1-1 containment associations
@@ -145,9 +149,11 @@ module ejs.db.mapper {
 
         /**
             Database query caching. This caches controls the caching of database records. If enabled, the results
-            of queries are cached with a given lifetime. If the lifetime has not expired, subsequent queries will
-            be optimized by retrieving cached data. If the record is updated, the cached data will be removed so that
-            the next query retrieves fresh data.
+            of queries are cached by the database using the query command and parameters as the key. If the lifetime
+            has not expired, subsequent queries will be optimized by retrieving cached data. When any table read by
+            a cached query is modified by this process, the cached data is removed so that the next query retrieves 
+            fresh data. Writes by other processes, including other worker processes of a prefork HttpServer, are not
+            detected. Cached data from such writes persists until the lifespan expires.
             Caching is disabled/enabled via the ejsrc config.cache.database.enable field. It is enabled by default.
             Caching may be used for any Database model, though typically it is most useful for state-less GET requests.
             @param model Model class. This can be a Model class object, "this" or a String model class name.
@@ -155,10 +161,10 @@ module ejs.db.mapper {
                 code and this routine will determine the underlying model class name.
             @param options Cache control options. Default options for all model caching can also be provided by the 
                 ejsrc config.cache.database field.
-            @option lifespan Time in seconds for the cached output to persist.
-            @option query SQL query command to further differentiate cached content. If supplied, different cache data
-                can be stored for each query that applies to the given model. If the URI is set to "*" all 
-                URIs for the specified model will be uniquely cached. 
+            @option lifespan Time in seconds for the cached output to persist. If zero or not set, the ejsrc 
+                config.cache.lifespan value is used. This defaults to one hour.
+            @option query SQL query command to cache. If supplied, only this query is cached for the given model. 
+                If not set or set to "*", all queries for the specified model will be uniquely cached. 
             @example 
                 cache()
                 cache("Store", {lifespan: 200})
@@ -182,27 +188,21 @@ module ejs.db.mapper {
                 mname = Object.getName(model)
             }
             blend(options, App.config.cache.database, {overwrite: false})
-            cacheIndex = getCacheIndex(mname)
-            _cacheOptions[cacheIndex] = options
-            if (options.lifespan is Number) {
-                let cacheName = cacheIndex
-                if (options.query) {
-                    cacheName += "::" + options.query
-                }
-                /* Invalidate cache data for app reloads */
-                App.cache.expire(cacheName, null)
-                App.cache.expire(cacheName, Date().future(options.lifespan * 1000))
-            }
+            _cacheOptions[getCacheIndex(mname)] = options
         }
 
         private static function getCacheIndex(model: String): String
             "::ejs.db.mapper::" + model
 
-        private static function getCacheName(name: String, options: Object?, query: String?): String {
-            if (options && options.query && query) {
-                name += "::" + query
+        /*
+            Get the cache lifespan for a query. Returns null if the query should not be cached.
+         */
+        private static function getCacheLifespan(cmd: String): Number? {
+            let options = _cacheOptions[getCacheIndex(_className)]
+            if (options && (!options.query || options.query == "*" || options.query == cmd)) {
+                return options.lifespan || App.config.cache.lifespan || DefaultCacheLifespan
             }
-            return name
+            return null
         }
 
 
@@ -256,14 +256,14 @@ module ejs.db.mapper {
          */
         private function coerceToEjsTypes(): Void {
             for (let field: String in this) {
-                let col: Column? = _imodel._columns[field]
+                let col = _imodel._columns[field]
                 if (col == undefined) {
                     continue
                 }
-                if (col.ejsType == Object.getType(this[field])) {
+                let value = this[field]
+                if (value == null || col.ejsType == Object.getType(value)) {
                     continue
                 }
-                let value: String = this[field]
                 switch (col.ejsType) {
                 case Boolean:
                     if (value is String) {
@@ -382,27 +382,6 @@ module ejs.db.mapper {
             _errors[field] = msg
         }
 
-        /*
-            Fetch cached data from the cache if present
-            @return a response object
-         */
-        private static function fetchCachedResponse(query: String? = null): Object? {
-            let cacheIndex = getCacheIndex(_className)
-            let options = _cacheOptions[cacheIndex]
-            if (options) {
-                let cacheName = getCacheName(cacheIndex, options, query)
-                if (!options.query || options.query == "*" || cacheName == (cacheIndex + "::" + options.query)) {
-                    let item = App.cache.readObj(cacheName)
-                    if (item) {
-                        App.log.debug(6, "Use cached database query: " + cacheName)
-                        return item
-                    }
-                }
-                App.log.debug(6, "No cached database query for: " + cacheName)
-            }
-            return null
-        }
-
         //  TODO - should not throw when a record is not found. 
         /**
             Find a record. Find and return a record identified by its primary key if supplied or by the specified options. 
@@ -662,11 +641,9 @@ module ejs.db.mapper {
             let conditions: String
             let where: Boolean
             let results: Array?
+            let params: Array?
 
             if (!_columns) _model.getSchema()
-            if (_caching && (results = fetchCachedResponse())) {
-                return results
-            }
             if (options == null) {
                 options = {}
             }
@@ -786,7 +763,9 @@ module ejs.db.mapper {
                 } else {
                     conditions += " AND "
                 }
-                conditions += (_tableName + "." + _keyName + " = ") + ((key) ? key : options.key)
+                /* Bind the key so the prepared statement can be reused for all keys */
+                conditions += _tableName + "." + _keyName + " = ?"
+                params = [(key) ? key : options.key]
             }
 
             //  Removed quote from "from"
@@ -810,26 +789,14 @@ module ejs.db.mapper {
             if (_db == null) {
                 throw new Error("Database connection has not yet been established")
             }
-            if (_caching && (results = fetchCachedResponse(cmd))) {
-                return results
-            }
-            if (results == null) {
-                try {
-                    if (_trace) {
-                        let start = new Date
-                        results = _db.query(cmd, "find", _trace)
-                        App.log.activity("TIME", "Query Time:", start.elapsed)
-                        App.log.info("Query Time:", start.elapsed)
-                    } else {
-                        results = _db.query(cmd, "find", _trace)
-                    }
-                    if (_caching) {
-                        saveQuery(results, cmd)
-                    }
-                } 
-                catch (e) {
-                    throw e
-                }
+            let lifespan = _caching ? getCacheLifespan(cmd) : null
+            if (_trace) {
+                let start = new Date
+                results = _db.query(cmd, "find", _trace, params, lifespan)
+                App.log.activity("TIME", "Query Time:", start.elapsed)
+                App.log.info("Query Time:", start.elapsed)
+            } else {
+                results = _db.query(cmd, "find", _trace, params, lifespan)
             }
             return results
         }
@@ -860,7 +827,7 @@ module ejs.db.mapper {
             Prepare a value to be written to the database
          */
         private static function prepareValue(field: String, value: Object?): String {
-            let col: Column? = _columns[field]
+            let col = _columns[field]
             if (col == undefined) {
                 return undefined
             }
@@ -893,6 +860,19 @@ module ejs.db.mapper {
             return Database.quote(value.toString())
         }
 
+        /*
+            Prepare a value to be bound as a parameter when writing to the database. Values are stored in the same
+            form as $prepareValue but without SQL quoting.
+         */
+        private static function prepareParam(field: String, value: Object?): String {
+            let result = prepareValue(field, value)
+            let ejsType = _columns[field].ejsType
+            if (ejsType == Boolean || ejsType == Date || ejsType == Number) {
+                return result
+            }
+            return value.toString()
+        }
+
         /*
             Read records for an assocation. Will return one or an array of records matching the supplied key and options.
          */
@@ -916,9 +896,9 @@ module ejs.db.mapper {
             @param ids Set of keys identifying the records to remove
          */
         static function remove(...ids): Void {
+            let cmd: String = "DELETE FROM " + _tableName + " WHERE " + _keyName + " = ?;"
             for each (let key: Object in ids) {
-                let cmd: String = "DELETE FROM " + _tableName + " WHERE " + _keyName + " = " + key + ";"
-                getDb().query(cmd, "remove", _trace)
+                getDb().query(cmd, "remove", _trace, [key])
             }
         }
 
@@ -1004,30 +984,80 @@ module ejs.db.mapper {
                 _keyValue = this["id"] = result[0]["last_insert_rowid()"] cast Number
             }
             runFilters(_imodel._afterFilters)
-            if (_imodel._caching) {
-                let cacheIndex = getCacheIndex(_imodel._className)
-                let options = _cacheOptions[cacheIndex]
-                if (options == null || options.query == null) {
-                    let cacheName = getCacheName(cacheIndex, options)
-                    App.log.debug(6, "Expire database query cache " + cacheName)
-                    App.cache.writeObj(cacheName, null, options)
-                } else {
-                }
-            }
             return true
         }
 
-        /*
-            Save the output from a database query for future reuse
+        /**
+            Save a set of records to the database. The records are validated and then written using one prepared 
+            statement for each distinct set of fields. All records are saved in a single transaction. If called inside 
+            a transaction, the records are saved as part of that transaction. This is much faster than calling $save 
+            for each record when saving many records.
+            @param records Array of records to save. The records must all be instances of this model.
+            @returns True if all the records are validated and successfully written to the database. If any record 
+                fails validation, no records are saved.
+            @throws IOError Throws exception on sql errors
          */
-        private static function saveQuery(results, query: String? = null): Void {
-            let cacheIndex = getCacheIndex(_className)
-            let options = _cacheOptions[cacheIndex]
-            if (options) {
-                let cacheName = getCacheName(cacheIndex, options, query)
-                App.cache.writeObj(cacheName, results, options)
-                App.log.debug(6, "Cache database query " + cacheName)
+        static function saveAll(records: Array): Boolean {
+            if (!_columns) getSchema()
+            for each (let rec in records) {
+                if (!rec.validateRecord()) {
+                    return false
+                }
+            }
+            let batches = {}
+            for each (let rec in records) {
+                rec.runFilters(_beforeFilters)
+                let fields = []
+                let params = []
+                for (let field: String in rec) {
+                    if (_columns[field]) {
+                        fields.append(field)
+                        params.append(prepareParam(field, rec[field]))
+                    }
+                }
+                let cmd: String
+                if (rec._keyValue == null) {
+                    cmd = "INSERT INTO " + _tableName + " (" + fields.join(", ") + ") VALUES (" + 
+                        fields.map(function(f) "?").join(", ") + ");"
+                } else {
+                    cmd = "UPDATE " + _tableName + " SET " + fields.join(" = ?, ") + " = ? WHERE " + _keyName + " = ?;"
+                    params.append(rec._keyValue)
+                }
+                let batch = batches[cmd]
+                if (!batch) {
+                    batch = batches[cmd] = {records: [], params: []}
+                }
+                batch.records.append(rec)
+                batch.params.append(params)
             }
+            let db = getDb()
+            /* A savepoint also nests inside a transaction started by the caller, where BEGIN would fail */
+            db.sql("SAVEPOINT saveAll;")
+            try {
+                for (let cmd in batches) {
+                    let batch = batches[cmd]
+                    let rowids = []
+                    if (_trace) {
+                        App.log.activity("saveAll", cmd + " (" + batch.params.length + " records)")
+                    }
+                    db.batch(cmd, batch.params, rowids)
+                    for (let i = 0; i < batch.records.length; i++) {
+                        let rec = batch.records[i]
+                        if (rec._keyValue == null) {
+                            rec._keyValue = rec[_keyName] = rowids[i]
+                        }
+                    }
+                }
+                db.sql("RELEASE saveAll;")
+            } catch (e) {
+                db.sql("ROLLBACK TO saveAll;")
+                db.sql("RELEASE saveAll;")
+                throw e
+            }
+            for each (let rec in records) {
+                rec.runFilters(_afterFilters)
+            }
+            return true
         }
 
         /**
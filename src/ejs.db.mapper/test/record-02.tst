@@ -0,0 +1,73 @@
+/*
+    Record.saveAll tests
+ */
+
+require ejs.db
+require ejs.db.mapper
+require ejs.db.sqlite
+
+let db = Database.defaultDatabase = new Database("sqlite", ":memory:")
+db.query("CREATE TABLE Items (id INTEGER PRIMARY KEY, name TEXT UNIQUE, price FLOAT);")
+
+public dynamic class Item implements Record {
+    function Item(fields: Object? = null) {
+        initialize(fields)
+    }
+}
+
+function count(): Number
+    db.query("SELECT COUNT(*) AS count FROM Items;")[0].count
+
+//  All records are committed and receive their keys
+let items = []
+for (i in 10) {
+    items.push(new Item({name: "item-" + i, price: i}))
+}
+assert(Item.saveAll(items))
+assert(count() == 10)
+assert(items[0].id == 1 && items[9].id == 10)
+
+//  Updates and inserts are saved together
+items[0].price = 100
+assert(Item.saveAll([items[0], new Item({name: "item-10", price: 10})]))
+assert(count() == 11)
+assert(db.query("SELECT price FROM Items WHERE id = 1;")[0].price == 100)
+
+//  A failing record rolls back all the records
+let caught
+try {
+    Item.saveAll([new Item({name: "new-1", price: 1}), new Item({name: "item-5", price: 2})])
+} catch {
+    caught = true
+}
+assert(caught)
+assert(count() == 11)
+assert(db.query("SELECT * FROM Items WHERE name = 'new-1';").length == 0)
+
+//  Inside a transaction, records are saved as part of the transaction
+db.query("BEGIN TRANSACTION;")
+assert(Item.saveAll([new Item({name: "new-2", price: 2})]))
+assert(count() == 12)
+db.query("ROLLBACK;")
+assert(count() == 11)
+
+db.query("BEGIN TRANSACTION;")
+assert(Item.saveAll([new Item({name: "new-3", price: 3})]))
+db.query("COMMIT;")
+assert(count() == 12)
+
+//  A failure inside a transaction rolls back only the saved records
+db.query("BEGIN TRANSACTION;")
+db.query("INSERT INTO Items (name, price) VALUES ('new-4', 4);")
+caught = false
+try {
+    Item.saveAll([new Item({name: "new-5", price: 5}), new Item({name: "item-5", price: 5})])
+} catch {
+    caught = true
+}
+assert(caught)
+db.query("COMMIT;")
+assert(count() == 13)
+assert(db.query("SELECT * FROM Items WHERE name = 'new-4';").length == 1)
+assert(db.query("SELECT * FROM Items WHERE name = 'new-5';").length == 0)
+db.close()
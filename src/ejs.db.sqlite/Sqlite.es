@@ -86,6 +86,11 @@ module ejs.db.sqlite {
                 containing an access URI for the database.
             @options name Database name URI specifying the SQLite database to open. 
                 Example: file://var/spool/db/database.db
+            Connections to database files are drawn from a process-wide pool that is shared by all interpreters
+            and workers. A connection is checked out for each command and returned when the command completes. 
+            Connections stay with the database object while a transaction is open or prepared statements are in use.
+            Pooled connections are configured once for write-ahead logging and a busy timeout. In-memory databases
+            (":memory:") are not pooled.
          */
         native function Sqlite(options: Object)
 
@@ -102,6 +107,12 @@ module ejs.db.sqlite {
         function addIndex(table: String, column: String, index: String): Void
             query("CREATE INDEX " + index + " ON " + table + " (" + column + ");")
 
+        /** @duplicate ejs.db::Database.batch */
+        native function batch(cmd: String, params: Array, rowids: Array? = null): Number
+
+        /** @duplicate ejs.db::Database.cachedSql */
+        native function cachedSql(cmd: String, params: Object? = null, lifespan: Number = 0): Array
+
         /** 
             @duplicate ejs.db::Database.changeColumn 
             @hide
@@ -272,8 +283,21 @@ module ejs.db.sqlite {
 
         //  TODO - why have query and sql
 
+        /**
+            Get connection pool statistics
+            @return An object hash indexed by database path. Each entry contains the properties: connections (open
+                connections), idle, inUse, waiting (threads waiting for a connection), checkouts, waits (checkouts 
+                that had to wait), overflows (extra connections opened when the pool was exhausted), waitTime (total 
+                wait time in msec) and maxWait (longest wait in msec).
+         */
+        static native function poolStats(): Object
+
+        /** @duplicate ejs.db::Database.prepare */
+        native function prepare(cmd: String): SqliteStatement
+
         /** @duplicate ejs.db::Database.query */
-        function query(cmd: String, tag: String = "SQL", trace: Boolean~ = false): Array {
+        function query(cmd: String, tag: String = "SQL", trace: Boolean~ = false, params: Object? = null, 
+                lifespan: Number? = null): Array {
             //  TODO - need to access Database.traceAll
             let mark, size
             //  TODO - rationalize Sqlite.query with Database.query and Record.innerFind
@@ -282,7 +306,7 @@ module ejs.db.sqlite {
                 mark = new Date
                 size = Memory.resident
             }
-            let result = sql(cmd)
+            let result = (lifespan != null) ? cachedSql(cmd, params, lifespan) : sql(cmd, params)
             if (trace) {
                 App.log.activity("Stats", "Sqlite query %.2f msec, memory %.2f MB, resident %.2f".format(mark.elapsed, 
                     (Memory.resident - size) / (1024 * 1024), Memory.resident / (1024 * 1024)))
@@ -291,7 +315,7 @@ module ejs.db.sqlite {
         }
 
         /** @duplicate ejs.db::Database.sql */
-        native function sql(cmd: String): Array
+        native function sql(cmd: String, params: Object? = null): Array
 
         /** @duplicate ejs.db::Database.sqlTypeToDataType */
         function sqlTypeToDataType(sqlType: String): String
@@ -305,6 +329,64 @@ module ejs.db.sqlite {
             @hide */
         function startTransaction(): Void {}
     }
+
+    /**
+        SQLite prepared statement. Statements are created via $Sqlite.prepare and may be run repeatedly with 
+        different parameters without reparsing the SQL.
+        @example
+            let stmt = db.prepare("SELECT * FROM Stocks WHERE id = ?")
+            stmt.bind(42)
+            while ((row = stmt.step()) != null) {
+                print(row.name)
+            }
+        @spec ejs
+        @stability prototype
+     */
+    class SqliteStatement {
+
+        use default namespace public
+
+        /**
+            Bind parameter values to the statement. This resets the statement and clears prior bindings.
+            @param params Parameter values. These may be positional values for "?" parameters, or a single Array of 
+                values, or a single Object of named values for ":name", "@name" or "$name" parameters. Numbers, Booleans,
+                Dates (as milliseconds since 1970), ByteArrays (as blobs), null and Strings are supported.
+            @return The statement
+         */
+        native function bind(...params): SqliteStatement
+
+        /**
+            Close the statement and free resources.
+         */
+        native function close(): Void
+
+        /**
+            Get an iterator for this statement to be used by "for each (row in statement)". The statement is reset
+            and run from the start and each result row is returned in turn. Rows are not accumulated, so this may be 
+            used to stream large result sets.
+            @return An iterator object that will return the result rows
+         */
+        override iterator native function getValues(): Iterator
+
+        /**
+            Reset the statement so it may be run again. Parameter bindings are preserved.
+         */
+        native function reset(): Void
+
+        /**
+            The SQL text of the statement
+         */
+        native function get sql(): String
+
+        /**
+            Run the statement to retrieve the next result row.
+            @return An object hash containing the column names and values of the next row. Column values are 
+                Numbers for INTEGER and REAL columns, ByteArrays for BLOB columns, null for NULL values and otherwise 
+                Strings. Returns null when there are no more rows.
+            @throws IOError on SQL errors
+         */
+        native function step(): Object?
+    }
 }
 
 
@@ -22,231 +22,1776 @@
 #ifndef ME_MAX_SQLITE_DURATION
     #define ME_MAX_SQLITE_DURATION 30000           /**< Database busy timeout */
 #endif
+#ifndef ME_MAX_SQLITE_STATEMENTS
+    #define ME_MAX_SQLITE_STATEMENTS 32            /**< Prepared statements to cache per connection */
+#endif
+#ifndef ME_MAX_SQLITE_CONNECTIONS
+    #define ME_MAX_SQLITE_CONNECTIONS 16           /**< Maximum pooled connections per database file */
+#endif
+#ifndef ME_MAX_SQLITE_POOL_WAIT
+    #define ME_MAX_SQLITE_POOL_WAIT 1000           /**< Time to wait for a pooled connection before opening another */
+#endif
+#ifndef ME_MAX_SQLITE_RESULTS
+    #define ME_MAX_SQLITE_RESULTS 64               /**< Cached query results per database object */
+#endif
+#ifndef ME_MAX_SQLITE_RESULT_ROWS
+    #define ME_MAX_SQLITE_RESULT_ROWS 1000         /**< Maximum rows in a cached query result */
+#endif
+#ifndef ME_MAX_SQLITE_TABLES
+    #define ME_MAX_SQLITE_TABLES 16                /**< Maximum tables tracked per query or transaction */
+#endif
+#ifndef ME_SQLITE_JOURNAL_MODE
+    #define ME_SQLITE_JOURNAL_MODE "WAL"           /**< Journal mode for pooled connections. Empty for the default */
+#endif
+
+/*********************************** Locals ***********************************/
+/*
+    Map allocation and mutex routines to use ejscript version.
+ */
+#define MAP_ALLOC   1
+#define MAP_MUTEXES 0
+
+#define THREAD_STYLE SQLITE_CONFIG_MULTITHREAD
+//#define THREAD_STYLE SQLITE_CONFIG_SERIALIZED
+
+/*
+    Cached prepared statement
+ */
+typedef struct CachedStatement {
+    sqlite3_stmt    *stmt;          /* Prepared statement */
+    char            *sql;           /* SQL text key */
+    uint            hash;           /* Hash of the SQL text */
+    uint64          lastUse;        /* Use sequence number for LRU eviction */
+} CachedStatement;
+
+/*
+    Table change version. The version is incremented when committed writes modify the table and is used to validate
+    cached query results. Allocated with palloc and never freed for pooled databases.
+ */
+typedef struct SqliteTable {
+    struct SqliteTable *next;       /* Next table in the list */
+    char            *name;          /* Table name */
+    uint64          version;        /* Change version. Access with the pool lock held */
+} SqliteTable;
+
+/*
+    Database connection. Connections to database files are pooled and shared by all interpreters in the process.
+    Each connection owns a cache of prepared statements which survives being returned to the pool.
+ */
+typedef struct SqliteConnection {
+    sqlite3         *sdb;           /* Sqlite handle */
+    struct SqlitePool *pool;        /* Owning pool. Null for private (in-memory) connections */
+    CachedStatement *statements;    /* LRU cache of prepared statements keyed by SQL text */
+    int             numStatements;  /* Number of cached statements */
+    uint64          useSeqno;       /* Sequence number for LRU */
+    SqliteTable     **tables;       /* Table version list. Points to the pool list or to ownTables */
+    SqliteTable     *ownTables;     /* Table versions for private connections */
+    SqliteTable     *dirty[ME_MAX_SQLITE_TABLES];   /* Tables modified by writes not yet published */
+    int             numDirty;       /* Number of dirty tables */
+    int             dirtyAll;       /* Too many tables modified to track individually */
+    struct QueryResult *collect;    /* Query result collecting the tables read by a statement being prepared */
+    int             dropping;       /* A table or view is being dropped */
+    sqlite3_stmt    **collected;    /* Statements of garbage collected statement objects awaiting finalization */
+    int             numCollected;   /* Number of collected statements. Access with the pool lock held */
+    int             maxCollected;   /* Size of the collected list */
+    int             prepared;       /* Number of statement objects. Access with the pool lock held */
+    int             closed;         /* Connection is closed and is freed when the last statement is released */
+} SqliteConnection;
+
+/*
+    Process-wide pool of connections for one database file. Allocated with palloc and never freed.
+ */
+typedef struct SqlitePool {
+    struct SqlitePool *next;        /* Next pool in the pool list */
+    char            *path;          /* Absolute database path */
+    SqliteConnection **idle;        /* Idle connections available for checkout */
+    int             numIdle;        /* Number of idle connections */
+    int             count;          /* Number of open connections (idle and in use) */
+    int             waiting;        /* Number of threads waiting for a connection */
+    uint64          checkouts;      /* Total number of connection checkouts */
+    uint64          waits;          /* Number of checkouts that had to wait */
+    uint64          overflows;      /* Number of overflow connections opened when the pool was exhausted */
+    MprTicks        waitTime;       /* Total time spent waiting for connections */
+    MprTicks        maxWait;        /* Longest wait for a connection */
+    MprCond         *cond;          /* Signalled when a connection is returned */
+    SqliteTable     *tables;        /* Table change versions for the database */
+} SqlitePool;
+
+/*
+    Result row shape. This is computed once per statement execution and describes how result columns map onto the
+    properties of each row object. Rows are cloned from the template so they share the same column name layout.
+ */
+typedef struct RowShape {
+    EjsPot          *template;      /* Row template with one property per unique column name */
+    int             *slots;         /* Property slot for each column. Set to -1 for duplicate column names */
+    int             ncol;           /* Number of result columns */
+} RowShape;
+
+/*
+    Cached query result. Results are stored as native row objects and are valid while the versions of the tables read
+    by the query are unchanged.
+ */
+typedef struct QueryResult {
+    EjsArray        *rows;                              /* Result rows */
+    SqliteTable     *tables[ME_MAX_SQLITE_TABLES];      /* Tables read by the query */
+    uint64          versions[ME_MAX_SQLITE_TABLES];     /* Table versions when the query was run */
+    int             ntables;                            /* Number of tables read */
+    int             cacheable;                          /* Query only reads user tables */
+    MprTicks        expires;                            /* Expiry time. Zero if the result does not expire */
+    uint64          lastUse;                            /* Use sequence number for LRU eviction */
+} QueryResult;
+
+/*
+    Ejscript Sqlite class object
+ */
+typedef struct EjsSqlite {
+    EjsPot          pot;            /* Extends Object */
+    sqlite3         *sdb;           /* Sqlite handle of the attached connection */
+    Ejs             *ejs;           /* Interp reference */
+    SqliteConnection *conn;         /* Attached connection. Pooled connections are attached per operation */
+    SqlitePool      *pool;          /* Connection pool. Null if the database is closed or uses a private connection */
+    int             statements;     /* Number of open SqliteStatement objects using the attached connection */
+    int             memory;         /* In-memory database */
+    MprHash         *results;       /* Cached query results keyed by normalized SQL and parameters */
+    uint64          resultSeqno;    /* Sequence number for result LRU */
+} EjsSqlite;
+
+/*
+    Ejscript SqliteStatement class object
+ */
+typedef struct EjsSqliteStatement {
+    EjsObj          obj;            /* Base object */
+    EjsSqlite       *db;            /* Owning database */
+    SqliteConnection *conn;         /* Connection that prepared the statement */
+    sqlite3_stmt    *stmt;          /* Prepared statement */
+    RowShape        *shape;         /* Result row shape for the current execution */
+} EjsSqliteStatement;
+
+static int sqliteInitialized;
+static SqlitePool *pools;           /* List of connection pools */
+static MprMutex *poolLock;          /* Lock for the pool list and pools */
+static int poolsClosed;             /* Pooled connections have been closed for shutdown */
+
+static void initSqlite();
+static int authorize(void *arg, int action, cchar *arg1, cchar *arg2, cchar *dbName, cchar *trigger);
+static void tableUpdated(void *arg, int op, cchar *dbName, cchar *table, sqlite3_int64 rowid);
+
+/************************************ Code ************************************/
+/*
+    Open a new database connection and configure it once for all subsequent uses
+ */
+static SqliteConnection *openConnection(cchar *path, SqlitePool *pool)
+{
+    SqliteConnection    *conn;
+    sqlite3             *sdb;
+
+    sdb = 0;
+    if (sqlite3_open(path, &sdb) != SQLITE_OK) {
+        sqlite3_close(sdb);
+        return 0;
+    }
+    sqlite3_busy_timeout(sdb, ME_MAX_SQLITE_DURATION);
+    if (pool && *ME_SQLITE_JOURNAL_MODE) {
+        sqlite3_exec(sdb, "PRAGMA journal_mode=" ME_SQLITE_JOURNAL_MODE ";", NULL, NULL, NULL);
+    }
+    if ((conn = palloc(sizeof(SqliteConnection))) == 0) {
+        sqlite3_close(sdb);
+        return 0;
+    }
+    memset(conn, 0, sizeof(SqliteConnection));
+    conn->sdb = sdb;
+    conn->pool = pool;
+    conn->tables = pool ? &pool->tables : &conn->ownTables;
+    sqlite3_set_authorizer(sdb, authorize, conn);
+    sqlite3_update_hook(sdb, tableUpdated, conn);
+    return conn;
+}
+
+
+/*
+    Finalize the statements of statement objects freed by the garbage collector. The collector may run on another
+    thread while the connection is in use, so statements are queued and finalized here by the thread using the
+    connection. Returns the number of statements finalized.
+ */
+static int finalizeCollected(SqliteConnection *conn)
+{
+    sqlite3_stmt    **collected;
+    int             i, count;
+
+    mprLock(poolLock);
+    collected = conn->collected;
+    count = conn->numCollected;
+    conn->collected = 0;
+    conn->numCollected = conn->maxCollected = 0;
+    mprUnlock(poolLock);
+
+    for (i = 0; i < count; i++) {
+        sqlite3_finalize(collected[i]);
+    }
+    pfree(collected);
+    return count;
+}
+
+
+/*
+    Release a statement object's reference to its connection. Must be called with the pool lock held. Returns true 
+    if the connection is closed and should be freed.
+ */
+static int releaseStatement(SqliteConnection *conn)
+{
+    return --conn->prepared == 0 && conn->closed;
+}
+
+
+/*
+    Close a connection. If statement objects still reference the connection, freeing is deferred until they are
+    released.
+ */
+static void closeConnection(SqliteConnection *conn)
+{
+    SqliteTable     *tp, *next;
+    int             i, prepared;
+
+    finalizeCollected(conn);
+    if (conn->statements) {
+        for (i = 0; i < conn->numStatements; i++) {
+            sqlite3_finalize(conn->statements[i].stmt);
+            pfree(conn->statements[i].sql);
+        }
+        pfree(conn->statements);
+    }
+    conn->statements = 0;
+    conn->numStatements = 0;
+    for (tp = conn->ownTables; tp; tp = next) {
+        next = tp->next;
+        pfree(tp->name);
+        pfree(tp);
+    }
+    conn->ownTables = 0;
+    /* Sqlite defers the close if there are unfinalized statement objects */
+    sqlite3_set_authorizer(conn->sdb, NULL, NULL);
+    sqlite3_update_hook(conn->sdb, NULL, NULL);
+    sqlite3_close_v2(conn->sdb);
+
+    mprLock(poolLock);
+    conn->closed = 1;
+    prepared = conn->prepared;
+    mprUnlock(poolLock);
+    if (prepared == 0) {
+        pfree(conn);
+    }
+}
+
+
+/*
+    Get the pool for a database path. Must be called with the pool lock held.
+ */
+static SqlitePool *getPool(cchar *path)
+{
+    SqlitePool  *pool;
+
+    for (pool = pools; pool; pool = pool->next) {
+        if (strcmp(pool->path, path) == 0) {
+            return pool;
+        }
+    }
+    if ((pool = palloc(sizeof(SqlitePool))) == 0) {
+        return 0;
+    }
+    memset(pool, 0, sizeof(SqlitePool));
+    pool->path = palloc(slen(path) + 1);
+    pool->idle = palloc(sizeof(SqliteConnection*) * ME_MAX_SQLITE_CONNECTIONS);
+    if (pool->path == 0 || pool->idle == 0 || (pool->cond = mprCreateCond()) == 0) {
+        return 0;
+    }
+    mprAddRoot(pool->cond);
+    strcpy(pool->path, path);
+    pool->next = pools;
+    pools = pool;
+    return pool;
+}
+
+
+/*
+    Get the change version record for a table. Must be called with the pool lock held.
+ */
+static SqliteTable *getTable(SqliteConnection *conn, cchar *name)
+{
+    SqliteTable     *tp;
+
+    if (conn->tables == 0) {
+        return 0;
+    }
+    for (tp = *conn->tables; tp; tp = tp->next) {
+        if (strcmp(tp->name, name) == 0) {
+            return tp;
+        }
+    }
+    if ((tp = palloc(sizeof(SqliteTable))) == 0) {
+        return 0;
+    }
+    if ((tp->name = palloc(slen(name) + 1)) == 0) {
+        pfree(tp);
+        return 0;
+    }
+    strcpy(tp->name, name);
+    tp->version = 0;
+    tp->next = *conn->tables;
+    *conn->tables = tp;
+    return tp;
+}
+
+
+/*
+    Record that a table has been modified by a write on this connection. The change is published to other users of the
+    database once committed.
+ */
+static void markDirty(SqliteConnection *conn, cchar *table)
+{
+    SqliteTable     *tp;
+    int             i;
+
+    if (conn->dirtyAll) {
+        return;
+    }
+    for (i = 0; i < conn->numDirty; i++) {
+        if (strcmp(conn->dirty[i]->name, table) == 0) {
+            return;
+        }
+    }
+    if (conn->numDirty >= ME_MAX_SQLITE_TABLES) {
+        conn->dirtyAll = 1;
+        return;
+    }
+    mprLock(poolLock);
+    tp = getTable(conn, table);
+    mprUnlock(poolLock);
+    if (tp) {
+        conn->dirty[conn->numDirty++] = tp;
+    } else {
+        conn->dirtyAll = 1;
+    }
+}
+
+
+/*
+    Publish committed writes by incrementing the version of each modified table. This invalidates cached query results
+    that read the tables. Must only be called when the connection is not in a transaction.
+ */
+static void publishChanges(SqliteConnection *conn)
+{
+    SqliteTable     *tp;
+    int             i;
+
+    if (conn->numDirty == 0 && !conn->dirtyAll) {
+        return;
+    }
+    mprLock(poolLock);
+    if (conn->dirtyAll) {
+        for (tp = conn->tables ? *conn->tables : 0; tp; tp = tp->next) {
+            tp->version++;
+        }
+    } else {
+        for (i = 0; i < conn->numDirty; i++) {
+            conn->dirty[i]->version++;
+        }
+    }
+    mprUnlock(poolLock);
+    conn->numDirty = 0;
+    conn->dirtyAll = 0;
+}
+
+
+/*
+    Sqlite update hook. Called for each row inserted, updated or deleted.
+ */
+static void tableUpdated(void *arg, int op, cchar *dbName, cchar *table, sqlite3_int64 rowid)
+{
+    markDirty((SqliteConnection*) arg, table);
+}
+
+
+/*
+    Sqlite authorizer. Called when statements are prepared. Collects the tables read by queries to be cached and marks
+    tables modified by schema changes.
+ */
+static int authorize(void *arg, int action, cchar *arg1, cchar *arg2, cchar *dbName, cchar *trigger)
+{
+    SqliteConnection    *conn;
+    QueryResult         *qr;
+    SqliteTable         *tp;
+    int                 i;
+
+    conn = (SqliteConnection*) arg;
+    switch (action) {
+    case SQLITE_READ:
+        if ((qr = conn->collect) == 0 || !qr->cacheable) {
+            break;
+        }
+        if (sncmp(arg1, "sqlite_", 7) == 0 || qr->ntables >= ME_MAX_SQLITE_TABLES) {
+            qr->cacheable = 0;
+            break;
+        }
+        for (i = 0; i < qr->ntables; i++) {
+            if (strcmp(qr->tables[i]->name, arg1) == 0) {
+                return SQLITE_OK;
+            }
+        }
+        mprLock(poolLock);
+        tp = getTable(conn, arg1);
+        mprUnlock(poolLock);
+        if (tp) {
+            qr->tables[qr->ntables++] = tp;
+        } else {
+            qr->cacheable = 0;
+        }
+        break;
+
+    case SQLITE_DELETE:
+        /*
+            Disable the truncate optimization for "DELETE FROM table" which bypasses the update hook.
+            The delete still proceeds. Deletes from the schema tables and the delete check made when dropping a table
+            must not be ignored as that would silently skip the command.
+         */
+        if (conn->dropping) {
+            conn->dropping = 0;
+        } else if (sncmp(arg1, "sqlite_", 7) != 0) {
+            return SQLITE_IGNORE;
+        }
+        break;
+
+    case SQLITE_DROP_TABLE:
+    case SQLITE_DROP_TEMP_TABLE:
+        markDirty(conn, arg1);
+        conn->dropping = 1;
+        break;
+
+    case SQLITE_DROP_VIEW:
+    case SQLITE_DROP_TEMP_VIEW:
+        conn->dropping = 1;
+        break;
+
+    case SQLITE_ALTER_TABLE:
+        markDirty(conn, arg2);
+        break;
+    }
+    return SQLITE_OK;
+}
+
+
+/*
+    Check out a connection from the pool. If all connections are in use, wait briefly for one to be returned. 
+    Native code cannot yield to the garbage collector, so the wait is abandoned if a collection is required or if 
+    the wait exceeds ME_MAX_SQLITE_POOL_WAIT. In that case, an overflow connection is opened that will be closed 
+    rather than pooled when returned.
+ */
+static SqliteConnection *checkoutConnection(Ejs *ejs, SqlitePool *pool)
+{
+    SqliteConnection    *conn;
+    MprTicks            mark, elapsed;
+
+    mark = 0;
+    mprLock(poolLock);
+    while (pool->numIdle == 0 && pool->count >= ME_MAX_SQLITE_CONNECTIONS) {
+        if (mark == 0) {
+            mark = mprGetTicks();
+            pool->waits++;
+        } else if (mprGetElapsedTicks(mark) >= ME_MAX_SQLITE_POOL_WAIT || MPR->heap->mustYield) {
+            pool->overflows++;
+            break;
+        }
+        pool->waiting++;
+        mprUnlock(poolLock);
+        mprWaitForCond(pool->cond, 10);
+        mprLock(poolLock);
+        pool->waiting--;
+    }
+    if (mark) {
+        elapsed = mprGetElapsedTicks(mark);
+        pool->waitTime += elapsed;
+        pool->maxWait = max(pool->maxWait, elapsed);
+    }
+    pool->checkouts++;
+    if (pool->numIdle > 0) {
+        conn = pool->idle[--pool->numIdle];
+        mprUnlock(poolLock);
+        return conn;
+    }
+    pool->count++;
+    mprUnlock(poolLock);
+
+    if ((conn = openConnection(pool->path, pool)) == 0) {
+        mprLock(poolLock);
+        pool->count--;
+        mprUnlock(poolLock);
+        ejsThrowIOError(ejs, "Cannot open database %s", pool->path);
+    }
+    return conn;
+}
+
+
+/*
+    Return a connection to its pool. Connections with prepared statements still in use cannot be shared and are closed
+    once the statements are finalized. Open transactions are rolled back.
+ */
+static void checkinConnection(SqliteConnection *conn, int reuse)
+{
+    SqlitePool  *pool;
+
+    pool = conn->pool;
+    finalizeCollected(conn);
+    if (reuse && !sqlite3_get_autocommit(conn->sdb)) {
+        sqlite3_exec(conn->sdb, "ROLLBACK;", NULL, NULL, NULL);
+    }
+    publishChanges(conn);
+    mprLock(poolLock);
+    reuse = reuse && !poolsClosed && pool->count <= ME_MAX_SQLITE_CONNECTIONS;
+    if (reuse) {
+        pool->idle[pool->numIdle++] = conn;
+    } else {
+        pool->count--;
+    }
+    if (pool->waiting) {
+        mprSignalCond(pool->cond);
+    }
+    mprUnlock(poolLock);
+    if (!reuse) {
+        closeConnection(conn);
+    }
+}
+
+
+/*
+    Close idle pooled connections when the MPR is shutting down so that databases are cleanly closed. Connections 
+    returned after this are closed rather than pooled.
+ */
+static void terminateSqlite(int state, int how, int status)
+{
+    SqlitePool  *pool;
+
+    if (state < MPR_STOPPED) {
+        return;
+    }
+    mprLock(poolLock);
+    poolsClosed = 1;
+    for (pool = pools; pool; pool = pool->next) {
+        while (pool->numIdle > 0) {
+            closeConnection(pool->idle[--pool->numIdle]);
+            pool->count--;
+        }
+    }
+    mprUnlock(poolLock);
+}
+
+
+/*
+    Test if the connection has prepared statements other than those in the statement cache
+ */
+static int hasActiveStatements(SqliteConnection *conn)
+{
+    sqlite3_stmt    *stmt;
+    int             count;
+
+    count = 0;
+    for (stmt = sqlite3_next_stmt(conn->sdb, 0); stmt; stmt = sqlite3_next_stmt(conn->sdb, stmt)) {
+        if (++count > conn->numStatements) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+
+/*
+    Finalize collected statements on the attached connection and release their hold on the connection
+ */
+static void reapStatements(EjsSqlite *db)
+{
+    int     count;
+
+    if (db->conn && db->conn->numCollected > 0) {
+        count = finalizeCollected(db->conn);
+        db->statements = max(db->statements - count, 0);
+    }
+}
+
+
+/*
+    Attach a connection to the database object for an operation. Pooled connections are checked out as required.
+ */
+static int attachConnection(Ejs *ejs, EjsSqlite *db)
+{
+    if (db->conn) {
+        reapStatements(db);
+        return 1;
+    }
+    if (db->pool == 0) {
+        ejsThrowIOError(ejs, "Database is closed");
+        return 0;
+    }
+    if ((db->conn = checkoutConnection(ejs, db->pool)) == 0) {
+        return 0;
+    }
+    db->sdb = db->conn->sdb;
+    return 1;
+}
+
+
+/*
+    Detach a pooled connection after an operation and return it to the pool. The connection stays attached while a
+    transaction is open or prepared statement objects are using it. Committed writes are published.
+ */
+static void detachConnection(EjsSqlite *db)
+{
+    SqliteConnection    *conn;
+
+    conn = db->conn;
+    if (conn == 0 || !sqlite3_get_autocommit(conn->sdb)) {
+        return;
+    }
+    reapStatements(db);
+    publishChanges(conn);
+    if (conn->pool == 0 || db->statements > 0) {
+        return;
+    }
+    db->conn = 0;
+    db->sdb = 0;
+    checkinConnection(conn, 1);
+}
+
+
+/*
+    DB Constructor and also used for constructor for sub classes.
+
+    function Sqlite(options: Object)
+
+    Options forms:
+        string
+            file://name
+        path
+            filename
+        { name: path }
+ */
+static EjsObj *sqliteConstructor(Ejs *ejs, EjsSqlite *db, int argc, EjsObj **argv)
+{
+    EjsObj          *options;
+    cchar           *path;
+
+    db->ejs = ejs;
+    options = argv[0];
+    
+    if (!sqliteInitialized) {
+        initSqlite();
+    }
+    /*
+        TODO - this will create a database if it doesn't exist. Should have more control over creating databases.
+     */
+    if (ejsIs(ejs, options, Path) || ejsIs(ejs, options, String)) {
+        path = ejsToMulti(ejs, ejsToString(ejs, options));
+    } else {
+        path = ejsToMulti(ejs, ejsToString(ejs, ejsGetPropertyByName(ejs, options, EN("name"))));
+    }
+#if MEMORY_BASED_SQLITE
+    if (strncmp(path, "memory://", 9) == 0) {
+        if ((db->conn = palloc(sizeof(SqliteConnection))) == 0) {
+            ejsThrowMemoryError(ejs);
+            return 0;
+        }
+        memset(db->conn, 0, sizeof(SqliteConnection));
+        db->conn->sdb = db->sdb = (sqlite3*) (size_t) stoi(&path[9], 10, NULL);
+        db->conn->tables = &db->conn->ownTables;
+        db->memory = 1;
+
+    } else {
+#endif
+        db->memory = 0;
+        if (strncmp(path, "file://", 7) == 0) {
+            path += 7;
+        }
+        if (strstr(path, "://") == NULL) {
+            if (*path == '\0' || strcmp(path, ":memory:") == 0 || ME_MAX_SQLITE_CONNECTIONS <= 0) {
+                /* Temporary and in-memory databases are private to this object */
+                if ((db->conn = openConnection(path, NULL)) == 0) {
+                    ejsThrowIOError(ejs, "Cannot open database %s", path);
+                    return 0;
+                }
+                db->sdb = db->conn->sdb;
+            } else {
+                mprLock(poolLock);
+                db->pool = getPool(mprGetAbsPath(path));
+                mprUnlock(poolLock);
+                if (db->pool == 0) {
+                    ejsThrowMemoryError(ejs);
+                    return 0;
+                }
+                /* Open a connection now to validate the database */
+                if (!attachConnection(ejs, db)) {
+                    db->pool = 0;
+                    return 0;
+                }
+                detachConnection(db);
+            }
+        } else {
+            ejsThrowArgError(ejs, "Unknown SQLite database URI %s", path);
+            return 0;
+        }
+#if MEMORY_BASED_SQLITE
+    }
+#endif
+    return (EjsObj*) db;
+}
+
+
+/*
+    function close(): Void
+ */
+static int sqliteClose(Ejs *ejs, EjsSqlite *db, int argc, EjsObj **argv)
+{
+    SqliteConnection    *conn;
+
+    assert(db);
+
+    if ((conn = db->conn) != 0) {
+        if (db->memory) {
+            pfree(conn);
+        } else if (conn->pool) {
+            /* Statement objects that were not closed may have been collected by the garbage collector */
+            reapStatements(db);
+            checkinConnection(conn, sqlite3_get_autocommit(conn->sdb) && (db->statements == 0 || 
+                !hasActiveStatements(conn)));
+        } else {
+            closeConnection(conn);
+        }
+    }
+    db->conn = 0;
+    db->sdb = 0;
+    db->pool = 0;
+    db->statements = 0;
+    db->results = 0;
+    return 0;
+}
+
+
+/*
+    Lookup a cached prepared statement for the given SQL text
+ */
+static sqlite3_stmt *lookupStatement(SqliteConnection *conn, cchar *cmd, uint hash)
+{
+    CachedStatement     *cp;
+    int                 i;
+
+    for (i = 0; i < conn->numStatements; i++) {
+        cp = &conn->statements[i];
+        if (cp->hash == hash && strcmp(cp->sql, cmd) == 0) {
+            cp->lastUse = ++conn->useSeqno;
+            return cp->stmt;
+        }
+    }
+    return 0;
+}
+
+
+/*
+    Add a prepared statement to the cache. If the cache is full, the least recently used statement is finalized.
+    Returns false if the statement could not be cached and should be finalized by the caller.
+ */
+static int cacheStatement(SqliteConnection *conn, sqlite3_stmt *stmt, cchar *cmd, uint hash)
+{
+    CachedStatement     *cp;
+    char                *sql;
+    ssize               len;
+    int                 i;
+
+    if (ME_MAX_SQLITE_STATEMENTS <= 0) {
+        return 0;
+    }
+    len = slen(cmd);
+    if ((sql = palloc(len + 1)) == 0) {
+        return 0;
+    }
+    memcpy(sql, cmd, len + 1);
+    if (conn->statements == 0) {
+        if ((conn->statements = palloc(sizeof(CachedStatement) * ME_MAX_SQLITE_STATEMENTS)) == 0) {
+            pfree(sql);
+            return 0;
+        }
+    }
+    if (conn->numStatements < ME_MAX_SQLITE_STATEMENTS) {
+        cp = &conn->statements[conn->numStatements++];
+    } else {
+        cp = &conn->statements[0];
+        for (i = 1; i < conn->numStatements; i++) {
+            if (conn->statements[i].lastUse < cp->lastUse) {
+                cp = &conn->statements[i];
+            }
+        }
+        sqlite3_finalize(cp->stmt);
+        pfree(cp->sql);
+    }
+    cp->stmt = stmt;
+    cp->sql = sql;
+    cp->hash = hash;
+    cp->lastUse = ++conn->useSeqno;
+    return 1;
+}
+
+
+static void throwSqlError(Ejs *ejs, EjsSqlite *db)
+{
+    if (db->sdb && sqlite3_errcode(db->sdb) != SQLITE_OK) {
+        ejsThrowIOError(ejs, "SQL error: %s", sqlite3_errmsg(db->sdb));
+    } else {
+        ejsThrowIOError(ejs, "Unspecified SQL error");
+    }
+}
+
+
+/*
+    Bind a value to a statement parameter. Parameter indicies are origin 1.
+ */
+static int bindValue(Ejs *ejs, sqlite3_stmt *stmt, int index, EjsAny *vp)
+{
+    EjsByteArray    *ba;
+    MprNumber       n;
+    cchar           *str;
+
+    if (vp == 0 || !ejsIsDefined(ejs, vp)) {
+        return sqlite3_bind_null(stmt, index);
+
+    } else if (ejsIs(ejs, vp, Boolean)) {
+        return sqlite3_bind_int(stmt, index, vp == ESV(true));
+
+    } else if (ejsIs(ejs, vp, Number)) {
+        n = ejsGetNumber(ejs, vp);
+        if (n == (MprNumber) (int64) n) {
+            return sqlite3_bind_int64(stmt, index, (int64) n);
+        }
+        return sqlite3_bind_double(stmt, index, n);
+
+    } else if (ejsIs(ejs, vp, Date)) {
+        return sqlite3_bind_int64(stmt, index, ((EjsDate*) vp)->value);
+
+    } else if (ejsIs(ejs, vp, ByteArray)) {
+        ba = (EjsByteArray*) vp;
+        return sqlite3_bind_blob(stmt, index, &ba->value[ba->readPosition], (int) (ba->writePosition - ba->readPosition),
+            SQLITE_TRANSIENT);
+    }
+    str = ejsToMulti(ejs, vp);
+    return sqlite3_bind_text(stmt, index, str, -1, SQLITE_TRANSIENT);
+}
+
+
+/*
+    Bind parameters to a statement. Params may be an Array of positional parameters or an Object of named parameters.
+    Named parameters may use any of the SQLite parameter prefixes: ":name", "@name" or "$name".
+ */
+static int bindParams(Ejs *ejs, EjsSqlite *db, sqlite3_stmt *stmt, EjsAny *params)
+{
+    EjsArray    *ap;
+    cchar       *name;
+    int         count, i;
+
+    if (params == 0 || (count = sqlite3_bind_parameter_count(stmt)) == 0) {
+        return 0;
+    }
+    if (ejsIs(ejs, params, Array)) {
+        ap = (EjsArray*) params;
+        for (i = 0; i < count && i < ap->length; i++) {
+            if (bindValue(ejs, stmt, i + 1, ejsGetProperty(ejs, ap, i)) != SQLITE_OK) {
+                throwSqlError(ejs, db);
+                return EJS_ERR;
+            }
+        }
+    } else {
+        for (i = 1; i <= count; i++) {
+            if ((name = sqlite3_bind_parameter_name(stmt, i)) == 0) {
+                continue;
+            }
+            if (bindValue(ejs, stmt, i, ejsGetPropertyByName(ejs, params, EN(&name[1]))) != SQLITE_OK) {
+                throwSqlError(ejs, db);
+                return EJS_ERR;
+            }
+        }
+    }
+    return 0;
+}
+
+
+static void manageRowShape(RowShape *shape, int flags)
+{
+    if (flags & MPR_MANAGE_MARK) {
+        mprMark(shape->template);
+        mprMark(shape->slots);
+    }
+}
+
+
+/*
+    Compute the row shape for a prepared statement. Columns from tables other than the default (first) table are 
+    prefixed with the table name. If column names are duplicated, the first column wins.
+ */
+static RowShape *createRowShape(Ejs *ejs, sqlite3_stmt *stmt)
+{
+    RowShape    *shape;
+    EjsName     qname;
+    char        *tableName;
+    cchar       *colName, *defaultTableName;
+    int         i, len, ncol;
+
+    ncol = sqlite3_column_count(stmt);
+    if ((shape = mprAllocObj(RowShape, manageRowShape)) == 0) {
+        return 0;
+    }
+    if ((shape->slots = mprAlloc(sizeof(int) * max(ncol, 1))) == 0) {
+        return 0;
+    }
+    if ((shape->template = ejsCreatePot(ejs, ESV(Object), ncol)) == 0) {
+        return 0;
+    }
+    /* The property slots are pre-allocated */
+    shape->template->numProp = 0;
+    shape->ncol = ncol;
+    defaultTableName = 0;
+
+    for (i = 0; i < ncol; i++) {
+        tableName = (char*) sqlite3_column_table_name(stmt, i);
+        if (defaultTableName == 0) {
+            defaultTableName = tableName;
+        }
+        colName = sqlite3_column_name(stmt, i);
+
+        if (tableName == 0 || strcmp(tableName, defaultTableName) == 0) {
+            qname = EN(colName);
+        } else {
+            /*
+                Append the table name for columns from foreign tables. Convert to camel case (tableColumn)
+                Prefix with "_". ie. "_TableColumn"
+             */
+            len = (int) strlen(tableName) + 1;
+            tableName = sjoin("_", tableName, colName, NULL);
+            if (len > 3 && tableName[len - 1] == 's' && tableName[len - 2] == 'e' && tableName[len - 3] == 'i') {
+                tableName[len - 3] = 'y';
+                strcpy(&tableName[len - 2], colName);
+                len -= 2;
+            } else if (len > 2 && tableName[len - 1] == 's' && tableName[len - 2] == 'e') {
+                strcpy(&tableName[len - 2], colName);
+                len -= 2;
+            } else if (tableName[len - 1] == 's') {
+                strcpy(&tableName[len - 1], colName);
+                len--;
+            }
+            tableName[len] = toupper((uchar) tableName[len]);
+            qname = EN(tableName);
+        }
+        if (ejsLookupProperty(ejs, shape->template, qname) >= 0) {
+            shape->slots[i] = -1;
+        } else if ((shape->slots[i] = ejsSetPropertyByName(ejs, shape->template, qname, ESV(null))) < 0) {
+            ejsThrowIOError(ejs, "Cannot update query result set name");
+            return 0;
+        }
+    }
+    return shape;
+}
+
+
+/*
+    Convert a column value to the corresponding native Ejscript type
+ */
+static EjsAny *getColumnValue(Ejs *ejs, sqlite3_stmt *stmt, int col)
+{
+    EjsByteArray    *ba;
+    ssize           len;
+
+    switch (sqlite3_column_type(stmt, col)) {
+    case SQLITE_INTEGER:
+        return ejsCreateNumber(ejs, (MprNumber) sqlite3_column_int64(stmt, col));
+
+    case SQLITE_FLOAT:
+        return ejsCreateNumber(ejs, sqlite3_column_double(stmt, col));
+
+    case SQLITE_NULL:
+        return ESV(null);
+
+    case SQLITE_BLOB:
+        len = sqlite3_column_bytes(stmt, col);
+        if ((ba = ejsCreateByteArray(ejs, len)) == 0) {
+            return 0;
+        }
+        if (len > 0) {
+            memcpy(ba->value, sqlite3_column_blob(stmt, col), len);
+        }
+        ba->writePosition = len;
+        return ba;
+
+    default:
+        return ejsCreateStringFromMulti(ejs, (cchar*) sqlite3_column_text(stmt, col), sqlite3_column_bytes(stmt, col));
+    }
+}
+
+
+/*
+    Create an object for the current result row. The row is cloned from the shape template and column values are 
+    stored by slot.
+ */
+static EjsObj *createRow(Ejs *ejs, sqlite3_stmt *stmt, RowShape *shape)
+{
+    EjsObj      *row;
+    EjsAny      *value;
+    int         i;
+
+    if ((row = ejsClonePot(ejs, shape->template, 0)) == 0) {
+        return 0;
+    }
+    for (i = 0; i < shape->ncol; i++) {
+        if (shape->slots[i] < 0) {
+            continue;
+        }
+        if ((value = getColumnValue(ejs, stmt, i)) == 0) {
+            return 0;
+        }
+        ejsSetProperty(ejs, row, shape->slots[i], value);
+    }
+    return row;
+}
+
+
+/*
+    Run a prepared statement and store the result rows starting at index zero in the result array
+ */
+static int runStatement(Ejs *ejs, EjsSqlite *db, sqlite3_stmt *stmt, EjsAny *params, EjsArray *result)
+{
+    EjsObj      *row;
+    RowShape    *shape;
+    int         rc, rowNum;
+
+    if (bindParams(ejs, db, stmt, params) < 0) {
+        return EJS_ERR;
+    }
+    shape = 0;
+    for (rowNum = 0; (rc = sqlite3_step(stmt)) == SQLITE_ROW; rowNum++) {
+        if (shape == 0 && (shape = createRowShape(ejs, stmt)) == 0) {
+            return EJS_ERR;
+        }
+        if ((row = createRow(ejs, stmt, shape)) == 0) {
+            return EJS_ERR;
+        }
+        if (ejsSetProperty(ejs, result, rowNum, row) < 0) {
+            ejsThrowIOError(ejs, "Cannot update query result set");
+            return EJS_ERR;
+        }
+    }
+    if (rc != SQLITE_DONE) {
+        throwSqlError(ejs, db);
+        return EJS_ERR;
+    }
+    return 0;
+}
+
+
+/*
+    Run a SQL command on the attached connection.
+    Will support multiple sql cmds but will only return one result table. Single statement commands are prepared once
+    and cached for reuse.
+ */
+static EjsArray *runSql(Ejs *ejs, EjsSqlite *db, cchar *cmd, EjsAny *params)
+{
+    sqlite3_stmt    *stmt;
+    EjsArray        *result;
+    cchar           *next, *tail;
+    uint            hash;
+    int             rc;
+
+    if ((result = ejsCreateArray(ejs, 0)) == 0) {
+        return 0;
+    }
+    hash = shash(cmd, slen(cmd));
+    if ((stmt = lookupStatement(db->conn, cmd, hash)) != 0) {
+        rc = runStatement(ejs, db, stmt, params, result);
+        sqlite3_reset(stmt);
+        sqlite3_clear_bindings(stmt);
+        return (rc < 0) ? 0 : result;
+    }
+    for (next = cmd; next && *next; next = tail) {
+        stmt = 0;
+        if (sqlite3_prepare_v2(db->sdb, next, -1, &stmt, &tail) != SQLITE_OK) {
+            throwSqlError(ejs, db);
+            return 0;
+        }
+        if (stmt == 0) {
+            /* Comment or white space */
+            continue;
+        }
+        while (isspace((uchar) *tail)) {
+            tail++;
+        }
+        rc = runStatement(ejs, db, stmt, params, result);
+        if (rc == 0 && next == cmd && *tail == '\0' && cacheStatement(db->conn, stmt, cmd, hash)) {
+            sqlite3_reset(stmt);
+            sqlite3_clear_bindings(stmt);
+        } else {
+            sqlite3_finalize(stmt);
+        }
+        if (rc < 0) {
+            return 0;
+        }
+    }
+    return result;
+}
+
+
+/*
+    function sql(cmd: String, params: Object? = null): Array
+ */
+static EjsArray *sqliteSql(Ejs *ejs, EjsSqlite *db, int argc, EjsObj **argv)
+{
+    EjsArray    *result;
+    EjsAny      *params;
+    cchar       *cmd;
+
+    assert(ejs);
+    assert(db);
+
+    if (!attachConnection(ejs, db)) {
+        return 0;
+    }
+    cmd = ejsToMulti(ejs, argv[0]);
+    params = (argc >= 2 && ejsIsDefined(ejs, argv[1])) ? argv[1] : 0;
+    result = runSql(ejs, db, cmd, params);
+    detachConnection(db);
+    return result;
+}
+
+
+static void manageQueryResult(QueryResult *qr, int flags)
+{
+    if (flags & MPR_MANAGE_MARK) {
+        mprMark(qr->rows);
+    }
+}
+
+
+/*
+    Append a parameter value to a query cache key. Returns false if the value cannot be used in a key.
+ */
+static int putKeyValue(Ejs *ejs, MprBuf *buf, EjsAny *vp)
+{
+    MprNumber   n;
+    uint64      bits;
+    cchar       *str;
+
+    if (vp == 0 || !ejsIsDefined(ejs, vp)) {
+        mprPutCharToBuf(buf, 'z');
+
+    } else if (ejsIs(ejs, vp, Boolean)) {
+        mprPutCharToBuf(buf, (vp == ESV(true)) ? 't' : 'f');
+
+    } else if (ejsIs(ejs, vp, Number)) {
+        n = ejsGetNumber(ejs, vp);
+        if (n == (MprNumber) (int64) n) {
+            mprPutToBuf(buf, "i%Ld", (int64) n);
+        } else {
+            memcpy(&bits, &n, sizeof(bits));
+            mprPutToBuf(buf, "d%Lx", bits);
+        }
+    } else if (ejsIs(ejs, vp, Date)) {
+        mprPutToBuf(buf, "i%Ld", (int64) ((EjsDate*) vp)->value);
+
+    } else if (ejsIs(ejs, vp, String)) {
+        str = ejsToMulti(ejs, vp);
+        mprPutToBuf(buf, "s%d:", (int) slen(str));
+        mprPutStringToBuf(buf, str);
+
+    } else {
+        return 0;
+    }
+    return 1;
+}
+
+
+/*
+    Create a query cache key from the SQL command and parameters. White space outside of quoted strings is collapsed
+    and trailing semicolons are removed so that equivalent commands share a key. Returns null if the parameters 
+    cannot be used in a key.
+ */
+static char *getQueryKey(Ejs *ejs, cchar *cmd, EjsAny *params)
+{
+    MprBuf      *buf;
+    EjsArray    *ap;
+    EjsName     qname;
+    cchar       *cp;
+    int         count, i, quote, space;
+
+    buf = mprCreateBuf(slen(cmd) + 32, -1);
+    quote = 0;
+    space = 0;
+    for (cp = cmd; *cp; cp++) {
+        if (quote) {
+            if (*cp == quote) {
+                quote = 0;
+            }
+        } else if (isspace((uchar) *cp)) {
+            space = 1;
+            continue;
+        } else if (*cp == '\'' || *cp == '"' || *cp == '`') {
+            quote = *cp;
+        } else if (*cp == '[') {
+            quote = ']';
+        }
+        if (space && mprGetBufLength(buf) > 0) {
+            mprPutCharToBuf(buf, ' ');
+        }
+        space = 0;
+        mprPutCharToBuf(buf, *cp);
+    }
+    while (mprGetBufLength(buf) > 0 && (mprLookAtLastCharInBuf(buf) == ';' || mprLookAtLastCharInBuf(buf) == ' ')) {
+        mprAdjustBufEnd(buf, -1);
+    }
+    if (params) {
+        if (ejsIs(ejs, params, Array)) {
+            ap = (EjsArray*) params;
+            for (i = 0; i < ap->length; i++) {
+                mprPutCharToBuf(buf, '\001');
+                if (!putKeyValue(ejs, buf, ejsGetProperty(ejs, ap, i))) {
+                    return 0;
+                }
+            }
+        } else {
+            count = ejsGetLength(ejs, params);
+            for (i = 0; i < count; i++) {
+                qname = ejsGetPropertyName(ejs, params, i);
+                if (qname.name == 0) {
+                    continue;
+                }
+                mprPutToBuf(buf, "\001%s=", ejsToMulti(ejs, qname.name));
+                if (!putKeyValue(ejs, buf, ejsGetProperty(ejs, params, i))) {
+                    return 0;
+                }
+            }
+        }
+    }
+    mprAddNullToBuf(buf);
+    return mprGetBufStart(buf);
+}
+
+
+/*
+    Lookup a cached query result. The result is discarded if it has expired or if any table read by the query has 
+    been modified since the result was cached.
+ */
+static QueryResult *lookupResult(EjsSqlite *db, cchar *key)
+{
+    QueryResult     *qr;
+    int             i, valid;
+
+    if (db->results == 0 || (qr = mprLookupKey(db->results, key)) == 0) {
+        return 0;
+    }
+    valid = qr->expires == 0 || qr->expires > mprGetTicks();
+    if (valid) {
+        mprLock(poolLock);
+        for (i = 0; i < qr->ntables; i++) {
+            if (qr->tables[i]->version != qr->versions[i]) {
+                valid = 0;
+                break;
+            }
+        }
+        mprUnlock(poolLock);
+    }
+    if (!valid) {
+        mprRemoveKey(db->results, key);
+        return 0;
+    }
+    qr->lastUse = ++db->resultSeqno;
+    return qr;
+}
+
+
+/*
+    Test if a table has a rowid. Writes to WITHOUT ROWID tables do not invoke the update hook, so queries reading them
+    cannot be cached. The table is treated as having no rowid unless every rowid alias resolves.
+ */
+static int hasRowid(sqlite3 *sdb, cchar *table)
+{
+    static cchar    *aliases[] = { "rowid", "oid", "_rowid_" };
+    int             i;
+
+    for (i = 0; i < (int) (sizeof(aliases) / sizeof(*aliases)); i++) {
+        if (sqlite3_table_column_metadata(sdb, NULL, table, aliases[i], NULL, NULL, NULL, NULL, NULL) != SQLITE_OK) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
 
-/*********************************** Locals ***********************************/
 /*
-    Map allocation and mutex routines to use ejscript version.
+    Prepare (but do not run) the statements of a query to determine the tables it reads. The current table versions
+    are captured before the query is run so that any write committed while running the query will invalidate the 
+    result. Returns false if the query cannot be cached.
  */
-#define MAP_ALLOC   1
-#define MAP_MUTEXES 0
+static int collectTables(EjsSqlite *db, cchar *cmd, QueryResult *qr)
+{
+    SqliteConnection    *conn;
+    sqlite3_stmt        *stmt;
+    cchar               *next, *tail;
+    int                 i;
+
+    conn = db->conn;
+    qr->ntables = 0;
+    qr->cacheable = 1;
+    conn->collect = qr;
+    for (next = cmd; next && *next && qr->cacheable; next = tail) {
+        stmt = 0;
+        if (sqlite3_prepare_v2(db->sdb, next, -1, &stmt, &tail) != SQLITE_OK) {
+            qr->cacheable = 0;
+        } else if (stmt && !sqlite3_stmt_readonly(stmt)) {
+            qr->cacheable = 0;
+        }
+        sqlite3_finalize(stmt);
+    }
+    conn->collect = 0;
+    if (!qr->cacheable || qr->ntables == 0) {
+        return 0;
+    }
+    for (i = 0; i < qr->ntables; i++) {
+        if (!hasRowid(db->sdb, qr->tables[i]->name)) {
+            return 0;
+        }
+    }
+    mprLock(poolLock);
+    for (i = 0; i < qr->ntables; i++) {
+        qr->versions[i] = qr->tables[i]->version;
+    }
+    mprUnlock(poolLock);
+    return 1;
+}
 
-#define THREAD_STYLE SQLITE_CONFIG_MULTITHREAD
-//#define THREAD_STYLE SQLITE_CONFIG_SERIALIZED
 
 /*
-    Ejscript Sqlite class object
+    Save a query result in the cache. If the cache is full, the least recently used result is discarded.
  */
-typedef struct EjsSqlite {
-    EjsPot          pot;            /* Extends Object */
-    sqlite3         *sdb;           /* Sqlite handle */
-    Ejs             *ejs;           /* Interp reference */
-    int             memory;         /* In-memory database */
-} EjsSqlite;
+static void saveResult(EjsSqlite *db, cchar *key, QueryResult *qr, EjsArray *rows, int lifespan)
+{
+    MprKey          *kp, *oldest;
+    QueryResult     *rp;
 
-static int sqliteInitialized;
+    if (db->results == 0 && (db->results = mprCreateHash(0, 0)) == 0) {
+        return;
+    }
+    if (mprGetHashLength(db->results) >= ME_MAX_SQLITE_RESULTS) {
+        oldest = 0;
+        for (ITERATE_KEYS(db->results, kp)) {
+            rp = (QueryResult*) kp->data;
+            if (oldest == 0 || rp->lastUse < ((QueryResult*) oldest->data)->lastUse) {
+                oldest = kp;
+            }
+        }
+        if (oldest) {
+            mprRemoveKey(db->results, oldest->key);
+        }
+    }
+    qr->rows = rows;
+    qr->expires = (lifespan > 0) ? (mprGetTicks() + (MprTicks) lifespan * TPS) : 0;
+    qr->lastUse = ++db->resultSeqno;
+    mprAddKey(db->results, key, qr);
+}
 
-static void initSqlite();
 
-/************************************ Code ************************************/
 /*
-    DB Constructor and also used for constructor for sub classes.
+    Copy cached result rows so callers may modify the returned rows without changing the cache
+ */
+static EjsArray *copyResult(Ejs *ejs, EjsArray *rows)
+{
+    EjsArray    *result;
+    int         i;
 
-    function Sqlite(options: Object)
+    if ((result = ejsCreateArray(ejs, rows->length)) == 0) {
+        return 0;
+    }
+    for (i = 0; i < rows->length; i++) {
+        if ((result->data[i] = ejsClonePot(ejs, rows->data[i], 0)) == 0) {
+            return 0;
+        }
+    }
+    return result;
+}
 
-    Options forms:
-        string
-            file://name
-        path
-            filename
-        { name: path }
+
+/*
+    Run a query and cache the result rows. Subsequent calls with the same normalized command and parameters return
+    a copy of the cached rows without accessing the database. Cached results are invalidated when writes to any table
+    read by the query are committed by any connection to the database in this process.
+
+    function cachedSql(cmd: String, params: Object? = null, lifespan: Number = 0): Array
  */
-static EjsObj *sqliteConstructor(Ejs *ejs, EjsSqlite *db, int argc, EjsObj **argv)
+static EjsArray *sqliteCachedSql(Ejs *ejs, EjsSqlite *db, int argc, EjsObj **argv)
 {
-    sqlite3         *sdb;
-    EjsObj          *options;
-    cchar           *path;
+    SqliteConnection    *conn;
+    QueryResult         *qr;
+    EjsArray            *result;
+    EjsAny              *params;
+    cchar               *cmd, *key;
+    int                 cacheable, lifespan;
+
+    params = (argc >= 2 && ejsIsDefined(ejs, argv[1])) ? argv[1] : 0;
+    lifespan = (argc >= 3) ? ejsGetInt(ejs, argv[2]) : 0;
+
+    /* Bypass the cache inside transactions and while writes are unpublished so the caller sees its own changes */
+    conn = db->conn;
+    cacheable = conn == 0 || (sqlite3_get_autocommit(conn->sdb) && conn->numDirty == 0 && !conn->dirtyAll);
+    if (cacheable) {
+        cmd = ejsToMulti(ejs, argv[0]);
+        if ((key = getQueryKey(ejs, cmd, params)) != 0 && (qr = lookupResult(db, key)) != 0) {
+            return copyResult(ejs, qr->rows);
+        }
+    }
+    if (!attachConnection(ejs, db)) {
+        return 0;
+    }
+    cmd = ejsToMulti(ejs, argv[0]);
+    key = 0;
+    qr = 0;
+    if (cacheable && (key = getQueryKey(ejs, cmd, params)) != 0) {
+        if ((qr = mprAllocObj(QueryResult, manageQueryResult)) == 0 || !collectTables(db, cmd, qr)) {
+            qr = 0;
+        }
+    }
+    result = runSql(ejs, db, cmd, params);
+    detachConnection(db);
+    if (result && qr && result->length <= ME_MAX_SQLITE_RESULT_ROWS) {
+        saveResult(db, key, qr, result, lifespan);
+        return copyResult(ejs, result);
+    }
+    return result;
+}
 
-    sdb = 0;
-    db->ejs = ejs;
-    options = argv[0];
-    
+
+/*
+    Get connection pool statistics. Returns an object hash indexed by database path.
+
+    static function poolStats(): Object
+ */
+static EjsObj *sqlitePoolStats(Ejs *ejs, EjsObj *unused, int argc, EjsObj **argv)
+{
+    SqlitePool  *pool;
+    EjsObj      *result, *stats;
+
+    if ((result = ejsCreateEmptyPot(ejs)) == 0) {
+        return 0;
+    }
     if (!sqliteInitialized) {
-        initSqlite();
+        return result;
     }
-    /*
-        TODO - this will create a database if it doesn't exist. Should have more control over creating databases.
-     */
-    if (ejsIs(ejs, options, Path) || ejsIs(ejs, options, String)) {
-        path = ejsToMulti(ejs, ejsToString(ejs, options));
-    } else {
-        path = ejsToMulti(ejs, ejsToString(ejs, ejsGetPropertyByName(ejs, options, EN("name"))));
+    mprLock(poolLock);
+    for (pool = pools; pool; pool = pool->next) {
+        if ((stats = ejsCreateEmptyPot(ejs)) == 0) {
+            break;
+        }
+        ejsSetPropertyByName(ejs, stats, EN("connections"), ejsCreateNumber(ejs, pool->count));
+        ejsSetPropertyByName(ejs, stats, EN("idle"), ejsCreateNumber(ejs, pool->numIdle));
+        ejsSetPropertyByName(ejs, stats, EN("inUse"), ejsCreateNumber(ejs, pool->count - pool->numIdle));
+        ejsSetPropertyByName(ejs, stats, EN("waiting"), ejsCreateNumber(ejs, pool->waiting));
+        ejsSetPropertyByName(ejs, stats, EN("checkouts"), ejsCreateNumber(ejs, (MprNumber) pool->checkouts));
+        ejsSetPropertyByName(ejs, stats, EN("waits"), ejsCreateNumber(ejs, (MprNumber) pool->waits));
+        ejsSetPropertyByName(ejs, stats, EN("overflows"), ejsCreateNumber(ejs, (MprNumber) pool->overflows));
+        ejsSetPropertyByName(ejs, stats, EN("waitTime"), ejsCreateNumber(ejs, (MprNumber) pool->waitTime));
+        ejsSetPropertyByName(ejs, stats, EN("maxWait"), ejsCreateNumber(ejs, (MprNumber) pool->maxWait));
+        ejsSetPropertyByName(ejs, result, EN(pool->path), stats);
     }
-#if MEMORY_BASED_SQLITE
-    if (strncmp(path, "memory://", 9) == 0) {
-        sdb = (sqlite3*) (size_t) stoi(&path[9], 10, NULL);
+    mprUnlock(poolLock);
+    return result;
+}
 
+
+/*
+    Run a single statement once for each set of parameters. If the database is not already in a transaction, the 
+    batch is run inside a transaction so that the rows are committed with one write.
+ */
+static EjsNumber *runBatch(Ejs *ejs, EjsSqlite *db, cchar *cmd, EjsArray *list, EjsArray *rowids)
+{
+    sqlite3_stmt    *stmt;
+    EjsAny          *params;
+    cchar           *tail;
+    uint            hash;
+    int64           changes;
+    int             cached, i, rc, transaction;
+
+    hash = shash(cmd, slen(cmd));
+    if ((stmt = lookupStatement(db->conn, cmd, hash)) != 0) {
+        cached = 1;
     } else {
-#endif
-        db->memory = 0;
-        if (strncmp(path, "file://", 7) == 0) {
-            path += 7;
+        cached = 0;
+        if (sqlite3_prepare_v2(db->sdb, cmd, -1, &stmt, &tail) != SQLITE_OK) {
+            throwSqlError(ejs, db);
+            return 0;
         }
-        if (strstr(path, "://") == NULL) {
-            if (sqlite3_open(path, &sdb) != SQLITE_OK) {
-                ejsThrowIOError(ejs, "Cannot open database %s", path);
-                return 0;
-            }
-            sqlite3_soft_heap_limit(ME_MAX_SQLITE_MEM);
-            sqlite3_busy_timeout(sdb, ME_MAX_SQLITE_DURATION);
-
-        } else {
-            ejsThrowArgError(ejs, "Unknown SQLite database URI %s", path);
+        while (tail && isspace((uchar) *tail)) {
+            tail++;
+        }
+        if (stmt == 0 || (tail && *tail)) {
+            sqlite3_finalize(stmt);
+            ejsThrowArgError(ejs, "Batch command must be a single SQL statement");
             return 0;
         }
-#if MEMORY_BASED_SQLITE
     }
-#endif
-    db->sdb = sdb;
-    return (EjsObj*) db;
+    transaction = sqlite3_get_autocommit(db->sdb);
+    if (transaction && sqlite3_exec(db->sdb, "BEGIN TRANSACTION;", NULL, NULL, NULL) != SQLITE_OK) {
+        throwSqlError(ejs, db);
+        if (!cached) {
+            sqlite3_finalize(stmt);
+        }
+        return 0;
+    }
+    changes = 0;
+    rc = SQLITE_DONE;
+    for (i = 0; i < list->length; i++) {
+        params = ejsGetProperty(ejs, list, i);
+        sqlite3_reset(stmt);
+        sqlite3_clear_bindings(stmt);
+        if (bindParams(ejs, db, stmt, ejsIsDefined(ejs, params) ? params : 0) < 0) {
+            rc = SQLITE_ERROR;
+            break;
+        }
+        while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) { }
+        if (rc != SQLITE_DONE) {
+            throwSqlError(ejs, db);
+            break;
+        }
+        changes += sqlite3_changes(db->sdb);
+        if (rowids) {
+            ejsSetProperty(ejs, rowids, i, ejsCreateNumber(ejs, (MprNumber) sqlite3_last_insert_rowid(db->sdb)));
+        }
+    }
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+    if (!cached && !cacheStatement(db->conn, stmt, cmd, hash)) {
+        sqlite3_finalize(stmt);
+    }
+    if (transaction) {
+        if (rc != SQLITE_DONE) {
+            sqlite3_exec(db->sdb, "ROLLBACK;", NULL, NULL, NULL);
+        } else if (sqlite3_exec(db->sdb, "COMMIT;", NULL, NULL, NULL) != SQLITE_OK) {
+            throwSqlError(ejs, db);
+            sqlite3_exec(db->sdb, "ROLLBACK;", NULL, NULL, NULL);
+            return 0;
+        }
+    }
+    return (rc == SQLITE_DONE) ? ejsCreateNumber(ejs, (MprNumber) changes) : 0;
 }
 
 
 /*
-    function close(): Void
+    function batch(cmd: String, params: Array, rowids: Array? = null): Number
  */
-static int sqliteClose(Ejs *ejs, EjsSqlite *db, int argc, EjsObj **argv)
+static EjsNumber *sqliteBatch(Ejs *ejs, EjsSqlite *db, int argc, EjsObj **argv)
 {
-    assert(ejs);
-    assert(db);
+    EjsNumber   *result;
+    EjsArray    *rowids;
+    cchar       *cmd;
 
-    if (db->sdb && !db->memory) {
-        sqlite3_close(db->sdb);
-        db->sdb = 0;
+    if (!attachConnection(ejs, db)) {
+        return 0;
     }
-    return 0;
+    cmd = ejsToMulti(ejs, argv[0]);
+    rowids = (argc >= 3 && ejsIs(ejs, argv[2], Array)) ? (EjsArray*) argv[2] : 0;
+    result = runBatch(ejs, db, cmd, (EjsArray*) argv[1], rowids);
+    detachConnection(db);
+    return result;
 }
 
 
 /*
-    function sql(cmd: String): Array
-
-    Will support multiple sql cmds but will only return one result table.
+    function prepare(cmd: String): SqliteStatement
  */
-static EjsObj *sqliteSql(Ejs *ejs, EjsSqlite *db, int argc, EjsObj **argv)
+static EjsSqliteStatement *sqlitePrepare(Ejs *ejs, EjsSqlite *db, int argc, EjsObj **argv)
 {
-    sqlite3         *sdb;
-    sqlite3_stmt    *stmt;
-    EjsArray        *result;
-    EjsObj          *row;
-    EjsObj          *svalue;
-    EjsName         qname;
-    char            *tableName;
-    cchar           *tail, *colName, *cmd, *value, *defaultTableName;
-    int             i, ncol, rc, retries, rowNum, len;
-
-    assert(ejs);
-    assert(db);
+    EjsSqliteStatement  *sp;
+    sqlite3_stmt        *stmt;
+    cchar               *cmd;
 
+    if (!attachConnection(ejs, db)) {
+        return 0;
+    }
     cmd = ejsToMulti(ejs, argv[0]);
-    retries = 0;
-    sdb = db->sdb;
-    if (sdb == 0) {
+    stmt = 0;
+    if (sqlite3_prepare_v2(db->sdb, cmd, -1, &stmt, NULL) != SQLITE_OK || stmt == 0) {
+        if (stmt == 0 && sqlite3_errcode(db->sdb) == SQLITE_OK) {
+            ejsThrowArgError(ejs, "Empty SQL statement");
+        } else {
+            throwSqlError(ejs, db);
+        }
+        detachConnection(db);
+        return 0;
+    }
+    /* The connection remains attached to the database object until the statement is closed */
+    if ((sp = ejsCreateObj(ejs, ejsGetTypeByName(ejs, N("ejs.db.sqlite", "SqliteStatement")), 0)) == 0) {
+        sqlite3_finalize(stmt);
+        detachConnection(db);
+        return 0;
+    }
+    sp->db = db;
+    sp->conn = db->conn;
+    sp->stmt = stmt;
+    db->statements++;
+    mprLock(poolLock);
+    db->conn->prepared++;
+    mprUnlock(poolLock);
+    return sp;
+}
+
+
+/*********************************** Statement ********************************/
+
+static int checkStatement(Ejs *ejs, EjsSqliteStatement *sp)
+{
+    if (sp->stmt == 0) {
+        ejsThrowStateError(ejs, "Statement is closed");
+        return 0;
+    }
+    if (sp->db->sdb == 0) {
         ejsThrowIOError(ejs, "Database is closed");
         return 0;
     }
-    result = ejsCreateArray(ejs, 0);
-    if (result == 0) {
+    return 1;
+}
+
+
+/*
+    function bind(...params): SqliteStatement
+ */
+static EjsSqliteStatement *stmtBind(Ejs *ejs, EjsSqliteStatement *sp, int argc, EjsObj **argv)
+{
+    EjsArray    *args;
+    EjsAny      *params;
+
+    if (!checkStatement(ejs, sp)) {
+        return 0;
+    }
+    args = (EjsArray*) argv[0];
+    params = args;
+    if (args->length == 1 && (ejsIs(ejs, args->data[0], Array) || 
+            (ejsIsPot(ejs, args->data[0]) && TYPE(args->data[0]) == ESV(Object)))) {
+        params = args->data[0];
+    }
+    sqlite3_reset(sp->stmt);
+    sqlite3_clear_bindings(sp->stmt);
+    sp->shape = 0;
+    if (bindParams(ejs, sp->db, sp->stmt, params) < 0) {
         return 0;
     }
-    rc = SQLITE_OK;
-    while (cmd && *cmd && (rc == SQLITE_OK || (rc == SQLITE_SCHEMA && ++retries < 2))) {
-        stmt = 0;
-        rc = sqlite3_prepare_v2(sdb, cmd, -1, &stmt, &tail);
-        if (rc != SQLITE_OK) {
-            continue;
-        }
-        if (stmt == 0) {
-            /* Comment or white space */
-            cmd = tail;
-            continue;
+    return sp;
+}
+
+
+/*
+    function close(): Void
+ */
+static EjsObj *stmtClose(Ejs *ejs, EjsSqliteStatement *sp, int argc, EjsObj **argv)
+{
+    int     release;
+
+    if (sp->stmt) {
+        sqlite3_finalize(sp->stmt);
+        sp->stmt = 0;
+        mprLock(poolLock);
+        release = releaseStatement(sp->conn);
+        mprUnlock(poolLock);
+        if (release) {
+            /* The database was closed before the statement */
+            pfree(sp->conn);
+        } else if (sp->db->statements > 0) {
+            sp->db->statements--;
+            detachConnection(sp->db);
         }
-        defaultTableName = 0;
-        ncol = sqlite3_column_count(stmt);
-        for (rowNum = 0; ; rowNum++) {
-            if (sqlite3_step(stmt) == SQLITE_ROW) {
-                row = ejsCreateEmptyPot(ejs);
-                if (row == 0) {
-                    sqlite3_finalize(stmt);
-                    return 0;
-                }
-                if (ejsSetProperty(ejs, (EjsObj*) result, rowNum, (EjsObj*) row) < 0) {
-                    ejsThrowIOError(ejs, "Cannot update query result set");
-                    return 0;
-                }
-                for (i = 0; i < ncol; i++) {
-                    tableName = (char*) sqlite3_column_table_name(stmt, i);
-                    if (defaultTableName == 0) {
-                        defaultTableName = tableName;
-                    }
-                    colName = sqlite3_column_name(stmt, i);
-                    value = (cchar*) sqlite3_column_text(stmt, i);
-
-                    if (tableName == 0 || strcmp(tableName, defaultTableName) == 0) {
-                        qname = EN(colName);
-                    } else {
-                        /*
-                            Append the table name for columns from foreign tables. Convert to camel case (tableColumn)
-                            Prefix with "_". ie. "_TableColumn"
-                         */
-                        len = (int) strlen(tableName) + 1;
-                        tableName = sjoin("_", tableName, colName, NULL);
-                        if (len > 3 && tableName[len - 1] == 's' && tableName[len - 2] == 'e' && tableName[len - 3] == 'i') {
-                            tableName[len - 3] = 'y';
-                            strcpy(&tableName[len - 2], colName);
-                            len -= 2;
-                        } else if (len > 2 && tableName[len - 1] == 's' && tableName[len - 2] == 'e') {
-                            strcpy(&tableName[len - 2], colName);
-                            len -= 2;
-                        } else if (tableName[len - 1] == 's') {
-                            strcpy(&tableName[len - 1], colName);
-                            len--;
-                        }
-                        tableName[len] = toupper((uchar) tableName[len]);
-                        qname = EN(tableName);
-                    }
-                    if (ejsLookupProperty(ejs, (EjsObj*) row, qname) < 0) {
-                        svalue = (EjsObj*) ejsCreateStringFromMulti(ejs, value, slen(value));
-                        if (ejsSetPropertyByName(ejs, (EjsObj*) row, qname, svalue) < 0) {
-                            ejsThrowIOError(ejs, "Cannot update query result set name");
-                            return 0;
-                        }
-                    }
-                }
-            } else {
-                rc = sqlite3_finalize(stmt);
-                stmt = 0;
-                if (rc != SQLITE_SCHEMA) {
-                    retries = 0;
-                    for (cmd = tail; isspace((uchar) *cmd); cmd++) {
-                        ;
-                    }
-                }
-                break;
+        sp->conn = 0;
+    }
+    return 0;
+}
+
+
+/*
+    function reset(): Void
+ */
+static EjsObj *stmtReset(Ejs *ejs, EjsSqliteStatement *sp, int argc, EjsObj **argv)
+{
+    if (checkStatement(ejs, sp)) {
+        sqlite3_reset(sp->stmt);
+        sp->shape = 0;
+    }
+    return 0;
+}
+
+
+/*
+    function get sql(): String
+ */
+static EjsString *stmtSql(Ejs *ejs, EjsSqliteStatement *sp, int argc, EjsObj **argv)
+{
+    if (sp->stmt == 0) {
+        return ESV(null);
+    }
+    return ejsCreateStringFromMulti(ejs, sqlite3_sql(sp->stmt), slen(sqlite3_sql(sp->stmt)));
+}
+
+
+/*
+    function step(): Object?
+ */
+static EjsObj *stmtStep(Ejs *ejs, EjsSqliteStatement *sp, int argc, EjsObj **argv)
+{
+    int     rc;
+
+    if (!checkStatement(ejs, sp)) {
+        return 0;
+    }
+    if ((rc = sqlite3_step(sp->stmt)) == SQLITE_ROW) {
+        if (sp->shape == 0 || sp->shape->ncol != sqlite3_column_count(sp->stmt)) {
+            if ((sp->shape = createRowShape(ejs, sp->stmt)) == 0) {
+                return 0;
             }
         }
+        return createRow(ejs, sp->stmt, sp->shape);
+    } else if (rc == SQLITE_DONE) {
+        sp->shape = 0;
+        if (sqlite3_get_autocommit(sp->db->sdb)) {
+            publishChanges(sp->db->conn);
+        }
+        return ESV(null);
     }
-    if (stmt) {
-        rc = sqlite3_finalize(stmt);
+    sp->shape = 0;
+    throwSqlError(ejs, sp->db);
+    sqlite3_reset(sp->stmt);
+    return 0;
+}
+
+
+static EjsObj *nextRow(Ejs *ejs, EjsIterator *ip, int argc, EjsObj **argv)
+{
+    EjsObj      *row;
+
+    if ((row = stmtStep(ejs, (EjsSqliteStatement*) ip->target, 0, NULL)) == ESV(null)) {
+        ejsThrowStopIteration(ejs);
+        return 0;
     }
-    if (rc != SQLITE_OK) {
-        if (rc == sqlite3_errcode(sdb)) {
-            ejsThrowIOError(ejs, "SQL error: %s", sqlite3_errmsg(sdb));
-        } else {
-            ejsThrowIOError(ejs, "Unspecified SQL error");
-        }
+    ip->index++;
+    return row;
+}
+
+
+/*
+    Return an iterator that runs the statement from the start and returns each result row in turn.
+    This streams the result set without creating an array of all rows.
+
+    iterator function getValues(): Iterator
+ */
+static EjsIterator *stmtGetValues(Ejs *ejs, EjsSqliteStatement *sp, int argc, EjsObj **argv)
+{
+    if (!checkStatement(ejs, sp)) {
         return 0;
     }
-    return (EjsObj*) result;
+    sqlite3_reset(sp->stmt);
+    sp->shape = 0;
+    return ejsCreateIterator(ejs, sp, -1, nextRow, 0, NULL);
 }
 
 
@@ -377,9 +1922,10 @@ static int manageSqlite(EjsSqlite *db, int flags)
 {
     if (flags & MPR_MANAGE_MARK) {
         ejsManagePot(db, flags);
+        mprMark(db->results);
 
     } else if (flags & MPR_MANAGE_FREE) {
-        if (db->sdb) {
+        if (db->conn) {
             sqliteClose(db->ejs, db, 0, 0);
         }
     }
@@ -387,6 +1933,58 @@ static int manageSqlite(EjsSqlite *db, int flags)
 }
 
 
+/*
+    Queue the statement of a collected statement object. This runs on the garbage collector thread while other threads
+    may be using the connection, so statements are only finalized here if the connection has been closed.
+ */
+static void queueCollected(SqliteConnection *conn, sqlite3_stmt *stmt)
+{
+    sqlite3_stmt    **collected;
+    int             release;
+
+    mprLock(poolLock);
+    if (conn->closed) {
+        release = releaseStatement(conn);
+        mprUnlock(poolLock);
+        sqlite3_finalize(stmt);
+        if (release) {
+            pfree(conn);
+        }
+        return;
+    }
+    if (conn->numCollected >= conn->maxCollected) {
+        conn->maxCollected = max(conn->maxCollected * 2, 8);
+        if ((collected = prealloc(conn->collected, sizeof(sqlite3_stmt*) * conn->maxCollected)) == 0) {
+            /* Leak the statement rather than finalize it while in use */
+            conn->maxCollected = conn->numCollected;
+            releaseStatement(conn);
+            mprUnlock(poolLock);
+            return;
+        }
+        conn->collected = collected;
+    }
+    conn->collected[conn->numCollected++] = stmt;
+    releaseStatement(conn);
+    mprUnlock(poolLock);
+}
+
+
+static void manageStatement(EjsSqliteStatement *sp, int flags)
+{
+    if (flags & MPR_MANAGE_MARK) {
+        mprMark(sp->db);
+        mprMark(sp->shape);
+        mprMark(TYPE(sp));
+
+    } else if (flags & MPR_MANAGE_FREE) {
+        if (sp->stmt) {
+            queueCollected(sp->conn, sp->stmt);
+            sp->stmt = 0;
+        }
+    }
+}
+
+
 static void initSqlite()
 {
     ejsLockService();
@@ -400,8 +1998,13 @@ static void initSqlite()
         sqlite3_config(THREAD_STYLE);
         if (sqlite3_initialize() != SQLITE_OK) {
             mprLog("ejs sqlite", 0, "Cannot initialize SQLite");
+            ejsUnlockService();
             return;
         }
+        sqlite3_soft_heap_limit(ME_MAX_SQLITE_MEM);
+        poolLock = mprCreateLock();
+        mprHold(poolLock);
+        mprAddTerminator(terminateSqlite);
         sqliteInitialized = 1;
     }
     ejsUnlockService();
@@ -419,8 +2022,24 @@ static int configureSqliteTypes(Ejs *ejs)
     }
     prototype = type->prototype;
     ejsBindConstructor(ejs, type, sqliteConstructor);
+    ejsBindMethod(ejs, type, ES_ejs_db_sqlite_Sqlite_poolStats, sqlitePoolStats);
+    ejsBindMethod(ejs, prototype, ES_ejs_db_sqlite_Sqlite_batch, sqliteBatch);
+    ejsBindMethod(ejs, prototype, ES_ejs_db_sqlite_Sqlite_cachedSql, sqliteCachedSql);
     ejsBindMethod(ejs, prototype, ES_ejs_db_sqlite_Sqlite_close, sqliteClose);
+    ejsBindMethod(ejs, prototype, ES_ejs_db_sqlite_Sqlite_prepare, sqlitePrepare);
     ejsBindMethod(ejs, prototype, ES_ejs_db_sqlite_Sqlite_sql, sqliteSql);
+
+    if ((type = ejsFinalizeScriptType(ejs, N("ejs.db.sqlite", "SqliteStatement"), sizeof(EjsSqliteStatement), 
+            manageStatement, EJS_TYPE_OBJ)) == 0) {
+        return 0;
+    }
+    prototype = type->prototype;
+    ejsBindMethod(ejs, prototype, ES_ejs_db_sqlite_SqliteStatement_bind, stmtBind);
+    ejsBindMethod(ejs, prototype, ES_ejs_db_sqlite_SqliteStatement_close, stmtClose);
+    ejsBindMethod(ejs, prototype, ES_ejs_db_sqlite_SqliteStatement_iterator_getValues, stmtGetValues);
+    ejsBindMethod(ejs, prototype, ES_ejs_db_sqlite_SqliteStatement_reset, stmtReset);
+    ejsBindMethod(ejs, prototype, ES_ejs_db_sqlite_SqliteStatement_sql, stmtSql);
+    ejsBindMethod(ejs, prototype, ES_ejs_db_sqlite_SqliteStatement_step, stmtStep);
     return 0;
 }
 
@@ -80,6 +80,38 @@ module ejs.db {
         function addIndex(table: String, column: String, index: String): Void
             adapter.addIndex(table, column, index)
 
+        /**
+            Run a SQL command once for each set of parameters. The command is prepared once and each parameter set is 
+            bound and executed in turn. If a transaction is not already active, the batch runs inside a single 
+            transaction so the rows are committed together. If any command fails, the batch is rolled back.
+            @param cmd SQL command string containing a single statement with "?" positional or ":name" named parameters
+            @param params Array of parameter sets. Each element is an Array of positional values or an Object of 
+                named values. See $query for details.
+            @param rowids Optional array to receive the last inserted row ID after each parameter set is executed
+            @returns The total number of rows changed by the batch
+            @example
+                db.batch("INSERT INTO Trades (symbol, price) VALUES (?, ?);", [["IBM", 120], ["MSFT", 40]])
+         */
+        function batch(cmd: String, params: Array, rowids: Array? = null): Number
+            adapter.batch(cmd, params, rowids)
+
+        /**
+            Execute a read-only SQL command and cache the result. Subsequent calls with the same command and parameters
+            return a copy of the cached rows without querying the database. Differences in white space and trailing
+            semicolons in the command are ignored. Cached results are discarded automatically when writes to any table
+            read by the command are committed by this process. Writes by other processes, including other worker 
+            processes of a prefork HttpServer, are not detected; use a lifespan to bound the staleness of results in
+            that case. Commands that modify the database, run inside a 
+            transaction or return more than a limited number of rows are not cached.
+            @param cmd SQL command string
+            @param params Optional parameter values to bind to the command. See $query for details.
+            @param lifespan Optional time in seconds to keep the result. Set to zero to keep the result until the 
+                tables read by the command are modified.
+            @returns An array of row results. See $query for details.
+         */
+        function cachedSql(cmd: String, params: Object? = null, lifespan: Number = 0): Array
+            adapter.cachedSql(cmd, params, lifespan)
+
         /**
             Change a column
             @param table Name of the table holding the column
@@ -210,15 +242,32 @@ module ejs.db {
             options.name
 
         /**
-            Execute a SQL command on the database.
+            Prepare a SQL statement for repeated execution. Parameters in the statement may be bound to values
+            without reparsing the SQL. 
+            @param cmd SQL command string. This may contain "?" positional or ":name" named parameters.
+            @returns A statement object with bind, step, reset and close methods. Use "for each (row in statement)"
+                to iterate over result rows without materializing the entire result set.
+         */
+        function prepare(cmd: String): Object
+            adapter.prepare(cmd)
+
+        /**
+            Execute a SQL command on the database. The database adapter may cache the prepared statement for the command
+            so that repeated commands are not reparsed. Use parameters rather than literal values in the command text
+            to maximize reuse.
             @param cmd SQL command string
             @param tag Debug tag to use when logging the command
             @param trace Set to true to eanble logging this command.
+            @param params Optional parameter values to bind to the command. This may be an Array of values for 
+                positional "?" parameters or an Object of named values for ":name" parameters.
+            @param lifespan If defined, the result is cached using $cachedSql with the given lifespan in seconds.
             @returns An array of row results where each row is represented by an Object hash containing the 
-                column names and values
+                column names and values. Values are stored using native types: Numbers for integer and real columns,
+                ByteArrays for blobs and null for SQL NULL values.
             @TODO Refactor logging when Log class implemented
          */
-        function query(cmd: String, tag: String = "SQL", trace: Boolean~ = false): Array {
+        function query(cmd: String, tag: String = "SQL", trace: Boolean~ = false, params: Object? = null, 
+                lifespan: Number? = null): Array {
             let mark, size
             trace ||= options.trace
             if (trace) {
@@ -226,7 +275,7 @@ module ejs.db {
                 mark = new Date
                 size = Memory.resident
             }
-            let result = adapter.sql(cmd)
+            let result = (lifespan != null) ? adapter.cachedSql(cmd, params, lifespan) : adapter.sql(cmd, params)
             if (trace) {
                 App.log.activity("Stats", "Elapsed %5.2f msec, memory %5.2f".format(mark.elapsed, 
                     (Memory.resident - size) / (1024 * 1024)))
@@ -278,11 +327,12 @@ module ejs.db {
             Execute a SQL command on the database. This is a low level SQL command interface that bypasses logging.
                 Use @query instead.
             @param cmd SQL command to issue. Note: "SELECT" is automatically prepended and ";" is appended for you.
+            @param params Optional parameter values to bind to the command. See $query for details.
             @returns An array of row results where each row is represented by an Object hash containing the column 
                 names and values
          */
-        function sql(cmd: String): Array
-            adapter.sql(cmd)
+        function sql(cmd: String, params: Object? = null): Array
+            adapter.sql(cmd, params)
 
         /**
             Map the SQL type to a database independant data type
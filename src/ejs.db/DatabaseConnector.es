@@ -25,6 +25,12 @@ module ejs.db {
         /** @duplicate ejs.db::Database.addIndex */
         function addIndex(table: String, column: String, index: String): Void
 
+        /** @duplicate ejs.db::Database.batch */
+        function batch(cmd: String, params: Array, rowids: Array? = null): Number
+
+        /** @duplicate ejs.db::Database.cachedSql */
+        function cachedSql(cmd: String, params: Object? = null, lifespan: Number = 0): Array
+
         /** @duplicate ejs.db::Database.changeColumn */
         function changeColumn(table: String, column: String, datatype: String, options: Object? = null): Void
 
@@ -62,6 +68,9 @@ module ejs.db {
         /** @duplicate ejs.db::Database.getTables */
         function getTables(): Array
 
+        /** @duplicate ejs.db::Database.prepare */
+        function prepare(cmd: String): Object
+
         /** @duplicate ejs.db::Database.removeColumns */
         function removeColumns(table: String, columns: Array): Void 
 
@@ -80,7 +89,7 @@ module ejs.db {
         function rollback(): Void
 
         /** @duplicate ejs.db::Database.sql */
-        function sql(cmd: String): Array
+        function sql(cmd: String, params: Object? = null): Array
 
         /** @duplicate ejs.db::Database.sqlTypeToDataType */
         function sqlTypeToDataType(sqlType: String): String
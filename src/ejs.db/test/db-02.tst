@@ -0,0 +1,66 @@
+/*
+  	Prepared statement and parameter binding tests
+ */
+
+if (Config.DB && Config.SQLITE) {
+    load('ejs.db.mod')
+    load('ejs.db.sqlite.mod')
+    use namespace 'ejs.db'
+
+    let db = new Database("sqlite", "test.sdb")
+
+    //  Positional and named parameters with query()
+    let rows = db.query("SELECT * FROM Trades WHERE id = ?;", "find", false, [2])
+    assert(rows.length == 1)
+    assert(rows[0].id == 2)
+    rows = db.query("SELECT * FROM Trades WHERE id >= :low AND id <= :high;", "find", false, {low: 1, high: 2})
+    assert(rows.length == 2)
+
+    //  Repeated commands reuse the cached statement with new bindings
+    for (i = 1; i <= 3; i++) {
+        rows = db.query("SELECT * FROM Trades WHERE id = ?;", "find", false, [i])
+        assert(rows.length == 1)
+        assert(rows[0].id == i)
+    }
+
+    //  Prepared statements
+    let stmt = db.prepare("SELECT * FROM Trades WHERE id >= ? ORDER BY id")
+    assert(stmt.sql == "SELECT * FROM Trades WHERE id >= ? ORDER BY id")
+    stmt.bind(2)
+    let ids = []
+    while ((row = stmt.step()) != null) {
+        ids.push(row.id)
+    }
+    assert(ids == "2,3")
+
+    //  Reset and run again with the same bindings
+    stmt.reset()
+    assert(stmt.step().id == 2)
+
+    //  Rebind
+    stmt.bind([3])
+    assert(stmt.step().id == 3)
+    assert(stmt.step() == null)
+    stmt.close()
+
+    let caught
+    try {
+        stmt.step()
+    } catch {
+        caught = true
+    }
+    assert(caught)
+
+    //  SQL errors
+    caught = false
+    try {
+        db.prepare("SELECT * FROM NoSuchTable")
+    } catch (e) {
+        caught = true
+        assert(e.message.contains("no such table"))
+    }
+    assert(caught)
+    db.close()
+} else {
+    test.skip("DB or SQLite not enabled")
+}
@@ -0,0 +1,64 @@
+/*
+  	Typed result set and statement iteration tests
+ */
+
+if (Config.DB && Config.SQLITE) {
+    load('ejs.db.mod')
+    load('ejs.db.sqlite.mod')
+    use namespace 'ejs.db'
+
+    let db = new Database("sqlite", ":memory:")
+    db.query("CREATE TABLE Items (id INTEGER PRIMARY KEY, name TEXT, price REAL, data BLOB, note TEXT);")
+    db.query("INSERT INTO Items VALUES (1, 'one', 1.5, X'0102', NULL);")
+    db.query("INSERT INTO Items VALUES (2, 'two', 2.25, X'', 'second');")
+    db.query("INSERT INTO Items VALUES (3, 'three', 3, NULL, NULL);")
+
+    //  Column values keep their native types
+    let rows = db.query("SELECT * FROM Items ORDER BY id;")
+    assert(rows.length == 3)
+    let row = rows[0]
+    assert(row.id is Number && row.id == 1)
+    assert(row.name is String && row.name == "one")
+    assert(row.price is Number && row.price == 1.5)
+    assert(row.data is ByteArray && row.data.length == 2)
+    assert(row.data[0] == 1 && row.data[1] == 2)
+    assert(row.note === null)
+    assert(rows[1].data is ByteArray && rows[1].data.length == 0)
+    assert(rows[1].note == "second")
+    assert(rows[2].data === null)
+
+    //  Rows share the same column layout
+    let names = []
+    for (let name in rows[2]) {
+        names.push(name)
+    }
+    assert(names == "id,name,price,data,note")
+
+    //  Duplicate column names take the first value
+    rows = db.query("SELECT id, name, id AS name FROM Items WHERE id = 2;")
+    assert(rows[0].name == "two")
+    assert(Object.getOwnPropertyCount(rows[0]) == 2)
+
+    //  Iterate over a statement without materializing the result set
+    let stmt = db.prepare("SELECT id, price FROM Items WHERE id >= ? ORDER BY id")
+    stmt.bind(2)
+    let total = 0
+    let ids = []
+    for each (row in stmt) {
+        ids.push(row.id)
+        total += row.price
+    }
+    assert(ids == "2,3")
+    assert(total == 5.25)
+
+    //  Iterating again reruns the statement
+    ids = []
+    for each (row in stmt) {
+        ids.push(row.id)
+    }
+    assert(ids == "2,3")
+    stmt.close()
+    db.close()
+} else {
+    test.skip("DB or SQLite not enabled")
+}
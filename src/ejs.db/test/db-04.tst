@@ -0,0 +1,52 @@
+/*
+  	Batch command tests
+ */
+
+if (Config.DB && Config.SQLITE) {
+    load('ejs.db.mod')
+    load('ejs.db.sqlite.mod')
+    use namespace 'ejs.db'
+
+    let db = new Database("sqlite", ":memory:")
+    db.query("CREATE TABLE Items (id INTEGER PRIMARY KEY, name TEXT UNIQUE, price REAL);")
+
+    //  Positional parameter sets with row IDs
+    let params = []
+    for (i = 0; i < 100; i++) {
+        params.push(["item-" + i, i])
+    }
+    let rowids = []
+    assert(db.batch("INSERT INTO Items (name, price) VALUES (?, ?);", params, rowids) == 100)
+    assert(rowids.length == 100)
+    assert(rowids[0] == 1 && rowids[99] == 100)
+    assert(db.query("SELECT COUNT(*) AS count FROM Items;")[0].count == 100)
+
+    //  Named parameter sets
+    let count = db.batch("UPDATE Items SET price = :price WHERE id = :id;", [{id: 1, price: 10}, {id: 2, price: 20}])
+    assert(count == 2)
+    assert(db.query("SELECT price FROM Items WHERE id = 2;")[0].price == 20)
+
+    //  A failing parameter set rolls back the whole batch
+    let caught
+    try {
+        db.batch("INSERT INTO Items (name, price) VALUES (?, ?);", [["new-1", 1], ["item-5", 2]])
+    } catch (e) {
+        caught = true
+        assert(e.message.contains("UNIQUE") || e.message.contains("unique"))
+    }
+    assert(caught)
+    assert(db.query("SELECT COUNT(*) AS count FROM Items;")[0].count == 100)
+
+    //  Only single statements are accepted
+    caught = false
+    try {
+        db.batch("DELETE FROM Items WHERE id = ?; DELETE FROM Items;", [[1]])
+    } catch {
+        caught = true
+    }
+    assert(caught)
+    assert(db.query("SELECT COUNT(*) AS count FROM Items;")[0].count == 100)
+    db.close()
+} else {
+    test.skip("DB or SQLite not enabled")
+}
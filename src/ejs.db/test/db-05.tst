@@ -0,0 +1,78 @@
+/*
+  	Connection pool tests
+ */
+
+if (Config.DB && Config.SQLITE) {
+    load('ejs.db.mod')
+    load('ejs.db.sqlite.mod')
+    use namespace 'ejs.db'
+    require ejs.db.sqlite
+
+    function getStats() {
+        for (let [path, stats] in Sqlite.poolStats()) {
+            if (Path(path).basename == "test.sdb") {
+                return stats
+            }
+        }
+        return null
+    }
+
+    //  Databases for the same file share pooled connections
+    let a = new Database("sqlite", "test.sdb")
+    let b = new Database("sqlite", "test.sdb")
+    assert(a.query("SELECT * FROM Trades;").length > 0)
+    assert(b.query("SELECT * FROM Trades;").length > 0)
+    let stats = getStats()
+    assert(stats)
+    assert(stats.connections == 1)
+    assert(stats.inUse == 0)
+    assert(stats.idle == 1)
+    assert(stats.checkouts >= 3)
+
+    //  Prepared statements keep the connection until closed
+    let stmt = a.prepare("SELECT * FROM Trades ORDER BY id")
+    assert(getStats().inUse == 1)
+    assert(b.query("SELECT * FROM Trades;").length > 0)
+    assert(getStats().connections == 2)
+    assert(stmt.step().id == 1)
+    stmt.close()
+    assert(getStats().inUse == 0)
+
+    //  Collected statements release the connection back to the pool
+    stmt = a.prepare("SELECT * FROM Trades ORDER BY id")
+    assert(stmt.step().id == 1)
+    assert(getStats().inUse == 1)
+    stmt = null
+    for (i in 50) {
+        //  The collector sweeps in the background, so the statement may be released after GC.run returns
+        GC.run()
+        assert(a.query("SELECT * FROM Trades;").length > 0)
+        if (getStats().inUse == 0) {
+            break
+        }
+        App.sleep(10)
+    }
+    assert(getStats().inUse == 0)
+    let overflows = getStats().connections
+    assert(b.query("SELECT * FROM Trades;").length > 0)
+    assert(getStats().connections == overflows)
+
+    //  Closed databases cannot be used
+    b.close()
+    let caught
+    try {
+        b.query("SELECT * FROM Trades;")
+    } catch {
+        caught = true
+    }
+    assert(caught)
+    a.close()
+
+    //  In-memory databases are private
+    let m = new Database("sqlite", ":memory:")
+    m.query("CREATE TABLE t (x INTEGER);")
+    assert(m.query("SELECT * FROM t;").length == 0)
+    m.close()
+} else {
+    test.skip("DB or SQLite not enabled")
+}
@@ -0,0 +1,98 @@
+/*
+  	Query result cache tests
+ */
+
+if (Config.DB && Config.SQLITE) {
+    load('ejs.db.mod')
+    load('ejs.db.sqlite.mod')
+    use namespace 'ejs.db'
+
+    let db = new Database("sqlite", ":memory:")
+    db.query("CREATE TABLE Items (id INTEGER PRIMARY KEY, name TEXT, price REAL);")
+    db.batch("INSERT INTO Items (name, price) VALUES (?, ?);", [["a", 1], ["b", 2], ["c", 3]])
+
+    //  Cached results match uncached results and are copies
+    let rows = db.cachedSql("SELECT * FROM Items ORDER BY id;")
+    assert(rows.length == 3)
+    assert(rows[0].name == "a" && rows[2].price == 3)
+    rows[0].name = "changed"
+    rows = db.cachedSql("SELECT  *  FROM Items\n ORDER BY id")
+    assert(rows.length == 3)
+    assert(rows[0].name == "a")
+
+    //  Parameters are part of the key
+    assert(db.cachedSql("SELECT name FROM Items WHERE id = ?;", [1])[0].name == "a")
+    assert(db.cachedSql("SELECT name FROM Items WHERE id = ?;", [2])[0].name == "b")
+    assert(db.cachedSql("SELECT name FROM Items WHERE name = :name;", {name: "c"})[0].name == "c")
+    assert(db.cachedSql("SELECT name FROM Items WHERE name = :name;", {name: "a"})[0].name == "a")
+
+    //  Writes invalidate cached results for the table
+    db.query("INSERT INTO Items (name, price) VALUES ('d', 4);")
+    assert(db.cachedSql("SELECT * FROM Items ORDER BY id;").length == 4)
+    db.batch("UPDATE Items SET name = ? WHERE id = ?;", [["A", 1]])
+    assert(db.cachedSql("SELECT name FROM Items WHERE id = ?;", [1])[0].name == "A")
+
+    //  Deleting all rows invalidates cached results
+    db.query("DELETE FROM Items;")
+    assert(db.cachedSql("SELECT * FROM Items ORDER BY id;").length == 0)
+
+    //  Uncommitted writes are visible inside a transaction
+    db.query("BEGIN TRANSACTION;")
+    db.query("INSERT INTO Items (name, price) VALUES ('e', 5);")
+    assert(db.cachedSql("SELECT * FROM Items ORDER BY id;").length == 1)
+    db.query("ROLLBACK;")
+    assert(db.cachedSql("SELECT * FROM Items ORDER BY id;").length == 0)
+
+    //  Writes to other tables do not affect the result, joins depend on both tables
+    db.query("CREATE TABLE Tags (id INTEGER PRIMARY KEY, itemId INTEGER, tag TEXT);")
+    db.query("INSERT INTO Items (name, price) VALUES ('f', 6);")
+    db.query("INSERT INTO Tags (itemId, tag) VALUES (last_insert_rowid(), 'new');")
+    let join = "SELECT Items.name, Tags.tag FROM Items, Tags WHERE Tags.itemId = Items.id;"
+    assert(db.cachedSql(join).length == 1)
+    db.query("INSERT INTO Tags (itemId, tag) VALUES ((SELECT id FROM Items WHERE name = 'f'), 'sale');")
+    assert(db.cachedSql(join).length == 2)
+
+    //  Commands that write are run but not cached
+    db.cachedSql("INSERT INTO Items (name, price) VALUES ('g', 7);")
+    assert(db.query("SELECT COUNT(*) AS count FROM Items;")[0].count == 2)
+
+    //  Writes to WITHOUT ROWID tables do not run the update hook so results are not cached
+    db.query("CREATE TABLE KV (k TEXT PRIMARY KEY, v INTEGER) WITHOUT ROWID;")
+    db.query("INSERT INTO KV (k, v) VALUES ('a', 1);")
+    assert(db.cachedSql("SELECT * FROM KV;")[0].v == 1)
+    db.query("UPDATE KV SET v = 2 WHERE k = 'a';")
+    assert(db.cachedSql("SELECT * FROM KV;")[0].v == 2)
+    db.query("UPDATE KV SET v = 3 WHERE k = 'a';")
+    assert(db.cachedSql("SELECT * FROM KV;")[0].v == 3)
+
+    //  Query with a lifespan
+    assert(db.query("SELECT * FROM Items;", "SQL", false, null, 60).length == 2)
+    db.close()
+
+    //  Writes by other database objects on the same file invalidate cached results
+    let a = new Database("sqlite", "test.sdb")
+    let b = new Database("sqlite", "test.sdb")
+    a.query("CREATE TABLE IF NOT EXISTS CacheItems (id INTEGER PRIMARY KEY, name TEXT);")
+    a.query("DELETE FROM CacheItems;")
+    assert(a.cachedSql("SELECT * FROM CacheItems;").length == 0)
+    b.query("INSERT INTO CacheItems (name) VALUES ('x');")
+    assert(a.cachedSql("SELECT * FROM CacheItems;").length == 1)
+    b.transaction(function() {
+        b.query("INSERT INTO CacheItems (name) VALUES ('y');")
+    })
+    assert(a.cachedSql("SELECT * FROM CacheItems;").length == 2)
+
+    //  Writes by other processes are not detected. The lifespan bounds the staleness.
+    assert(a.cachedSql("SELECT name FROM CacheItems;", null, 1).length == 2)
+    Cmd.run([Cmd.locate(App.exeDir.join("ejs")), "--require", "ejs.db ejs.db.sqlite", "--cmd",
+        "new Database('sqlite', 'test.sdb').query(\"INSERT INTO CacheItems (name) VALUES ('z');\")"])
+    assert(a.cachedSql("SELECT name FROM CacheItems;", null, 1).length == 2)
+    App.sleep(1100)
+    assert(a.cachedSql("SELECT name FROM CacheItems;", null, 1).length == 3)
+
+    a.query("DROP TABLE CacheItems;")
+    a.close()
+    b.close()
+} else {
+    test.skip("DB or SQLite not enabled")
+}
@@ -370,9 +370,11 @@ PUBLIC EjsName ejsEmptyName(struct Ejs *ejs, cchar *name);
 #define S_Event ES_Event
 #define S_File ES_File
 #define S_FileSystem ES_FileSystem
+#define S_Float64Array ES_Float64Array
 #define S_Frame ES_Frame
 #define S_Function ES_Function
 #define S_Http ES_Http
+#define S_Int32Array ES_Int32Array
 #define S_Namespace ES_Namespace
 #define S_Null ES_Null
 #define S_Number ES_Number
@@ -381,6 +383,7 @@ PUBLIC EjsName ejsEmptyName(struct Ejs *ejs, cchar *name);
 #define S_RegExp ES_RegExp
 #define S_String ES_String
 #define S_Type ES_Type
+#define S_Uint8Array ES_Uint8Array
 #define S_Uri ES_Uri
 #define S_Void ES_Void
 #define S_Worker ES_Worker
@@ -472,6 +475,7 @@ typedef struct Ejs {
     int                 joining;            /**< In Worker.join */
     int                 serializeDepth;     /**< Serialization depth */
     int                 spreadArgs;         /**< Count of spread args */
+    int                 xmlGeneration;      /**< XML modification count. Used to validate XML descendant indexes */
     int                 gc;                 /**< GC required (don't make bit field) */
     uint                abandoned: 1;       /**< Pooled VM is released awaiting GC  */
     uint                hosted: 1;          /**< Interp is hosted (webserver) */
@@ -493,10 +497,11 @@ typedef struct Ejs {
     void                (*loaderCallback)(struct Ejs *ejs, int kind, ...);
 
     void                *loadData;          /**< Arg to load callbacks */
-    void                *httpServer;        /**< HttpServer instance when VM is embedded */
+    void                *httpServer;        /**< HttpServer instance when VM is embedded or pooled */
 
     MprHash             *doc;               /**< Documentation */
     void                *sqlite;            /**< Sqlite context information */
+    struct EjsDateCache *dateCache;         /**< Recently formatted dates */
 
     Http                *http;              /**< Http service object (copy of EjsService.http) */
     MprMutex            *mutex;             /**< Multithread locking */
@@ -599,10 +604,13 @@ typedef struct EjsPool {
 PUBLIC EjsPool *ejsCreatePool(int poolMax, cchar *templateScript, cchar *startScript, cchar *startScriptPath, cchar *home,
         cchar *documents);
 
+#define EJS_POOL_RESERVED   0x1     /**< Caller has counted the VM in pool->count while holding the pool lock */
+
 /**
     Allocate a VM from the pool
     @param pool EjsPool reference
-    @param flags Reserved
+    @param flags Set to EJS_POOL_RESERVED to create a new VM for a slot the caller has already reserved by incrementing
+        pool->count while holding the pool mutex. Otherwise set to zero.
     @returns Returns an Ejs VM instance
     @ingroup EjsPool
  */
@@ -1400,7 +1408,7 @@ PUBLIC bool ejsMatchName(Ejs *ejs, EjsName *a, EjsName *b);
     @see EjsString ejsAtoi ejsCompareAsc ejsCompareString ejsCompareSubstring ejsCompareWide ejsContainsAsc 
         ejsContainsChar ejsContainsString ejsCreateBareString ejsCreateString ejsCreateStringFromAsc 
         ejsCreateStringFromBytes ejsCreateStringFromConst ejsCreateStringFromMulti ejsCreateStringWithLength 
-        ejsDestroyIntern ejsInternAsc ejsInternMulti ejsInternString ejsInternWide ejsJoinString 
+        ejsDestroyIntern ejsHashString ejsInternAsc ejsInternMulti ejsInternString ejsInternWide ejsJoinString 
         ejsJoinStrings ejsSerialize ejsSerializeWithOptions ejsSprintf ejsStartsWithAsc ejsStrcat ejsStrdup 
         ejsSubstring ejsToJSON ejsToLiteralString ejsToMulti ejsToString ejsToUpper ejsTruncateString ejsVarToString 
         ejsToLower 
@@ -1411,6 +1419,7 @@ typedef struct EjsString {
     struct EjsObj    obj;               /**< Base object */
     struct EjsString *next;             /**< Next string in hash chain link when interning */
     struct EjsString *prev;             /**< Prev string in hash chain */
+    uint             hash;              /**< Cached hash of the string value. Zero until computed */
     ssize            length;            /**< Length of string */
     wchar            value[ARRAY_FLEX]; /**< String value */
 } EjsString;
@@ -1486,6 +1495,17 @@ PUBLIC EjsString *ejsCreateBareString(Ejs *ejs, ssize len);
  */
 PUBLIC EjsString *ejsInternString(EjsString *sp);
 
+/** 
+    Get the hash code for a string
+    @description The hash is computed once and cached in the string. Interned strings are hashed when they are 
+        interned. Strings are immutable once defined, so this must not be called on a string created via 
+        ejsCreateBareString until its value has been fully defined.
+    @param sp String object
+    @return The string hash code
+    @ingroup EjsString
+ */
+PUBLIC uint ejsHashString(EjsString *sp);
+
 /** 
     Intern a string object from a UTF-8 string. 
     @description A string is created using the UTF-8 string as input. 
@@ -1796,18 +1816,31 @@ PUBLIC EjsString *ejsExpandString(Ejs *ejs, EjsString *sp, EjsObj *tokens);
         indexed location within a list. The Array class can store objects with numerical indicies and can also store 
         any named properties. The named properties are stored in the obj field, whereas the numeric indexed values are
         stored in the data field. Array extends EjsObj and has all the capabilities of EjsObj.
+        \n\n
+        Arrays created by scripts store numbers unboxed in a packed vector of integers. An array transitions to packed 
+        doubles when a non-integer number is stored and to boxed object references when any other value is stored or 
+        when an update would leave holes. Arrays created via #ejsCreateArray always store object references. Code that 
+        accesses the data field of other arrays must first call #ejsUnpackArray.
     @defgroup EjsArray EjsArray
     @see EjsArray ejsAddItem ejsClearArray ejsCloneArray ejsCreateArray ejsGetFirstItem ejsGetItem ejsGetLastItem 
         ejsGetNextItem ejsGetPrevItem ejsInsertItem ejsAppendArray ejsLookupItem ejsRemoveItem ejsRemoveItemAtPos 
-        ejsRemoveLastItem 
+        ejsRemoveLastItem ejsUnpackArray
     @stability Internal
  */
 typedef struct EjsArray {
     EjsPot          pot;                /**< Property storage */
-    EjsObj          **data;             /**< Array elements */
+    EjsObj          **data;             /**< Array elements. Packed arrays store a vector of int or double */
     int             length;             /**< Array length property */
+    int             kind;               /**< Element kind: EJS_ARRAY_OBJECTS, EJS_ARRAY_INTS or EJS_ARRAY_DOUBLES */
 } EjsArray;
 
+/*
+    Array element kinds
+ */
+#define EJS_ARRAY_OBJECTS   0           /**< Elements are boxed object references */
+#define EJS_ARRAY_INTS      1           /**< Elements are packed integers */
+#define EJS_ARRAY_DOUBLES   2           /**< Elements are packed doubles */
+
 
 /** 
     Append an array
@@ -2001,6 +2034,17 @@ PUBLIC EjsArray *ejsRemoveItems(Ejs *ejs, EjsArray *ap, EjsArray *items);
  */
 PUBLIC EjsArray *ejsSortArray(Ejs *ejs, EjsArray *ap, int argc, EjsObj **argv);
 
+/**
+    Unpack an array
+    @description Convert a packed array of numbers to store boxed object references. This must be called before 
+        accessing the array data field directly. It has no effect if the array is already unpacked.
+    @param ejs Ejs reference returned from #ejsCreateVM
+    @param ap Array to unpack
+    @return Zero if successful, otherwise a negative MPR error code.
+    @ingroup EjsArray
+ */
+PUBLIC int ejsUnpackArray(Ejs *ejs, EjsArray *ap);
+
 /************************************************ Block ********************************************************/
 /** 
     Block class
@@ -2777,11 +2821,84 @@ PUBLIC bool ejsMakeRoomInByteArray(Ejs *ejs, EjsByteArray *ba, ssize require);
  */
 PUBLIC struct EjsNumber *ejsWriteToByteArray(Ejs *ejs, EjsByteArray *ba, int argc, EjsObj **argv);
 
+/*
+    Typed array element kinds
+ */
+#define EJS_TYPED_INT32     1           /**< Int32Array elements */
+#define EJS_TYPED_FLOAT64   2           /**< Float64Array elements */
+#define EJS_TYPED_UINT8     3           /**< Uint8Array elements */
+
+/**
+    EjsTypedArray
+    @description The Int32Array, Float64Array and Uint8Array classes provide fixed length arrays of packed numbers.
+        Elements are stored unboxed in native byte order in a ByteArray buffer which may be shared by several views.
+        The element data is located via the buffer on each access so the buffer may safely grow.
+    @defgroup EjsTypedArray EjsTypedArray
+    @see EjsTypedArray ejsCreateTypedArray ejsGetTypedArrayElement ejsIsTypedArray ejsSetTypedArrayElement
+    @stability Prototype
+ */
+typedef struct EjsTypedArray {
+    EjsObj          obj;                /**< Base object */
+    EjsByteArray    *buffer;            /**< Byte array storing the elements */
+    ssize           offset;             /**< Byte offset of the first element in the buffer */
+    int             length;             /**< Number of elements */
+    int             kind;               /**< Element kind: EJS_TYPED_INT32, EJS_TYPED_FLOAT64 or EJS_TYPED_UINT8 */
+    int             size;               /**< Size of an element in bytes */
+} EjsTypedArray;
+
+/**
+    Create a typed array
+    @description Create a typed array with a new zero filled buffer.
+    @param ejs Ejs reference returned from #ejsCreateVM
+    @param kind Element kind. Set to EJS_TYPED_INT32, EJS_TYPED_FLOAT64 or EJS_TYPED_UINT8.
+    @param length Number of elements
+    @return A new typed array instance
+    @ingroup EjsTypedArray
+ */
+PUBLIC EjsTypedArray *ejsCreateTypedArray(Ejs *ejs, int kind, int length);
+
+/**
+    Get a typed array element
+    @param ejs Ejs reference returned from #ejsCreateVM
+    @param ta Typed array
+    @param index Element index
+    @return The element value as a number. Throws an OutOfBoundsError and returns null if the index is out of range.
+    @ingroup EjsTypedArray
+ */
+PUBLIC EjsAny *ejsGetTypedArrayElement(Ejs *ejs, EjsTypedArray *ta, int index);
+
+/**
+    Set a typed array element
+    @description The value is converted to the element kind. Integer kinds wrap and fractions are truncated.
+    @param ejs Ejs reference returned from #ejsCreateVM
+    @param ta Typed array
+    @param index Element index
+    @param value Value to store
+    @return The index if successful. Throws an OutOfBoundsError and returns EJS_ERR if the index is out of range.
+    @ingroup EjsTypedArray
+ */
+PUBLIC int ejsSetTypedArrayElement(Ejs *ejs, EjsTypedArray *ta, int index, EjsAny *value);
+
+#if DOXYGEN
+    /**
+        Determine if a variable is a typed array
+        @param ejs Ejs reference returned from #ejsCreateVM
+        @param obj Object to test
+        @return True if the variable is an Int32Array, Float64Array or Uint8Array
+        @ingroup EjsTypedArray
+     */
+    extern bool ejsIsTypedArray(Ejs *ejs, EjsAny *obj);
+#else
+    #define ejsIsTypedArray(ejs, obj) (obj && (TYPE(obj) == EST(Float64Array) || TYPE(obj) == EST(Int32Array) || \
+        TYPE(obj) == EST(Uint8Array)))
+#endif
+
 /******************************************* Cache ************************************************/
 /**
     EjsCache
     @defgroup EjsCache EjsCache
     @see ejsCacheExpire ejsCacheRead ejsCacheReadObj ejsCacheRemove ejsSetCacheLimits ejsCacheWrite ejsCacheWriteObj
+        ejsGetLocalCache ejsReadLocalCacheObj ejsWriteLocalCacheObj
  */
 
 /** 
@@ -2808,7 +2925,8 @@ PUBLIC EjsAny *ejsCacheRead(Ejs *ejs, EjsObj *cache, struct EjsString *key, EjsO
 
 /** 
     Read an object from the cache
-    @description This call reads a cache item and then deserializes using JSON encoding into an object.
+    @description This call reads a cache item and then deserializes using JSON encoding into an object. If the cache
+        uses the local cache adapter and no options are supplied, objects are read in native form via ejsReadLocalCacheObj.
     @param ejs Interpreter instance returned from #ejsCreateVM
     @param cache Cache object
     @param key Cache item key
@@ -2891,6 +3009,43 @@ PUBLIC struct EjsNumber *ejsCacheWrite(Ejs *ejs, EjsObj *cache, struct EjsString
  */
 PUBLIC struct EjsNumber *ejsCacheWriteObj(Ejs *ejs, EjsObj *cache, struct EjsString *key, EjsAny *value, EjsObj *options);
 
+/** 
+    Get the local cache for a cache object
+    @description Objects can be stored in a local cache in native form without serialization.
+    @param ejs Interpreter instance returned from #ejsCreateVM
+    @param cache Cache or LocalCache object
+    @return The LocalCache object if the cache uses the local cache adapter. Otherwise null.
+    @ingroup EjsCache
+ */
+PUBLIC EjsAny *ejsGetLocalCache(Ejs *ejs, EjsObj *cache);
+
+/** 
+    Read an object from a local cache
+    @description Objects written via ejsWriteLocalCacheObj are stored in native form. This call returns a private copy
+        of the object for the caller without deserialization. Other items are deserialized using JSON encoding.
+    @param ejs Interpreter instance returned from #ejsCreateVM
+    @param cache LocalCache object
+    @param key Cache item key
+    @return Cache item object or null if the key is not present or has expired.
+    @ingroup EjsCache
+ */
+PUBLIC EjsAny *ejsReadLocalCacheObj(Ejs *ejs, EjsObj *cache, struct EjsString *key);
+
+/** 
+    Write an object to a local cache
+    @description The object is copied and stored in native form without serialization. The stored copy is never 
+        modified and may be read by other interpreters in the process.
+    @param ejs Interpreter instance returned from #ejsCreateVM
+    @param cache LocalCache object
+    @param key Cache item key
+    @param value Value to write
+    @param options Cache write options. Only the lifespan and expires options are supported.
+    @return The approximate memory used by the item
+    @ingroup EjsCache
+ */
+PUBLIC struct EjsNumber *ejsWriteLocalCacheObj(Ejs *ejs, EjsObj *cache, struct EjsString *key, EjsAny *value, 
+    EjsObj *options);
+
 /******************************************** Cmd *************************************************/
 /** 
     Cmd class
@@ -3668,7 +3823,8 @@ PUBLIC struct EjsNumber *ejsToNumber(Ejs *ejs, EjsAny *obj);
 typedef struct EjsRegExp {
     EjsObj          obj;                /**< Base object */
     wchar           *pattern;           /**< Pattern to match */
-    void            *compiled;          /**< Compiled pattern (not alloced) */
+    void            *compiled;          /**< Compiled pattern (not alloced). Owned by the shared pattern */
+    struct EjsRegExpPattern *shared;    /**< Shared compiled pattern from the regular expression cache */
     bool            global;             /**< Search for pattern globally (multiple times) */
     bool            ignoreCase;         /**< Do case insensitive matching */
     bool            multiline;          /**< Match patterns over multiple lines */
@@ -3709,6 +3865,33 @@ PUBLIC EjsRegExp *ejsParseRegExp(Ejs *ejs, EjsString *pattern);
  */
 PUBLIC EjsString *ejsRegExpToString(Ejs *ejs, EjsRegExp *rp);
 
+/**
+    Compiled regular expression pattern shared over all interpreters
+    @ingroup EjsRegExp
+    @stability Internal
+ */
+typedef struct EjsRegExpPattern {
+    char                    *key;       /**< Cache key of compile options and pattern */
+    void                    *compiled;  /**< Compiled pattern (malloced) */
+    struct EjsRegExpPattern *prev;      /**< Next more recently used pattern */
+    struct EjsRegExpPattern *next;      /**< Next less recently used pattern */
+} EjsRegExpPattern;
+
+/**
+    Cache of compiled regular expression patterns shared over all interpreters
+    @description Compiling a pattern is much more expensive than matching. The cache is indexed by the compile
+        options and pattern so that repeated regular expression literals and RegExp constructions reuse the 
+        compiled pattern. The least recently used patterns are discarded when the cache is full.
+    @ingroup EjsRegExp
+    @stability Internal
+ */
+typedef struct EjsRegExpCache {
+    MprHash             *patterns;      /**< Compiled patterns indexed by key */
+    EjsRegExpPattern    lru;            /**< List head. The next pattern is the least recently used */
+    int                 max;            /**< Maximum number of cached patterns */
+    MprMutex            *mutex;         /**< Multithread lock */
+} EjsRegExpCache;
+
 /******************************************** Socket **********************************************/
 /**
     Socket Class
@@ -3826,7 +4009,7 @@ PUBLIC EjsUri *ejsToUri(Ejs *ejs, EjsAny *obj);
     Worker Class
     @description The Worker class provides the ability to create new interpreters in dedicated threads
     @defgroup EjsWorker EjsWorker
-    @see EjsObj ejsCreateWorker ejsRemoveWorkers
+    @see EjsObj ejsCopyValue ejsCreateWorker ejsDecodeValue ejsEncodeValue ejsRemoveWorkers
     @stability Internal
  */
 typedef struct EjsWorker {
@@ -3865,6 +4048,42 @@ PUBLIC EjsWorker *ejsCreateWorker(Ejs *ejs);
  */
 PUBLIC void ejsRemoveWorkers(Ejs *ejs);
 
+/**
+    Copy a value for use by another interpreter
+    @description Plain objects and arrays are copied deeply so the copy shares no mutable state with the original.
+        Strings, numbers and other immutable values are shared. Values with a custom toJSON method are copied via JSON.
+    @param ejs Ejs reference returned from #ejsCreateVM
+    @param vp Value to copy
+    @param readOnly Set to true if vp must not be modified because it may be read concurrently by other interpreters.
+        The value must then be free of cyclic references. Values returned by ejsCopyValue are acyclic.
+    @param size Optional reference to receive the approximate memory used by the value. The size is added to *size.
+    @return A copy of the value
+    @ingroup EjsWorker
+ */
+PUBLIC EjsAny *ejsCopyValue(Ejs *ejs, EjsAny *vp, int readOnly, ssize *size);
+
+/**
+    Encode a value using the compact binary format of worker messages
+    @description The encoding is versioned and is independent of byte order and character width, so it may be
+        stored in caches shared with other systems. ByteArrays are copied.
+    @param ejs Ejs reference returned from #ejsCreateVM
+    @param vp Value to encode
+    @return A buffer containing the encoded value
+    @ingroup EjsWorker
+ */
+PUBLIC MprBuf *ejsEncodeValue(Ejs *ejs, EjsAny *vp);
+
+/**
+    Decode a value encoded by ejsEncodeValue
+    @description The data is treated as untrusted. Worker message encodings that transfer buffer pointers are rejected.
+    @param ejs Ejs reference returned from #ejsCreateVM
+    @param data Encoded data
+    @param len Length of the encoded data
+    @return The decoded value. Returns null and throws an exception if the data is not a valid encoding.
+    @ingroup EjsWorker
+ */
+PUBLIC EjsAny *ejsDecodeValue(Ejs *ejs, cchar *data, ssize len);
+
 /******************************************** Void ************************************************/
 /** 
     Void class
@@ -3957,15 +4176,14 @@ typedef struct EjsXmlState {
 typedef struct EjsXML {
     EjsObj          obj;                /**< Base object */
     EjsName         qname;              /**< XML node name (e.g. tagName) */
-    int             kind;               /**< Kind of XML node */
     MprList         *elements;          /**< List elements or child nodes */
     MprList         *attributes;        /**< Node attributes */
-    MprList         *namespaces;        /**< List of namespaces as Namespace objects */
     struct EjsXML   *parent;            /**< Parent node reference (XML or XMLList) */
     struct EjsXML   *targetObject;      /**< XML/XMLList object modified when items inserted into an empty list */
     EjsName         targetProperty;     /**< XML property modified when items inserted into an empty list */
     EjsString       *value;             /**< Value of text|attribute|comment|pi */
-    int             flags;
+    struct EjsXMLIndex *index;          /**< Descendant index. Built on demand by ejsGetXMLDescendants */
+    int             kind;               /**< Kind of XML node */
 } EjsXML;
 
 #if DOXYGEN
@@ -4026,6 +4244,8 @@ PUBLIC EjsXML *ejsCreateXMLList(Ejs *ejs, EjsXML *targetObject, EjsName targetPr
 
 /** 
     Get the descendants of an XML node that match the given name
+    @description Element and attribute names are resolved using a name index that is built for the node on the 
+        first query and reused until any XML tree is modified.
     @param ejs Ejs reference returned from #ejsCreateVM
     @param xml Node to examine
     @param qname Name to search for
@@ -4078,10 +4298,37 @@ PUBLIC int ejsXMLToBuf(Ejs *ejs, MprBuf *buf, EjsXML *xml, int indentLevel);
 /*  
     Internal
  */
+#define ejsModifyXML(ejs) ((ejs)->xmlGeneration++)
 PUBLIC EjsXML *ejsConfigureXML(Ejs *ejs, EjsXML *xml, int kind, EjsString *name, EjsXML *parent, EjsString *value);
 PUBLIC void ejsManageXML(EjsXML *xml, int flags);
 PUBLIC MprXml *ejsCreateXmlParser(Ejs *ejs, EjsXML *xml, cchar *filename);
 
+/** 
+    XMLReader class
+    @description The XMLReader class reads XML documents incrementally as a stream of start, end, text and comment
+        events without building an XML object for the whole document. Input is read in fixed size chunks so memory use
+        is bounded by the largest token and by any elements that are expanded into XML objects.
+    @defgroup EjsXMLReader EjsXMLReader
+    @see EjsXMLReader
+    @stability Prototype
+ */
+typedef struct EjsXMLReader {
+    EjsObj          obj;                /**< Base object */
+    EjsObj          *input;             /**< Input source: Stream, Path or String */
+    EjsObj          *emitter;           /**< Event emitter for listeners */
+    EjsByteArray    *chunk;             /**< Read buffer for Stream input */
+    struct EjsFunction *read;           /**< Stream read method */
+    EjsObj          *last;              /**< Last start event. Used when expanding an element */
+    EjsObj          *pending;           /**< Queued end event for a solo element */
+    EjsArray        *select;            /**< Element names to expand when parsing */
+    MprBuf          *buf;               /**< Input read but not yet tokenized */
+    MprFile         *file;              /**< Input file for File and Path inputs */
+    MprList         *stack;             /**< Names of the currently open elements */
+    ssize           chunkSize;          /**< Size of input reads */
+    int             lineNumber;         /**< Current input line number */
+    int             eof;                /**< Input has been fully read */
+} EjsXMLReader;
+
 /******************************************** Type ************************************************/
 /** 
     Allocation and Type Helpers
@@ -4578,12 +4825,14 @@ PUBLIC void     ejsConfigureStringType(Ejs *ejs);
 PUBLIC void     ejsConfigureSocketType(Ejs *ejs);
 PUBLIC void     ejsConfigureSystemType(Ejs *ejs);
 PUBLIC void     ejsConfigureTimerType(Ejs *ejs);
+PUBLIC void     ejsConfigureTypedArrayTypes(Ejs *ejs);
 PUBLIC void     ejsConfigureTypes(Ejs *ejs);
 PUBLIC void     ejsConfigureUriType(Ejs *ejs);
 PUBLIC void     ejsConfigureVoidType(Ejs *ejs);
 PUBLIC void     ejsConfigureWorkerType(Ejs *ejs);
 PUBLIC void     ejsConfigureXMLType(Ejs *ejs);
 PUBLIC void     ejsConfigureXMLListType(Ejs *ejs);
+PUBLIC void     ejsConfigureXMLReaderType(Ejs *ejs);
 PUBLIC void     ejsConfigureWebSocketType(Ejs *ejs);
 
 PUBLIC void     ejsCreateCoreNamespaces(Ejs *ejs);
@@ -4686,6 +4935,7 @@ typedef struct EjsService {
     uint            immutableInitialized: 1;/**< Immutable types are initialized */
     uint            seqno;                  /**< Interp sequence numbers */
     EjsIntern       *intern;                /**< Interned Unicode string hash - shared over all interps */
+    struct EjsRegExpCache *regexpCache;     /**< Compiled regular expression cache - shared over all interps */
     EjsPot          *immutable;             /**< Immutable types and special values*/
     EjsHelpers      objHelpers;             /**< Default EjsObj helpers */
     EjsHelpers      potHelpers;             /**< Default EjsPot helpers */
@@ -4698,6 +4948,7 @@ typedef struct EjsService {
    Internal
  */
 PUBLIC EjsIntern *ejsCreateIntern(EjsService *sp);
+PUBLIC EjsRegExpCache *ejsCreateRegExpCache(EjsService *sp);
 PUBLIC int ejsInitCompiler(EjsService *sp);
 PUBLIC void ejsAttention(Ejs *ejs);
 PUBLIC void ejsClearAttention(Ejs *ejs);
@@ -42,6 +42,12 @@ module ejs.template  {
         private var viewClass: String = "View"
         private var viewModule: String
 
+        /**
+            Files read while parsing the template. This includes included pages and layout pages (but not the template
+            itself) and is used to invalidate compiled templates when any of these files are modified.
+         */
+        public var dependencies: Array = []
+
         /**
             Build a templated page
             @param script String containing the script to parse
@@ -118,6 +124,8 @@ module ejs.template  {
                             Recurse and process the include script
                          */
                         let inc: TemplateParser = new TemplateParser
+                        inc.dependencies = dependencies
+                        dependencies.push(incPath)
                         out.write(inc.parse(incPath.readString(), options))
                         break
 
@@ -163,7 +171,10 @@ module ejs.template  {
             }
             if (layoutPage && layoutPage != options.currentLayout) {
                 let layoutOptions = blend(options.clone(), { currentLayout: layoutPage })
-                let layoutText: String = new TemplateParser().parse(layoutPage.readString(), layoutOptions)
+                let parser: TemplateParser = new TemplateParser
+                parser.dependencies = dependencies
+                dependencies.push(layoutPage)
+                let layoutText: String = parser.parse(layoutPage.readString(), layoutOptions)
                 return layoutText.replace(ContentPattern, out.toString().replace(/\$/g, "$$$$"))
             }
             return out.toString()
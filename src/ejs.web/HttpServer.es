@@ -19,9 +19,21 @@ module ejs.web {
         /** Frequency to check and release excess worker threads */
         static var PrunePeriod = 60 * 1000
 
-        private var idleWorkers: Array = []
-        private var activeWorkers: Array = []
-        private var workerImage: Worker
+        /** Environment variable defining the process index in a worker process started by a supervisor */
+        static const WorkerProcessEnv = "EJS_WORKER_PROCESS"
+
+        /** Delay before restarting a worker process that exited unexpectedly */
+        static var RestartDelay = 1000
+
+        private static const SIGKILL = 9
+        private static const SIGTERM = 15
+
+        /* Time to wait for a worker process to exit when the supervisor is closed */
+        private static const StopTimeout = 5000
+
+        /* Worker processes when this server is the supervisor. Indexed by process number. */
+        private var workerProcesses: Array
+        private var supervising: Boolean
 
         private static const defaultConfig = {
             dirs: {
@@ -149,6 +161,8 @@ module ejs.web {
             @option uri Maximum size of URIs.
             @option workers Maximum number of Worker threads to utilize for threaded requests. This value is initialized
                 from the ejsrc cache.workers.limit field.
+            @option workerQueue Maximum number of threaded requests to queue when all workers are busy. Requests beyond
+                this limit are rejected with a 503 status. Defaults to the workers limit.
             @see setLimits
           */
         native function get limits(): Object
@@ -213,6 +227,12 @@ module ejs.web {
             @option config Alternate App.config settings
             @option unhosted If hosted inside a web server, set to true to bypass any web server listening endpoints and 
                 create a new stand-alone (unhosted) listening connection.
+            @option workers Worker configuration to blend into the config.web.workers settings. Set workers.processes
+                to a number greater than one to serve requests from that many worker processes. Set workers.script to 
+                the server script each worker process runs with the ejs program, or set workers.command to the
+                complete worker command line. See $listen for details.
+                Set workers.min to the number of worker interpreters to create in advance for threaded requests. 
+                These are retained when pruning idle workers.
             @spec ejs
             @stability prototype
             @example: This is a fully async server:
@@ -266,6 +286,9 @@ server.listen("127.0.0.1:7777")
                 dirs[key] = home.join(value)
             }
             let web = config.web
+            if (options.workers) {
+                web.workers = blend(web.workers || {}, options.workers)
+            }
             if (web.trace) {
                 trace(web.trace)
             }
@@ -307,34 +330,18 @@ server.listen("127.0.0.1:7777")
 
         /** 
             @duplicate Stream.close 
+            If this server is supervising worker processes, they are stopped before close returns.
          */
-        native function close(): Void
-
-        /*
-            Get a worker for a multithreaded request. This will clone a worker from the workerImage and will
-            enforce the configured limits.workers value.
-         */
-        private function getWorker(): Worker? {
-            let w = idleWorkers.pop()
-            if (w == undefined) {
-                if (limits.workers && activeWorkers.length >= limits.workers) {
-                    App.log.debug(1, "Too many workers " + activeWorkers.length + "/" + limits.workers)
-                    return null
-                }
-                if (workerImage == null) {
-                    workerImage = new Worker
-                    workerImage.preeval("require ejs.web")
-                }
-                w = workerImage.clone()
-                if (config.web.workers && config.web.workers.init) {
-                    w.preeval(config.web.workers.init)
-                }
+        function close(): Void {
+            if (supervising) {
+                stopWorkerProcesses()
             }
-            activeWorkers.push(w)
-            App.log.debug(5, "HttpServer.getWorker idle: " + idleWorkers.length + " active:" + activeWorkers.length)
-            return w
+            closeEndpoint()
         }
 
+        /** @hide */
+        native function closeEndpoint(): Void
+
         //  TODO - should take an array of endpoints (like GoAhead) and allow https:///
         //  TODO - Should not throw
 
@@ -358,7 +365,18 @@ server.listen("127.0.0.1:7777")
             If the server is hosted in a web server, an appropriate existing web server listening connection will be 
             used. Otherwise, if not hosted, a server socket will be opened on the endpoint.
             If hosted and an endpoint is not provided, the server will listen on all appropriate web server connections.
-            @throws ArgError if the specified endpoint address is not valid or available for binding.
+
+            If config.web.workers.processes is greater than one and the server is not hosted, this process becomes a 
+            supervisor. It does not listen itself, but starts the configured number of worker processes. Each worker 
+            process runs config.web.workers.command, or runs the config.web.workers.script server script with the ejs 
+            program from the application's bin directory. The $WorkerProcessEnv environment variable is set to the 
+            worker index. A server that is started with this variable defined listens on the endpoint with the 
+            SO_REUSEPORT socket option so the operating system balances connections among the worker processes. 
+            Worker processes that exit unexpectedly are restarted. Sending SIGHUP to the supervisor or calling 
+            $reload will restart the worker processes one at a time. Closing the supervisor stops the worker 
+            processes. On Linux, worker processes also exit when the supervisor exits.
+            @throws ArgError if the specified endpoint address is not valid or available for binding, or if worker 
+                processes are configured without a worker script or command.
             @event Issues a "accept" event when there is a new connection available.
             @example:
                 server = new Http({home: ".", documents: "web"})
@@ -368,7 +386,26 @@ server.listen("127.0.0.1:7777")
                 })
                 server.listen("80")
          */
-        native function listen(endpoint: String? = null): Void
+        function listen(endpoint: String? = null): Void {
+            let workers = config.web.workers
+            let processes = (workers && workers.processes) ? workers.processes : 0
+            if (!hosted) {
+                if (App.getenv(WorkerProcessEnv) != null) {
+                    reusePort = true
+                    watchSupervisor()
+                } else if (processes > 1) {
+                    startWorkerProcesses(processes, workerCommand(workers))
+                    return
+                }
+            }
+            if (workers && workers.min) {
+                prewarmWorkers(workers.min)
+            }
+            listenEndpoint(endpoint)
+        }
+
+        /** @hide */
+        native function listenEndpoint(endpoint: String? = null): Void
 
         /** 
             Remove an observer from the server. 
@@ -392,9 +429,15 @@ server.listen("127.0.0.1:7777")
             Pass a request into a worker VM. The onrequest callback receives the request. This routine clones stub 
             Request and HttpServer objects into the worker VM.
             @param request Request object
-            @param worker Worker to handle the request
+            @param worker Worker to handle the request. If null, the request is passed to a pooled worker interpreter.
+                If all pooled interpreters are busy, the request is queued until one is available. The server is 
+                cloned once into each pooled interpreter and reused for subsequent requests.
+            @return True if the request was accepted. Returns false if all workers are busy and the queue is full.
          */
-        native function passRequest(request: Request, worker: Worker)
+        native function passRequest(request: Request, worker: Worker? = null): Boolean
+
+        /** @hide */
+        native function prewarmWorkers(count: Number): Void
 
         /** 
             Process a web request
@@ -515,22 +558,38 @@ server.listen("127.0.0.1:7777")
             After calling, the next request will be a little slower as it will need to recreate a worker interpreter.
             This is normally run every PrunePeriod. It may be also be called manually at any time.
          */
-        function pruneWorkers(): Void {
-            if (idleWorkers.length > 0) {
-                App.log.debug(6, "HttpServer prune " + idleWorkers.length + " workers")
-                idleWorkers = []
-                GC.run()
-            }
-        }
+        native function pruneWorkers(): Void
 
-        private function releaseWorker(w: Worker): Void {
-            activeWorkers.remove(w)
-            if (config.cache.workers.enable) {
-                idleWorkers.push(w)
+        /**
+            Restart worker processes one at a time. Each worker process is sent SIGTERM to gracefully complete current
+            requests and is restarted when it exits. This is only effective when the server is supervising worker 
+            processes. See $listen for details.
+         */
+        function reload(): Void {
+            if (!supervising) {
+                return
+            }
+            App.log.debug(1, "HttpServer reloading " + workerProcesses.length + " worker processes")
+            let pending = workerProcesses.clone()
+            function next() {
+                let cmd = pending.shift()
+                if (cmd) {
+                    cmd.on("complete", function() {
+                        Timer(RestartDelay, next).start()
+                    })
+                    cmd.stop(SIGTERM)
+                }
             }
-            App.log.debug(5, "HttpServer.releaseWorker idle: " + idleWorkers.length + " active:" + activeWorkers.length)
+            next()
         }
 
+        /**
+            Share the listening endpoint with other processes via the SO_REUSEPORT socket option. This must be set
+            before calling $listen. It is set automatically for worker processes.
+         */
+        native function get reusePort(): Boolean
+        native function set reusePort(enable: Boolean): Void
+
         /** 
             Run the application event loop to service requests.
             If the HttpServer is hosted in a web server, this call does nothing as the web server will service events and
@@ -569,18 +628,12 @@ server.listen("127.0.0.1:7777")
         function serve(request: Request, router: Router = Router()): Void {
             request.mark = new Date
             try {
-                let w: Worker?
                 let route: Route = router.route(request)
                 if (route.workers) {
-                    if ((w = getWorker()) == null) {
+                    if (!passRequest(request)) {
                         request.writeError(Http.ServiceUnavailable, "Server busy")
                         return
                     }
-                    request.on("close", function() {
-                        releaseWorker(w) 
-                        App.log.debug(5, "Elapsed " + request.mark.elapsed + " msec for " + request.uri)
-                    })
-                    passRequest(request, w)
                     /* Must not touch request from here on - the worker owns it now */
                 } else {
                     //  TODO - rename response => responder
@@ -594,6 +647,84 @@ server.listen("127.0.0.1:7777")
             }
         }
 
+        /*
+            Start and supervise the worker processes. The supervisor does not listen for requests.
+         */
+        private function startWorkerProcesses(count: Number, command: Object): Void {
+            supervising = true
+            workerProcesses = []
+            for (i in count) {
+                startWorkerProcess(i, command)
+            }
+            on("reload", function() {
+                reload()
+            })
+            trapSignals()
+        }
+
+        /*
+            Stop the worker processes and wait for them to exit so the endpoint is free
+         */
+        private function stopWorkerProcesses(): Void {
+            supervising = false
+            for each (cmd in workerProcesses) {
+                cmd.stop(SIGTERM)
+            }
+            for each (cmd in workerProcesses) {
+                if (!cmd.wait(StopTimeout)) {
+                    cmd.stop(SIGKILL)
+                    cmd.wait(StopTimeout)
+                }
+            }
+        }
+
+        private function startWorkerProcess(index: Number, command: Object): Void {
+            let cmd = new Cmd
+            let env = {}
+            env[WorkerProcessEnv] = index
+            cmd.env = env
+            cmd.on("readable", function(event, cmd) {
+                let data = new ByteArray
+                if (cmd.read(data)) {
+                    App.outputStream.write(data)
+                }
+            })
+            cmd.on("error", function(event, cmd) {
+                App.errorStream.write(cmd.errorStream.readString())
+            })
+            //  NOTE: "this" is set to the cmd in observers
+            let server = this
+            cmd.on("complete", function(event, cmd) {
+                if (server.supervising && server.workerProcesses[index] == cmd) {
+                    App.log.debug(1, "HttpServer worker process " + index + " exited, restarting")
+                    Timer(RestartDelay, function() {
+                        server.startWorkerProcess(index, command)
+                    }).start()
+                }
+            })
+            cmd.start(command, {detach: true})
+            cmd.finalize()
+            workerProcesses[index] = cmd
+            App.log.debug(2, "HttpServer started worker process " + index + " pid " + cmd.pid)
+        }
+
+        /** @hide */
+        native function trapSignals(): Void
+
+        /*
+            Get the worker process command line from the workers.command or workers.script settings
+         */
+        private function workerCommand(workers: Object): Object {
+            if (workers.command) {
+                return workers.command
+            }
+            if (!workers.script) {
+                throw new ArgError("Worker processes require a workers.script or workers.command setting")
+            }
+            let ejs = Cmd.locate(App.exeDir.join("ejs")) || Path("ejs")
+            return [ejs, workers.script]
+        }
+
         /**
             Define the stages of the Http processing pipeline. Data flows through the processing pipeline and is
             filtered or transmuted by filter stages. A communications connector is responsible for transmitting to 
@@ -658,6 +789,9 @@ server.listen("127.0.0.1:7777")
          */
         native function verifyClients(caCertPath: Path?, caCertFile: Path?): Void
 
+        /** @hide */
+        native function watchSupervisor(): Void
+
         /**
             Convenience routine to create a web server. This will start a routing web server that will serve a 
             variety of content using the given specified route tables.
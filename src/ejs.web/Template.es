@@ -52,23 +52,204 @@ module ejs.web {
         @stability prototype
      */
     function TemplateBuilder(request: Request, options: Object = {}): Function {
-        let path
-        if (!options.literal) {
+        let path = null, key
+        if (options.literal) {
+            key = md5(options.literal) + "|" + options.layout
+        } else {
             path = request.filename
+            key = path + "|" + options.layout
+        }
+        let app = TemplateCache.lookup(key, request.config)
+        if (app) {
+            return app
+        }
+        if (!options.literal) {
             if (path && !path.exists) {
                 request.writeError(Http.NotFound, "Cannot find " + escapeHtml(request.pathInfo))
                 //  TODO - is this a generic need for a function like this?
                 return function() {}
             }
         }
-        return Loader.load(path, path, request.config, function (id, path) {
+        /*
+            The files read to build a template are saved beside the cached module. They are needed if the module is 
+            reused without parsing the template.
+         */
+        let cache = path ? Loader.cached(path, request.config) : null
+        let dependencies = TemplateCache.readDependencies(cache, request.config)
+        let built = false
+        /* Literal templates use an empty id so they are not cached on disk */
+        app = Loader.load(path || "", path, request.config, function (id, path) {
             if (!global.TemplateParser) {
                 global.load("ejs.template.mod", {reload: false})
             }
-            options.dir = path.dirname
-            let data = options.literal || TemplateParser().build(path.readString(), options)
-            return Loader.wrap(path, data)
+            options.dir = path ? path.dirname : (options.dir || ".")
+            let parser = new TemplateParser
+            let data = parser.build(options.literal || path.readString(), options)
+            dependencies = parser.dependencies
+            built = true
+            return Loader.wrap(id, data)
         }).app
+        if (built) {
+            TemplateCache.writeDependencies(cache, dependencies)
+        }
+        let files = options.layout ? [Path(options.layout)].concat(dependencies) : dependencies
+        TemplateCache.add(key, app, path ? [path].concat(files) : files, cache)
+        return app
+    }
+
+    /**
+        In-memory registry of compiled templates. Templates are indexed by path and layout so that rendering a cached 
+        template does not access the file system. Each entry records the files used to build the template (page, 
+        includes and layouts). If config.cache.app.reload is enabled, these are checked for modification at most once 
+        per $CheckPeriod and the entry is discarded if any have changed. The registry holds at most $MaxTemplates 
+        templates. When full, the entries are scanned and the template with the oldest use time is discarded.
+        @spec ejs
+        @stability prototype
+        @hide
+     */
+    class TemplateCache {
+        use default namespace public
+
+        /** Minimum period in milliseconds between modification checks of a template and its dependencies */
+        static const CheckPeriod: Number = 1000
+
+        /** Maximum number of compiled templates to retain */
+        static const MaxTemplates: Number = 500
+
+        private static var templates: Object = {}
+        private static var count: Number = 0
+
+        /**
+            Add a compiled template to the cache
+            @param key Template key
+            @param app Compiled template function
+            @param files Array of paths used to build the template
+            @param cache Path of the cached module file for the template. Removed if any of the files are modified.
+         */
+        static function add(key: String, app: Function, files: Array, cache: Path? = null): Void {
+            let stamps = []
+            for each (file in files) {
+                let modified = Path(file).modified
+                stamps.push(modified ? modified.time : 0)
+            }
+            if (!templates[key]) {
+                if (count >= MaxTemplates) {
+                    evict()
+                }
+                count++
+            }
+            let now = Date.now()
+            templates[key] = { app: app, files: files, cache: cache, stamps: stamps, checked: now, used: now }
+        }
+
+        /**
+            Lookup a compiled template
+            @param key Template key
+            @param config Request configuration
+            @return The compiled template function or null if not cached or out of date
+         */
+        static function lookup(key: String, config: Object): Function? {
+            let entry = templates[key]
+            if (!entry) {
+                return null
+            }
+            let now = Date.now()
+            if (config.cache.app.reload && (now - entry.checked) >= CheckPeriod) {
+                entry.checked = now
+                for (let i = 0; i < entry.files.length; i++) {
+                    let modified = Path(entry.files[i]).modified
+                    if ((modified ? modified.time : 0) != entry.stamps[i]) {
+                        /* Remove the module cache so a modified include or layout forces a recompile */
+                        if (entry.cache && entry.cache.exists) {
+                            entry.cache.remove()
+                        }
+                        delete templates[key]
+                        count--
+                        return null
+                    }
+                }
+            }
+            entry.used = now
+            return entry.app
+        }
+
+        /**
+            Read the dependencies saved for a cached template module. If config.cache.app.reload is enabled and any 
+            dependency is newer than the module, the module is removed so the template will be rebuilt.
+            @param cache Path of the cached module file
+            @param config Request configuration
+            @return Array of dependency paths. Empty if none are saved.
+         */
+        static function readDependencies(cache: Path?, config: Object): Array {
+            let result = []
+            if (!cache || !cache.exists) {
+                return result
+            }
+            let deps = cache.replaceExt("deps")
+            if (deps.exists) {
+                try {
+                    for each (file in deserialize(deps.readString())) {
+                        result.push(Path(file))
+                    }
+                } catch {}
+            }
+            if (config.cache.app.reload) {
+                for each (file in result) {
+                    let modified = file.modified
+                    if (!modified || modified > cache.modified) {
+                        cache.remove()
+                        break
+                    }
+                }
+            }
+            return result
+        }
+
+        /**
+            Save the dependencies of a template beside its cached module
+            @param cache Path of the cached module file
+            @param dependencies Array of dependency paths
+         */
+        static function writeDependencies(cache: Path?, dependencies: Array): Void {
+            if (cache) {
+                let files = []
+                for each (file in dependencies) {
+                    files.push(file.toString())
+                }
+                cache.replaceExt("deps").write(serialize(files))
+            }
+        }
+
+        /**
+            The number of cached templates
+         */
+        static function get length(): Number
+            count
+
+        /**
+            Discard all compiled templates
+         */
+        static function clear(): Void {
+            templates = {}
+            count = 0
+        }
+
+        /*
+            Discard the template with the oldest use time. This scans all entries, which is acceptable as it only runs
+            when adding a template to a full cache.
+         */
+        private static function evict(): Void {
+            let oldest
+            for (let [key, entry] in templates) {
+                if (!oldest || entry.used < templates[oldest].used) {
+                    oldest = key
+                }
+            }
+            if (oldest) {
+                delete templates[oldest]
+                count--
+            }
+        }
     }
 }
 
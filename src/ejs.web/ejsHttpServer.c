@@ -17,6 +17,8 @@
 
 static EjsRequest *createRequest(EjsHttpServer *sp, HttpConn *conn);
 static EjsHttpServer *lookupServer(Ejs *ejs, cchar *ip, int port);
+static void releaseWorker(EjsRequest *req, MprEvent *event);
+static void reloadSignal(EjsHttpServer *sp, MprSignal *sig);
 static void setHttpPipeline(Ejs *ejs, EjsHttpServer *sp);
 static void setupConnTrace(HttpConn *conn);
 static void stateChangeNotifier(HttpConn *conn, int event, int arg);
@@ -100,7 +102,7 @@ static EjsPath *hs_hostedHome(Ejs *ejs, EjsHttpServer *sp, int argc, EjsObj **ar
 
 
 /*  
-    function close(): Void
+    function closeEndpoint(): Void
  */
 static EjsObj *hs_close(Ejs *ejs, EjsHttpServer *sp, int argc, EjsObj **argv)
 {
@@ -191,7 +193,7 @@ static EjsVoid *hs_set_hosted(Ejs *ejs, EjsHttpServer *sp, int argc, EjsObj **ar
 
 
 /*  
-    function listen(endpoint): Void
+    function listenEndpoint(endpoint): Void
 
     An endpoint can be either a "port" or "ip:port", or null. If hosted, this call does little -- just add to the
     ejs->httpServers list.
@@ -231,6 +233,9 @@ static EjsVoid *hs_listen(Ejs *ejs, EjsHttpServer *sp, int argc, EjsObj **argv)
             return 0;
         }
         sp->endpoint = endpoint;
+        if (sp->reusePort) {
+            endpoint->flags |= HTTP_REUSE_PORT;
+        }
         host = httpCreateHost(NULL);
         httpSetHostName(host, sfmt("%s:%d", sp->ip, sp->port));
         route = httpCreateConfiguredRoute(host, 1);
@@ -349,6 +354,25 @@ static EjsNumber *hs_port(Ejs *ejs, EjsHttpServer *sp, int argc, EjsObj **argv)
 }
 
 
+/*
+    function get reusePort(): Boolean
+ */
+static EjsObj *hs_reusePort(Ejs *ejs, EjsHttpServer *sp, int argc, EjsObj **argv)
+{
+    return sp->reusePort ? ESV(true): ESV(false);
+}
+
+
+/*
+    function set reusePort(enable: Boolean): Void
+ */
+static EjsObj *hs_set_reusePort(Ejs *ejs, EjsHttpServer *sp, int argc, EjsObj **argv)
+{
+    sp->reusePort = ejsGetBoolean(ejs, argv[0]);
+    return 0;
+}
+
+
 /*  
     function run(): Void
  */
@@ -444,6 +468,46 @@ static EjsObj *hs_setPipeline(Ejs *ejs, EjsHttpServer *sp, int argc, EjsObj **ar
 }
 
 
+/*
+    function trapSignals(): Void
+
+    Issue a "reload" event on SIGHUP. Used when supervising worker processes.
+ */
+static EjsObj *hs_trapSignals(Ejs *ejs, EjsHttpServer *sp, int argc, EjsObj **argv)
+{
+#if ME_UNIX_LIKE
+    if (sp->reloadSignal == 0) {
+        sp->reloadSignal = mprAddSignalHandler(SIGHUP, reloadSignal, sp, ejs->dispatcher, MPR_SIGNAL_AFTER);
+    }
+#endif
+    return 0;
+}
+
+
+static void reloadSignal(EjsHttpServer *sp, MprSignal *sig)
+{
+    ejsSendEvent(sp->ejs, sp->emitter, "reload", sp, sp);
+}
+
+
+/*
+    function watchSupervisor(): Void
+
+    Terminate this worker process if the supervisor process exits. Only supported on Linux.
+ */
+static EjsObj *hs_watchSupervisor(Ejs *ejs, EjsHttpServer *sp, int argc, EjsObj **argv)
+{
+#if LINUX && defined(PR_SET_PDEATHSIG)
+    prctl(PR_SET_PDEATHSIG, SIGTERM);
+    if (getppid() == 1) {
+        /* Supervisor already gone */
+        mprShutdown(MPR_EXIT_NORMAL, 0, 0);
+    }
+#endif
+    return 0;
+}
+
+
 /*  
     function trace(options): Void
  */
@@ -500,20 +564,15 @@ static void receiveRequest(EjsRequest *req, MprEvent *event)
 
 
 /*
-    function passRequest(req: Request, worker: Worker): Void
+    Clone the request into the worker interpreter and run the request on the interpreter's dispatcher.
+    If nsp is supplied, it is a server already cloned into the interpreter and is reused.
  */
-static EjsVoid *hs_passRequest(Ejs *ejs, EjsHttpServer *server, int argc, EjsAny **argv)
+static EjsRequest *transferRequest(Ejs *ejs, EjsRequest *req, Ejs *nejs, EjsHttpServer *nsp)
 {
-    Ejs             *nejs;
-    EjsRequest      *req, *nreq;
-    EjsWorker       *worker;
+    EjsRequest      *nreq;
     HttpConn        *conn;
     MprEvent        *event;
 
-    req = argv[0];
-    worker = argv[1];
-
-    nejs = worker->pair->ejs;
     conn = req->conn;
     conn->ejs = nejs;
 
@@ -523,12 +582,267 @@ static EjsVoid *hs_passRequest(Ejs *ejs, EjsHttpServer *server, int argc, EjsAny
     }
     httpSetConnContext(conn, nreq);
 
-    if ((nreq->server = ejsCloneHttpServer(nejs, req->server, 1)) == 0) {
+    if (nsp == 0 && (nsp = ejsCloneHttpServer(nejs, req->server, 1)) == 0) {
         ejsThrowStateError(ejs, "Cannot clone request");
         return 0;
     }
+    nreq->server = nsp;
     event = mprCreateEvent(conn->dispatcher, "RequestWorker", 0, receiveRequest, nreq, MPR_EVENT_DONT_QUEUE);
     httpUseWorker(conn, nejs->dispatcher, event);
+    return nreq;
+}
+
+
+/*
+    Create the pool of worker interpreters on first use. Interpreters are cloned from a template that has 
+    already loaded ejs.web. The server is cloned once into each interpreter and reused for all its requests.
+ */
+static EjsPool *getWorkerPool(Ejs *ejs, EjsHttpServer *sp)
+{
+    EjsObj      *config, *web, *cache, *workers, *vp;
+    cchar       *init;
+    int         max;
+
+    if (sp->workers) {
+        return sp->workers;
+    }
+    max = 0;
+    init = 0;
+    sp->workersMin = 0;
+    sp->cacheWorkers = 1;
+    if (sp->limits && (vp = ejsGetPropertyByName(ejs, sp->limits, EN("workers"))) != 0 && ejsIs(ejs, vp, Number)) {
+        max = ejsGetInt(ejs, vp);
+    }
+    sp->workerQueue = max;
+    if (sp->limits && (vp = ejsGetPropertyByName(ejs, sp->limits, EN("workerQueue"))) != 0 && ejsIs(ejs, vp, Number)) {
+        sp->workerQueue = ejsGetInt(ejs, vp);
+    }
+    config = ejsGetProperty(ejs, sp, ES_ejs_web_HttpServer_config);
+    if (config && (cache = ejsGetPropertyByName(ejs, config, EN("cache"))) != 0 && 
+            (workers = ejsGetPropertyByName(ejs, cache, EN("workers"))) != 0 && ejsIsPot(ejs, workers)) {
+        sp->cacheWorkers = ejsGetPropertyByName(ejs, workers, EN("enable")) != ESV(false);
+    }
+    if (config && (web = ejsGetPropertyByName(ejs, config, EN("web"))) != 0 && 
+            (workers = ejsGetPropertyByName(ejs, web, EN("workers"))) != 0 && ejsIsPot(ejs, workers)) {
+        if ((vp = ejsGetPropertyByName(ejs, workers, EN("init"))) != 0 && ejsIs(ejs, vp, String)) {
+            init = ejsToMulti(ejs, vp);
+        }
+        if ((vp = ejsGetPropertyByName(ejs, workers, EN("min"))) != 0 && ejsIs(ejs, vp, Number)) {
+            sp->workersMin = ejsGetInt(ejs, vp);
+        }
+    }
+    if ((sp->workers = ejsCreatePool(max, "require ejs.web", init, NULL, NULL, NULL)) == 0) {
+        ejsThrowMemoryError(ejs);
+        return 0;
+    }
+    sp->pendingRequests = mprCreateList(0, 0);
+    return sp->workers;
+}
+
+
+/*
+    Take an idle worker interpreter or reserve a pool slot for a new one. The pool mutex must be held so the capacity
+    check and the reservation are atomic. Returns false if all worker interpreters are busy.
+ */
+static bool reserveWorker(EjsPool *pool, Ejs **vm)
+{
+    if ((*vm = mprPopItem(pool->list)) != 0) {
+        return 1;
+    }
+    if (pool->count < pool->max) {
+        pool->count++;
+        return 1;
+    }
+    return 0;
+}
+
+
+/*
+    Transfer the request to a worker interpreter reserved via reserveWorker. If nejs is null, a new interpreter is 
+    created for the reserved slot.
+ */
+static int passToWorkerPool(Ejs *ejs, EjsHttpServer *sp, EjsRequest *req, Ejs *nejs)
+{
+    EjsPool     *pool;
+    EjsRequest  *nreq;
+
+    pool = sp->workers;
+    if (nejs == 0 && (nejs = ejsAllocPoolVM(pool, EJS_POOL_RESERVED)) == 0) {
+        ejsThrowStateError(ejs, "Cannot allocate worker interpreter");
+        return MPR_ERR_CANT_CREATE;
+    }
+    if ((nreq = transferRequest(ejs, req, nejs, nejs->httpServer)) == 0) {
+        ejsFreePoolVM(pool, nejs);
+        return MPR_ERR_CANT_CREATE;
+    }
+    /* Cache the cloned server in the interpreter for subsequent requests */
+    nejs->httpServer = nreq->server;
+    req->conn->pool = pool;
+    return 0;
+}
+
+
+/*
+    Run threaded requests that were queued while all worker interpreters were busy. Runs on the server dispatcher.
+ */
+static void runPendingRequests(EjsHttpServer *sp, MprEvent *event)
+{
+    EjsPool     *pool;
+    EjsRequest  *req;
+    HttpConn    *conn;
+    Ejs         *ejs, *nejs;
+
+    ejs = sp->ejs;
+    pool = sp->workers;
+    while (1) {
+        mprLock(pool->mutex);
+        while ((req = mprPopItem(sp->pendingRequests)) != 0) {
+            if ((conn = req->conn) != 0 && !conn->error && conn->state < HTTP_STATE_FINALIZED) {
+                break;
+            }
+            /* Request was abandoned while waiting */
+        }
+        if (req && !reserveWorker(pool, &nejs)) {
+            mprAddItem(sp->pendingRequests, req);
+            req = 0;
+        }
+        mprUnlock(pool->mutex);
+        if (req == 0) {
+            break;
+        }
+        if (passToWorkerPool(ejs, sp, req, nejs) < 0) {
+            ejsClearException(ejs);
+            httpError(conn, HTTP_CODE_SERVICE_UNAVAILABLE, "Cannot run request");
+        }
+        httpEnableConnEvents(conn);
+    }
+}
+
+
+/*
+    Return a worker interpreter to the pool when its request completes. Runs on the interpreter's dispatcher.
+ */
+static void releaseWorker(EjsRequest *req, MprEvent *event)
+{
+    EjsHttpServer   *sp;
+    EjsPool         *pool;
+    Ejs             *nejs;
+    int             pending;
+
+    nejs = req->ejs;
+    sp = req->cloned->server;
+    pool = sp->workers;
+    mprLock(pool->mutex);
+    if (sp->cacheWorkers) {
+        ejsFreePoolVM(pool, nejs);
+    } else {
+        nejs->abandoned = 1;
+        pool->count--;
+    }
+    pending = mprGetListLength(sp->pendingRequests);
+    mprUnlock(pool->mutex);
+    if (pending) {
+        mprCreateEvent(sp->ejs->dispatcher, "pendingRequests", 0, runPendingRequests, sp, 0);
+    }
+}
+
+
+/*
+    function passRequest(req: Request, worker: Worker? = null): Boolean
+
+    Pass the request to the given worker or to a pooled worker interpreter. If all pooled interpreters are busy,
+    the request is queued for the next available interpreter. Returns false if the queue is full.
+ */
+static EjsBoolean *hs_passRequest(Ejs *ejs, EjsHttpServer *sp, int argc, EjsAny **argv)
+{
+    EjsRequest      *req;
+    EjsWorker       *worker;
+    EjsPool         *pool;
+    Ejs             *nejs;
+    int             busy, queued;
+
+    req = argv[0];
+    worker = (argc >= 2 && ejsIs(ejs, argv[1], Worker)) ? argv[1] : 0;
+
+    if (worker) {
+        return transferRequest(ejs, req, worker->pair->ejs, NULL) ? ESV(true) : ESV(false);
+    }
+    if ((pool = getWorkerPool(ejs, sp)) == 0) {
+        return ESV(false);
+    }
+    queued = 0;
+    mprLock(pool->mutex);
+    if ((busy = !reserveWorker(pool, &nejs)) != 0) {
+        if (mprGetListLength(sp->pendingRequests) < sp->workerQueue) {
+            mprAddItem(sp->pendingRequests, req);
+            queued = 1;
+        }
+    }
+    mprUnlock(pool->mutex);
+    if (busy) {
+        if (!queued) {
+            mprLog("ejs web", 2, "All %d workers busy and %d requests queued", pool->count, sp->workerQueue);
+        }
+        return queued ? ESV(true) : ESV(false);
+    }
+    return (passToWorkerPool(ejs, sp, req, nejs) < 0) ? ESV(false) : ESV(true);
+}
+
+
+/*
+    function prewarmWorkers(count: Number): Void
+
+    Create worker interpreters in advance so the first threaded requests do not pay the creation cost
+ */
+static EjsObj *hs_prewarmWorkers(Ejs *ejs, EjsHttpServer *sp, int argc, EjsObj **argv)
+{
+    EjsPool     *pool;
+    Ejs         *vms[64];
+    int         i, count;
+
+    if ((pool = getWorkerPool(ejs, sp)) == 0) {
+        return 0;
+    }
+    count = min(ejsGetInt(ejs, argv[0]), (int) (sizeof(vms) / sizeof(Ejs*)));
+    count = min(count, pool->max) - mprGetListLength(pool->list);
+    for (i = 0; i < count; i++) {
+        if ((vms[i] = ejsAllocPoolVM(pool, 0)) == 0) {
+            break;
+        }
+    }
+    while (--i >= 0) {
+        ejsFreePoolVM(pool, vms[i]);
+    }
+    return 0;
+}
+
+
+/*
+    function pruneWorkers(): Void
+
+    Release idle worker interpreters in excess of the configured minimum
+ */
+static EjsObj *hs_pruneWorkers(Ejs *ejs, EjsHttpServer *sp, int argc, EjsObj **argv)
+{
+    EjsPool     *pool;
+    Ejs         *vm;
+    int         pruned;
+
+    if ((pool = sp->workers) == 0) {
+        return 0;
+    }
+    pruned = 0;
+    mprLock(pool->mutex);
+    while (mprGetListLength(pool->list) > sp->workersMin && (vm = mprPopItem(pool->list)) != 0) {
+        vm->abandoned = 1;
+        pool->count--;
+        pruned++;
+    }
+    mprUnlock(pool->mutex);
+    if (pruned) {
+        mprDebug("ejs web", 6, "HttpServer prune %d workers", pruned);
+        mprGC(MPR_GC_FORCE);
+    }
     return 0;
 }
 
@@ -614,6 +928,11 @@ static void stateChangeNotifier(HttpConn *conn, int event, int arg)
                 ejsSendRequestCloseEvent(ejs, req);
                 if (req->cloned) {
                     ejsSendRequestCloseEvent(req->ejs, req->cloned);
+                    if (conn->pool && req->cloned->server && req->cloned->server->workers == conn->pool) {
+                        /* Release after the current event so the interpreter is idle when reused */
+                        conn->pool = 0;
+                        mprCreateEvent(ejs->dispatcher, "releaseWorker", 0, releaseWorker, req, 0);
+                    }
                 }
             }
         }
@@ -845,8 +1164,15 @@ static void manageHttpServer(EjsHttpServer *sp, int flags)
         mprMark(sp->limits);
         mprMark(sp->outgoingStages);
         mprMark(sp->incomingStages);
+        mprMark(sp->reloadSignal);
+        mprMark(sp->workers);
+        mprMark(sp->pendingRequests);
         
     } else {
+        if (sp->reloadSignal) {
+            mprRemoveSignalHandler(sp->reloadSignal);
+            sp->reloadSignal = 0;
+        }
         if (sp->ejs && sp->ejs->httpServers) {
             mprRemoveItem(sp->ejs->httpServers, sp);
         }
@@ -890,6 +1216,7 @@ EjsHttpServer *ejsCloneHttpServer(Ejs *ejs, EjsHttpServer *sp, bool deep)
     nsp->ssl = sp->ssl;
     nsp->connector = sp->connector;
     nsp->port = sp->port;
+    nsp->reusePort = sp->reusePort;
     nsp->ip = sp->ip;
     nsp->certFile = sp->certFile;
     nsp->keyFile = sp->keyFile;
@@ -939,22 +1266,27 @@ void ejsConfigureHttpServerType(Ejs *ejs)
     ejsBindAccess(ejs, prototype, ES_ejs_web_HttpServer_async, hs_async, hs_set_async);
     ejsBindMethod(ejs, prototype, ES_ejs_web_HttpServer_hostedDocuments, hs_hostedDocuments);
     ejsBindMethod(ejs, prototype, ES_ejs_web_HttpServer_hostedHome, hs_hostedHome);
-    ejsBindMethod(ejs, prototype, ES_ejs_web_HttpServer_close, hs_close);
+    ejsBindMethod(ejs, prototype, ES_ejs_web_HttpServer_closeEndpoint, hs_close);
     ejsBindMethod(ejs, prototype, ES_ejs_web_HttpServer_limits, hs_limits);
     ejsBindAccess(ejs, prototype, ES_ejs_web_HttpServer_hosted, hs_hosted, hs_set_hosted);
     ejsBindMethod(ejs, prototype, ES_ejs_web_HttpServer_isSecure, hs_isSecure);
-    ejsBindMethod(ejs, prototype, ES_ejs_web_HttpServer_listen, hs_listen);
+    ejsBindMethod(ejs, prototype, ES_ejs_web_HttpServer_listenEndpoint, hs_listen);
     ejsBindAccess(ejs, prototype, ES_ejs_web_HttpServer_name, hs_name, hs_set_name);
     ejsBindMethod(ejs, prototype, ES_ejs_web_HttpServer_port, hs_port);
     ejsBindMethod(ejs, prototype, ES_ejs_web_HttpServer_off, hs_off);
     ejsBindMethod(ejs, prototype, ES_ejs_web_HttpServer_on, hs_on);
     ejsBindMethod(ejs, prototype, ES_ejs_web_HttpServer_passRequest, hs_passRequest);
+    ejsBindMethod(ejs, prototype, ES_ejs_web_HttpServer_prewarmWorkers, hs_prewarmWorkers);
+    ejsBindMethod(ejs, prototype, ES_ejs_web_HttpServer_pruneWorkers, hs_pruneWorkers);
+    ejsBindAccess(ejs, prototype, ES_ejs_web_HttpServer_reusePort, hs_reusePort, hs_set_reusePort);
     ejsBindMethod(ejs, prototype, ES_ejs_web_HttpServer_run, hs_run);
     ejsBindMethod(ejs, prototype, ES_ejs_web_HttpServer_secure, hs_secure);
     ejsBindMethod(ejs, prototype, ES_ejs_web_HttpServer_setLimits, hs_setLimits);
     ejsBindMethod(ejs, prototype, ES_ejs_web_HttpServer_setPipeline, hs_setPipeline);
     ejsBindMethod(ejs, prototype, ES_ejs_web_HttpServer_trace, hs_trace);
+    ejsBindMethod(ejs, prototype, ES_ejs_web_HttpServer_trapSignals, hs_trapSignals);
     ejsBindMethod(ejs, prototype, ES_ejs_web_HttpServer_verifyClients, hs_verifyClients);
+    ejsBindMethod(ejs, prototype, ES_ejs_web_HttpServer_watchSupervisor, hs_watchSupervisor);
     ejsBindMethod(ejs, prototype, ES_ejs_web_HttpServer_software, hs_software);
 
     /* One time initializations */
@@ -999,6 +999,18 @@ static EjsObj *req_set_async(Ejs *ejs, EjsRequest *req, int argc, EjsObj **argv)
 }
 
 
+/*
+    Save session updates before finalizing the response. The client may issue its next request as soon as it
+    receives the response.
+ */
+static void saveSession(EjsRequest *req)
+{
+    if (req->session) {
+        ejsSaveSession(req->ejs, req->session);
+    }
+}
+
+
 /*  
     function autoFinalize(): Void
 
@@ -1008,6 +1020,7 @@ static EjsObj *req_autoFinalize(Ejs *ejs, EjsRequest *req, int argc, EjsObj **ar
 {
     /* If writeBuffer is set, HttpServer is capturning output for caching */
     if (req->conn && !req->dontAutoFinalize) {
+        saveSession(req);
         if (!req->writeBuffer) {
             httpFinalize(req->conn);
         }
@@ -1023,6 +1036,7 @@ static EjsObj *req_autoFinalize(Ejs *ejs, EjsRequest *req, int argc, EjsObj **ar
 static EjsObj *req_close(Ejs *ejs, EjsRequest *req, int argc, EjsObj **argv)
 {
     if (req->conn) {
+        saveSession(req);
         if (!req->writeBuffer) {
             httpFinalize(req->conn);
         }
@@ -1068,6 +1082,7 @@ static EjsObj *req_dontAutoFinalize(Ejs *ejs, EjsRequest *req, int argc, EjsObj
 static EjsObj *req_finalize(Ejs *ejs, EjsRequest *req, int argc, EjsObj **argv)
 {
     if (req->conn) {
+        saveSession(req);
         if (!req->writeBuffer || req->writeBuffer == ESV(null)) {
             httpFinalize(req->conn);
             httpFlush(req->conn);
@@ -1277,9 +1292,10 @@ static EjsObj *req_trace(Ejs *ejs, EjsRequest *req, int argc, EjsObj **argv)
 
 
 /*
-    Single channel for all write data
+    Single channel for all write data. If an owner is supplied, the data is immutable and is queued by reference
+    without copying.
  */
-static ssize writeResponseData(Ejs *ejs, EjsRequest *req, cchar *buf, ssize len)
+static ssize writeResponseData(Ejs *ejs, EjsRequest *req, cchar *buf, ssize len, cvoid *owner)
 {
     ssize   written;
     
@@ -1291,7 +1307,7 @@ static ssize writeResponseData(Ejs *ejs, EjsRequest *req, cchar *buf, ssize len)
         httpSetResponded(req->conn);
         return written;
     } else {
-        return httpWriteBlock(req->conn->writeq, buf, len, HTTP_BUFFER);
+        return httpWriteBlockRef(req->conn->writeq, buf, len, owner, HTTP_BUFFER);
     }
 }
 
@@ -1325,7 +1341,7 @@ static EjsNumber *req_write(Ejs *ejs, EjsRequest *req, int argc, EjsObj **argv)
         switch (TYPE(data)->sid) {
         case S_String:
             s = (EjsString*) data;
-            if ((written = writeResponseData(ejs, req, s->value, s->length)) != s->length) {
+            if ((written = writeResponseData(ejs, req, s->value, s->length, s)) != s->length) {
                 err++;
             }
             break;
@@ -1333,7 +1349,8 @@ static EjsNumber *req_write(Ejs *ejs, EjsRequest *req, int argc, EjsObj **argv)
         case S_ByteArray:
             ba = (EjsByteArray*) data;
             len = ba->writePosition - ba->readPosition;
-            if ((written = writeResponseData(ejs, req, (char*) &ba->value[ba->readPosition], len)) != len) {
+            /* ByteArrays are mutable and may be reused by the caller, so the data is copied */
+            if ((written = writeResponseData(ejs, req, (char*) &ba->value[ba->readPosition], len, NULL)) != len) {
                 err++;
             } else {
                 ba->readPosition += len;
@@ -1342,7 +1359,7 @@ static EjsNumber *req_write(Ejs *ejs, EjsRequest *req, int argc, EjsObj **argv)
 
         default:
             s = (EjsString*) ejsToString(ejs, data);
-            if (s == NULL || (written = writeResponseData(ejs, req, s->value, s->length)) != s->length) {
+            if (s == NULL || (written = writeResponseData(ejs, req, s->value, s->length, s)) != s->length) {
                 err++;
             }
         }
@@ -1395,6 +1412,7 @@ static EjsObj *req_writeFile(Ejs *ejs, EjsRequest *req, int argc, EjsObj **argv)
     tx->length = tx->entityLength = info->size;
     httpSetSendConnector(req->conn, path->value);
     httpPutForService(conn->writeq, packet, 0);
+    saveSession(req);
     httpFinalize(req->conn);
     req->finalized = 1;
     return ESV(true);
@@ -1487,6 +1505,8 @@ void ejsSendRequestCloseEvent(Ejs *ejs, EjsRequest *req)
         req->closed = 1;
         ejsSendEvent(ejs, req->emitter, "close", NULL, req);
     }
+    /* Save any session updates made after the request was finalized */
+    saveSession(req);
 }
 
 
@@ -12,6 +12,13 @@
 #include    "ejs.h"
 #include    "ejsWeb.h"
 
+/*********************************** Locals ***********************************/
+/*
+    Prefix for session state stored in external cache backends. The binary encoding follows in base64 so the stored 
+    string never contains nulls. JSON text cannot start with this character.
+ */
+#define SESSION_ENCODED     "\001"
+
 /********************************** Forwards  *********************************/
 
 static int getSessionState(Ejs *ejs, EjsSession *sp);
@@ -28,6 +35,7 @@ static EjsSession *initSession(Ejs *ejs, EjsSession *sp, EjsString *key, MprTick
         sp->cache = 0;
         return 0;
     }
+    sp->local = ejsGetLocalCache(ejs, sp->cache);
     sp->timeout = timeout;
     sp->key = key;
     return sp;
@@ -73,6 +81,7 @@ EjsSession *ejsGetSession(Ejs *ejs, EjsString *key, MprTicks timeout, int create
 int ejsDestroySession(Ejs *ejs, EjsSession *sp)
 {
     if (sp) {
+        sp->dirty = 0;
         ejsCacheRemove(ejs, sp->cache, sp->key);
     }
     return 0;
@@ -85,13 +94,46 @@ static void manageSession(EjsSession *sp, int flags)
         ejsManagePot(sp, flags);
         mprMark(sp->key);
         mprMark(sp->cache);
+        mprMark(sp->local);
         mprMark(sp->options);
     }
 }
 
 
 /*
-    Session state is read once and cached. Writes to session properties are cached with write-through
+    Read the session state from the store. A local cache returns a private copy of the native session object.
+    Other cache backends return the binary encoded session or JSON text. Stored data that cannot be decoded is 
+    ignored and a new session is used.
+ */
+static EjsAny *readSessionState(Ejs *ejs, EjsSession *sp)
+{
+    EjsString   *data;
+    EjsAny      *vp;
+    cchar       *encoded;
+    ssize       len;
+
+    if (sp->local) {
+        return ejsReadLocalCacheObj(ejs, sp->local, sp->key);
+    }
+    if ((data = ejsCacheRead(ejs, sp->cache, sp->key, 0)) == 0 || !ejsIs(ejs, data, String) || data->length == 0) {
+        return 0;
+    }
+    //  UNICODE
+    if (data->value[0] == SESSION_ENCODED[0]) {
+        if ((encoded = mprDecode64Block((cchar*) &data->value[1], &len, MPR_DECODE_TOKEQ)) == 0) {
+            return 0;
+        }
+        if ((vp = ejsDecodeValue(ejs, encoded, len)) == 0) {
+            ejsClearException(ejs);
+        }
+        return vp;
+    }
+    return ejsDeserialize(ejs, data);
+}
+
+
+/*
+    Session state is read once and cached. Writes to session properties are batched and saved by ejsSaveSession
  */
 static int getSessionState(Ejs *ejs, EjsSession *sp) 
 {
@@ -103,7 +145,7 @@ static int getSessionState(Ejs *ejs, EjsSession *sp)
         return 1;
     }
     sp->ready = 1;
-    if (sp->key && (src = ejsCacheReadObj(ejs, sp->cache, sp->key, 0)) != 0) {
+    if (sp->key && (src = readSessionState(ejs, sp)) != 0 && ejsIsPot(ejs, src)) {
         sp->pot.numProp = 0;
         count = ejsGetLength(ejs, src);
         for (i = 0; i < count; i++) {
@@ -152,19 +194,49 @@ static int lookupSessionProperty(Ejs *ejs, EjsSession *sp, EjsName qname)
 
 
 /*
-    Set a session property with write-through to the key/value cache
+    Set a session property. The session is marked as modified and is saved when the request completes.
  */
 static int setSessionProperty(Ejs *ejs, EjsSession *sp, int slotNum, EjsAny *value)
 {
     if (ejs->service->potHelpers.setProperty(ejs, sp, slotNum, value) != slotNum) {
         return EJS_ERR;
     }
+    sp->dirty = 1;
+    return 0;
+}
+
+
+/*
+    Save modified session state. A local cache stores a copy of the session in native form. Other cache backends store 
+    the session using the compact binary encoding in base64.
+ */
+int ejsSaveSession(Ejs *ejs, EjsSession *sp)
+{
+    EjsString   *data;
+    MprBuf      *buf;
+    cchar       *encoded;
+
+    if (!sp || !sp->dirty || !sp->key) {
+        return 0;
+    }
+    sp->dirty = 0;
     if (sp->options == 0) {
         sp->options = ejsCreateEmptyPot(ejs);
         ejsSetPropertyByName(ejs, sp->options, EN("lifespan"), 
             ejsCreateNumber(ejs, (MprNumber) (sp->timeout / TPS)));
     }
-    if (ejsCacheWriteObj(ejs, sp->cache, sp->key, sp, sp->options) == 0) {
+    if (sp->local) {
+        if (ejsWriteLocalCacheObj(ejs, sp->local, sp->key, sp, sp->options) == 0) {
+            return EJS_ERR;
+        }
+        return 0;
+    }
+    if ((buf = ejsEncodeValue(ejs, sp)) == 0) {
+        return EJS_ERR;
+    }
+    encoded = mprEncode64Block(mprGetBufStart(buf), mprGetBufLength(buf));
+    data = ejsCreateStringFromAsc(ejs, sjoin(SESSION_ENCODED, encoded, NULL));
+    if (ejsCacheWrite(ejs, sp->cache, sp->key, data, sp->options) == 0) {
         return EJS_ERR;
     }
     return 0;
@@ -176,6 +248,8 @@ static int setSessionProperty(Ejs *ejs, EjsSession *sp, int slotNum, EjsAny *val
  */
 void ejsSetSessionTimeout(Ejs *ejs, EjsSession *sp, MprTicks timeout)
 {
+    sp->timeout = timeout;
+    sp->options = 0;
     ejsCacheExpire(ejs, sp->cache, sp->key, ejsCreateDate(ejs, mprGetTime() + timeout));
 }
 
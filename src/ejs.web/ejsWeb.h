@@ -51,7 +51,14 @@ typedef struct EjsHttpServer {
     int             async;                      /**< Async mode */
     int             port;                       /**< Listening port */
     int             hosted;                     /**< Server being hosted inside a web server */
+    int             reusePort;                  /**< Share the listening port with other processes */
     struct EjsHttpServer *cloned;               /**< Server that was cloned */
+    struct MprSignal *reloadSignal;             /**< SIGHUP handler to reload worker processes */
+    struct EjsPool  *workers;                   /**< Pool of worker interpreters for threaded requests */
+    MprList         *pendingRequests;           /**< Threaded requests waiting for a worker interpreter */
+    int             workersMin;                 /**< Minimum number of idle worker interpreters to retain */
+    int             cacheWorkers;               /**< Reuse worker interpreters for subsequent requests */
+    int             workerQueue;                /**< Maximum number of pending threaded requests */
     EjsObj          *emitter;                   /**< Event emitter */
     EjsObj          *limits;                    /**< Limits object */
     EjsArray        *incomingStages;            /**< Incoming Http pipeline stages */
@@ -150,15 +157,17 @@ extern EjsRequest *ejsCreateRequest(Ejs *ejs, EjsHttpServer *server, HttpConn *c
         that persists beyond a single request.
     @stability Prototype
     @defgroup EjsSession EjsSession
-    @see EjsSession ejsGetSession ejsDestroySession
+    @see EjsSession ejsGetSession ejsDestroySession ejsSaveSession
  */
 typedef struct EjsSession {
     EjsPot      pot;                /* Session properties */
     EjsString   *key;               /* Session ID key */
     EjsObj      *cache;             /* Cache store reference */
+    EjsObj      *local;             /* Local cache adapter if session state is stored in native form */
     EjsObj      *options;           /* Default write options */
     MprTicks    timeout;            /* Session inactivity timeout (msecs) */
     int         ready;              /* Data cached from store into pot */
+    int         dirty;              /* Properties modified since the session was last saved */
 } EjsSession;
 
 /** 
@@ -180,6 +189,18 @@ extern EjsSession *ejsGetSession(Ejs *ejs, EjsString *key, MprTicks timeout, int
  */
 extern int ejsDestroySession(Ejs *ejs, EjsSession *session);
 
+/** 
+    Save a session to the session store
+    @description Updates to session properties are batched and saved once when the request completes. This call saves
+        the session if any properties have been modified since it was last saved. Sessions are stored in native form in a
+        local cache and are encoded using a compact binary format for other cache backends.
+    @param ejs Ejs interpreter handle returned from $ejsCreate
+    @param sp Session object
+    @return Zero if successful, otherwise a negative MPR error code.
+    @ingroup EjsSession
+ */
+extern int ejsSaveSession(Ejs *ejs, EjsSession *sp);
+
 /** 
     Set a session timeout
     @param ejs Ejs interpreter handle returned from $ejsCreate
@@ -0,0 +1,34 @@
+/*
+    Test write() of large strings that are queued by reference and interleaved with small writes
+ */
+require ejs.web
+
+const HTTP = App.config.uris.http
+const COUNT = 5
+
+server = new HttpServer
+server.listen(HTTP)
+load("../utils.es")
+
+let big = "x".times(4000)
+let expected = ""
+for (i in COUNT) {
+    expected += big + "<" + i + ">"
+}
+
+server.on("readable", function (event, request: Request) {
+    for (i in COUNT) {
+        write(big)
+        write("<" + i + ">")
+    }
+    finalize()
+})
+
+let http = new Http
+http.get(HTTP + "/index.html")
+http.wait()
+assert(http.status == 200)
+assert(http.response.length == expected.length)
+assert(http.response == expected)
+http.close()
+server.close()
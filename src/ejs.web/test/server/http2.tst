@@ -0,0 +1,125 @@
+/*
+    Test HTTP/2 over cleartext (h2c prior knowledge) using hand-built frames
+    The frames are sent over a plain Socket, so no external HTTP/2 client or Python packages are required.
+ */
+require ejs.web
+
+const HTTP = App.config.uris.http
+const TIMEOUT = 10000
+load("../utils.es")
+
+const PREFACE = "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n"
+const DATA = 0, HEADERS = 1, RST_STREAM = 3, SETTINGS = 4, GOAWAY = 7
+const END_STREAM = 0x1, END_HEADERS = 0x4, ACK = 0x1
+
+server = new HttpServer
+server.on("readable", function (event, request) {
+    write("Hello " + pathInfo)
+    finalize()
+})
+server.listen(HTTP)
+
+/*
+    Frame header fields are big endian and are written a byte at a time
+ */
+function frame(type: Number, flags: Number, stream: Number, payload: ByteArray? = null): ByteArray {
+    let length = payload ? payload.length : 0
+    let ba = new ByteArray
+    ba.writeByte(length >> 16)
+    ba.writeByte((length >> 8) & 0xff)
+    ba.writeByte(length & 0xff)
+    ba.writeByte(type)
+    ba.writeByte(flags)
+    for each (shift in [24, 16, 8, 0]) {
+        ba.writeByte((stream >> shift) & 0xff)
+    }
+    if (payload) {
+        ba.write(payload)
+    }
+    return ba
+}
+
+function literal(ba: ByteArray, index: Number, value: String) {
+    //  Literal header field without indexing, indexed name (RFC 7541 6.2.2)
+    ba.writeByte(index)
+    ba.writeByte(value.length)
+    ba.write(value)
+}
+
+/*
+    Request headers for a GET using the HPACK static table: :method GET (2), :scheme http (6), :path (4), :authority (1)
+ */
+function get(stream: Number, path: String): ByteArray {
+    let block = new ByteArray
+    block.writeByte(0x82)
+    block.writeByte(0x86)
+    literal(block, 4, path)
+    literal(block, 1, Uri(HTTP).address)
+    return frame(HEADERS, END_STREAM | END_HEADERS, stream, block)
+}
+
+let client = new Socket
+client.async = true
+client.connect(Uri(HTTP).address)
+client.write(PREFACE)
+client.write(frame(SETTINGS, 0, 0))
+client.write(get(1, "/one"))
+client.write(get(3, "/two"))
+
+/*
+    Read frames until both streams complete
+ */
+let input = new ByteArray
+let responses = {}
+let settings = false, complete = 0
+let mark = new Date
+while (complete < 2 && mark.elapsed < TIMEOUT) {
+    App.run(10, true)
+    client.read(input, -1)
+    while (input.length >= 9) {
+        let start = input.readPosition
+        let length = (input.readByte() << 16) | (input.readByte() << 8) | input.readByte()
+        let type = input.readByte()
+        let flags = input.readByte()
+        let stream = 0
+        for (i in 4) {
+            stream = (stream << 8) | input.readByte()
+        }
+        stream &= 0x7fffffff
+        if (input.length < length) {
+            input.readPosition = start
+            break
+        }
+        let payload = new ByteArray
+        if (length > 0) {
+            input.read(payload, 0, length)
+        }
+        assert(type != RST_STREAM && type != GOAWAY)
+        if (type == SETTINGS && !(flags & ACK)) {
+            settings = true
+            client.write(frame(SETTINGS, ACK, 0))
+        } else if (type == HEADERS) {
+            //  Indexed :status 200 from the HPACK static table
+            assert(payload.readByte() == 0x88)
+            responses[stream] = ""
+        } else if (type == DATA) {
+            responses[stream] += payload.readString()
+        }
+        if ((type == HEADERS || type == DATA) && (flags & END_STREAM)) {
+            complete++
+        }
+    }
+    input.reset()
+}
+client.close()
+assert(settings)
+assert(complete == 2)
+assert(responses[1] == "Hello /one")
+assert(responses[3] == "Hello /two")
+
+//  HTTP/1.1 is still served on the same endpoint
+let http = fetch(HTTP + "/three")
+assert(http.response == "Hello /three")
+http.close()
+
+server.close()
@@ -0,0 +1,14 @@
+/*
+    Worker process server for prefork.tst
+
+    Respond with the worker process index and pid
+ */
+require ejs.web
+
+let server = new HttpServer
+server.on("readable", function (event, request) {
+    write(App.getenv(HttpServer.WorkerProcessEnv) + " " + App.pid)
+    finalize()
+})
+server.listen(App.config.uris.http)
+App.run()
@@ -0,0 +1,70 @@
+/*
+    Test pre-forked worker processes. The supervisor runs prefork.es in each worker process.
+ */
+require ejs.web
+
+const HTTP = App.config.uris.http
+const PROCESSES = 2
+
+//  Worker processes need a worker script or command
+let caught
+try {
+    new HttpServer({workers: {processes: PROCESSES}}).listen(HTTP)
+} catch (e) {
+    caught = e is ArgError
+}
+assert(caught)
+
+HttpServer.RestartDelay = 100
+server = new HttpServer({workers: {processes: PROCESSES, script: "prefork.es"}})
+server.listen(HTTP)
+
+/*
+    Request until a worker process responds with a process index that satisfies the accept function.
+    Returns the [index, pid] of the responding worker.
+ */
+function request(accept): Array? {
+    let mark = new Date
+    while (mark.elapsed < 30000) {
+        let http = new Http
+        try {
+            http.retries = 0
+            http.get(HTTP)
+            http.wait(5000)
+            if (http.status == Http.Ok) {
+                let [index, pid] = http.response.split(" ")
+                if (accept(index, pid)) {
+                    http.close()
+                    return [index, pid]
+                }
+            }
+        } catch {}
+        http.close()
+        App.sleep(10)
+    }
+    return null
+}
+
+//  Requests are served by all the worker processes and not by the supervisor
+let pids = []
+for (i in PROCESSES) {
+    let result = request(function(index, pid) pids[index] == null)
+    assert(result != null)
+    let [index, pid] = result
+    assert(index >= 0 && index < PROCESSES)
+    assert(pid != App.pid)
+    pids[index] = pid
+}
+
+//  Worker processes that exit are restarted
+for each (pid in pids) {
+    Cmd.kill(pid, 9)
+}
+let result = request(function(index, pid) !pids.contains(pid))
+assert(result != null)
+
+//  Closing the supervisor stops the worker processes and frees the endpoint
+server.close()
+server = new HttpServer
+server.listen(HTTP)
+server.close()
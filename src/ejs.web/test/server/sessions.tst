@@ -9,6 +9,14 @@ load("../utils.es")
 server = new HttpServer
 
 server.on("readable", function (event, request) {
+    if (pathInfo == "/cart") {
+        let cart = session["cart"]
+        write(cart ? (cart.items.join(",") + " " + cart.owner.name + " " + session["count"]) : "")
+        session["cart"] = {items: [1, 2, 3], owner: {name: "joe"}}
+        session["count"] = (session["count"] || 0) + 1
+        finalize()
+        return
+    }
     let old = session["value"]
     session["value"] = 42
     write(old)
@@ -51,5 +59,90 @@ assert(http.response == "")
 http.close()
 
 
+
+//  Nested session state and multiple updates in one request are saved when the request completes
+http = fetch(HTTP + "/cart")
+assert(http.response == "")
+cookie = http.sessionCookie
+http.close()
+
+http = new Http
+http.setCookie(cookie)
+http.get(HTTP + "/cart")
+http.wait(30 * 1000)
+assert(http.response == "1,2,3 joe 1")
+http.close()
+server.close()
+
+
+/*
+    Cache that is not backed by the native local cache. Stores values as given.
+ */
+class StoreCache extends Cache {
+    var store = {}
+    var writes = 0
+    override public function expire(key: String, when: Date?): Boolean true
+    override public function read(key: String, options: Object = null): String? store[key]
+    override public function remove(key: String): Boolean delete store[key]
+    override public function write(key: String, value: String, options: Object = null): Number? {
+        store[key] = value
+        writes++
+        return value.length
+    }
+}
+let cache = App.cache = new StoreCache
+
+//  Sessions are saved when the request is finalized, before the response completes
+let saved
+server = new HttpServer
+server.on("readable", function (event, request) {
+    let writes = cache.writes
+    session["cart"] = {items: [1, 2, 3], count: 0x10000, price: 1.5}
+    finalize()
+    saved = cache.writes > writes
+})
+server.listen(HTTP)
+
+http = fetch(HTTP + "/")
+assert(saved)
+cookie = http.sessionCookie
+http.close()
+
+//  Stored session data is base64 text and reads back intact
+let stored = 0
+for each (data in cache.store) {
+    assert(data is String)
+    assert(data.slice(1).match(/^[A-Za-z0-9+\/]+=*$/) != null)
+    stored++
+}
+assert(stored == 1)
+
+server.close()
+server = new HttpServer
+server.on("readable", function (event, request) {
+    let cart = session["cart"]
+    write(cart ? (cart.items.join(",") + " " + cart.count + " " + cart.price) : "none")
+    finalize()
+})
+server.listen(HTTP)
+
+http = new Http
+http.setCookie(cookie)
+http.get(HTTP + "/")
+http.wait(30 * 1000)
+assert(http.response == "1,2,3 65536 1.5")
+http.close()
+
+//  Stored data that transfers a buffer pointer is rejected. This is {cart: <buffer at 0x4141414141414141>}.
+for (key in cache.store) {
+    cache.store[key] = "\x01gQgBAAAACQRjYXJ0DUFBQUFBQUFBEAAQ"
+}
+http = new Http
+http.setCookie(cookie)
+http.get(HTTP + "/")
+http.wait(30 * 1000)
+assert(http.response == "none")
+http.close()
+
 server.close()
 
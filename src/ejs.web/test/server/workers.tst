@@ -0,0 +1,49 @@
+/*
+    Test threaded request queueing when all worker interpreters are busy
+ */
+require ejs.web
+
+const HTTP = App.config.uris.http
+load("../utils.es")
+
+server = new HttpServer
+server.setLimits({ workers: 1, workerQueue: 1 })
+
+//  Runs in the worker interpreter. Hold the worker so later requests must queue.
+server.onrequest = function (request) {
+    App.sleep(500)
+    request.write("done")
+    request.finalize()
+}
+
+server.on("readable", function (event, request) {
+    if (!server.passRequest(request)) {
+        request.writeError(Http.ServiceUnavailable, "Server busy")
+    }
+})
+server.listen(HTTP)
+
+//  First request occupies the only worker, the second is queued and the third is rejected
+let requests = []
+for (i in 3) {
+    let http = new Http
+    http.retries = 0
+    http.get(HTTP)
+    requests.push(http)
+    App.run(100)
+}
+let ok = 0, busy = 0
+for each (http in requests) {
+    http.wait(30000)
+    if (http.status == Http.Ok) {
+        assert(http.response == "done")
+        ok++
+    } else if (http.status == Http.ServiceUnavailable) {
+        busy++
+    }
+    http.close()
+}
+assert(ok == 2)
+assert(busy == 1)
+
+server.close()
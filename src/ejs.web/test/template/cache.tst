@@ -0,0 +1,75 @@
+/*
+    cache.tst -- Compiled template cache
+ */
+require ejs.web
+
+let dir = Path("cache-test").absolute
+dir.removeAll()
+dir.join("cache").makeDir()
+App.config.cache.app.enable = true
+App.config.cache.app.reload = true
+App.config.dirs.cache = dir.join("cache")
+
+let r = new Request("/index.html")
+let config = r.config
+
+//  The cache is bounded and discards the least recently used template
+TemplateCache.clear()
+let max = TemplateCache.MaxTemplates
+for (i in max) {
+    TemplateCache.add("key-" + i, function() {}, [])
+}
+assert(TemplateCache.length == max)
+App.sleep(10)
+assert(TemplateCache.lookup("key-0", config))
+TemplateCache.add("key-" + max, function() {}, [])
+assert(TemplateCache.length == max)
+assert(TemplateCache.lookup("key-0", config))
+assert(TemplateCache.lookup("key-1", config) == null)
+
+//  Literal templates are cached in memory only
+TemplateCache.clear()
+assert(TemplateBuilder(r, {literal: "<%= 1 + 2 %>"}) is Function)
+assert(TemplateCache.length == 1)
+assert(dir.join("cache").files().length == 0)
+
+//  Changing the layout of a literal template does not remove a module cached for the layout path
+let layout = dir.join("layout.ejs")
+layout.write("<html><%@ content %></html>")
+let layoutModule = Loader.cached(layout, config)
+layoutModule.write("")
+assert(TemplateBuilder(r, {literal: "Hello", layout: layout}) is Function)
+App.sleep(1100)
+layout.write("<body><%@ content %></body>")
+assert(TemplateBuilder(r, {literal: "Hello", layout: layout}) is Function)
+assert(layoutModule.exists)
+
+//  Dependencies are saved with the module and used when the module is reused
+let page = dir.join("page.ejs")
+let part = dir.join("part.ejs")
+page.write('<%@ include "part.ejs" %>')
+part.write("one")
+r.filename = page
+TemplateBuilder(r)
+let pageModule = Loader.cached(page, config)
+assert(pageModule.exists)
+assert(pageModule.replaceExt("deps").exists)
+
+TemplateCache.clear()
+TemplateBuilder(r)
+App.sleep(1100)
+part.write("two")
+assert(TemplateCache.lookup(page + "|" + undefined, config) == null)
+assert(!pageModule.exists)
+
+//  A dependency modified while the module was not in memory forces a rebuild
+TemplateBuilder(r)
+assert(pageModule.exists)
+TemplateCache.clear()
+App.sleep(1100)
+part.write("three")
+TemplateBuilder(r)
+assert(pageModule.exists)
+assert(pageModule.modified >= part.modified)
+
+dir.removeAll()
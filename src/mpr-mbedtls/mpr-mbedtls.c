@@ -27,6 +27,8 @@ typedef struct MbedConfig {
     mbedtls_x509_crl            revoke;         /* Certificate revoke list */
     mbedtls_ssl_config          conf;           /* SSL configuration */
     int                         *ciphers;       /* Set of acceptable ciphers - null terminated */
+    char                        **alpn;         /* ALPN protocols - null terminated */
+    char                        *alpnNames;     /* Storage for the ALPN protocol names */
 } MbedConfig;
 
 
@@ -53,6 +55,7 @@ static int                      mbedLogLevel;   /* MPR log level to start SSL tr
 static void     closeMbed(MprSocket *sp, bool gracefully);
 static void     disconnectMbed(MprSocket *sp);
 static void     freeMbedLock(mbedtls_threading_mutex_t *tm);
+static char     **getAlpnList(MbedConfig *cfg, cchar *protocols);
 static int      *getCipherSuite(MprSsl *ssl);
 static char     *getMbedState(MprSocket *sp);
 static int      getPeerCertInfo(MprSocket *sp);
@@ -151,6 +154,8 @@ static void manageMbedConfig(MbedConfig *cfg, int flags)
 {
     if (flags & MPR_MANAGE_MARK) {
         mprMark(cfg->ciphers);
+        mprMark(cfg->alpn);
+        mprMark(cfg->alpnNames);
 
     } else if (flags & MPR_MANAGE_FREE) {
         mbedtls_pk_free(&cfg->key);
@@ -303,6 +308,14 @@ static int configMbed(MprSsl *ssl, int flags, char **errorMsg)
     if (flags & MPR_SOCKET_SERVER && ssl->matchSsl) {
         mbedtls_ssl_conf_sni(mconf, sniCallback, 0);
     }
+#if defined(MBEDTLS_SSL_ALPN)
+    if (ssl->alpn && (cfg->alpn = getAlpnList(cfg, ssl->alpn)) != 0) {
+        if ((rc = mbedtls_ssl_conf_alpn_protocols(mconf, (cchar**) cfg->alpn)) < 0) {
+            merror(rc, "Cannot define ALPN protocols");
+            return MPR_ERR_CANT_INITIALIZE;
+        }
+    }
+#endif
     ssl->changed = 0;
     return 0;
 }
@@ -468,6 +481,7 @@ static int getPeerCertInfo(MprSocket *sp)
     mbedtls_ssl_context     *ctx;
     const mbedtls_x509_crt  *peer;
     mbedtls_ssl_session     *session;
+    cchar                   *protocol;
     ssize                   len;
     int                     i;
     char                    cbuf[5120], *cp, *end;
@@ -502,6 +516,11 @@ static int getPeerCertInfo(MprSocket *sp)
         }
     }
     sp->cipher = replaceHyphen(sclone(mbedtls_ssl_get_ciphersuite(ctx)), '-', '_');
+#if defined(MBEDTLS_SSL_ALPN)
+    if ((protocol = mbedtls_ssl_get_alpn_protocol(ctx)) != 0) {
+        sp->protocol = sclone(protocol);
+    }
+#endif
 
     /*
         Convert session into a string
@@ -833,6 +852,28 @@ static int *getCipherSuite(MprSsl *ssl)
 }
 
 
+/*
+    Convert a comma separated protocol list into the null terminated array required by mbedtls.
+    The array and names are retained in the config as mbedtls does not copy them.
+ */
+static char **getAlpnList(MbedConfig *cfg, cchar *protocols)
+{
+    char    **list, *name, *next;
+    int     count;
+
+    cfg->alpnNames = sclone(protocols);
+    count = (int) (slen(protocols) / 2) + 2;
+    if ((list = mprAllocZeroed(count * sizeof(char*))) == 0) {
+        return 0;
+    }
+    count = 0;
+    for (next = cfg->alpnNames; (name = stok(next, ", \t", &next)) != 0; ) {
+        list[count++] = name;
+    }
+    return count ? list : 0;
+}
+
+
 static int parseCert(mbedtls_x509_crt *cert, cchar *path, char **errorMsg)
 {
     uchar   *buf;
@@ -165,6 +165,8 @@ static CipherMap cipherMap[] = {
 typedef struct OpenConfig {
     SSL_CTX         *ctx;
     DH              *dhKey;
+    uchar           *alpn;
+    int             alpnLen;
     int             clearFlags;
     int             setFlags;
 } OpenConfig;
@@ -227,6 +229,7 @@ static DH       *dhcallback(SSL *ssl, int isExport, int keyLength);
 static void     disconnectOss(MprSocket *sp);
 static ssize    flushOss(MprSocket *sp);
 static DH       *getDhKey();
+static void     setAlpn(OpenConfig *cfg, SSL_CTX *ctx, cchar *protocols, int flags);
 static char     *getOssSession(MprSocket *sp);
 static char     *getOssState(MprSocket *sp);
 static char     *getOssError(MprSocket *sp);
@@ -317,7 +320,7 @@ PUBLIC int mprSslInit(void *unused, MprModule *module)
 static void manageOpenConfig(OpenConfig *cfg, int flags)
 {
     if (flags & MPR_MANAGE_MARK) {
-        /* Nothing to do  */
+        mprMark(cfg->alpn);
 
     } else if (flags & MPR_MANAGE_FREE) {
         if (cfg->ctx != 0) {
@@ -612,6 +615,10 @@ static int configOss(MprSsl *ssl, int flags, char **errorMsg)
     SSL_CTX_set_options(ctx, cfg->setFlags);
     SSL_CTX_clear_options(ctx, cfg->clearFlags);
 
+    if (ssl->alpn) {
+        setAlpn(cfg, ctx, ssl->alpn, flags);
+    }
+
     cfg->ctx = ctx;
     ssl->changed = 0;
     ssl->config = cfg;
@@ -1260,14 +1267,73 @@ static int sniHostname(SSL *handle, int *ad, void *arg)
 }
 
 
+#if OPENSSL_VERSION_NUMBER >= 0x10002000L
+/*
+    Server side ALPN selection. Choose the first configured protocol that the client also offers.
+ */
+static int selectAlpn(SSL *handle, cuchar **out, uchar *outlen, cuchar *in, uint inlen, void *arg)
+{
+    OpenConfig  *cfg;
+
+    cfg = arg;
+    if (SSL_select_next_proto((uchar**) out, outlen, cfg->alpn, cfg->alpnLen, in, inlen) != OPENSSL_NPN_NEGOTIATED) {
+        return SSL_TLSEXT_ERR_NOACK;
+    }
+    return SSL_TLSEXT_ERR_OK;
+}
+#endif
+
+
+/*
+    Convert a comma separated protocol list into the length-prefixed wire format
+ */
+static void setAlpn(OpenConfig *cfg, SSL_CTX *ctx, cchar *protocols, int flags)
+{
+#if OPENSSL_VERSION_NUMBER >= 0x10002000L
+    char    *name, *next;
+    ssize   len;
+    int     pos;
+
+    if ((cfg->alpn = mprAlloc(slen(protocols) + 1)) == 0) {
+        return;
+    }
+    pos = 0;
+    for (next = sclone(protocols); (name = stok(next, ", \t", &next)) != 0; ) {
+        if ((len = slen(name)) > 255) {
+            continue;
+        }
+        cfg->alpn[pos++] = (uchar) len;
+        memcpy(&cfg->alpn[pos], name, len);
+        pos += (int) len;
+    }
+    cfg->alpnLen = pos;
+    if (flags & MPR_SOCKET_SERVER) {
+        SSL_CTX_set_alpn_select_cb(ctx, selectAlpn, cfg);
+    } else {
+        SSL_CTX_set_alpn_protos(ctx, cfg->alpn, cfg->alpnLen);
+    }
+#endif
+}
+
+
 static void setSecured(MprSocket *sp)
 {
     OpenSocket    *osp;
+#if OPENSSL_VERSION_NUMBER >= 0x10002000L
+    cuchar        *protocol;
+    uint          len;
+#endif
 
     sp->secured = 1;
     osp = sp->sslSocket;
     sp->cipher = sclone(SSL_get_cipher(osp->handle));
     sp->session = getOssSession(sp);
+#if OPENSSL_VERSION_NUMBER >= 0x10002000L
+    SSL_get0_alpn_selected(osp->handle, &protocol, &len);
+    if (len > 0) {
+        sp->protocol = snclone((cchar*) protocol, len);
+    }
+#endif
 }
 
 
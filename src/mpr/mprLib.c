@@ -4184,6 +4184,7 @@ PUBLIC void mprAtomicListInsert(void **head, void **link, void *item)
 /********************************** Forwards **********************************/
 
 static void manageBuf(MprBuf *buf, int flags);
+static void manageRefBuf(MprBuf *buf, int flags);
 
 /*********************************** Code *************************************/
 /*
@@ -4215,6 +4216,32 @@ static void manageBuf(MprBuf *bp, int flags)
 }
 
 
+/*
+    Create a read-only buffer over external data. The data is not marked (it may be an interior pointer), the owner is.
+ */
+PUBLIC MprBuf *mprCreateRefBuf(cvoid *data, ssize len, cvoid *owner)
+{
+    MprBuf      *bp;
+
+    if ((bp = mprAllocObj(MprBuf, manageRefBuf)) == 0) {
+        return 0;
+    }
+    bp->data = bp->start = (char*) data;
+    bp->end = bp->endbuf = &bp->data[len];
+    bp->buflen = bp->maxsize = len;
+    bp->refillArg = (void*) owner;
+    return bp;
+}
+
+
+static void manageRefBuf(MprBuf *bp, int flags)
+{
+    if (flags & MPR_MANAGE_MARK) {
+        mprMark(bp->refillArg);
+    }
+}
+
+
 PUBLIC MprBuf *mprCloneBuf(MprBuf *orig)
 {
     MprBuf      *bp;
@@ -20099,6 +20126,7 @@ typedef struct MprEjsString {
 #endif
     void            *next;
     void            *prev;
+    uint            hash;
     ssize           length;
     wchar         value[0];
 } MprEjsString;
@@ -22203,6 +22231,7 @@ static void manageSocket(MprSocket *sp, int flags)
         mprMark(sp->peerName);
         mprMark(sp->peerCert);
         mprMark(sp->peerCertIssuer);
+        mprMark(sp->protocol);
         mprMark(sp->provider);
         mprMark(sp->ssl);
         mprMark(sp->sslSocket);
@@ -22277,7 +22306,7 @@ PUBLIC Socket mprListenOnSocket(MprSocket *sp, cchar *ip, int port, int flags)
     sp->fd = INVALID_SOCKET;
     sp->port = port;
     sp->flags = (flags & (MPR_SOCKET_BROADCAST | MPR_SOCKET_DATAGRAM | MPR_SOCKET_BLOCK |
-         MPR_SOCKET_NOREUSE | MPR_SOCKET_NODELAY | MPR_SOCKET_THREAD));
+         MPR_SOCKET_NOREUSE | MPR_SOCKET_NODELAY | MPR_SOCKET_THREAD | MPR_SOCKET_REUSE_PORT));
     datagram = sp->flags & MPR_SOCKET_DATAGRAM;
 
     /*
@@ -22309,12 +22338,14 @@ PUBLIC Socket mprListenOnSocket(MprSocket *sp, cchar *ip, int port, int flags)
         if (setsockopt(sp->fd, SOL_SOCKET, SO_REUSEADDR, (char*) &enable, sizeof(enable)) != 0) {
             mprLog("error mpr socket", 3, "Cannot set reuseaddr, errno %d", errno);
         }
-#if defined(SO_REUSEPORT) && KEEP
+#if defined(SO_REUSEPORT)
         /*
-            This permits multiple servers listening on the same endpoint
+            This permits multiple servers listening on the same endpoint. The kernel balances connections among them.
          */
-        if (setsockopt(sp->fd, SOL_SOCKET, SO_REUSEPORT, (char*) &enable, sizeof(enable)) != 0) {
-            mprLog("error mpr socket", 3, "Cannot set reuseport, errno %d", errno);
+        if (sp->flags & MPR_SOCKET_REUSE_PORT) {
+            if (setsockopt(sp->fd, SOL_SOCKET, SO_REUSEPORT, (char*) &enable, sizeof(enable)) != 0) {
+                mprLog("error mpr socket", 3, "Cannot set reuseport, errno %d", errno);
+            }
         }
 #endif
 #elif ME_WIN_LIKE && defined(SO_EXCLUSIVEADDRUSE)
@@ -23687,6 +23718,7 @@ PUBLIC void mprSetSocketPrebindCallback(MprSocketPrebind callback)
 static void manageSsl(MprSsl *ssl, int flags)
 {
     if (flags & MPR_MANAGE_MARK) {
+        mprMark(ssl->alpn);
         mprMark(ssl->certFile);
         mprMark(ssl->caFile);
         mprMark(ssl->caPath);
@@ -23842,6 +23874,14 @@ PUBLIC void mprAddSslCiphers(MprSsl *ssl, cchar *ciphers)
 }
 
 
+PUBLIC void mprSetSslAlpn(MprSsl *ssl, cchar *protocols)
+{
+    assert(ssl);
+    ssl->alpn = (protocols && *protocols) ? sclone(protocols) : 0;
+    ssl->changed = 1;
+}
+
+
 PUBLIC void mprSetSslCaFile(MprSsl *ssl, cchar *caFile)
 {
     assert(ssl);
@@ -26,39 +26,61 @@
 #define ES_ejs_db_sqlite_Sqlite_DataTypeToSqlType                      1
 #define ES_ejs_db_sqlite_Sqlite_SqlTypeToDataType                      2
 #define ES_ejs_db_sqlite_Sqlite_SqlTypeToEjsType                       3
-#define ES_ejs_db_sqlite_Sqlite_NUM_CLASS_PROP                         4
+#define ES_ejs_db_sqlite_Sqlite_poolStats                              4
+#define ES_ejs_db_sqlite_Sqlite_NUM_CLASS_PROP                         5
 
 /*
    Prototype (instance) slots for "Sqlite" type 
  */
 #define ES_ejs_db_sqlite_Sqlite_addColumn                              0
 #define ES_ejs_db_sqlite_Sqlite_addIndex                               1
-#define ES_ejs_db_sqlite_Sqlite_changeColumn                           2
-#define ES_ejs_db_sqlite_Sqlite_close                                  3
-#define ES_ejs_db_sqlite_Sqlite_commit                                 4
-#define ES_ejs_db_sqlite_Sqlite_connect                                5
-#define ES_ejs_db_sqlite_Sqlite_createDatabase                         6
-#define ES_ejs_db_sqlite_Sqlite_createTable                            7
-#define ES_ejs_db_sqlite_Sqlite_dataTypeToSqlType                      8
-#define ES_ejs_db_sqlite_Sqlite_destroyDatabase                        9
-#define ES_ejs_db_sqlite_Sqlite_destroyTable                           10
-#define ES_ejs_db_sqlite_Sqlite_endTransaction                         11
-#define ES_ejs_db_sqlite_Sqlite_getColumns                             12
-#define ES_ejs_db_sqlite_Sqlite_getNumRows                             13
-#define ES_ejs_db_sqlite_Sqlite_getTables                              14
-#define ES_ejs_db_sqlite_Sqlite_removeColumns                          15
-#define ES_ejs_db_sqlite_Sqlite_removeIndex                            16
-#define ES_ejs_db_sqlite_Sqlite_renameColumn                           17
-#define ES_ejs_db_sqlite_Sqlite_renameTable                            18
-#define ES_ejs_db_sqlite_Sqlite_rollback                               19
-#define ES_ejs_db_sqlite_Sqlite_query                                  20
-#define ES_ejs_db_sqlite_Sqlite_sql                                    21
-#define ES_ejs_db_sqlite_Sqlite_sqlTypeToDataType                      22
-#define ES_ejs_db_sqlite_Sqlite_sqlTypeToEjsType                       23
-#define ES_ejs_db_sqlite_Sqlite_startTransaction                       24
-#define ES_ejs_db_sqlite_Sqlite_NUM_INSTANCE_PROP                      25
+#define ES_ejs_db_sqlite_Sqlite_batch                                  2
+#define ES_ejs_db_sqlite_Sqlite_cachedSql                              3
+#define ES_ejs_db_sqlite_Sqlite_changeColumn                           4
+#define ES_ejs_db_sqlite_Sqlite_close                                  5
+#define ES_ejs_db_sqlite_Sqlite_commit                                 6
+#define ES_ejs_db_sqlite_Sqlite_connect                                7
+#define ES_ejs_db_sqlite_Sqlite_createDatabase                         8
+#define ES_ejs_db_sqlite_Sqlite_createTable                            9
+#define ES_ejs_db_sqlite_Sqlite_dataTypeToSqlType                      10
+#define ES_ejs_db_sqlite_Sqlite_destroyDatabase                        11
+#define ES_ejs_db_sqlite_Sqlite_destroyTable                           12
+#define ES_ejs_db_sqlite_Sqlite_endTransaction                         13
+#define ES_ejs_db_sqlite_Sqlite_getColumns                             14
+#define ES_ejs_db_sqlite_Sqlite_getNumRows                             15
+#define ES_ejs_db_sqlite_Sqlite_getTables                              16
+#define ES_ejs_db_sqlite_Sqlite_removeColumns                          17
+#define ES_ejs_db_sqlite_Sqlite_removeIndex                            18
+#define ES_ejs_db_sqlite_Sqlite_renameColumn                           19
+#define ES_ejs_db_sqlite_Sqlite_renameTable                            20
+#define ES_ejs_db_sqlite_Sqlite_rollback                               21
+#define ES_ejs_db_sqlite_Sqlite_prepare                                22
+#define ES_ejs_db_sqlite_Sqlite_query                                  23
+#define ES_ejs_db_sqlite_Sqlite_sql                                    24
+#define ES_ejs_db_sqlite_Sqlite_sqlTypeToDataType                      25
+#define ES_ejs_db_sqlite_Sqlite_sqlTypeToEjsType                       26
+#define ES_ejs_db_sqlite_Sqlite_startTransaction                       27
+#define ES_ejs_db_sqlite_Sqlite_NUM_INSTANCE_PROP                      28
 #define ES_ejs_db_sqlite_Sqlite_NUM_INHERITED_PROP                     0
 
-#define _ES_CHECKSUM_ejs_db_sqlite   73576
+
+/*
+    Class property slots for the "SqliteStatement" type 
+ */
+#define ES_ejs_db_sqlite_SqliteStatement_NUM_CLASS_PROP                0
+
+/*
+   Prototype (instance) slots for "SqliteStatement" type 
+ */
+#define ES_ejs_db_sqlite_SqliteStatement_bind                          0
+#define ES_ejs_db_sqlite_SqliteStatement_close                         1
+#define ES_ejs_db_sqlite_SqliteStatement_iterator_getValues            2
+#define ES_ejs_db_sqlite_SqliteStatement_reset                         3
+#define ES_ejs_db_sqlite_SqliteStatement_sql                           4
+#define ES_ejs_db_sqlite_SqliteStatement_step                          5
+#define ES_ejs_db_sqlite_SqliteStatement_NUM_INSTANCE_PROP             6
+#define ES_ejs_db_sqlite_SqliteStatement_NUM_INHERITED_PROP            0
+
+#define _ES_CHECKSUM_ejs_db_sqlite   88036
 
 #endif
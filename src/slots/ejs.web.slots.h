@@ -217,55 +217,68 @@
  */
 #define ES_ejs_web_HttpServer__initializer___HttpServer_               0
 #define ES_ejs_web_HttpServer_PrunePeriod                              1
-#define ES_ejs_web_HttpServer_defaultConfig                            2
-#define ES_ejs_web_HttpServer_initHttpServer                           3
-#define ES_ejs_web_HttpServer_indicies                                 4
-#define ES_ejs_web_HttpServer_create                                   5
-#define ES_ejs_web_HttpServer_NUM_CLASS_PROP                           6
+#define ES_ejs_web_HttpServer_WorkerProcessEnv                         2
+#define ES_ejs_web_HttpServer_RestartDelay                             3
+#define ES_ejs_web_HttpServer_SIGKILL                                  4
+#define ES_ejs_web_HttpServer_SIGTERM                                  5
+#define ES_ejs_web_HttpServer_StopTimeout                              6
+#define ES_ejs_web_HttpServer_defaultConfig                            7
+#define ES_ejs_web_HttpServer_initHttpServer                           8
+#define ES_ejs_web_HttpServer_indicies                                 9
+#define ES_ejs_web_HttpServer_create                                   10
+#define ES_ejs_web_HttpServer_NUM_CLASS_PROP                           11
 
 /*
    Prototype (instance) slots for "HttpServer" type 
  */
-#define ES_ejs_web_HttpServer_idleWorkers                              0
-#define ES_ejs_web_HttpServer_activeWorkers                            1
-#define ES_ejs_web_HttpServer_workerImage                              2
-#define ES_ejs_web_HttpServer_address                                  3
-#define ES_ejs_web_HttpServer_async                                    4
-#define ES_ejs_web_HttpServer_config                                   5
-#define ES_ejs_web_HttpServer_documents                                6
-#define ES_ejs_web_HttpServer_hostedDocuments                          7
-#define ES_ejs_web_HttpServer_hostedHome                               8
-#define ES_ejs_web_HttpServer_isSecure                                 9
-#define ES_ejs_web_HttpServer_hosted                                   10
-#define ES_ejs_web_HttpServer_limits                                   11
-#define ES_ejs_web_HttpServer_name                                     12
-#define ES_ejs_web_HttpServer_options                                  13
-#define ES_ejs_web_HttpServer_port                                     14
-#define ES_ejs_web_HttpServer_onrequest                                15
-#define ES_ejs_web_HttpServer_defaultOnRequest                         16
-#define ES_ejs_web_HttpServer_home                                     17
-#define ES_ejs_web_HttpServer_software                                 18
-#define ES_ejs_web_HttpServer_openSession                              19
-#define ES_ejs_web_HttpServer_accept                                   20
-#define ES_ejs_web_HttpServer_close                                    21
-#define ES_ejs_web_HttpServer_getWorker                                22
-#define ES_ejs_web_HttpServer_listen                                   23
+#define ES_ejs_web_HttpServer_workerProcesses                          0
+#define ES_ejs_web_HttpServer_supervising                              1
+#define ES_ejs_web_HttpServer_address                                  2
+#define ES_ejs_web_HttpServer_async                                    3
+#define ES_ejs_web_HttpServer_config                                   4
+#define ES_ejs_web_HttpServer_documents                                5
+#define ES_ejs_web_HttpServer_hostedDocuments                          6
+#define ES_ejs_web_HttpServer_hostedHome                               7
+#define ES_ejs_web_HttpServer_isSecure                                 8
+#define ES_ejs_web_HttpServer_hosted                                   9
+#define ES_ejs_web_HttpServer_limits                                   10
+#define ES_ejs_web_HttpServer_name                                     11
+#define ES_ejs_web_HttpServer_options                                  12
+#define ES_ejs_web_HttpServer_port                                     13
+#define ES_ejs_web_HttpServer_onrequest                                14
+#define ES_ejs_web_HttpServer_defaultOnRequest                         15
+#define ES_ejs_web_HttpServer_home                                     16
+#define ES_ejs_web_HttpServer_software                                 17
+#define ES_ejs_web_HttpServer_openSession                              18
+#define ES_ejs_web_HttpServer_accept                                   19
+#define ES_ejs_web_HttpServer_close                                    20
+#define ES_ejs_web_HttpServer_closeEndpoint                            21
+#define ES_ejs_web_HttpServer_listen                                   22
+#define ES_ejs_web_HttpServer_listenEndpoint                           23
 #define ES_ejs_web_HttpServer_off                                      24
 #define ES_ejs_web_HttpServer_on                                       25
 #define ES_ejs_web_HttpServer_passRequest                              26
-#define ES_ejs_web_HttpServer_process                                  27
-#define ES_ejs_web_HttpServer_processBody                              28
-#define ES_ejs_web_HttpServer_pruneWorkers                             29
-#define ES_ejs_web_HttpServer_releaseWorker                            30
-#define ES_ejs_web_HttpServer_run                                      31
-#define ES_ejs_web_HttpServer_secure                                   32
-#define ES_ejs_web_HttpServer_serve                                    33
-#define ES_ejs_web_HttpServer_setPipeline                              34
-#define ES_ejs_web_HttpServer_setLimits                                35
-#define ES_ejs_web_HttpServer_setWorkerImage                           36
-#define ES_ejs_web_HttpServer_trace                                    37
-#define ES_ejs_web_HttpServer_verifyClients                            38
-#define ES_ejs_web_HttpServer_NUM_INSTANCE_PROP                        39
+#define ES_ejs_web_HttpServer_prewarmWorkers                           27
+#define ES_ejs_web_HttpServer_process                                  28
+#define ES_ejs_web_HttpServer_processBody                              29
+#define ES_ejs_web_HttpServer_pruneWorkers                             30
+#define ES_ejs_web_HttpServer_reload                                   31
+#define ES_ejs_web_HttpServer_reusePort                                32
+#define ES_ejs_web_HttpServer_run                                      33
+#define ES_ejs_web_HttpServer_secure                                   34
+#define ES_ejs_web_HttpServer_serve                                    35
+#define ES_ejs_web_HttpServer_startWorkerProcesses                     36
+#define ES_ejs_web_HttpServer_stopWorkerProcesses                      37
+#define ES_ejs_web_HttpServer_startWorkerProcess                       38
+#define ES_ejs_web_HttpServer_trapSignals                              39
+#define ES_ejs_web_HttpServer_workerCommand                            40
+#define ES_ejs_web_HttpServer_setPipeline                              41
+#define ES_ejs_web_HttpServer_setLimits                                42
+#define ES_ejs_web_HttpServer_setWorkerImage                           43
+#define ES_ejs_web_HttpServer_trace                                    44
+#define ES_ejs_web_HttpServer_verifyClients                            45
+#define ES_ejs_web_HttpServer_watchSupervisor                          46
+#define ES_ejs_web_HttpServer_NUM_INSTANCE_PROP                        47
 #define ES_ejs_web_HttpServer_NUM_INHERITED_PROP                       0
 
 /*
@@ -525,6 +538,44 @@
 #define ES_ejs_web_Session_destorySession_session                      0
 
 
+/*
+    Class property slots for the "TemplateCache" type 
+ */
+#define ES_ejs_web_TemplateCache__initializer___TemplateCache_         0
+#define ES_ejs_web_TemplateCache_CheckPeriod                           1
+#define ES_ejs_web_TemplateCache_MaxTemplates                          2
+#define ES_ejs_web_TemplateCache_templates                             3
+#define ES_ejs_web_TemplateCache_count                                 4
+#define ES_ejs_web_TemplateCache_add                                   5
+#define ES_ejs_web_TemplateCache_lookup                                6
+#define ES_ejs_web_TemplateCache_readDependencies                      7
+#define ES_ejs_web_TemplateCache_writeDependencies                     8
+#define ES_ejs_web_TemplateCache_length                                9
+#define ES_ejs_web_TemplateCache_clear                                 10
+#define ES_ejs_web_TemplateCache_evict                                 11
+#define ES_ejs_web_TemplateCache_NUM_CLASS_PROP                        12
+
+/*
+   Prototype (instance) slots for "TemplateCache" type 
+ */
+#define ES_ejs_web_TemplateCache_NUM_INSTANCE_PROP                     0
+#define ES_ejs_web_TemplateCache_NUM_INHERITED_PROP                    0
+
+/*
+    Local slots for methods in type "TemplateCache" 
+ */
+#define ES_ejs_web_TemplateCache_add_key                               0
+#define ES_ejs_web_TemplateCache_add_app                               1
+#define ES_ejs_web_TemplateCache_add_files                             2
+#define ES_ejs_web_TemplateCache_add_cache                             3
+#define ES_ejs_web_TemplateCache_lookup_key                            0
+#define ES_ejs_web_TemplateCache_lookup_config                         1
+#define ES_ejs_web_TemplateCache_readDependencies_cache                0
+#define ES_ejs_web_TemplateCache_readDependencies_config               1
+#define ES_ejs_web_TemplateCache_writeDependencies_cache               0
+#define ES_ejs_web_TemplateCache_writeDependencies_dependencies        1
+
+
 /*
     Class property slots for the "UploadFile" type 
  */
@@ -619,6 +670,6 @@
 #define ES_ejs_web_View_plainFormatter_value                           1
 #define ES_ejs_web_View_plainFormatter_options                         2
 
-#define _ES_CHECKSUM_ejs_web   834053
+#define _ES_CHECKSUM_ejs_web   898500
 
 #endif
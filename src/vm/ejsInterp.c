@@ -841,7 +841,12 @@ static void VM(Ejs *ejs, EjsFunction *fun, EjsAny *otherThis, int argc, int stac
                 BREAK;
             }
             if (TYPE(vp)->numericIndicies && ejsIs(ejs, v1, Number)) {
-                vp = ejsGetProperty(ejs, vp, ejsGetInt(ejs, v1));
+                if (ejsIsTypedArray(ejs, vp)) {
+                    /* Unboxed elements: bypass the property helpers */
+                    vp = ejsGetTypedArrayElement(ejs, (EjsTypedArray*) vp, (int) ((EjsNumber*) v1)->value);
+                } else {
+                    vp = ejsGetProperty(ejs, vp, ejsGetInt(ejs, v1));
+                }
                 push(vp == 0 ? ESV(null) : vp);
                 BREAK;
             } else {
@@ -1058,7 +1063,11 @@ static void VM(Ejs *ejs, EjsFunction *fun, EjsAny *otherThis, int argc, int stac
             value = pop(ejs);
             //  TODO -- cleanup this too - push into storeProperty
             if (TYPE(obj)->numericIndicies && ejsIs(ejs, v1, Number)) {
-                ejsSetProperty(ejs, obj, ejsGetInt(ejs, v1), value);
+                if (ejsIsTypedArray(ejs, obj)) {
+                    ejsSetTypedArrayElement(ejs, (EjsTypedArray*) obj, (int) ((EjsNumber*) v1)->value, value);
+                } else {
+                    ejsSetProperty(ejs, obj, ejsGetInt(ejs, v1), value);
+                }
             } else {
                 qname.name = ejsToString(ejs, v1);
                 if (ejsIs(ejs, v2, Namespace)) {
@@ -45,6 +45,7 @@ static EjsService *createService()
     sp->mutex = mprCreateLock();
     sp->vmlist = mprCreateList(-1, MPR_LIST_STATIC_VALUES);
     sp->intern = ejsCreateIntern(sp);
+    sp->regexpCache = ejsCreateRegExpCache(sp);
     sp->dtoaSpin[0] = mprCreateSpinLock();
     sp->dtoaSpin[1] = mprCreateSpinLock();
     ejsInitCompiler(sp);
@@ -61,6 +62,7 @@ static void manageEjsService(EjsService *sp, int flags)
         mprMark(sp->vmlist);
         mprMark(sp->nativeModules);
         mprMark(sp->intern);
+        mprMark(sp->regexpCache);
         mprMark(sp->immutable);
         mprMark(sp->dtoaSpin[0]);
         mprMark(sp->dtoaSpin[1]);
@@ -286,7 +288,9 @@ static void manageEjs(Ejs *ejs, int flags)
         }
         mprMark(ejs->modules);
         mprMark(ejs->httpServers);
+        mprMark(ejs->httpServer);
         mprMark(ejs->doc);
+        mprMark(ejs->dateCache);
         mprMark(ejs->http);
         mprMark(ejs->mutex);
 
@@ -347,73 +351,100 @@ EjsPool *ejsCreatePool(int poolMax, cchar *templateScript, cchar *startScript, c
 }
 
 
-Ejs *ejsAllocPoolVM(EjsPool *pool, int flags)
+/*
+    Create a new pool interpreter. The template is created on first use. Called with the pool count already reserved.
+ */
+static Ejs *createPoolVM(EjsPool *pool, int flags)
 {
     Ejs         *ejs;
     EjsString   *script;
     int         paused;
 
-    assert(pool);
-
-    if ((ejs = mprPopItem(pool->list)) == 0) {
-        if (pool->count >= pool->max) {
-            mprLog("ejs vm", 0, "Too many ejs VMS: %d max %d", pool->count, pool->max);
+    lock(pool);
+    if (pool->template == 0) {
+        /*
+            Create the pool template VM
+         */
+        if ((pool->template = ejsCreateVM(0, 0, flags)) == 0) {
+            unlock(pool);
             return 0;
         }
-        lock(pool);
-        if (pool->template == 0) {
-            /*
-                Create the pool template VM
-             */
-            if ((pool->template = ejsCreateVM(0, 0, flags)) == 0) {
-                unlock(pool);
-                return 0;
-            }
-            if (ejsLoadModules(pool->template, 0, 0) < 0) {
+        if (ejsLoadModules(pool->template, 0, 0) < 0) {
+            unlock(pool);
+            return 0;
+        }
+        if (pool->templateScript) {
+            script = ejsCreateStringFromAsc(pool->template, pool->templateScript);
+            paused = ejsBlockGC(pool->template);
+            if (ejsLoadScriptLiteral(pool->template, script, NULL, EC_FLAGS_NO_OUT | EC_FLAGS_BIND) < 0) {
+                mprLog("ejs vm", 0, "Cannot execute \"%@\"\n%s", script, ejsGetErrorMsg(pool->template, 1));
                 unlock(pool);
-                return 0;
-            }
-            if (pool->templateScript) {
-                script = ejsCreateStringFromAsc(pool->template, pool->templateScript);
-                paused = ejsBlockGC(pool->template);
-                if (ejsLoadScriptLiteral(pool->template, script, NULL, EC_FLAGS_NO_OUT | EC_FLAGS_BIND) < 0) {
-                    mprLog("ejs vm", 0, "Cannot execute \"%@\"\n%s", script, ejsGetErrorMsg(pool->template, 1));
-                    unlock(pool);
-                    ejsUnblockGC(pool->template, paused);
-                    return 0;
-                }
                 ejsUnblockGC(pool->template, paused);
+                return 0;
             }
+            ejsUnblockGC(pool->template, paused);
         }
-        unlock(pool);
+    }
+    unlock(pool);
 
-        if ((ejs = ejsCloneVM(pool->template)) == 0) {
-            mprLog("ejs vm", 0, "Cannot alloc ejs VM");
+    if ((ejs = ejsCloneVM(pool->template)) == 0) {
+        mprLog("ejs vm", 0, "Cannot alloc ejs VM");
+        return 0;
+    }
+    if (pool->hostedDocuments) {
+        ejs->hostedDocuments = pool->hostedDocuments;
+    }
+    if (pool->hostedHome) {
+        ejs->hostedHome = pool->hostedHome;
+    }
+    mprAddRoot(ejs);
+    if (pool->startScriptPath) {
+        if (ejsLoadScriptFile(ejs, pool->startScriptPath, NULL, EC_FLAGS_NO_OUT | EC_FLAGS_BIND) < 0) {
+            mprLog("ejs vm", 0, "Cannot load \"%s\"\n%s", pool->startScriptPath, ejsGetErrorMsg(ejs, 1));
+            mprRemoveRoot(ejs);
             return 0;
         }
-        if (pool->hostedDocuments) {
-            ejs->hostedDocuments = pool->hostedDocuments;
-        }
-        if (pool->hostedHome) {
-            ejs->hostedHome = pool->hostedHome;
+    } else if (pool->startScript) {
+        script = ejsCreateStringFromAsc(ejs, pool->startScript);
+        if (ejsLoadScriptLiteral(ejs, script, NULL, EC_FLAGS_NO_OUT | EC_FLAGS_BIND) < 0) {
+            mprLog("ejs vm", 0, "Cannot load \"%@\"\n%s", script, ejsGetErrorMsg(ejs, 1));
+            mprRemoveRoot(ejs);
+            return 0;
         }
-        mprAddRoot(ejs);
-        if (pool->startScriptPath) {
-            if (ejsLoadScriptFile(ejs, pool->startScriptPath, NULL, EC_FLAGS_NO_OUT | EC_FLAGS_BIND) < 0) {
-                mprLog("ejs vm", 0, "Cannot load \"%s\"\n%s", pool->startScriptPath, ejsGetErrorMsg(ejs, 1));
-                mprRemoveRoot(ejs);
-                return 0;
-            }
-        } else if (pool->startScript) {
-            script = ejsCreateStringFromAsc(ejs, pool->startScript);
-            if (ejsLoadScriptLiteral(ejs, script, NULL, EC_FLAGS_NO_OUT | EC_FLAGS_BIND) < 0) {
-                mprLog("ejs vm", 0, "Cannot load \"%@\"\n%s", script, ejsGetErrorMsg(ejs, 1));
-                mprRemoveRoot(ejs);
-                return 0;
-            }
+    }
+    mprRemoveRoot(ejs);
+    return ejs;
+}
+
+
+Ejs *ejsAllocPoolVM(EjsPool *pool, int flags)
+{
+    Ejs         *ejs;
+
+    assert(pool);
+
+    if (flags & EJS_POOL_RESERVED) {
+        ejs = 0;
+    } else if ((ejs = mprPopItem(pool->list)) == 0) {
+        /*
+            Reserve the new interpreter under the lock as pool users release interpreters from other threads
+         */
+        lock(pool);
+        if (pool->count >= pool->max) {
+            unlock(pool);
+            mprLog("ejs vm", 0, "Too many ejs VMS: %d max %d", pool->count, pool->max);
+            return 0;
         }
-        mprRemoveRoot(ejs);
         pool->count++;
+        unlock(pool);
+    }
+    if (ejs == 0) {
+        if ((ejs = createPoolVM(pool, flags & ~EJS_POOL_RESERVED)) == 0) {
+            lock(pool);
+            pool->count--;
+            unlock(pool);
+            return 0;
+        }
     }
     pool->lastActivity = mprGetTime();
     mprDebug("ejs", 5, "Alloc VM active %d, allocated %d, max %d", pool->count - mprGetListLength(pool->list), 
@@ -628,9 +659,11 @@ static int configureEjs(Ejs *ejs)
         ejsConfigureStringType(ejs);
         ejsConfigureSystemType(ejs);
         ejsConfigureTimerType(ejs);
+        ejsConfigureTypedArrayTypes(ejs);
         ejsConfigureWorkerType(ejs);
         ejsConfigureXMLType(ejs);
         ejsConfigureXMLListType(ejs);
+        ejsConfigureXMLReaderType(ejs);
 #if ME_HTTP_WEB_SOCKETS
         ejsConfigureWebSocketType(ejs);
 #endif